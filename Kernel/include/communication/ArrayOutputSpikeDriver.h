@@ -26,8 +26,6 @@
  * This file declares a class for write output spikes into a vector in memory.
  */
 
-#include <vector>
-
 #include "./OutputSpikeDriver.h"
 
 
@@ -37,6 +35,9 @@
  * \brief Class for getting output spikes only using a function when the simulation is stopped.
  *
  * This class abstract methods for communicate the output spikes when you are simulating step-by-step.
+ * The spikes are stored in two buffers (arrays of times and cells) owned by the driver: the spikes
+ * of a slot are read from one of them (GetSlotSpikes) while the simulation writes in the other one,
+ * so the spikes can be read without allocations nor copies.
  *
  * \author Jesus Garrido
  * \date May 2010
@@ -46,31 +47,37 @@ class ArrayOutputSpikeDriver: public OutputSpikeDriver {
 	private:
 
 		/*!
-		 * Output spike struct.
+		 * Spike times of both buffers.
 		 */
-		struct OutputSpike {
-			/*!
-			 * Number of neuron.
-			 */
-			long int Neuron;
+		double * BufferTimes[2];
 
-			/*!
-			 * Time of the spike.
-			 */
-			float Time;
+		/*!
+		 * Spike cells of both buffers.
+		 */
+		long int * BufferCells[2];
 
-			OutputSpike(){};
+		/*!
+		 * Number of spikes of both buffers.
+		 */
+		int BufferSize[2];
 
-			OutputSpike(int NewNeuron, float NewTime):Neuron(NewNeuron), Time(NewTime){};
-		};
+		/*!
+		 * Allocated spikes of both buffers.
+		 */
+		int BufferCapacity[2];
 
-	public:
 		/*!
-		 * Spike buffer
+		 * Buffer where the new spikes are written.
 		 */
-		vector<OutputSpike> OutputBuffer;
+		int WriteBuffer;
+
+		/*!
+		 * Spikes of the write buffer which have been already removed (RemoveBufferedSpike).
+		 */
+		int ReadPosition;
+
+	public:
 
-	
 
 		/*!
 		 * \brief Class constructor.
@@ -96,7 +103,7 @@ class ArrayOutputSpikeDriver: public OutputSpikeDriver {
 		 * \param NewSpike The spike for send.
 		 *
 		 * \see FlushBuffers()
-		 * \see GetBufferedSpikes()
+		 * \see GetSlotSpikes()
 		 *
 		 * \throw EDLUTException If something wrong happens in the output process.
 		 */
@@ -158,15 +165,33 @@ class ArrayOutputSpikeDriver: public OutputSpikeDriver {
 		 * \note This function allocates the necessary memory (spike_number*(sizeof(double)+sizeof(long int)).
 		 * \note The buffered will be empty after storing all the spikes.
 		 *
+		 * \see GetSlotSpikes() It returns the spikes without allocations nor copies.
+		 *
 		 * \throw EDLUTException If something wrong happens in the output process.
 		 */
 		 int GetBufferedSpikes(double *& Times, long int *& Cells);
 
+		/*!
+		 * \brief It returns the spikes of the output buffer without copying them.
+		 *
+		 * This method returns the buffered spikes as read-only arrays of times and cells owned by
+		 * the driver, and the new spikes are written in the other buffer. The arrays are valid until
+		 * the next call to this method (or GetBufferedSpikes).
+		 *
+		 * \param Times Variable where the spike times array is stored.
+		 * \param Cells Variable where the spike cells array is stored.
+		 *
+		 * \return The number of spikes.
+		 *
+		 * \note The buffer will be empty after calling this method.
+		 */
+		 int GetSlotSpikes(const double *& Times, const long int *& Cells);
+
 		/*!
 		 * \brief It pops the first spike from the output buffer.
 		 *
 		 * This method returns (as parameters) the first existing 
-		 * spike in the output buffer and removes it from the buffer.
+		 * spike in the output buffer and removes it from the buffer (in constant time).
 		 *
 		 * \param Time Variable where spike time is stored.
 		 * \param Cell Variable where spike cell os stored.
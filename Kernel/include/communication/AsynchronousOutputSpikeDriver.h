@@ -0,0 +1,347 @@
+/***************************************************************************
+ *                           AsynchronousOutputSpikeDriver.h               *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef ASYNCHRONOUSOUTPUTSPIKEDRIVER_H_
+#define ASYNCHRONOUSOUTPUTSPIKEDRIVER_H_
+
+/*!
+ * \file AsynchronousOutputSpikeDriver.h
+ *
+ * \author Jesus Garrido
+ * \date July 2013
+ *
+ * This file declares a class which moves the work of an output driver to a background thread.
+ */
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <pthread.h>
+#endif
+
+#include "./OutputSpikeDriver.h"
+
+#include "../spike/EDLUTException.h"
+
+/*!
+ * Default number of slots of the record ring (it must be a power of two).
+ */
+#define ASYNCOUTPUTRINGSIZE 1048576
+
+/*!
+ * Size (in bytes) of a cache line. It separates the positions of the producer and the consumer.
+ */
+#define ASYNCOUTPUTCACHELINE 64
+
+/*!
+ * Number of times the writer thread yields on an empty ring before it sleeps.
+ */
+#define ASYNCOUTPUTSPINS 100
+
+/*!
+ * \brief Slot of the record ring.
+ *
+ * Each record is stored in consecutive slots (modulo the ring size): the kind of record (or the
+ * number of state values), the event time, the source neuron and the state values. Flush records
+ * only store the kind and the flush time.
+ */
+union AsynchronousOutputSlot {
+	/*!
+	 * Kind of record or number of state values.
+	 */
+	unsigned int Kind;
+
+	/*!
+	 * Event time or state value.
+	 */
+	double Value;
+
+	/*!
+	 * Source neuron of the event.
+	 */
+	Neuron * Source;
+};
+
+/*!
+ * \class AsynchronousOutputSpikeDriver
+ *
+ * \brief Output driver which writes the activity of another driver from a background thread.
+ *
+ * This class wraps an output driver. The simulation thread only copies the spikes and the neuron
+ * states (as compact records) to a lock-free single-producer single-consumer ring, and a
+ * background thread drains the ring and calls the wrapped driver. The records keep their order,
+ * and the buffer flushes of the wrapped driver are forwarded as records too (with their time).
+ *
+ * When the ring is full, the simulation thread waits for the writer (a stall). The number of
+ * stalls and the ring high-water mark are reported when the driver is destroyed.
+ *
+ * An idle writer yields for a while and then sleeps (at most 1 ms). The flush and end records
+ * and the stalls wake it up, so a flush of the wrapped driver (e.g. a TCP/IP step) is not delayed
+ * by the sleep.
+ *
+ * \author Jesus Garrido
+ * \date July 2013
+ */
+class AsynchronousOutputSpikeDriver: public OutputSpikeDriver {
+	
+	private:
+
+		/*!
+		 * The wrapped output driver.
+		 */
+		OutputSpikeDriver * Driver;
+
+		/*!
+		 * The record ring.
+		 */
+		AsynchronousOutputSlot * Ring;
+
+		/*!
+		 * Number of slots of the ring.
+		 */
+		unsigned long RingSize;
+
+		/*!
+		 * Padding which keeps the producer position in its own cache line.
+		 */
+		char PaddingHead[ASYNCOUTPUTCACHELINE];
+
+		/*!
+		 * Number of slots written by the producer (simulation thread).
+		 */
+		volatile unsigned long Head;
+
+		/*!
+		 * Number of wake-ups of the writer thread (the writer sleeps on it).
+		 */
+		volatile unsigned int WakeSequence;
+
+		/*!
+		 * Padding which keeps the consumer position in its own cache line.
+		 */
+		char PaddingTail[ASYNCOUTPUTCACHELINE];
+
+		/*!
+		 * Number of slots read by the consumer (writer thread).
+		 */
+		volatile unsigned long Tail;
+
+		/*!
+		 * It tells if the writer thread is sleeping (or going to sleep).
+		 */
+		volatile unsigned int WriterWaiting;
+
+		/*!
+		 * Padding after the consumer position.
+		 */
+		char PaddingEnd[ASYNCOUTPUTCACHELINE];
+
+		/*!
+		 * Maximum number of used slots.
+		 */
+		unsigned long HighWaterMark;
+
+		/*!
+		 * Number of writes which have waited for free slots.
+		 */
+		unsigned long Stalls;
+
+		/*!
+		 * Simulation time of the next flush.
+		 */
+		double FlushTime;
+
+		/*!
+		 * First error of the writer thread (NULL if no error has happened).
+		 */
+		EDLUTException * volatile Error;
+
+#ifdef _WIN32
+		/*!
+		 * The event which wakes up the writer thread.
+		 */
+		HANDLE WriterEvent;
+#endif
+
+		/*!
+		 * The writer thread.
+		 */
+#ifdef _WIN32
+		HANDLE Writer;
+#else
+		pthread_t Writer;
+#endif
+
+		/*!
+		 * \brief It reserves consecutive slots in the ring.
+		 * 
+		 * It reserves consecutive slots in the ring. If there are not enough free slots, it waits
+		 * until the writer thread releases them.
+		 * 
+		 * \param Slots Number of slots.
+		 * 
+		 * \return The position of the first slot (it must be masked with the ring size).
+		 * 
+		 * \throw EDLUTException If the writer thread has failed or the record is larger than the ring.
+		 */
+		unsigned long ReserveSlots(unsigned long Slots) throw (EDLUTException);
+
+		/*!
+		 * \brief It publishes the reserved slots.
+		 * 
+		 * It makes the reserved slots visible to the writer thread.
+		 * 
+		 * \param Slots Number of slots.
+		 */
+		void PublishSlots(unsigned long Slots);
+
+		/*!
+		 * \brief It wakes up the writer thread.
+		 * 
+		 * It wakes up the writer thread if it is sleeping on an empty ring.
+		 */
+		void WakeWriter();
+
+		/*!
+		 * \brief It drains the ring.
+		 * 
+		 * It drains the ring (the body of the writer thread) until the end record is found.
+		 */
+		void DrainRing();
+
+		/*!
+		 * \brief Entry point of the writer thread.
+		 * 
+		 * Entry point of the writer thread.
+		 * 
+		 * \param Object The driver.
+		 */
+#ifdef _WIN32
+		static DWORD WINAPI WriterThread(LPVOID Object);
+#else
+		static void * WriterThread(void * Object);
+#endif
+		
+	public:
+	
+		/*!
+		 * \brief Class constructor.
+		 * 
+		 * It creates a new object and starts the writer thread. The wrapped driver will be
+		 * destroyed with this object.
+		 * 
+		 * \param NewDriver The wrapped output driver.
+		 * \param NewRingSize Number of slots of the ring (a power of two).
+		 * 
+		 * \throw EDLUTException If the writer thread can not be created.
+		 */
+		AsynchronousOutputSpikeDriver(OutputSpikeDriver * NewDriver, unsigned long NewRingSize=ASYNCOUTPUTRINGSIZE) throw (EDLUTException);
+		
+		/*!
+		 * \brief Class desctructor.
+		 * 
+		 * Class desctructor. It waits until the writer thread has written every record, prints
+		 * the ring statistics and destroys the wrapped driver.
+		 */
+		~AsynchronousOutputSpikeDriver();
+	
+		/*!
+		 * \brief It communicates the output activity to the external system.
+		 * 
+		 * This method stores the output spike in the ring.
+		 * 
+		 * \param NewSpike The spike for print.
+		 * 
+		 * \throw EDLUTException If something wrong has happened in the writer thread.
+		 */
+		virtual void WriteSpike(const Spike * NewSpike) throw (EDLUTException);
+		
+		/*!
+		 * \brief It communicates the neuron state to the external system.
+		 * 
+		 * This method copies the printable state values of the neuron to the ring.
+		 * 
+		 * \param Time Time of the event (potential value).
+		 * \param Source Source neuron of the potential.
+		 * 
+		 * \throw EDLUTException If something wrong has happened in the writer thread.
+		 */		
+		virtual void WriteState(float Time, Neuron * Source) throw (EDLUTException);
+
+		/*!
+		 * \brief It communicates a copy of the neuron state to the external system.
+		 * 
+		 * This method copies the given state values of the neuron to the ring.
+		 * 
+		 * \param Time Time of the event (potential value).
+		 * \param Source Source neuron of the potential.
+		 * \param NumberOfValues Number of state values.
+		 * \param Values The state values.
+		 * 
+		 * \throw EDLUTException If something wrong has happened in the writer thread.
+		 */		
+		virtual void WriteStateValues(float Time, Neuron * Source, unsigned int NumberOfValues, const double * Values) throw (EDLUTException);
+		
+		/*!
+		 * \brief It checks if the current output driver is buffered.
+		 * 
+		 * This method checks if the wrapped output driver has an output buffer.
+		 * 
+		 * \return True if the wrapped driver has an output buffer. False in other case.
+		 */
+		 virtual bool IsBuffered() const;
+		 
+		/*!
+		 * \brief It checks if the current output driver can write neuron potentials.
+		 * 
+		 * This method checks if the wrapped output driver can write neuron potentials.
+		 * 
+		 * \return True if the wrapped driver can write neuron potentials. False in other case.
+		 */
+		 virtual bool IsWritePotentialCapable() const;
+		 
+		/*!
+		 * \brief It writes the existing spikes in the output buffer.
+		 * 
+		 * This method stores a flush record in the ring. The writer thread will flush the buffers
+		 * of the wrapped driver after the previous records.
+		 * 
+		 * \throw EDLUTException If something wrong has happened in the writer thread.
+		 */
+		 virtual void FlushBuffers() throw (EDLUTException);
+
+		/*!
+		 * \brief It sets the simulation time of the next buffer flush.
+		 * 
+		 * This method stores the time, which is forwarded to the wrapped driver with the next
+		 * flush record.
+		 * 
+		 * \param Time Simulation time of the communication step.
+		 */
+		 virtual void SetFlushTime(double Time);
+
+		/*!
+		 * \brief It prints the information of the object.
+		 *
+		 * It prints the information of the object.
+		 *
+		 * \param out The output stream where it prints the object to.
+		 * \return The output stream.
+		 */
+		virtual ostream & PrintInfo(ostream & out);
+};
+
+#endif /*ASYNCHRONOUSOUTPUTSPIKEDRIVER_H_*/
@@ -0,0 +1,231 @@
+/***************************************************************************
+ *                           BinaryFileOutputSpikeDriver.h                 *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef BINARYFILEOUTPUTSPIKEDRIVER_H_
+#define BINARYFILEOUTPUTSPIKEDRIVER_H_
+
+/*!
+ * \file BinaryFileOutputSpikeDriver.h
+ *
+ * \author Jesus Garrido
+ * \date July 2013
+ *
+ * This file declares a class for write output spikes and neuron states in a binary file.
+ */
+#include <cstdio>
+#include <string>
+ 
+#include "./OutputSpikeDriver.h"
+
+#include "../spike/EDLUTException.h"
+
+/*!
+ * File signature of the binary output files.
+ */
+#define BINARYOUTPUTSIGNATURE "EDLUTBIN"
+
+/*!
+ * Format version of the binary output files.
+ */
+#define BINARYOUTPUTVERSION 1
+
+/*!
+ * Byte order mark of the binary output files (it allows to detect files written in other architectures).
+ */
+#define BINARYOUTPUTBYTEORDER 0x01020304
+
+/*!
+ * Size (in bytes) of the file header: signature, version and byte order mark.
+ */
+#define BINARYOUTPUTHEADERSIZE 16
+
+/*!
+ * Size (in bytes) of the fixed part of a record: time (double), neuron index (int) and
+ * number of state values (unsigned int).
+ */
+#define BINARYOUTPUTRECORDSIZE 16
+
+/*!
+ * Default size (in bytes) of the write buffer.
+ */
+#define BINARYOUTPUTBUFFERSIZE 1048576
+
+/*!
+ * \class BinaryFileOutputSpikeDriver
+ *
+ * \brief Class for communicate output spikes and neuron states in a binary output file. 
+ *
+ * This class abstract methods for communicate the output spikes to the target file. Unlike
+ * FileOutputSpikeDriver, the events are not formatted as text. Each event is stored in a
+ * record with the event time (double), the neuron index (int) and the number of state values
+ * (unsigned int, 0 for the spikes) followed by the state values (double). The records are
+ * accumulated in a large buffer which is written to the file when it is full.
+ *
+ * The file starts with the signature BINARYOUTPUTSIGNATURE, the format version and the byte
+ * order mark (both unsigned int). The binaryconverter tool turns these files into the text
+ * layout of FileOutputSpikeDriver.
+ *
+ * \author Jesus Garrido
+ * \date July 2013
+ */
+class BinaryFileOutputSpikeDriver: public OutputSpikeDriver {
+	
+	private:
+	
+		/*!
+		 * The file handler.
+		 */
+		FILE * Handler;
+		
+		/*!
+		 * The file name.
+		 */
+		string FileName;
+		
+		/*!
+		 * Write potential events.
+		 */
+		bool PotentialWriteable;
+
+		/*!
+		 * The write buffer.
+		 */
+		char * Buffer;
+
+		/*!
+		 * Capacity (in bytes) of the write buffer.
+		 */
+		unsigned int BufferSize;
+
+		/*!
+		 * Number of bytes stored in the write buffer.
+		 */
+		unsigned int BufferUsed;
+
+		/*!
+		 * \brief It reserves space for a new record in the write buffer.
+		 * 
+		 * It reserves space for a new record in the write buffer. The buffer is written to
+		 * the file if there is not enough space (and it is enlarged if the record does not fit
+		 * in the empty buffer).
+		 * 
+		 * \param Size Size (in bytes) of the record.
+		 * 
+		 * \return The position of the record in the buffer.
+		 * 
+		 * \throw EDLUTException If something wrong happens when the buffer is written.
+		 */
+		char * ReserveRecord(unsigned int Size) throw (EDLUTException);
+		
+	public:
+	
+		/*!
+		 * \brief Class constructor.
+		 * 
+		 * It creates a new object from the file target and writes the file header.
+		 * 
+		 * \param NewFileName Name of the target output file.
+		 * \param WritePotential If true, the potential events will be saved.
+		 * 
+		 * \throw EDLUTException If something wrong happens when the file is been wrotten.
+		 */
+		BinaryFileOutputSpikeDriver(const char * NewFileName, bool WritePotential) throw (EDLUTException);
+		
+		/*!
+		 * \brief Class desctructor.
+		 * 
+		 * Class desctructor. It writes the pending records to the file.
+		 */
+		~BinaryFileOutputSpikeDriver();
+	
+		/*!
+		 * \brief It communicates the output activity to the output file.
+		 * 
+		 * This method stores the output spike in the write buffer.
+		 * 
+		 * \param NewSpike The spike for print.
+		 * 
+		 * \throw EDLUTException If something wrong happens in the output process.
+		 */
+		virtual void WriteSpike(const Spike * NewSpike) throw (EDLUTException);
+		
+		/*!
+		 * \brief It communicates the neuron state to the output file.
+		 * 
+		 * This method stores the printable state values of the neuron in the write buffer.
+		 * 
+		 * \param Time Time of the event (potential value).
+		 * \param Source Source neuron of the potential.
+		 * 
+		 * \throw EDLUTException If something wrong happens in the output process.
+		 */		
+		virtual void WriteState(float Time, Neuron * Source) throw (EDLUTException);
+
+		/*!
+		 * \brief It communicates a copy of the neuron state to the output file.
+		 * 
+		 * This method introduces a copy of the printable state values to the output file.
+		 * 
+		 * \param Time Time of the event (potential value).
+		 * \param Source Source neuron of the potential.
+		 * \param NumberOfValues Number of printable state values.
+		 * \param Values The printable state values.
+		 * 
+		 * \throw EDLUTException If something wrong happens in the output process.
+		 */		
+		virtual void WriteStateValues(float Time, Neuron * Source, unsigned int NumberOfValues, const double * Values) throw (EDLUTException);
+		
+		/*!
+		 * \brief It checks if the current output driver is buffered.
+		 * 
+		 * This method checks if the current output driver has an output buffer. The write
+		 * buffer of this driver only exists to reduce the file accesses, so it does not
+		 * need to be flushed in every communication event.
+		 * 
+		 * \return False.
+		 */
+		 virtual bool IsBuffered() const;
+		 
+		/*!
+		 * \brief It checks if the current output driver can write neuron potentials.
+		 * 
+		 * This method checks if the current output driver can write neuron potentials.
+		 * 
+		 * \return True if the current driver can write neuron potentials. False in other case.
+		 */
+		 virtual bool IsWritePotentialCapable() const;
+		 
+		/*!
+		 * \brief It writes the existing spikes in the output buffer.
+		 * 
+		 * This method writes the existing records of the write buffer to the file.
+		 * 
+		 * \throw EDLUTException If something wrong happens in the output process.
+		 */
+		 virtual void FlushBuffers() throw (EDLUTException);
+
+		/*!
+		 * \brief It prints the information of the object.
+		 *
+		 * It prints the information of the object.
+		 *
+		 * \param out The output stream where it prints the object to.
+		 * \return The output stream.
+		 */
+		virtual ostream & PrintInfo(ostream & out);
+};
+
+#endif /*BINARYFILEOUTPUTSPIKEDRIVER_H_*/
@@ -30,10 +30,15 @@
 
 #include "./CommunicationDevice.h"
 
+// The socket status is a TCPIPConnectionType (the drivers compare their type with the same values)
+#include "./TCPIPConnectionType.h"
+
 using namespace std;
 
-#define CLIENT 0
-#define SERVER 1
+/*!
+ * Maximum number of blocks sent by sendBuffers.
+ */
+#define CDSOCKETMAXBUFFERS 8
 
 //( Cd_Socket
 
@@ -88,6 +93,42 @@ public:
    **/
   int receiveBuffer(void* buffer,int buffer_size);
 
+  /*!
+   *
+   * \brief Send several blocks of data with a single call (gather write)
+   * 
+   * \param   buffers       data blocks to send (at most CDSOCKETMAXBUFFERS)
+   * \param   buffer_sizes  sizes of the blocks
+   * \param   buffer_number number of blocks
+   *
+   * \return  the number of sent bytes (-1 if something wrong happened)
+   *
+   **/
+  int sendBuffers(void** buffers,int* buffer_sizes,int buffer_number);
+
+  /*!
+   *
+   * \brief Wait until there is data to be received
+   * 
+   * \param   timeout      maximum waiting time in milliseconds
+   *
+   * \return  true if there is data to be received
+   *
+   **/
+  bool waitForData(int timeout);
+
+  /*!
+   *
+   * \brief Copy the received data without removing it (and without blocking)
+   * 
+   * \param   buffer       where the data is copied
+   * \param   buffer_size  maximum size of the data
+   *
+   * \return  the number of copied bytes (0 or less if there is no data)
+   *
+   **/
+  int peekBuffer(void* buffer,int buffer_size);
+
 
 protected:
   /*!
@@ -141,7 +182,7 @@ protected:
 
   /*!
    *
-   * is it a client or server ? 0 = CLIENT / 1 = SERVER
+   * is it a client or server ? CLIENT / SERVER
    * 
    **/
   unsigned short status;
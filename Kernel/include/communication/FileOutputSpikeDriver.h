@@ -108,6 +108,20 @@ class FileOutputSpikeDriver: public OutputSpikeDriver {
 		 * \throw EDLUTException If something wrong happens in the output process.
 		 */		
 		virtual void WriteState(float Time, Neuron * Source) throw (EDLUTException);
+
+		/*!
+		 * \brief It communicates a copy of the neuron state to the output file.
+		 * 
+		 * This method introduces a copy of the printable state values to the output file.
+		 * 
+		 * \param Time Time of the event (potential value).
+		 * \param Source Source neuron of the potential.
+		 * \param NumberOfValues Number of printable state values.
+		 * \param Values The printable state values.
+		 * 
+		 * \throw EDLUTException If something wrong happens in the output process.
+		 */		
+		virtual void WriteStateValues(float Time, Neuron * Source, unsigned int NumberOfValues, const double * Values) throw (EDLUTException);
 		
 		/*!
 		 * \brief It checks if the current output driver is buffered.
@@ -0,0 +1,222 @@
+/***************************************************************************
+ *                           GeneratorInputSpikeDriver.h                   *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef GENERATORINPUTSPIKEDRIVER_H_
+#define GENERATORINPUTSPIKEDRIVER_H_
+
+/*!
+ * \file GeneratorInputSpikeDriver.h
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ *
+ * This file declares a class for generating input spikes inside the simulator from
+ * per-neuron firing rates.
+ */
+#include "./InputSpikeDriver.h"
+
+class EventQueue;
+class Network;
+
+/*!
+ * Default length (in seconds) of the time windows generated at once.
+ */
+#define GENERATORINPUTSTEP 0.001
+
+/*!
+ * \class GeneratorInputSpikeDriver
+ *
+ * \brief Class for generating input spikes from per-neuron firing rates. 
+ *
+ * This class generates the input spikes of a range of consecutive neurons from a firing rate
+ * per neuron. The spikes are not generated in advance: a GeneratorInputEvent at the beginning of
+ * each time window generates the spikes of this window and schedules the following one, so the
+ * rates can be changed between windows (i.e. between simulation slots) without any per-spike work
+ * out of the simulator.
+ *
+ * Each neuron accumulates the integral of its rate along the time, and it fires when this integral
+ * reaches the mass drawn after its last spike. The subclasses choose this mass (a unit exponential
+ * for Poisson trains, 1 for regular trains), so piecewise-constant rates are handled exactly.
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ */
+class GeneratorInputSpikeDriver: public InputSpikeDriver {
+	
+	protected:
+	
+		/*!
+		 * First neuron of the generator.
+		 */
+		int FirstNeuron;
+		
+		/*!
+		 * Number of neurons of the generator.
+		 */
+		int NumberOfNeurons;
+
+		/*!
+		 * Length of the time windows.
+		 */
+		double Step;
+
+		/*!
+		 * Firing rate (in Hz) of each neuron.
+		 */
+		double * Rates;
+
+		/*!
+		 * Rate integral which remains until the next spike of each neuron.
+		 */
+		double * Remaining;
+
+		/*!
+		 * Start time of the first time window.
+		 */
+		double StartTime;
+
+		/*!
+		 * Number of generated time windows (the window limits are computed from the start time
+		 * and this number, so they don't drift).
+		 */
+		long Windows;
+
+		/*!
+		 * True if the first time window has been scheduled.
+		 */
+		bool Scheduled;
+
+		/*!
+		 * State of the random number generator.
+		 */
+		unsigned long long RandomState;
+
+		/*!
+		 * \brief It returns a uniform random number.
+		 * 
+		 * It returns a uniform random number in [0,1) from a xorshift generator.
+		 * 
+		 * \return The random number.
+		 */
+		double RandomUniform();
+
+		/*!
+		 * \brief It returns the rate integral until the next spike.
+		 * 
+		 * It returns the rate integral which a neuron must accumulate between two spikes.
+		 * 
+		 * \return The rate integral until the next spike.
+		 */
+		virtual double NextSpikeMass() = 0;
+	
+	public:
+	
+		/*!
+		 * \brief Class constructor.
+		 * 
+		 * It creates a new generator with null rates.
+		 * 
+		 * \param NewFirstNeuron First neuron of the generator.
+		 * \param NewNumberOfNeurons Number of neurons of the generator.
+		 * \param NewStep Length (in seconds) of the time windows.
+		 * \param NewStartTime Start time of the first time window.
+		 * \param Seed Seed of the random number generator.
+		 */
+		GeneratorInputSpikeDriver(int NewFirstNeuron, int NewNumberOfNeurons, double NewStep=GENERATORINPUTSTEP, double NewStartTime=0.0, unsigned int Seed=1);
+		
+		/*!
+		 * \brief Class desctructor.
+		 * 
+		 * Class desctructor.
+		 */
+		virtual ~GeneratorInputSpikeDriver();
+	
+		/*!
+		 * \brief It schedules the first time window.
+		 * 
+		 * This method generates the first time window. The following windows are generated by the
+		 * GeneratorInputEvent objects.
+		 * 
+		 * \param Queue The event queue where the input spikes are inserted.
+		 * \param Net The network associated to the input spikes.
+		 * 
+		 * \throw EDLUTException If the neurons of the generator are not defined in the network.
+		 */
+		virtual void LoadInputs(EventQueue * Queue, Network * Net) throw (EDLUTException);
+
+		/*!
+		 * \brief It generates the input spikes of the next time window.
+		 * 
+		 * This method inserts the input spikes of the time window which starts in CurrentTime
+		 * and a GeneratorInputEvent at the end of the window. The rates are read at this moment,
+		 * so the rates which are set before the window starts are used in the whole window.
+		 * 
+		 * \param Queue The event queue where the input spikes are inserted.
+		 * \param Net The network associated to the input spikes.
+		 * \param CurrentTime Current simulation time.
+		 */
+		void LoadWindow(EventQueue * Queue, Network * Net, double CurrentTime);
+
+		/*!
+		 * \brief It sets the firing rate of a neuron.
+		 * 
+		 * It sets the firing rate of a neuron from the next time window.
+		 * 
+		 * \param Index The neuron index (relative to the first neuron of the generator).
+		 * \param Rate The firing rate (in Hz).
+		 */
+		void SetRate(int Index, double Rate);
+
+		/*!
+		 * \brief It sets the firing rates of every neuron.
+		 * 
+		 * It sets the firing rates of every neuron from the next time window.
+		 * 
+		 * \param NewRates The firing rates (in Hz). One for each neuron of the generator.
+		 */
+		void SetRates(const double * NewRates);
+
+		/*!
+		 * \brief It returns the firing rate of a neuron.
+		 * 
+		 * It returns the firing rate of a neuron.
+		 * 
+		 * \param Index The neuron index (relative to the first neuron of the generator).
+		 * 
+		 * \return The firing rate (in Hz).
+		 */
+		double GetRate(int Index) const;
+
+		/*!
+		 * \brief It returns the first neuron of the generator.
+		 * 
+		 * It returns the first neuron of the generator.
+		 * 
+		 * \return The first neuron of the generator.
+		 */
+		int GetFirstNeuron() const;
+
+		/*!
+		 * \brief It returns the number of neurons of the generator.
+		 * 
+		 * It returns the number of neurons of the generator.
+		 * 
+		 * \return The number of neurons of the generator.
+		 */
+		int GetNumberOfNeurons() const;
+};
+
+#endif /*GENERATORINPUTSPIKEDRIVER_H_*/
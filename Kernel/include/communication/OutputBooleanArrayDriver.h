@@ -57,12 +57,35 @@ class OutputBooleanArrayDriver: public ArrayOutputSpikeDriver {
 		 */
 		unsigned int NumOutputLines;
 
+		/*!
+		 * Lowest associated cell.
+		 */
+		long int FirstCell;
+
+		/*!
+		 * Number of cells between the lowest and the highest associated cells.
+		 */
+		long int CellRange;
+
+		/*!
+		 * First output line of each cell (FirstLine[cell-FirstCell], -1 if the cell has no line).
+		 */
+		int * FirstLine;
+
+		/*!
+		 * Next output line of the same cell (-1 if it is the last one).
+		 */
+		int * NextLine;
+
 	public:
 
 		/*!
 		 * \brief Class constructor.
 		 *
-		 * It creates a new object to send spikes.
+		 * It creates a new object to send spikes and the index from cells to output lines.
+		 *
+		 * \param OutputLines Number of output lines.
+		 * \param Associated Cell associated to each output line.
 		 */
 		OutputBooleanArrayDriver(unsigned int OutputLines, int * Associated);
 
@@ -76,7 +99,8 @@ class OutputBooleanArrayDriver: public ArrayOutputSpikeDriver {
 		/*!
 		 * \brief This method sends spikes from arrays to a boolean array.
 		 *
-		 * This method sends spikes from arrays to a boolean array.
+		 * This method sends spikes from arrays to a boolean array. The time is proportional to
+		 * the number of spikes (and output lines), not to their product.
 		 *
 		 * \param OutputLines An array of NumOutputLines boolean values (true->Output spikes to associated neuron).
 		 */
@@ -43,14 +43,98 @@ class Spike;
  * This class abstract methods for communicate the output spikes to the external system. Its subclasses
  * implements the output target and methods.
  *
+ * When the driver monitors the neuron states, it also filters which states are written: it can
+ * write the state of each neuron once per sampling period, only inside some time windows, only
+ * when the neuron fires, and only a subset of the state variables. This bounds the cost of the
+ * state recording independently of the input rate and the simulation step.
+ *
  * \author Jesus Garrido
  * \author Richard Carrillo
  * \date August 2008
  */
 class OutputSpikeDriver : public PrintableObject {
 
+	private:
+
+		/*!
+		 * It tells if some state monitoring filter is set (otherwise every state is written).
+		 */
+		bool StateFiltered;
+
+		/*!
+		 * Period between two state samples of the same neuron (0 if every state is written).
+		 */
+		double StatePeriod;
+
+		/*!
+		 * Time of the next state sample of each neuron (indexed by the neuron number).
+		 */
+		float * NextStateTime;
+
+		/*!
+		 * Number of neurons in the next state sample time array.
+		 */
+		long int NumberOfStateNeurons;
+
+		/*!
+		 * Time windows where the states are written (start and end of each window).
+		 */
+		double * StateWindows;
+
+		/*!
+		 * Number of time windows (0 if the states are written at any time).
+		 */
+		unsigned int NumberOfStateWindows;
+
+		/*!
+		 * Indexes of the written state variables (printable values).
+		 */
+		unsigned int * StateVariables;
+
+		/*!
+		 * Number of written state variables (0 if all the state variables are written).
+		 */
+		unsigned int NumberOfStateVariables;
+
+		/*!
+		 * Buffer with the values of the written state variables.
+		 */
+		double * StateValues;
+
+		/*!
+		 * It tells if the states are written only when the neuron fires.
+		 */
+		bool StateOnlyAtFiring;
+
+		/*!
+		 * \brief It updates the state monitoring filter flag.
+		 *
+		 * It updates the state monitoring filter flag.
+		 */
+		void UpdateStateFiltered();
+
+	protected:
+
+		/*!
+		 * \brief It prints the state monitoring configuration.
+		 *
+		 * It prints the state monitoring configuration (nothing if every state is written).
+		 *
+		 * \param out The stream where it prints the information.
+		 *
+		 * \return The stream after the printer.
+		 */
+		ostream & PrintStateMonitoring(ostream & out);
+
 	public:
 	
+		/*!
+		 * \brief Default constructor.
+		 * 
+		 * It creates a new driver which writes every neuron state.
+		 */
+		OutputSpikeDriver();
+
 		/*!
 		 * \brief Default destructor.
 		 * 
@@ -80,6 +164,22 @@ class OutputSpikeDriver : public PrintableObject {
 		 * \throw EDLUTException If something wrong happens in the output process.
 		 */		
 		virtual void WriteState(float Time, Neuron * Source) throw (EDLUTException) = 0;
+
+		/*!
+		 * \brief It communicates a copy of the neuron state to the external system.
+		 * 
+		 * This method introduces the neuron state to the output target from a copy of the printable
+		 * values (taken by the simulation thread when the neuron state could have changed later).
+		 * The default implementation ignores the state, as the drivers which can not write potentials.
+		 * 
+		 * \param Time Time of the event (potential value).
+		 * \param Source Source neuron of the potential.
+		 * \param NumberOfValues Number of printable state values.
+		 * \param Values The printable state values.
+		 * 
+		 * \throw EDLUTException If something wrong happens in the output process.
+		 */		
+		virtual void WriteStateValues(float Time, Neuron * Source, unsigned int NumberOfValues, const double * Values) throw (EDLUTException);
 		
 		/*!
 		 * \brief It checks if the current output driver is buffered.
@@ -107,6 +207,83 @@ class OutputSpikeDriver : public PrintableObject {
 		 * \throw EDLUTException If something wrong happens in the output process.
 		 */
 		 virtual void FlushBuffers() throw (EDLUTException) = 0;
+
+		/*!
+		 * \brief It sets the simulation time of the next buffer flush.
+		 * 
+		 * This method sets the simulation time of the communication step which is flushed
+		 * next. The default implementation ignores it (only the drivers which send this time
+		 * with the spikes use it).
+		 * 
+		 * \param Time Simulation time of the communication step.
+		 */
+		 virtual void SetFlushTime(double Time);
+
+		/*!
+		 * \brief It writes the neuron state if the state monitoring filter accepts it.
+		 * 
+		 * This method checks the state monitoring configuration of the driver (sampling period,
+		 * time windows and firing condition) and writes the neuron state (or the selected state
+		 * variables) if it is accepted.
+		 * 
+		 * \param Time Time of the event (potential value).
+		 * \param Source Source neuron of the potential.
+		 * \param Firing True if the state is written because the neuron fires.
+		 * 
+		 * \throw EDLUTException If something wrong happens in the output process.
+		 */
+		 void MonitorState(float Time, Neuron * Source, bool Firing) throw (EDLUTException);
+
+		/*!
+		 * \brief It sets the state sampling period.
+		 * 
+		 * This method sets the minimum period between two written states of the same neuron. The
+		 * state of a neuron is written in the first event after each multiple of the period.
+		 * 
+		 * \param Period The sampling period (0 to write the state in every event).
+		 */
+		 void SetStateSamplingPeriod(double Period);
+
+		/*!
+		 * \brief It adds a state monitoring time window.
+		 * 
+		 * This method adds a time window. If some window is defined, the states are only written
+		 * inside the windows.
+		 * 
+		 * \param Start Start time of the window.
+		 * \param End End time of the window (not included).
+		 */
+		 void AddStateWindow(double Start, double End);
+
+		/*!
+		 * \brief It sets the written state variables.
+		 * 
+		 * This method sets the state variables (indexes of the printable values of the neuron state)
+		 * which are written. The indexes which don't exist in a neuron model are ignored.
+		 * 
+		 * \param Number Number of state variables (0 to write all of them).
+		 * \param Variables Indexes of the state variables.
+		 */
+		 void SetStateVariables(unsigned int Number, const unsigned int * Variables);
+
+		/*!
+		 * \brief It sets if the states are written only when the neuron fires.
+		 * 
+		 * This method sets if the states are written only when the neuron fires.
+		 * 
+		 * \param OnlyAtFiring True to write the states only when the neuron fires.
+		 */
+		 void SetStateOnlyAtFiring(bool OnlyAtFiring);
+
+		/*!
+		 * \brief It copies the state monitoring configuration of other driver.
+		 * 
+		 * This method copies the state monitoring configuration of other driver (it is used by
+		 * the drivers which wrap other driver).
+		 * 
+		 * \param Driver The driver whose configuration is copied.
+		 */
+		 void CopyStateMonitoring(const OutputSpikeDriver * Driver);
 	
 };
 
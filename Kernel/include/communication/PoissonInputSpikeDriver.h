@@ -0,0 +1,88 @@
+/***************************************************************************
+ *                           PoissonInputSpikeDriver.h                     *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef POISSONINPUTSPIKEDRIVER_H_
+#define POISSONINPUTSPIKEDRIVER_H_
+
+/*!
+ * \file PoissonInputSpikeDriver.h
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ *
+ * This file declares a class for generating Poisson input spike trains inside the simulator.
+ */
+#include "./GeneratorInputSpikeDriver.h"
+
+/*!
+ * \class PoissonInputSpikeDriver
+ *
+ * \brief Class for generating Poisson input spike trains. 
+ *
+ * This class generates a Poisson spike train in each neuron of the generator with the
+ * firing rate of the neuron (which can be changed between time windows).
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ */
+class PoissonInputSpikeDriver: public GeneratorInputSpikeDriver {
+	
+	protected:
+
+		/*!
+		 * \brief It returns the rate integral until the next spike.
+		 * 
+		 * It returns a unit exponential random number, so the intervals between spikes are
+		 * exponentially distributed.
+		 * 
+		 * \return The rate integral until the next spike.
+		 */
+		virtual double NextSpikeMass();
+	
+	public:
+	
+		/*!
+		 * \brief Class constructor.
+		 * 
+		 * It creates a new generator with null rates.
+		 * 
+		 * \param NewFirstNeuron First neuron of the generator.
+		 * \param NewNumberOfNeurons Number of neurons of the generator.
+		 * \param NewStep Length (in seconds) of the time windows.
+		 * \param NewStartTime Start time of the first time window.
+		 * \param Seed Seed of the random number generator.
+		 */
+		PoissonInputSpikeDriver(int NewFirstNeuron, int NewNumberOfNeurons, double NewStep=GENERATORINPUTSTEP, double NewStartTime=0.0, unsigned int Seed=1);
+		
+		/*!
+		 * \brief Class desctructor.
+		 * 
+		 * Class desctructor.
+		 */
+		virtual ~PoissonInputSpikeDriver();
+
+		/*!
+		 * \brief It prints the information of the object.
+		 *
+		 * It prints the information of the object.
+		 *
+		 * \param out The output stream where it prints the object to.
+		 * \return The output stream.
+		 */
+		virtual ostream & PrintInfo(ostream & out);
+};
+
+#endif /*POISSONINPUTSPIKEDRIVER_H_*/
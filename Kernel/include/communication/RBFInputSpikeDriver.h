@@ -0,0 +1,132 @@
+/***************************************************************************
+ *                           RBFInputSpikeDriver.h                         *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RBFINPUTSPIKEDRIVER_H_
+#define RBFINPUTSPIKEDRIVER_H_
+
+/*!
+ * \file RBFInputSpikeDriver.h
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ *
+ * This file declares a class for encoding an analog input variable in input spike trains
+ * with radial basis functions.
+ */
+#include "./GeneratorInputSpikeDriver.h"
+
+/*!
+ * \class RBFInputSpikeDriver
+ *
+ * \brief Class for encoding an analog input variable with radial basis functions. 
+ *
+ * Each neuron of the generator has a gaussian receptive field. The centers are evenly spaced
+ * between the first and the last center, and the width is chosen to get the specified overlap
+ * between consecutive gaussians. The firing rate of each neuron is the maximum frequency
+ * multiplied by its gaussian at the current value of the input variable. The spike trains
+ * are regular (as in the robot control interface) or Poisson.
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ */
+class RBFInputSpikeDriver: public GeneratorInputSpikeDriver {
+	
+	private:
+
+		/*!
+		 * Center of the first gaussian.
+		 */
+		double FirstCenter;
+
+		/*!
+		 * Distance between consecutive centers.
+		 */
+		double CenterDistance;
+
+		/*!
+		 * Width of the gaussians.
+		 */
+		double Width;
+
+		/*!
+		 * Firing rate (in Hz) at the center of a gaussian.
+		 */
+		double MaxFrequency;
+
+		/*!
+		 * True if the spike trains are Poisson trains.
+		 */
+		bool Stochastic;
+
+	protected:
+
+		/*!
+		 * \brief It returns the rate integral until the next spike.
+		 * 
+		 * It returns a unit exponential random number for Poisson trains and 1 for regular trains.
+		 * 
+		 * \return The rate integral until the next spike.
+		 */
+		virtual double NextSpikeMass();
+	
+	public:
+	
+		/*!
+		 * \brief Class constructor.
+		 * 
+		 * It creates a new generator with null rates.
+		 * 
+		 * \param NewFirstNeuron First neuron of the generator.
+		 * \param NewNumberOfNeurons Number of neurons (gaussians) of the generator.
+		 * \param NewFirstCenter Center of the first gaussian.
+		 * \param LastCenter Center of the last gaussian.
+		 * \param Overlap Value of two consecutive gaussians at their middle point (0,1).
+		 * \param NewMaxFrequency Firing rate (in Hz) at the center of a gaussian.
+		 * \param NewStochastic True for Poisson spike trains. False for regular spike trains.
+		 * \param NewStep Length (in seconds) of the time windows.
+		 * \param NewStartTime Start time of the first time window.
+		 * \param Seed Seed of the random number generator.
+		 */
+		RBFInputSpikeDriver(int NewFirstNeuron, int NewNumberOfNeurons, double NewFirstCenter, double LastCenter, double Overlap, double NewMaxFrequency, bool NewStochastic=false, double NewStep=GENERATORINPUTSTEP, double NewStartTime=0.0, unsigned int Seed=1);
+		
+		/*!
+		 * \brief Class desctructor.
+		 * 
+		 * Class desctructor.
+		 */
+		virtual ~RBFInputSpikeDriver();
+
+		/*!
+		 * \brief It sets the value of the input variable.
+		 * 
+		 * It sets the firing rates of every neuron from the value of the input variable.
+		 * 
+		 * \param Value The value of the input variable.
+		 */
+		void SetInput(double Value);
+
+		/*!
+		 * \brief It prints the information of the object.
+		 *
+		 * It prints the information of the object.
+		 *
+		 * \param out The output stream where it prints the object to.
+		 * \return The output stream.
+		 */
+		virtual ostream & PrintInfo(ostream & out);
+};
+
+#endif /*RBFINPUTSPIKEDRIVER_H_*/
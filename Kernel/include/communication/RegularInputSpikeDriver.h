@@ -0,0 +1,87 @@
+/***************************************************************************
+ *                           RegularInputSpikeDriver.h                     *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef REGULARINPUTSPIKEDRIVER_H_
+#define REGULARINPUTSPIKEDRIVER_H_
+
+/*!
+ * \file RegularInputSpikeDriver.h
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ *
+ * This file declares a class for generating regular input spike trains inside the simulator.
+ */
+#include "./GeneratorInputSpikeDriver.h"
+
+/*!
+ * \class RegularInputSpikeDriver
+ *
+ * \brief Class for generating regular input spike trains. 
+ *
+ * This class generates a regular spike train in each neuron of the generator. The interval
+ * between two spikes is the inverse of the firing rate of the neuron (when the rate changes,
+ * the elapsed fraction of the current interval is kept).
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ */
+class RegularInputSpikeDriver: public GeneratorInputSpikeDriver {
+	
+	protected:
+
+		/*!
+		 * \brief It returns the rate integral until the next spike.
+		 * 
+		 * It returns 1, so the interval between spikes is the inverse of the rate.
+		 * 
+		 * \return The rate integral until the next spike.
+		 */
+		virtual double NextSpikeMass();
+	
+	public:
+	
+		/*!
+		 * \brief Class constructor.
+		 * 
+		 * It creates a new generator with null rates.
+		 * 
+		 * \param NewFirstNeuron First neuron of the generator.
+		 * \param NewNumberOfNeurons Number of neurons of the generator.
+		 * \param NewStep Length (in seconds) of the time windows.
+		 * \param NewStartTime Start time of the first time window.
+		 */
+		RegularInputSpikeDriver(int NewFirstNeuron, int NewNumberOfNeurons, double NewStep=GENERATORINPUTSTEP, double NewStartTime=0.0);
+		
+		/*!
+		 * \brief Class desctructor.
+		 * 
+		 * Class desctructor.
+		 */
+		virtual ~RegularInputSpikeDriver();
+
+		/*!
+		 * \brief It prints the information of the object.
+		 *
+		 * It prints the information of the object.
+		 *
+		 * \param out The output stream where it prints the object to.
+		 * \return The output stream.
+		 */
+		virtual ostream & PrintInfo(ostream & out);
+};
+
+#endif /*REGULARINPUTSPIKEDRIVER_H_*/
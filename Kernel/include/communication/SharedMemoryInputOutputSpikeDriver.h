@@ -0,0 +1,182 @@
+/***************************************************************************
+ *                           SharedMemoryInputOutputSpikeDriver.h          *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SHAREDMEMORYINPUTOUTPUTSPIKEDRIVER_H_
+#define SHAREDMEMORYINPUTOUTPUTSPIKEDRIVER_H_
+
+/*!
+ * \file SharedMemoryInputOutputSpikeDriver.h
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ *
+ * This file declares a class for getting input spikes and sending output spikes through a shared memory segment.
+ */
+ 
+#include <vector>
+
+#include "./InputSpikeDriver.h"
+#include "./OutputSpikeDriver.h"
+
+#include "./TCPIPConnectionType.h"
+#include "./SharedMemorySpikeChannel.h"
+
+#include "../spike/EDLUTException.h"
+
+using namespace std;
+
+/*!
+ * \class SharedMemoryInputOutputSpikeDriver
+ *
+ * \brief Class for getting input spikes and send output spikes from an only shared memory segment.
+ *
+ * This class exchanges the spikes with another process of the same host (a robot controller or
+ * another simulation) through both directions of a shared memory segment. It can be used instead of
+ * a TCPIP input-output connection when both processes run in the same host.
+ *
+ * \see SharedMemorySpikeChannel
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ */
+class SharedMemoryInputOutputSpikeDriver: public InputSpikeDriver, public OutputSpikeDriver {
+	
+	private:
+	
+		/*!
+		 * The shared memory channel.
+		 */
+		SharedMemorySpikeChannel * Channel;
+		
+		/*!
+		 * Spike buffer
+		 */
+		vector<SharedMemorySpike> OutputBuffer;
+
+		/*!
+		 * Simulation time of the next flush.
+		 */
+		double FlushTime;
+
+	public:
+	
+		/*!
+		 * \brief Class constructor.
+		 * 
+		 * It creates (server) or opens (client) the shared memory segment.
+		 * 
+		 * \param Type Client or Server. The server creates the segment.
+		 * \param Name Name of the shared memory segment.
+		 * 
+		 * \throw EDLUTException If the segment can't be created or opened.
+		 */
+		SharedMemoryInputOutputSpikeDriver(enum TCPIPConnectionType Type, string Name) throw (EDLUTException);
+		
+		/*!
+		 * \brief Class desctructor.
+		 * 
+		 * Class desctructor.
+		 */
+		~SharedMemoryInputOutputSpikeDriver();
+	
+		/*!
+		 * \brief It introduces the input activity in the simulation event queue from the shared memory.
+		 * 
+		 * This method introduces the cumulated input activity in the simulation event queue.
+		 * 
+		 * \param Queue The event queue where the input spikes are inserted.
+		 * \param Net The network associated to the input spikes.
+		 * 
+		 * \throw EDLUTException If something wrong happens in the input process.
+		 */
+		virtual void LoadInputs(EventQueue * Queue, Network * Net) throw (EDLUTException);
+
+		/*!
+		 * \brief It adds the spike to the buffer.
+		 * 
+		 * This method introduces the output spikes to the output buffer. If the object isn't buffered,
+		 * then the spike will be automatically sent.
+		 * 
+		 * \param NewSpike The spike for send.
+		 * 
+		 * \see FlushBuffers()
+		 * 
+		 * \throw EDLUTException If something wrong happens in the output process.
+		 */
+		virtual void WriteSpike(const Spike * NewSpike) throw (EDLUTException);
+		
+		/*!
+		 * \brief This function isn't implemented in SharedMemoryInputOutputSpikeDriver.
+		 * 
+		 * This function isn't implemented in SharedMemoryInputOutputSpikeDriver.
+		 * 
+		 * \param Time Time of the event (potential value).
+		 * \param Source Source neuron of the potential.
+		 * 
+		 * \throw EDLUTException If something wrong happens in the output process.
+		 */		
+		virtual void WriteState(float Time, Neuron * Source) throw (EDLUTException);
+		
+		/*!
+		 * \brief It checks if the current output driver is buffered.
+		 * 
+		 * This method checks if the current output driver has an output buffer.
+		 * 
+		 * \return True if the current driver has an output buffer. False in other case.
+		 */
+		 virtual bool IsBuffered() const;
+		 
+		/*!
+		 * \brief It checks if the current output driver can write neuron potentials.
+		 * 
+		 * This method checks if the current output driver can write neuron potentials.
+		 * 
+		 * \return True if the current driver can write neuron potentials. False in other case.
+		 */
+		 virtual bool IsWritePotentialCapable() const;
+		 
+		/*!
+		 * \brief It writes the existing spikes in the output buffer.
+		 * 
+		 * This method writes the existing spikes in the output buffer to the shared memory.
+		 * 
+		 * \throw EDLUTException If something wrong happens in the output process.
+		 */
+		 void FlushBuffers() throw (EDLUTException);
+
+		/*!
+		 * \brief It sets the simulation time of the next buffer flush.
+		 * 
+		 * This method sets the time which is sent in the header of the next batch.
+		 * 
+		 * \param Time Simulation time of the communication step.
+		 */
+		 void SetFlushTime(double Time);
+
+		/*!
+		 * \brief It prints the information of the object.
+		 *
+		 * It prints the information of the object.
+		 *
+		 * \param out The output stream where it prints the object to.
+		 * \return The output stream.
+		 */
+		virtual ostream & PrintInfo(ostream & out);
+	
+};
+
+
+#endif /*SHAREDMEMORYINPUTOUTPUTSPIKEDRIVER_H_*/
@@ -0,0 +1,107 @@
+/***************************************************************************
+ *                           SharedMemoryInputSpikeDriver.h                *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SHAREDMEMORYINPUTSPIKEDRIVER_H_
+#define SHAREDMEMORYINPUTSPIKEDRIVER_H_
+
+/*!
+ * \file SharedMemoryInputSpikeDriver.h
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ *
+ * This file declares a class for getting external input spikes from a shared memory segment.
+ */
+ 
+#include "./InputSpikeDriver.h"
+
+#include "./TCPIPConnectionType.h"
+#include "./SharedMemorySpikeChannel.h"
+
+#include "../spike/EDLUTException.h"
+
+using namespace std;
+
+/*!
+ * \class SharedMemoryInputSpikeDriver
+ *
+ * \brief Class for getting input spikes from a shared memory segment.
+ *
+ * This class gets the input spikes from another process of the same host (a robot controller or
+ * another simulation) through a shared memory segment. It can be used instead of a TCPIP connection
+ * when both processes run in the same host, so the spikes aren't copied by the operating system.
+ *
+ * \see SharedMemorySpikeChannel
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ */
+class SharedMemoryInputSpikeDriver: public InputSpikeDriver {
+	
+	private:
+	
+		/*!
+		 * The shared memory channel.
+		 */
+		SharedMemorySpikeChannel * Channel;
+
+	public:
+	
+		/*!
+		 * \brief Class constructor.
+		 * 
+		 * It creates (server) or opens (client) the shared memory segment.
+		 * 
+		 * \param Type Client or Server. The server creates the segment.
+		 * \param Name Name of the shared memory segment.
+		 * 
+		 * \throw EDLUTException If the segment can't be created or opened.
+		 */
+		SharedMemoryInputSpikeDriver(enum TCPIPConnectionType Type, string Name) throw (EDLUTException);
+		
+		/*!
+		 * \brief Class desctructor.
+		 * 
+		 * Class desctructor.
+		 */
+		~SharedMemoryInputSpikeDriver();
+	
+		/*!
+		 * \brief It introduces the input activity in the simulation event queue from the shared memory.
+		 * 
+		 * This method introduces the cumulated input activity in the simulation event queue.
+		 * 
+		 * \param Queue The event queue where the input spikes are inserted.
+		 * \param Net The network associated to the input spikes.
+		 * 
+		 * \throw EDLUTException If something wrong happens in the input process.
+		 */
+		void LoadInputs(EventQueue * Queue, Network * Net) throw (EDLUTException);
+
+		/*!
+		 * \brief It prints the information of the object.
+		 *
+		 * It prints the information of the object.
+		 *
+		 * \param out The output stream where it prints the object to.
+		 * \return The output stream.
+		 */
+		virtual ostream & PrintInfo(ostream & out);
+	
+};
+
+
+#endif /*SHAREDMEMORYINPUTSPIKEDRIVER_H_*/
@@ -0,0 +1,169 @@
+/***************************************************************************
+ *                           SharedMemoryOutputSpikeDriver.h               *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SHAREDMEMORYOUTPUTSPIKEDRIVER_H_
+#define SHAREDMEMORYOUTPUTSPIKEDRIVER_H_
+
+/*!
+ * \file SharedMemoryOutputSpikeDriver.h
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ *
+ * This file declares a class for sending output spikes through a shared memory segment.
+ */
+ 
+#include <vector>
+
+#include "./OutputSpikeDriver.h"
+
+#include "./TCPIPConnectionType.h"
+#include "./SharedMemorySpikeChannel.h"
+
+#include "../spike/EDLUTException.h"
+
+using namespace std;
+
+/*!
+ * \class SharedMemoryOutputSpikeDriver
+ *
+ * \brief Class for sending output spikes through a shared memory segment.
+ *
+ * This class sends the output spikes to another process of the same host (a robot controller or
+ * another simulation) through a shared memory segment. It can be used instead of a TCPIP connection
+ * when both processes run in the same host, so the spikes aren't copied by the operating system.
+ *
+ * \see SharedMemorySpikeChannel
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ */
+class SharedMemoryOutputSpikeDriver: public OutputSpikeDriver {
+	
+	private:
+	
+		/*!
+		 * The shared memory channel.
+		 */
+		SharedMemorySpikeChannel * Channel;
+		
+		/*!
+		 * Spike buffer
+		 */
+		vector<SharedMemorySpike> OutputBuffer;
+
+		/*!
+		 * Simulation time of the next flush.
+		 */
+		double FlushTime;
+
+	public:
+	
+		/*!
+		 * \brief Class constructor.
+		 * 
+		 * It creates (server) or opens (client) the shared memory segment.
+		 * 
+		 * \param Type Client or Server. The server creates the segment.
+		 * \param Name Name of the shared memory segment.
+		 * 
+		 * \throw EDLUTException If the segment can't be created or opened.
+		 */
+		SharedMemoryOutputSpikeDriver(enum TCPIPConnectionType Type, string Name) throw (EDLUTException);
+		
+		/*!
+		 * \brief Class desctructor.
+		 * 
+		 * Class desctructor.
+		 */
+		~SharedMemoryOutputSpikeDriver();
+	
+		/*!
+		 * \brief It adds the spike to the buffer.
+		 * 
+		 * This method introduces the output spikes to the output buffer. If the object isn't buffered,
+		 * then the spike will be automatically sent.
+		 * 
+		 * \param NewSpike The spike for send.
+		 * 
+		 * \see FlushBuffers()
+		 * 
+		 * \throw EDLUTException If something wrong happens in the output process.
+		 */
+		virtual void WriteSpike(const Spike * NewSpike) throw (EDLUTException);
+		
+		/*!
+		 * \brief This function isn't implemented in SharedMemoryOutputSpikeDriver.
+		 * 
+		 * This function isn't implemented in SharedMemoryOutputSpikeDriver.
+		 * 
+		 * \param Time Time of the event (potential value).
+		 * \param Source Source neuron of the potential.
+		 * 
+		 * \throw EDLUTException If something wrong happens in the output process.
+		 */		
+		virtual void WriteState(float Time, Neuron * Source) throw (EDLUTException);
+		
+		/*!
+		 * \brief It checks if the current output driver is buffered.
+		 * 
+		 * This method checks if the current output driver has an output buffer.
+		 * 
+		 * \return True if the current driver has an output buffer. False in other case.
+		 */
+		 virtual bool IsBuffered() const;
+		 
+		/*!
+		 * \brief It checks if the current output driver can write neuron potentials.
+		 * 
+		 * This method checks if the current output driver can write neuron potentials.
+		 * 
+		 * \return True if the current driver can write neuron potentials. False in other case.
+		 */
+		 virtual bool IsWritePotentialCapable() const;
+		 
+		/*!
+		 * \brief It writes the existing spikes in the output buffer.
+		 * 
+		 * This method writes the existing spikes in the output buffer to the shared memory.
+		 * 
+		 * \throw EDLUTException If something wrong happens in the output process.
+		 */
+		 void FlushBuffers() throw (EDLUTException);
+
+		/*!
+		 * \brief It sets the simulation time of the next buffer flush.
+		 * 
+		 * This method sets the time which is sent in the header of the next batch.
+		 * 
+		 * \param Time Simulation time of the communication step.
+		 */
+		 void SetFlushTime(double Time);
+
+		/*!
+		 * \brief It prints the information of the object.
+		 *
+		 * It prints the information of the object.
+		 *
+		 * \param out The output stream where it prints the object to.
+		 * \return The output stream.
+		 */
+		virtual ostream & PrintInfo(ostream & out);
+	
+};
+
+
+#endif /*SHAREDMEMORYOUTPUTSPIKEDRIVER_H_*/
@@ -0,0 +1,371 @@
+/***************************************************************************
+ *                           SharedMemorySpikeChannel.h                    *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SHAREDMEMORYSPIKECHANNEL_H_
+#define SHAREDMEMORYSPIKECHANNEL_H_
+
+/*!
+ * \file SharedMemorySpikeChannel.h
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ *
+ * This file declares a class which exchanges batches of spikes with another process of the
+ * same host through a shared memory segment.
+ */
+
+#ifdef _WIN32
+	#include <windows.h>
+#endif
+
+#include <string>
+
+#include "./TCPIPConnectionType.h"
+
+#include "../spike/EDLUTException.h"
+
+using namespace std;
+
+/*!
+ * Magic number of an initialized shared memory segment ("EDSM" in a little-endian machine).
+ */
+#define SHAREDMEMORYMAGIC 0x4D534445
+
+/*!
+ * Default size (in bytes) of the ring of each direction.
+ */
+#define SHAREDMEMORYRINGSIZE (1<<20)
+
+/*!
+ * Time (in milliseconds) which a client waits for the server to create the segment.
+ */
+#define SHAREDMEMORYCONNECTIONTIMEOUT 10000
+
+/*!
+ * Number of checks of the ring before the waiting process sleeps.
+ */
+#define SHAREDMEMORYSPINS 200
+
+/*!
+ * Size of the cache line (to avoid false sharing between the indexes of the ring).
+ */
+#define SHAREDMEMORYCACHELINE 64
+
+/*!
+ * Spike exchanged through shared memory.
+ */
+struct SharedMemorySpike {
+	/*!
+	 * Number of neuron.
+	 */
+	int Neuron;
+
+	/*!
+	 * Time of the spike.
+	 */
+	float Time;
+
+	SharedMemorySpike(){};
+
+	SharedMemorySpike(int NewNeuron, float NewTime):Neuron(NewNeuron), Time(NewTime){};
+};
+
+/*!
+ * Header of a batch of spikes.
+ */
+struct SharedMemoryBatchHeader {
+	/*!
+	 * Number of spikes.
+	 */
+	unsigned int Spikes;
+
+	/*!
+	 * Reserved (0).
+	 */
+	unsigned int Reserved;
+
+	/*!
+	 * Simulation time of the communication step.
+	 */
+	double Time;
+};
+
+/*!
+ * Control block of a single-producer single-consumer ring (one direction of the channel).
+ * The indexes are free-running byte counters.
+ */
+struct SharedMemoryRing {
+	/*!
+	 * Bytes written by the producer (it is also the futex word of the consumer).
+	 */
+	volatile unsigned int Head;
+
+	/*!
+	 * True if the producer is sleeping (waiting for room).
+	 */
+	volatile unsigned int ProducerWaiting;
+
+	/*!
+	 * True if the producer has closed the ring.
+	 */
+	volatile unsigned int Closed;
+
+	char PaddingHead[SHAREDMEMORYCACHELINE-3*sizeof(unsigned int)];
+
+	/*!
+	 * Bytes read by the consumer (it is also the futex word of the producer).
+	 */
+	volatile unsigned int Tail;
+
+	/*!
+	 * True if the consumer is sleeping (waiting for data).
+	 */
+	volatile unsigned int ConsumerWaiting;
+
+	char PaddingTail[SHAREDMEMORYCACHELINE-2*sizeof(unsigned int)];
+};
+
+/*!
+ * Header of the shared memory segment. The data of both rings follow it.
+ */
+struct SharedMemorySegment {
+	/*!
+	 * Magic number (SHAREDMEMORYMAGIC) written when the segment is initialized.
+	 */
+	volatile unsigned int Magic;
+
+	/*!
+	 * Size (in bytes) of the ring of each direction.
+	 */
+	unsigned int RingSize;
+
+	char Padding[SHAREDMEMORYCACHELINE-2*sizeof(unsigned int)];
+
+	/*!
+	 * Rings (0: from the server to the client, 1: from the client to the server).
+	 */
+	SharedMemoryRing Rings[2];
+};
+
+/*!
+ * \class SharedMemorySpikeChannel
+ *
+ * \brief Class for exchanging batches of spikes through a shared memory segment.
+ *
+ * The segment has a single-producer single-consumer ring in each direction. A batch is a
+ * SharedMemoryBatchHeader followed by the spikes, and it is streamed through the ring, so
+ * batches bigger than the ring are also allowed. A process which finds the ring full (or empty)
+ * checks it SHAREDMEMORYSPINS times and then sleeps on the index of the other process (a futex
+ * in Linux, the other systems yield the processor). The processes only make system calls when
+ * the other one is sleeping.
+ *
+ * The server creates the segment (it replaces any former segment with the same name) and removes
+ * its name when it is destroyed. The client waits SHAREDMEMORYCONNECTIONTIMEOUT milliseconds for
+ * the segment. When one of them is destroyed, the other one receives no more spikes (as a closed
+ * TCP/IP connection).
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ */
+class SharedMemorySpikeChannel {
+
+	private:
+
+		/*!
+		 * Name of the segment.
+		 */
+		string Name;
+
+		/*!
+		 * Client or Server.
+		 */
+		enum TCPIPConnectionType Type;
+
+		/*!
+		 * The mapped segment.
+		 */
+		SharedMemorySegment * Segment;
+
+		/*!
+		 * Size (in bytes) of the mapped segment.
+		 */
+		unsigned long SegmentSize;
+
+#ifdef _WIN32
+		/*!
+		 * Handle of the file mapping.
+		 */
+		HANDLE Mapping;
+#endif
+
+		/*!
+		 * Ring where this process writes.
+		 */
+		SharedMemoryRing * OutputRing;
+
+		/*!
+		 * Data of the ring where this process writes.
+		 */
+		char * OutputData;
+
+		/*!
+		 * Ring where this process reads.
+		 */
+		SharedMemoryRing * InputRing;
+
+		/*!
+		 * Data of the ring where this process reads.
+		 */
+		char * InputData;
+
+		/*!
+		 * Size (in bytes) of each ring (a power of 2).
+		 */
+		unsigned int RingSize;
+
+		/*!
+		 * Received spikes.
+		 */
+		SharedMemorySpike * Spikes;
+
+		/*!
+		 * Allocated received spikes.
+		 */
+		unsigned int AllocatedSpikes;
+
+		/*!
+		 * True if the other process has closed the channel.
+		 */
+		bool Closed;
+
+		/*!
+		 * \brief It creates and maps the segment.
+		 *
+		 * It creates and maps the segment (server side).
+		 *
+		 * \param NewRingSize Size of each ring.
+		 *
+		 * \throw EDLUTException If the segment can't be created.
+		 */
+		void CreateSegment(unsigned int NewRingSize) throw (EDLUTException);
+
+		/*!
+		 * \brief It opens and maps the segment.
+		 *
+		 * It opens and maps the segment created by the server (client side).
+		 *
+		 * \throw EDLUTException If the segment doesn't exist after the timeout.
+		 */
+		void OpenSegment() throw (EDLUTException);
+
+		/*!
+		 * \brief It writes data in the output ring.
+		 *
+		 * It writes data in the output ring. It waits for room if the ring is full.
+		 *
+		 * \param Buffer The data.
+		 * \param Size Number of bytes.
+		 */
+		void Write(const void * Buffer, unsigned int Size);
+
+		/*!
+		 * \brief It reads data from the input ring.
+		 *
+		 * It reads data from the input ring. It waits for data if the ring is empty.
+		 *
+		 * \param Buffer The data (output).
+		 * \param Size Number of bytes.
+		 *
+		 * \return False if the ring has been closed before reading all the data.
+		 */
+		bool Read(void * Buffer, unsigned int Size);
+
+	public:
+
+		/*!
+		 * \brief Class constructor.
+		 *
+		 * It creates (server) or opens (client) the shared memory segment.
+		 *
+		 * \param NewName Name of the segment.
+		 * \param NewType Client or Server.
+		 * \param NewRingSize Size (in bytes) of each ring (only used by the server).
+		 *
+		 * \throw EDLUTException If the segment can't be created or opened.
+		 */
+		SharedMemorySpikeChannel(string NewName, enum TCPIPConnectionType NewType, unsigned int NewRingSize=SHAREDMEMORYRINGSIZE) throw (EDLUTException);
+
+		/*!
+		 * \brief Class destructor.
+		 *
+		 * It closes the output ring and unmaps the segment.
+		 */
+		~SharedMemorySpikeChannel();
+
+		/*!
+		 * \brief It sends a batch of spikes.
+		 *
+		 * It sends a batch of spikes.
+		 *
+		 * \param Time Simulation time of the communication step.
+		 * \param NewSpikes The spikes.
+		 * \param Number Number of spikes.
+		 */
+		void SendSpikes(double Time, const SharedMemorySpike * NewSpikes, unsigned int Number);
+
+		/*!
+		 * \brief It receives a batch of spikes.
+		 *
+		 * It receives a batch of spikes. The spikes are valid until the next batch is received.
+		 * If the other process has closed the channel, no spikes are received.
+		 *
+		 * \param Time Simulation time of the communication step (output).
+		 *
+		 * \return Number of received spikes.
+		 *
+		 * \see GetSpikes()
+		 */
+		unsigned int ReceiveSpikes(double & Time);
+
+		/*!
+		 * \brief It returns the received spikes.
+		 *
+		 * It returns the spikes of the last received batch.
+		 *
+		 * \return The received spikes.
+		 */
+		const SharedMemorySpike * GetSpikes() const;
+
+		/*!
+		 * \brief It checks if the other process has closed the channel.
+		 *
+		 * It checks if the other process has closed the channel.
+		 *
+		 * \return True if the channel has been closed.
+		 */
+		bool IsClosed() const;
+
+		/*!
+		 * \brief It returns the name of the segment.
+		 *
+		 * It returns the name of the segment.
+		 *
+		 * \return The name of the segment.
+		 */
+		string GetName() const;
+};
+
+#endif /*SHAREDMEMORYSPIKECHANNEL_H_*/
@@ -0,0 +1,198 @@
+/***************************************************************************
+ *                           StreamFileInputSpikeDriver.h                  *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef STREAMFILEINPUTSPIKEDRIVER_H_
+#define STREAMFILEINPUTSPIKEDRIVER_H_
+
+/*!
+ * \file StreamFileInputSpikeDriver.h
+ *
+ * \author Jesus Garrido
+ * \date July 2013
+ *
+ * This file declares a class for getting external input spikes from a time-sorted file
+ * incrementally.
+ */
+#include <cstdio>
+#include <string>
+
+#include "./InputSpikeDriver.h"
+
+#include "../spike/EDLUTFileException.h"
+ 
+class EventQueue;
+class Network;
+
+/*!
+ * Default length (in seconds) of the time windows loaded from the file.
+ */
+#define STREAMINPUTWINDOW 0.01
+
+/*!
+ * \class StreamFileInputSpikeDriver
+ *
+ * \brief Class for getting input spikes from a time-sorted file incrementally. 
+ *
+ * This class reads the same file format as FileInputSpikeDriver, but the lines must be sorted
+ * by their first spike time. Instead of inserting every input spike in the event queue at the
+ * beginning of the simulation, it only inserts the lines which start in the next time window,
+ * and a StreamInputEvent at the end of the window which loads the following one. The event queue
+ * only holds the input spikes of the current window (and the pending spikes of the lines which
+ * have started), and the lines after the end of the simulation are never read.
+ *
+ * \author Jesus Garrido
+ * \date July 2013
+ */
+class StreamFileInputSpikeDriver: public InputSpikeDriver {
+	
+	private:
+	
+		/*!
+		 * The file handler.
+		 */
+		FILE * Handler;
+		
+		/*!
+		 * The file name.
+		 */
+		string FileName;
+		
+		/*!
+		 * The current line in the file.
+		 */
+		long Currentline; 
+
+		/*!
+		 * Length of the time windows.
+		 */
+		double Window;
+
+		/*!
+		 * Number of input spikes specified in the file header (-1 before reading it).
+		 */
+		int NumberOfInputs;
+
+		/*!
+		 * Number of input spikes read from the file.
+		 */
+		int ReadInputs;
+
+		/*!
+		 * True if the next line has been read but it has not been inserted yet.
+		 */
+		bool PendingLine;
+
+		/*!
+		 * First spike time of the pending line.
+		 */
+		float LineTime;
+
+		/*!
+		 * Number of spikes of each neuron in the pending line.
+		 */
+		int LineSpikes;
+
+		/*!
+		 * Interval between the spikes of the pending line.
+		 */
+		float LineInterval;
+
+		/*!
+		 * First neuron of the pending line.
+		 */
+		int LineNeuron;
+
+		/*!
+		 * Number of consecutive neurons of the pending line.
+		 */
+		int LineRepetitions;
+
+		/*!
+		 * \brief It reads the next line of the file.
+		 * 
+		 * It reads the next line of the file as the pending line.
+		 * 
+		 * \param Net The network associated to the input spikes.
+		 * 
+		 * \return True if a line has been read. False if all the input spikes have been read.
+		 * 
+		 * \throw EDLUTFileException If the line is wrong.
+		 */
+		bool ReadLine(Network * Net) throw (EDLUTFileException);
+	
+	public:
+	
+		/*!
+		 * \brief Class constructor.
+		 * 
+		 * It creates a new object from the file source.
+		 * 
+		 * \param NewFileName Name of the source input file.
+		 * \param NewWindow Length (in seconds) of the time windows.
+		 * 
+		 * \throw EDLUTException If something wrong happens when the file is been read.
+		 */
+		StreamFileInputSpikeDriver(const char * NewFileName, double NewWindow=STREAMINPUTWINDOW) throw (EDLUTException);
+		
+		/*!
+		 * \brief Class desctructor.
+		 * 
+		 * Class desctructor.
+		 */
+		~StreamFileInputSpikeDriver();
+	
+		/*!
+		 * \brief It introduces the input activity in the simulation event queue from the file.
+		 * 
+		 * This method loads the first time window. The following windows are loaded by the
+		 * StreamInputEvent objects.
+		 * 
+		 * \param Queue The event queue where the input spikes are inserted.
+		 * \param Net The network associated to the input spikes.
+		 * 
+		 * \throw EDLUTException If something wrong happens in the input process.
+		 */
+		void LoadInputs(EventQueue * Queue, Network * Net) throw (EDLUTFileException);
+
+		/*!
+		 * \brief It introduces the input spikes of the next time window in the event queue.
+		 * 
+		 * This method inserts the lines which start before the end of the next time window
+		 * (CurrentTime, or the first pending spike if it is later, plus the window length) and a
+		 * StreamInputEvent at the end of the window.
+		 * 
+		 * \param Queue The event queue where the input spikes are inserted.
+		 * \param Net The network associated to the input spikes.
+		 * \param CurrentTime Current simulation time.
+		 * 
+		 * \throw EDLUTFileException If something wrong happens in the input process (or the
+		 * lines are not sorted by time).
+		 */
+		void LoadWindow(EventQueue * Queue, Network * Net, double CurrentTime) throw (EDLUTFileException);
+
+		/*!
+		 * \brief It prints the information of the object.
+		 *
+		 * It prints the information of the object.
+		 *
+		 * \param out The output stream where it prints the object to.
+		 * \return The output stream.
+		 */
+		virtual ostream & PrintInfo(ostream & out);
+	
+};
+
+#endif /*STREAMFILEINPUTSPIKEDRIVER_H_*/
@@ -33,6 +33,7 @@
 #include "./OutputSpikeDriver.h"
 
 #include "./TCPIPConnectionType.h"
+#include "./TCPIPSpikeProtocol.h"
 
 
 #include "../spike/EDLUTFileException.h"
@@ -40,6 +41,7 @@
 using namespace std;
 
 class CdSocket;
+class TCPIPSpikeProtocol;
 
 /*!
  * \class TCPIPInputOutputSpikeDriver
@@ -57,34 +59,26 @@ class TCPIPInputOutputSpikeDriver: public InputSpikeDriver, public OutputSpikeDr
 	
 	private:
 	
-		/*!
-		 * Output spike struct.
-		 */
-		struct OutputSpike {
-			/*!
-			 * Number of neuron.
-			 */
-			long int Neuron;
-			
-			/*!
-			 * Time of the spike.
-			 */
-			float Time;	
-			
-			OutputSpike(){};
-			
-			OutputSpike(int NewNeuron, float NewTime):Neuron(NewNeuron), Time(NewTime){};
-		};
 	
 		/*!
 		 * The TCP IP device.
 		 */
 		CdSocket * Socket;
+
+		/*!
+		 * The spike protocol of the connection.
+		 */
+		TCPIPSpikeProtocol * Protocol;
 		
 		/*!
 		 * Spike buffer
 		 */
-		vector<OutputSpike> OutputBuffer;
+		vector<TCPIPSpike> OutputBuffer;
+
+		/*!
+		 * Simulation time of the next flush.
+		 */
+		double FlushTime;
 	
 	public:
 	
@@ -96,9 +90,12 @@ class TCPIPInputOutputSpikeDriver: public InputSpikeDriver, public OutputSpikeDr
 		 * \param Type Client or Server
 		 * \param server_address address of the server host. If Type==Server, server_address is not used.
 		 * \param tcp_port tcp_port to connect
+		 * \param Version Requested version of the protocol (2 negotiates the version 2 protocol)
+		 * \param Delta True to request delta-encoded payloads (version 2 protocol)
 		 * 
+		 * \throw EDLUTException If the negotiation of the protocol fails.
 		 */
-		TCPIPInputOutputSpikeDriver(enum TCPIPConnectionType Type, string server_address,unsigned short tcp_port);
+		TCPIPInputOutputSpikeDriver(enum TCPIPConnectionType Type, string server_address,unsigned short tcp_port, unsigned int Version=1, bool Delta=false) throw (EDLUTException);
 		
 		/*!
 		 * \brief Class desctructor.
@@ -117,7 +114,7 @@ class TCPIPInputOutputSpikeDriver: public InputSpikeDriver, public OutputSpikeDr
 		 * 
 		 * \throw EDLUTException If something wrong happens in the input process.
 		 */
-		virtual void LoadInputs(EventQueue * Queue, Network * Net) throw (EDLUTFileException);
+		virtual void LoadInputs(EventQueue * Queue, Network * Net) throw (EDLUTException);
 		
 		/*!
 		 * \brief It adds the spike to the buffer.
@@ -172,6 +169,15 @@ class TCPIPInputOutputSpikeDriver: public InputSpikeDriver, public OutputSpikeDr
 		 */
 		 void FlushBuffers() throw (EDLUTException);
 
+		/*!
+		 * \brief It sets the simulation time of the next buffer flush.
+		 * 
+		 * This method sets the time which is sent in the header of the next batch (version 2 protocol).
+		 * 
+		 * \param Time Simulation time of the communication step.
+		 */
+		 void SetFlushTime(double Time);
+
 		/*!
 		 * \brief It prints the information of the object.
 		 *
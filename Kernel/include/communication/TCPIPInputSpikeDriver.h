@@ -34,6 +34,7 @@
 #include "../spike/EDLUTFileException.h"
 
 class CdSocket;
+class TCPIPSpikeProtocol;
 
 /*!
  * \class TCPIPInputSpikeDriver
@@ -51,29 +52,16 @@ class TCPIPInputSpikeDriver: public InputSpikeDriver {
 	
 	private:
 	
-		/*!
-		 * Output spike struct.
-		 */
-		struct OutputSpike {
-			/*!
-			 * Number of neuron.
-			 */
-			long int Neuron;
-			
-			/*!
-			 * Time of the spike.
-			 */
-			float Time;	
-			
-			OutputSpike(){};
-			
-			OutputSpike(int NewNeuron, float NewTime):Neuron(NewNeuron), Time(NewTime){};
-		};
 	
 		/*!
 		 * The TCP IP device.
 		 */
 		CdSocket * Socket;
+
+		/*!
+		 * The spike protocol of the connection.
+		 */
+		TCPIPSpikeProtocol * Protocol;
 	
 	public:
 	
@@ -85,9 +73,12 @@ class TCPIPInputSpikeDriver: public InputSpikeDriver {
 		 * \param Type Client or Server
 		 * \param server_address address of the server host. If Type==Server, server_address is not used.
 		 * \param tcp_port tcp_port to connect
+		 * \param Version Requested version of the protocol (2 negotiates the version 2 protocol)
+		 * \param Delta True to request delta-encoded payloads (version 2 protocol)
 		 * 
+		 * \throw EDLUTException If the negotiation of the protocol fails.
 		 */
-		TCPIPInputSpikeDriver(enum TCPIPConnectionType Type, string server_address,unsigned short tcp_port);
+		TCPIPInputSpikeDriver(enum TCPIPConnectionType Type, string server_address,unsigned short tcp_port, unsigned int Version=1, bool Delta=false) throw (EDLUTException);
 		
 		/*!
 		 * \brief Class desctructor.
@@ -106,7 +97,7 @@ class TCPIPInputSpikeDriver: public InputSpikeDriver {
 		 * 
 		 * \throw EDLUTException If something wrong happens in the input process.
 		 */
-		void LoadInputs(EventQueue * Queue, Network * Net) throw (EDLUTFileException);
+		void LoadInputs(EventQueue * Queue, Network * Net) throw (EDLUTException);
 
 		/*!
 		 * \brief It prints the information of the object.
@@ -0,0 +1,333 @@
+/***************************************************************************
+ *                           TCPIPSpikeProtocol.h                          *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef TCPIPSPIKEPROTOCOL_H_
+#define TCPIPSPIKEPROTOCOL_H_
+
+/*!
+ * \file TCPIPSpikeProtocol.h
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ *
+ * This file declares a class which sends and receives batches of spikes through a TCP/IP
+ * connection with the version 1 or 2 protocol.
+ */
+
+#include "./TCPIPConnectionType.h"
+
+#include "../spike/EDLUTException.h"
+
+class CdSocket;
+
+/*!
+ * Magic number of the hello message of the version 2 protocol ("EDL2" in a little-endian machine).
+ */
+#define TCPIPPROTOCOLMAGIC 0x324C4445
+
+/*!
+ * Latest version of the protocol.
+ */
+#define TCPIPPROTOCOLVERSION 2
+
+/*!
+ * Flag of the hello message to request delta-encoded payloads.
+ */
+#define TCPIPDELTAENCODING 0x1
+
+/*!
+ * Time (in milliseconds) which a server waits for the hello message of the client.
+ */
+#define TCPIPNEGOTIATIONTIMEOUT 1000
+
+/*!
+ * Maximum number of spikes of a batch in the version 1 protocol.
+ */
+#define TCPIPVERSION1MAXSPIKES 65535
+
+/*!
+ * Spike in the version 2 protocol.
+ */
+struct TCPIPSpike {
+	/*!
+	 * Number of neuron.
+	 */
+	int Neuron;
+
+	/*!
+	 * Time of the spike.
+	 */
+	float Time;
+
+	TCPIPSpike(){};
+
+	TCPIPSpike(int NewNeuron, float NewTime):Neuron(NewNeuron), Time(NewTime){};
+};
+
+/*!
+ * Spike in the version 1 protocol (its size depends on the architecture).
+ */
+struct TCPIPLegacySpike {
+	/*!
+	 * Number of neuron.
+	 */
+	long int Neuron;
+
+	/*!
+	 * Time of the spike.
+	 */
+	float Time;
+};
+
+/*!
+ * Hello message of the version 2 protocol.
+ */
+struct TCPIPHello {
+	/*!
+	 * Magic number (TCPIPPROTOCOLMAGIC).
+	 */
+	unsigned int Magic;
+
+	/*!
+	 * Protocol version (the requested one from the client, the agreed one from the server).
+	 */
+	unsigned int Version;
+
+	/*!
+	 * Protocol flags (TCPIPDELTAENCODING).
+	 */
+	unsigned int Flags;
+
+	/*!
+	 * Reserved (0).
+	 */
+	unsigned int Reserved;
+};
+
+/*!
+ * Header of a batch of spikes in the version 2 protocol.
+ */
+struct TCPIPFrameHeader {
+	/*!
+	 * Number of spikes.
+	 */
+	unsigned int Spikes;
+
+	/*!
+	 * Size of the payload in bytes.
+	 */
+	unsigned int Bytes;
+
+	/*!
+	 * Simulation time of the communication step.
+	 */
+	double Time;
+};
+
+/*!
+ * \class TCPIPSpikeProtocol
+ *
+ * \brief Class for sending and receiving batches of spikes through a TCP/IP connection.
+ *
+ * The version 1 protocol sends a 16-bit number of spikes followed by the spikes as
+ * TCPIPLegacySpike structs. The version 2 protocol sends a TCPIPFrameHeader (with a 32-bit
+ * number of spikes and the time of the communication step) and the payload with a single
+ * gather write. The payload is an array of TCPIPSpike structs, or the delta-encoded spikes:
+ * the zigzag varint of the difference with the previous neuron and the zigzag varint of the
+ * difference between the bits of the float times (the first one relative to the header time).
+ * The encoding is lossless, and the sorted spikes of a step take 2-4 bytes instead of 8.
+ *
+ * The version 2 protocol is negotiated when the connection is created: the client sends a
+ * TCPIPHello and the server answers with the agreed version and flags. A server which doesn't
+ * receive a hello message in TCPIPNEGOTIATIONTIMEOUT milliseconds (or receives other data) falls
+ * back to the version 1 protocol, so the former clients keep working. The data is sent in the
+ * byte order of the machine, as in the version 1 protocol.
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ */
+class TCPIPSpikeProtocol {
+
+	private:
+
+		/*!
+		 * The TCP IP device.
+		 */
+		CdSocket * Socket;
+
+		/*!
+		 * Agreed version of the protocol.
+		 */
+		unsigned int Version;
+
+		/*!
+		 * True if the payloads are delta-encoded.
+		 */
+		bool DeltaEncoding;
+
+		/*!
+		 * Received spikes.
+		 */
+		TCPIPSpike * Spikes;
+
+		/*!
+		 * Allocated received spikes.
+		 */
+		unsigned int AllocatedSpikes;
+
+		/*!
+		 * Encoded payload (or version 1 spikes).
+		 */
+		unsigned char * Payload;
+
+		/*!
+		 * Allocated bytes of the payload.
+		 */
+		unsigned int AllocatedPayload;
+
+		/*!
+		 * True if the other end has closed the connection.
+		 */
+		bool Closed;
+
+		/*!
+		 * \brief It reserves the received spikes.
+		 *
+		 * It reserves at least this number of received spikes.
+		 *
+		 * \param Number Number of spikes.
+		 */
+		void ReserveSpikes(unsigned int Number);
+
+		/*!
+		 * \brief It reserves the payload.
+		 *
+		 * It reserves at least this number of bytes of payload.
+		 *
+		 * \param Bytes Number of bytes.
+		 */
+		void ReservePayload(unsigned int Bytes);
+
+		/*!
+		 * \brief It negotiates the protocol version as the server of the connection.
+		 *
+		 * It negotiates the protocol version as the server of the connection.
+		 *
+		 * \param RequestedFlags Flags supported by the server.
+		 */
+		void NegotiateServer(unsigned int RequestedFlags);
+
+		/*!
+		 * \brief It negotiates the protocol version as the client of the connection.
+		 *
+		 * It negotiates the protocol version as the client of the connection.
+		 *
+		 * \param RequestedFlags Flags requested by the client.
+		 *
+		 * \throw EDLUTException If the server doesn't answer with a hello message.
+		 */
+		void NegotiateClient(unsigned int RequestedFlags) throw (EDLUTException);
+
+	public:
+
+		/*!
+		 * \brief Class constructor.
+		 *
+		 * It creates a new object and negotiates the protocol version.
+		 *
+		 * \param NewSocket The connected socket.
+		 * \param Type Client or Server.
+		 * \param RequestedVersion Requested version of the protocol (1 doesn't negotiate).
+		 * \param RequestedDelta True to request delta-encoded payloads.
+		 *
+		 * \throw EDLUTException If the negotiation fails.
+		 */
+		TCPIPSpikeProtocol(CdSocket * NewSocket, enum TCPIPConnectionType Type, unsigned int RequestedVersion, bool RequestedDelta) throw (EDLUTException);
+
+		/*!
+		 * \brief Class destructor.
+		 *
+		 * Class destructor.
+		 */
+		~TCPIPSpikeProtocol();
+
+		/*!
+		 * \brief It sends a batch of spikes.
+		 *
+		 * It sends a batch of spikes. The version 2 raw payload is sent directly from the array.
+		 *
+		 * \param Time Simulation time of the communication step.
+		 * \param NewSpikes The spikes.
+		 * \param Number Number of spikes.
+		 *
+		 * \throw EDLUTException If the spikes can't be sent.
+		 */
+		void SendSpikes(double Time, const TCPIPSpike * NewSpikes, unsigned int Number) throw (EDLUTException);
+
+		/*!
+		 * \brief It receives a batch of spikes.
+		 *
+		 * It receives a batch of spikes. The spikes are valid until the next batch is received.
+		 * If the other end has closed the connection between two batches, no spikes are received.
+		 *
+		 * \param Time Simulation time of the communication step (output, -1 in the version 1 protocol).
+		 *
+		 * \return Number of received spikes.
+		 *
+		 * \see GetSpikes()
+		 *
+		 * \throw EDLUTException If the spikes can't be received.
+		 */
+		unsigned int ReceiveSpikes(double & Time) throw (EDLUTException);
+
+		/*!
+		 * \brief It returns the received spikes.
+		 *
+		 * It returns the spikes of the last received batch.
+		 *
+		 * \return The received spikes.
+		 */
+		const TCPIPSpike * GetSpikes() const;
+
+		/*!
+		 * \brief It returns the agreed protocol version.
+		 *
+		 * It returns the agreed protocol version.
+		 *
+		 * \return The agreed protocol version.
+		 */
+		unsigned int GetVersion() const;
+
+		/*!
+		 * \brief It checks if the payloads are delta-encoded.
+		 *
+		 * It checks if the payloads are delta-encoded.
+		 *
+		 * \return True if the payloads are delta-encoded.
+		 */
+		bool IsDeltaEncoding() const;
+
+		/*!
+		 * \brief It checks if the other end has closed the connection.
+		 *
+		 * It checks if the other end has closed the connection.
+		 *
+		 * \return True if the connection has been closed.
+		 */
+		bool IsClosed() const;
+};
+
+#endif /*TCPIPSPIKEPROTOCOL_H_*/
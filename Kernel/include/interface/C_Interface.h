@@ -108,6 +108,36 @@ simulation for one subnetwork.
 
 extern "C" void LSAM_des_injectSpike(Simulation *Simul, double time, int neuron_index);
 
+/** Inject a set of spikes in simulation network.
+This procedure injects several spikes in the network with a single call. The spikes
+are appended to the external input spikes of the event queue (they are sorted
+once if they are not given in time order), so no event is allocated per spike.
+\param Simul is the simulation object that holds the state of
+simulation for one subnetwork.
+\param number is the number of spikes to be injected.
+\param times is the array with the time of each spike.
+\param neuron_indexes is the array with the index of the neuron of each spike.
+\returns zero if the spikes have been injected, non-zero if some neuron index
+does not exist (no spike is injected in that case). */
+
+extern "C" int LSAM_des_injectSpikes(Simulation *Simul, int number, const double *times, const int *neuron_indexes);
+
+/** Inject the spikes of a bitmask in simulation network.
+This procedure injects a spike at the same time in each neuron of a range whose
+bit is set in a mask. It is intended to encode the input of one time slot with a
+single call.
+\param Simul is the simulation object that holds the state of
+simulation for one subnetwork.
+\param time is the time of the spikes.
+\param first_neuron is the index of the neuron which corresponds to the first bit.
+\param number is the number of neurons (bits) of the mask.
+\param mask is the bitmask (bit i of the mask is bit i%8 of byte i/8, and it
+corresponds to neuron first_neuron+i).
+\returns zero if the spikes have been injected, non-zero if the range of neurons
+does not exist (no spike is injected in that case). */
+
+extern "C" int LSAM_des_injectSpikeMask(Simulation *Simul, double time, int first_neuron, int number, const unsigned char *mask);
+
 /** Run simulator until a specified time.
 Runs a simulation until simulation time reaches a specified limit.
 \param Simul is the simulation object that holding the state of simulation
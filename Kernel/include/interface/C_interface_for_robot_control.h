@@ -38,8 +38,12 @@
 #ifdef __cplusplus
 //#include "../include/simulation/Simulation.h"
 class Simulation;
+class GeneratorInputSpikeDriver;
+class RBFInputSpikeDriver;
 #else // incomplete typedef for Simulation
 typedef struct Simulation_tag Simulation;
+typedef struct GeneratorInputSpikeDriver_tag GeneratorInputSpikeDriver;
+typedef struct RBFInputSpikeDriver_tag RBFInputSpikeDriver;
 #endif
 
 /// \brief Duration of a inner control loop iteration (time slot)
@@ -54,6 +58,10 @@ typedef struct Simulation_tag Simulation;
 /// (should be smaller than SIM_SLOT_LENGTH)
 #define TIME_DRIVEN_STEP_TIME 0.001
 
+/// \brief Delay of the time windows of the input generators with respect to the time slots
+/// (the rates set before a slot are used from the beginning of the slot plus this delay)
+#define INPUT_GENERATOR_DELAY SIM_SLOT_LENGTH*0.001
+
 /// \brief Maximum delay time that a delay line can have in seconds
 /// (The particular delay of each line is specified when calling init_delay())
 #define MAX_DELAY_TIME 0.1
@@ -138,7 +146,8 @@ struct rbf_set
 EXTERN_C Simulation *create_neural_simulation(const char *net_file, const char *input_weight_file, const char *input_spike_file, const char *output_weight_file, const char *output_spike_file, double weight_save_period, int real_time_simulation);
 
 /// \brief Finishes and deletes a neural network simulation.
-/// Neural simulation output data is stored in the previously-specified files
+/// Neural simulation output data is stored in the previously-specified files.
+/// The input generators of the simulation are also deleted
 /// \param neural_sim Pointer to a Simulation created by create_neural_simulation()
 EXTERN_C void finish_neural_simulation(Simulation *neural_sim);
 
@@ -294,6 +303,79 @@ EXTERN_C void generate_input_traj_activity(Simulation *neural_sim, double cur_sl
 /// \param max_traj_amplitude Pointer to an array in which the maximum values for the position and velocity will be stored.
 EXTERN_C void generate_robot_state_activity(Simulation *neural_sim, double cur_slot_time, double *robot_state_vars, double *min_traj_amplitude, double *max_traj_amplitude);
 
+///////////////////////////// INPUT GENERATORS //////////////////////////
+
+/// \brief Creates an input generator of Poisson spike trains.
+/// The spikes are generated inside the simulator in each time slot from the firing rate of each neuron,
+/// which is set with set_input_generator_rates(). The initial rates are 0.
+/// \param neural_sim Pointer to a Simulation created by create_neural_simulation().
+/// \param cur_slot_time The simulation time of the beginning of the slot that will be simulated next.
+/// \param first_neuron Number (index) of the first network neuron of the generator.
+/// \param num_neurons Number of consecutive neurons of the generator.
+/// \param seed Seed of the random number generator.
+/// \return A pointer to the created generator (NULL if the neurons are not defined in the network).
+/// \note The generator is deleted by finish_neural_simulation()
+EXTERN_C GeneratorInputSpikeDriver *create_poisson_input_generator(Simulation *neural_sim, double cur_slot_time, long first_neuron, long num_neurons, unsigned int seed);
+
+/// \brief Creates an input generator of regular spike trains.
+/// The spikes are generated inside the simulator in each time slot from the firing rate of each neuron,
+/// which is set with set_input_generator_rates(). The initial rates are 0.
+/// \param neural_sim Pointer to a Simulation created by create_neural_simulation().
+/// \param cur_slot_time The simulation time of the beginning of the slot that will be simulated next.
+/// \param first_neuron Number (index) of the first network neuron of the generator.
+/// \param num_neurons Number of consecutive neurons of the generator.
+/// \return A pointer to the created generator (NULL if the neurons are not defined in the network).
+/// \note The generator is deleted by finish_neural_simulation()
+EXTERN_C GeneratorInputSpikeDriver *create_regular_input_generator(Simulation *neural_sim, double cur_slot_time, long first_neuron, long num_neurons);
+
+/// \brief Creates an input generator which encodes an input variable with RBFs.
+/// This generator produces the same activity as generate_activityRBF() inside the simulator.
+/// The encoded value is set with set_rbf_input_generator_value().
+/// \param neural_sim Pointer to a Simulation created by create_neural_simulation().
+/// \param cur_slot_time The simulation time of the beginning of the slot that will be simulated next.
+/// \param rbfs Pointer to the RBF definitions that will be used for the encoding into neural activity.
+/// \param first_input_neuron Number (index) of the first mossy fiber which encode this input variable.
+/// \param max_spk_freq Maximum firing frequency for a mossy fiber.
+/// \param stochastic Indicates if the spike trains are Poisson trains (1) or regular trains (0).
+/// \param seed Seed of the random number generator (only used by Poisson trains).
+/// \return A pointer to the created generator (NULL if the neurons are not defined in the network).
+/// \note The generator is deleted by finish_neural_simulation()
+EXTERN_C RBFInputSpikeDriver *create_rbf_input_generator(Simulation *neural_sim, double cur_slot_time, struct rbf_set *rbfs, long first_input_neuron, double max_spk_freq, int stochastic, unsigned int seed);
+
+/// \brief Sets the firing rates of the neurons of an input generator.
+/// The rates are used from the next time slot.
+/// \param generator Pointer to a generator created by create_poisson_input_generator() or create_regular_input_generator().
+/// \param rates Pointer to an array which contains the firing rate (in Hz) of each neuron of the generator.
+EXTERN_C void set_input_generator_rates(GeneratorInputSpikeDriver *generator, double *rates);
+
+/// \brief Sets the value of the input variable encoded by an RBF input generator.
+/// The value is encoded from the next time slot.
+/// \param generator Pointer to a generator created by create_rbf_input_generator().
+/// \param input_var Input variable to be encoded.
+EXTERN_C void set_rbf_input_generator_value(RBFInputSpikeDriver *generator, double input_var);
+
+/// \brief Injects a set of input spikes in the neural network with a single call.
+/// The spikes are appended to the external input spikes of the simulation (they are sorted once
+/// if they are not in time order), so no memory is allocated per spike.
+/// \param neural_sim Pointer to a Simulation created by create_neural_simulation().
+/// \param num_spikes Number of spikes to be injected.
+/// \param spike_times Pointer to an array which contains the time of each spike.
+/// \param spike_neurons Pointer to an array which contains the number (index) of the network neuron of each spike.
+/// \return Error occurred during the function execution (0 if it is successfully executed, 1 if
+///   some neuron is not defined in the network; no spike is injected in that case)
+EXTERN_C int inject_input_spikes(Simulation *neural_sim, long num_spikes, const double *spike_times, const long *spike_neurons);
+
+/// \brief Injects a spike in each neuron of a range whose bit is set in a mask.
+/// It is intended to encode the input activity of a simulation slot with a single call.
+/// \param neural_sim Pointer to a Simulation created by create_neural_simulation().
+/// \param spike_time The time of the injected spikes.
+/// \param first_neuron Number (index) of the network neuron which corresponds to the first bit of the mask.
+/// \param num_neurons Number of consecutive neurons (bits) of the mask.
+/// \param mask Pointer to the bitmask (bit i%8 of byte i/8 corresponds to neuron first_neuron+i).
+/// \return Error occurred during the function execution (0 if it is successfully executed, 1 if
+///   the neurons are not defined in the network; no spike is injected in that case)
+EXTERN_C int inject_input_spike_mask(Simulation *neural_sim, double spike_time, long first_neuron, long num_neurons, const unsigned char *mask);
+
 /////////////////////// GENERATE LEARNING ACTIVITY ///////////////////
 
 /// \brief Calculates and weighs the robot's obtained errors in positions and velocities.
@@ -364,6 +446,15 @@ EXTERN_C void generate_learning_activity(Simulation *neural_sim, double cur_slot
 /// \return Number of generated spikes
 EXTERN_C int compute_output_activity(Simulation *neural_sim, double *output_vars);
 
+/// \brief Returns the output spikes generated by the network since the last call.
+/// The arrays belong to the simulation (they must not be freed) and they are valid until the next call
+/// to this function or to compute_output_activity(), so no memory is allocated in the control loop.
+/// \param neural_sim Pointer to a Simulation created by create_neural_simulation().
+/// \param spike_times Pointer where the address of the array of spike times is stored.
+/// \param spike_neurons Pointer where the address of the array of spike neurons is stored.
+/// \return Number of output spikes
+EXTERN_C int get_output_spikes(Simulation *neural_sim, const double **spike_times, const long **spike_neurons);
+
 ///////////////////////////// VARIABLES LOG //////////////////////////
 
 /// \brief Comment string used in the text files
@@ -67,8 +67,32 @@ class AdditiveKernelChange : public WithoutPostSynaptic {
 		 */
 		float a2prepre;
 
+		/*!
+		 * Presynaptic activity of the synapses updated at once (see ApplyTeachingSignal).
+		 */
+		float * PresynapticActivity;
+
+		/*!
+		 * Size of PresynapticActivity.
+		 */
+		unsigned int PresynapticActivitySize;
+
 	public:
 
+		/*!
+		 * \brief Default constructor.
+		 *
+		 * It creates a new AdditiveKernelChange object.
+		 */
+		AdditiveKernelChange();
+
+		/*!
+		 * \brief Object destructor.
+		 *
+		 * It remove an AdditiveKernelChange object.
+		 */
+		virtual ~AdditiveKernelChange();
+
 		/*!
 		 * \brief It initialize the state associated to the learning rule for all the synapses.
 		 *
@@ -100,6 +124,29 @@ class AdditiveKernelChange : public WithoutPostSynaptic {
    		 */
    		virtual void ApplyPreSynapticSpike(Interconnection * Connection,double SpikeTime);
 
+   		/*!
+   		 * \brief It applies the teaching signal to the input connections of a neuron.
+   		 *
+   		 * It applies the weight change of the teaching signal to a set of input connections of the same
+   		 * neuron with this learning rule. The kernels of all the connections are evaluated at once.
+   		 *
+   		 * \param Connections The input connections.
+   		 * \param NumberOfConnections The number of connections.
+   		 * \param SpikeTime The spike time of the teaching signal.
+   		 */
+   		void ApplyTeachingSignal(Interconnection ** Connections, unsigned int NumberOfConnections, double SpikeTime);
+
+		/*!
+		 * \brief It sets the input synapses of a target neuron.
+		 *
+		 * It sets the consecutive synapses with this learning rule which have the same target neuron, so that
+		 * their kernels share the same epoch (see AdditiveKernelState).
+		 *
+		 * \param FirstIndex The index of the first synapse.
+		 * \param NumberOfSynapses The number of synapses.
+		 */
+		virtual void SetTargetSynapses(unsigned int FirstIndex, unsigned int NumberOfSynapses);
+
    		/*!
 		 * \brief It prints the learning rule info.
 		 *
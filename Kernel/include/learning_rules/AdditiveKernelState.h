@@ -0,0 +1,231 @@
+/***************************************************************************
+ *                           AdditiveKernelState.h                         *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef ADDITIVEKERNELSTATE_H_
+#define ADDITIVEKERNELSTATE_H_
+
+#include "ConnectionState.h"
+
+#include <vector>
+
+using namespace std;
+
+/*!
+ * \file AdditiveKernelState.h
+ *
+ * \author Jesus Garrido
+ * \date June 2013
+ *
+ * This file declares a class which abstracts the current state of the synaptic connections
+ * with an additive kernel learning rule.
+ */
+
+/*!
+ * Maximum time (relative to the time constant of the kernel) between the epoch of a group
+ * and the time where its synapses are updated. The coefficients grow as exp(EPOCHLENGTH).
+ */
+#define EPOCHLENGTH 8.0f
+
+/*!
+ * Minimum number of synapses to evaluate the kernels in parallel.
+ */
+#define PARALLELKERNELEVALUATION 1024
+
+/*!
+ * \class AdditiveKernelState
+ *
+ * \brief Synaptic connection current state with a lazily evaluated kernel.
+ *
+ * This class abstracts the state of the synaptic connections with an additive kernel learning
+ * rule. The kernel of every synapse is a linear time-invariant system, so its state is stored as
+ * time-stamped coefficients referred to the epoch of its group (the synapses with the same target
+ * neuron): the kernel at time t is M(t-epoch)*coefficients. A presynaptic spike only modifies the
+ * coefficients of its synapse, and the kernels of all the synapses of a group are evaluated at the
+ * same time (a teaching signal) with the same decay factors, without updating the state.
+ *
+ * The epoch of a group is moved forward (and its coefficients are decayed) when the state is
+ * updated more than EPOCHLENGTH time constants after the epoch.
+ *
+ * \author Jesus Garrido
+ * \date June 2013
+ */
+class AdditiveKernelState : public ConnectionState{
+
+	protected:
+		/*!
+		 * Group of each synapse.
+		 */
+		unsigned int * SynapseGroup;
+
+		/*!
+		 * First synapse of each group.
+		 */
+		vector<unsigned int> GroupFirstSynapse;
+
+		/*!
+		 * Number of synapses of each group.
+		 */
+		vector<unsigned int> GroupSize;
+
+		/*!
+		 * Epoch of each group.
+		 */
+		vector<double> GroupEpoch;
+
+		/*!
+		 * \brief It moves the epoch of consecutive synapses.
+		 *
+		 * It decays the coefficients of the synapses [FirstIndex, FirstIndex+NumberOfIndexes).
+		 *
+		 * \param FirstIndex The index of the first synapse.
+		 * \param NumberOfIndexes The number of synapses.
+		 * \param ElapsedRelative The time elapsed since the former epoch (relative to tau).
+		 */
+		virtual void MoveEpoch(unsigned int FirstIndex, unsigned int NumberOfIndexes, float ElapsedRelative) = 0;
+
+		/*!
+		 * \brief It adds a presynaptic spike to the coefficients of a synapse.
+		 *
+		 * It adds a presynaptic spike to the coefficients of a synapse.
+		 *
+		 * \param index The synapse's index inside the learning rule.
+		 * \param ElapsedRelative The time of the spike since the epoch (relative to tau).
+		 */
+		virtual void AddSpike(unsigned int index, float ElapsedRelative) = 0;
+
+		/*!
+		 * \brief It evaluates the kernel of consecutive synapses.
+		 *
+		 * It evaluates the kernel of the synapses [FirstIndex, FirstIndex+NumberOfIndexes).
+		 *
+		 * \param FirstIndex The index of the first synapse.
+		 * \param NumberOfIndexes The number of synapses.
+		 * \param ElapsedRelative The time since the epoch (relative to tau).
+		 * \param Activity The kernel of each synapse (output).
+		 */
+		virtual void EvaluateKernels(unsigned int FirstIndex, unsigned int NumberOfIndexes, float ElapsedRelative, float * Activity) = 0;
+
+		/*!
+		 * \brief It moves the epoch of a group if it is too far from a time.
+		 *
+		 * It moves the epoch of a group to NewTime if it is more than EPOCHLENGTH time constants older.
+		 *
+		 * \param group The group.
+		 * \param NewTime The time.
+		 */
+		void CheckEpoch(unsigned int group, double NewTime);
+
+	public:
+		/*!
+		 * Tau constant of the learning rule.
+		 */
+		float tau;
+		float inv_tau;
+
+		/*!
+		 * \brief Default constructor with parameters.
+		 *
+		 * It generates a new state of the connections. All the synapses belong to the
+		 * same group until SetGroup is called.
+		 *
+		 * \param NumSynapses Number of synapses that implement this learning rule.
+		 * \param NumVariables Number of coefficients of each synapse.
+		 * \param NewTau Time constant of the kernel.
+		 */
+		AdditiveKernelState(unsigned int NumSynapses, int NumVariables, float NewTau);
+
+		/*!
+		 * \brief Class destructor.
+		 *
+		 * It destroys an object of this class.
+		 */
+		virtual ~AdditiveKernelState();
+
+		/*!
+		 * \brief It sets a group of synapses.
+		 *
+		 * It sets the consecutive synapses [FirstIndex, FirstIndex+NumberOfIndexes) as a group
+		 * (the synapses of the same target neuron), before the simulation starts.
+		 *
+		 * \param FirstIndex The index of the first synapse.
+		 * \param NumberOfIndexes The number of synapses.
+		 */
+		void SetGroup(unsigned int FirstIndex, unsigned int NumberOfIndexes);
+
+		/*!
+		 * \brief It gets the value of the accumulated presynaptic activity.
+		 *
+		 * It gets the value of the kernel at the last update time of the synapse.
+		 *
+		 * \param index The synapse's index inside the learning rule.
+		 * \return The accumulated presynaptic activity.
+		 */
+		virtual float GetPresynapticActivity(unsigned int index);
+
+		/*!
+		 * \brief It gets the value of the accumulated postsynaptic activity.
+		 *
+		 * It gets the value of the accumulated postsynaptic activity.
+		 *
+		 * \param index The synapse's index inside the learning rule.
+		 * \return The accumulated postsynaptic activity.
+		 */
+		virtual float GetPostsynapticActivity(unsigned int index);
+
+		/*!
+		 * \brief It gets the presynaptic activity of consecutive synapses at a time.
+		 *
+		 * It evaluates the kernel of the synapses [FirstIndex, FirstIndex+NumberOfIndexes) (all of
+		 * them in the same group) at a time without updating them.
+		 *
+		 * \param FirstIndex The index of the first synapse.
+		 * \param NumberOfIndexes The number of synapses.
+		 * \param Time The time.
+		 * \param Activity The presynaptic activity of each synapse (output).
+		 */
+		void GetPresynapticActivities(unsigned int FirstIndex, unsigned int NumberOfIndexes, double Time, float * Activity);
+
+		/*!
+		 * \brief set new time to spikes.
+		 *
+		 * It sets the last update time of a synapse (the kernel is not evaluated).
+		 *
+		 * \param index The synapse's index inside the learning rule.
+		 * \param NewTime new time.
+		 * \param pre_post Not used.
+		 */
+		virtual void SetNewUpdateTime(unsigned int index, double NewTime, bool pre_post);
+
+		/*!
+		 * \brief It implements the behaviour when it transmits a spike.
+		 *
+		 * It adds a presynaptic spike at the last update time of the synapse.
+		 *
+		 * \param index The synapse's index inside the learning rule.
+		 */
+		virtual void ApplyPresynapticSpike(unsigned int index);
+
+		/*!
+		 * \brief It implements the behaviour when the target cell fires a spike.
+		 *
+		 * It does nothing: the kernel only depends on the presynaptic activity.
+		 *
+		 * \param index The synapse's index inside the learning rule.
+		 */
+		virtual void ApplyPostsynapticSpike(unsigned int index);
+};
+
+#endif /* ADDITIVEKERNELSTATE_H_ */
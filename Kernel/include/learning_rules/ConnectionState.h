@@ -17,8 +17,6 @@
 #ifndef CONNECTIONSTATE_H_
 #define CONNECTIONSTATE_H_
 
-class ExponentialTable;
-
 /*!
  * \file ConnectionState.h
  *
@@ -28,13 +26,20 @@ class ExponentialTable;
  * This file declares a class which abstracts the current state of a synaptic connection.
  */
 
+/*!
+ * Alignment (in bytes) of the array of each state variable.
+ */
+#define CONNECTIONSTATEALIGNMENT 64
+
 /*!
  * \class ConnectionState
  *
  * \brief Synaptic connection current state.
  *
  * This class abstracts the state of a synaptic connection and defines the state variables of
- * that connection.
+ * that connection. The state variables are stored as a structure of arrays: every state variable
+ * has its own aligned array with the values of all the synapses, so the updates of consecutive
+ * synapses (the inputs of a target neuron) access consecutive memory positions.
  *
  * \author Jesus Garrido
  * \date October 2011
@@ -59,18 +64,23 @@ class ConnectionState {
 	   	 */
 	   	double * LastUpdate;
 
+		/*!
+		 * \brief Distance (in elements) between the arrays of two consecutive state variables.
+		 */
+		unsigned int VariableStride;
+
+		/*!
+		 * \brief Allocated memory of the state variables (StateVars is aligned inside it).
+		 */
+		float * AllocatedStateVars;
+
 
 	public:
 		/*!
-	   	 * \brief Neuron state variables.
+	   	 * \brief Connection state variables (an array of VariableStride elements per variable).
 	   	 */
 	   	float * StateVars;
 
-		/*!
-		 * \brief exponential look-up table.
-		 */
-		ExponentialTable * exponential;
-
 
 	   	/*!
 		 * \brief It sets the time when the last update happened.
@@ -107,7 +117,7 @@ class ConnectionState {
 		 */
 		//void SetStateVariableAt(int index, unsigned int position,float NewValue);
 		inline void SetStateVariableAt(unsigned int index, unsigned int position, float NewValue){
-			*(this->StateVars + index*NumberOfVariables + position) = NewValue;
+			*(this->StateVars + position*VariableStride + index) = NewValue;
 		}
 
 		/*!
@@ -120,8 +130,8 @@ class ConnectionState {
 		 * \param NewValue The new value of that state variable.
 		 */
 		inline void SetStateVariableAt(unsigned int index, unsigned int position,float NewValue1, float NewValue2){
-			*(this->StateVars + index*NumberOfVariables + position) = NewValue1;
-			*(this->StateVars + index*NumberOfVariables + position + 1) = NewValue2;
+			*(this->StateVars + position*VariableStride + index) = NewValue1;
+			*(this->StateVars + (position+1)*VariableStride + index) = NewValue2;
 		}
 
 		
@@ -135,7 +145,7 @@ class ConnectionState {
 		 * \param increment The increment of that state variable.
 		 */
 		inline void incrementStateVaraibleAt(unsigned int index, unsigned int position, float increment){
-			*(this->StateVars + index*NumberOfVariables + position) += increment;
+			*(this->StateVars + position*VariableStride + index) += increment;
 		}
 
 		/*!
@@ -148,7 +158,7 @@ class ConnectionState {
 		 * \param factor The multiplier of that state variable.
 		 */
 		inline void multiplyStateVaraibleAt(unsigned int index, unsigned int position, float factor){
-			*(this->StateVars + index*NumberOfVariables + position) *= factor;
+			*(this->StateVars + position*VariableStride + index) *= factor;
 		}
 
 
@@ -179,7 +189,20 @@ class ConnectionState {
 		 */
 		//float GetStateVariableAt(int index, int position);
 		inline float GetStateVariableAt(unsigned int index, unsigned int position){
-			return *(this->StateVars + index*NumberOfVariables + position);
+			return *(this->StateVars + position*VariableStride + index);
+		}
+
+		/*!
+		 * \brief It gets the array of a state variable.
+		 *
+		 * It gets the array of a state variable. The value of the synapse index is at position index
+		 * and the array is aligned to CONNECTIONSTATEALIGNMENT bytes.
+		 *
+		 * \param position The position of the state variable.
+		 * \return The array with the values of the position-th state variable of all the synapses.
+		 */
+		inline float * GetStateVariableArray(unsigned int position){
+			return this->StateVars + position*VariableStride;
 		}
 
 		/*!
@@ -0,0 +1,133 @@
+/***************************************************************************
+ *                           DeferredWeightChanges.h                       *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef DEFERREDWEIGHTCHANGES_H_
+#define DEFERREDWEIGHTCHANGES_H_
+
+/*!
+ * \file DeferredWeightChanges.h
+ *
+ * \author Jesus Garrido
+ * \date July 2013
+ *
+ * This file declares a class which stores the weight changes of the learning rules until
+ * they are applied to the connections.
+ */
+
+#include "../spike/Interconnection.h"
+
+/*!
+ * Value of a deferred weight when the connection has no pending weight change.
+ */
+#define NO_DEFERRED_WEIGHT -1.0f
+
+/*!
+ * \class DeferredWeightChanges
+ *
+ * \brief Weight changes pending to be applied.
+ *
+ * This class stores the changed weight of every connection (indexed by the connection index)
+ * and the list of changed connections. The connections keep their weights until the changes
+ * are applied, so the weights are only written at that moment. The weight limits are checked in
+ * every change, so the final weights are the same as if every change was applied immediately.
+ *
+ * \author Jesus Garrido
+ * \date July 2013
+ */
+class DeferredWeightChanges {
+
+	private:
+
+		/*!
+		 * \brief Changed weight of every connection (NO_DEFERRED_WEIGHT if it has not been changed).
+		 */
+		float * Weights;
+
+		/*!
+		 * \brief Indexes of the changed connections.
+		 */
+		long int * ChangedConnections;
+
+		/*!
+		 * \brief Number of changed connections.
+		 */
+		long int NumberOfChangedConnections;
+
+	public:
+
+		/*!
+		 * \brief Constructor with parameters.
+		 *
+		 * It creates a new object without pending changes.
+		 *
+		 * \param NumConnections Number of connections of the network.
+		 */
+		DeferredWeightChanges(long int NumConnections);
+
+		/*!
+		 * \brief Class destructor.
+		 *
+		 * It destroys an object of this class.
+		 */
+		~DeferredWeightChanges();
+
+		/*!
+		 * \brief It changes the weight of a connection.
+		 *
+		 * It increments the pending weight of a connection (its current weight if it has not
+		 * been changed yet) and checks the final value is inside the limits.
+		 *
+		 * \param Connection The connection.
+		 * \param Increment The synaptic weight increment of the connection.
+		 */
+		inline void IncrementWeight(Interconnection * Connection, float Increment){
+			long int Index = Connection->GetIndex();
+			float NewWeight;
+			if (this->Weights[Index]==NO_DEFERRED_WEIGHT){
+				this->ChangedConnections[this->NumberOfChangedConnections++] = Index;
+				NewWeight = Connection->GetWeight() + Increment;
+			} else {
+				NewWeight = this->Weights[Index] + Increment;
+			}
+
+			if(NewWeight > Connection->GetMaxWeight()){
+				NewWeight = Connection->GetMaxWeight();
+			}else if(NewWeight < 0.0f){
+				NewWeight = 0.0f;
+			}
+			this->Weights[Index] = NewWeight;
+		}
+
+		/*!
+		 * \brief It applies the pending weight changes.
+		 *
+		 * It sets the changed weights in the connections and removes the pending changes.
+		 *
+		 * \param Connections The connections of the network (ordered by their index).
+		 */
+		void ApplyChanges(Interconnection ** Connections);
+
+		/*!
+		 * \brief It gets the number of connections with pending changes.
+		 *
+		 * It gets the number of connections with pending changes.
+		 *
+		 * \return The number of changed connections.
+		 */
+		long int GetNumberOfChangedConnections() const;
+};
+
+#endif /* DEFERREDWEIGHTCHANGES_H_ */
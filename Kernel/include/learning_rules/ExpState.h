@@ -17,7 +17,7 @@
 #ifndef EXPSTATE_H_
 #define EXPSTATE_H_
 
-#include "ConnectionState.h"
+#include "AdditiveKernelState.h"
 
 /*!
  * \file ExpState.h
@@ -38,57 +38,68 @@
  * that connection. The kernel function is f(t) = (t/tau)*exp(-t/tau), where t represents the time since
  * the last presynaptic spike reached the cell.
  *
+ * The kernel at time t is (A+B*x)*exp(-x), where x=(t-epoch)/tau and A and B are the coefficients
+ * of the synapse (state variables 0 and 1). A presynaptic spike at y=(t-epoch)/tau adds
+ * -y*exp(y) to A and exp(y) to B.
+ *
  * \author Jesus Garrido
  * \date October 2011
  */
 
-class ExpState : public ConnectionState{
+class ExpState : public AdditiveKernelState{
 
-	private:
+	protected:
 		/*!
-		 * Tau constant of the learning rule.
+		 * \brief It moves the epoch of consecutive synapses.
+		 *
+		 * It decays the coefficients of the synapses [FirstIndex, FirstIndex+NumberOfIndexes).
+		 *
+		 * \param FirstIndex The index of the first synapse.
+		 * \param NumberOfIndexes The number of synapses.
+		 * \param ElapsedRelative The time elapsed since the former epoch (relative to tau).
 		 */
-		float tau;
-		float inv_tau;
-
-	public:
+		virtual void MoveEpoch(unsigned int FirstIndex, unsigned int NumberOfIndexes, float ElapsedRelative);
 
 		/*!
-		 * \brief Default constructor with parameters.
+		 * \brief It adds a presynaptic spike to the coefficients of a synapse.
 		 *
-		 * It generates a new state of a connection.
+		 * It adds a presynaptic spike to the coefficients of a synapse.
 		 *
-		 * \param NewTau The temporal constant of the learning rule.
+		 * \param index The synapse's index inside the learning rule.
+		 * \param ElapsedRelative The time of the spike since the epoch (relative to tau).
 		 */
-		ExpState(unsigned int NumSynapses, float NewTau);
+		virtual void AddSpike(unsigned int index, float ElapsedRelative);
 
 		/*!
-		 * \brief Class destructor.
+		 * \brief It evaluates the kernel of consecutive synapses.
 		 *
-		 * It destroys an object of this class.
+		 * It evaluates the kernel of the synapses [FirstIndex, FirstIndex+NumberOfIndexes).
+		 *
+		 * \param FirstIndex The index of the first synapse.
+		 * \param NumberOfIndexes The number of synapses.
+		 * \param ElapsedRelative The time since the epoch (relative to tau).
+		 * \param Activity The kernel of each synapse (output).
 		 */
-		virtual ~ExpState();
+		virtual void EvaluateKernels(unsigned int FirstIndex, unsigned int NumberOfIndexes, float ElapsedRelative, float * Activity);
+
+	public:
 
 		/*!
-		 * \brief It gets the value of the accumulated presynaptic activity.
+		 * \brief Default constructor with parameters.
 		 *
-		 * It gets the value of the accumulated presynaptic activity.
+		 * It generates a new state of a connection.
 		 *
-		 * \param index The synapse's index inside the learning rule.
-		 * \return The accumulated presynaptic activity.
+		 * \param NumSynapses Number of synapses that implement this learning rule.
+		 * \param NewTau The temporal constant of the learning rule.
 		 */
-		virtual float GetPresynapticActivity(unsigned int index);
+		ExpState(unsigned int NumSynapses, float NewTau);
 
 		/*!
-		 * \brief It gets the value of the accumulated postsynaptic activity.
-		 *
-		 * It gets the value of the accumulated postsynaptic activity.
+		 * \brief Class destructor.
 		 *
-		 * \param index The synapse's index inside the learning rule.
-		 * \return The accumulated postsynaptic activity.
+		 * It destroys an object of this class.
 		 */
-		virtual float GetPostsynapticActivity(unsigned int index);
-
+		virtual ~ExpState();
 
 		/*!
 		 * \brief It gets the number of variables that you can print in this state.
@@ -102,46 +113,13 @@ class ExpState : public ConnectionState{
 		/*!
 		 * \brief It gets a value to be printed from this state.
 		 *
-		 * It gets a value to be printed from this state.
+		 * It gets a value of the first synapse: the kernel and its second term at the last update
+		 * time (not the coefficients referred to the epoch), the last update time and tau.
 		 *
 		 * \return The value at position-th position in this state.
 		 */
 		virtual double GetPrintableValuesAt(unsigned int position);
 
-
-		/*!
-		 * \brief set new time to spikes.
-		 *
-		 * It set new time to spikes.
-		 *
-		 * \param index The synapse's index inside the learning rule.
-		 * \param NewTime new time.
-		 * \param pre_post In some learning rules (i.e. STDPLS) this variable indicate wether the update affects the pre- or post- variables.
-		 */
-		virtual void SetNewUpdateTime(unsigned int index, double NewTime, bool pre_post);
-
-
-		/*!
-		 * \brief It implements the behaviour when it transmits a spike.
-		 *
-		 * It implements the behaviour when it transmits a spike. It must be implemented
-		 * by any inherited class.
-		 *
-		 * \param index The synapse's index inside the learning rule.
-		 */
-		virtual void ApplyPresynapticSpike(unsigned int index);
-
-		/*!
-		 * \brief It implements the behaviour when the target cell fires a spike.
-		 *
-		 * It implements the behaviour when it the target cell fires a spike. It must be implemented
-		 * by any inherited class.
-		 *
-		 * \param index The synapse's index inside the learning rule.
-		 */
-		virtual void ApplyPostsynapticSpike(unsigned int index);
-
 };
 
 #endif /* NEURONSTATE_H_ */
-
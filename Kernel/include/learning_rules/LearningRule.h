@@ -21,6 +21,8 @@
 
 #include "../spike/EDLUTFileException.h"
 
+#include "./DeferredWeightChanges.h"
+
 /*!
  * \file LearningRule.h
  *
@@ -30,7 +32,6 @@
  * This file declares a class which abstracts a learning rule.
  */
 
-class Interconnection;
 class ConnectionState;
 
 /*!
@@ -57,6 +58,39 @@ class LearningRule : public PrintableObject {
 		 */
 		int counter;
 
+		/*!
+		 * \brief Deferred weight changes of the network. 0 if the weight changes are applied immediately.
+		 */
+		DeferredWeightChanges * DeferredWeights;
+
+		/*!
+		 * \brief It changes the weight of a connection.
+		 *
+		 * It changes the weight of a connection. If the weight changes are deferred, the connection
+		 * keeps its weight and the changed weight is stored until the network applies it (see
+		 * Network::ApplyDeferredWeights).
+		 *
+		 * \param Connection The connection.
+		 * \param Increment The synaptic weight increment of the connection.
+		 */
+		inline void ChangeWeight(Interconnection * Connection, float Increment){
+			if (this->DeferredWeights!=0){
+				this->DeferredWeights->IncrementWeight(Connection, Increment);
+			} else {
+				Connection->IncrementWeight(Increment);
+			}
+		}
+
+		/*!
+		 * \brief It sets where the weight changes are stored.
+		 *
+		 * It sets where the weight changes are stored until they are applied. 0 applies the
+		 * weight changes immediately.
+		 *
+		 * \param NewDeferredWeights The deferred weight changes of the network.
+		 */
+		void SetDeferredWeights(DeferredWeightChanges * NewDeferredWeights);
+
 		/*!
 		 * \brief It initialize the state associated to the learning rule for all the synapses.
 		 *
@@ -66,6 +100,30 @@ class LearningRule : public PrintableObject {
 		 */
 		virtual void InitializeConnectionState(unsigned int NumberOfSynapses) = 0;
 
+		/*!
+		 * \brief It initialize the state associated to the learning rule for all the synapses.
+		 *
+		 * It initialize the state associated to the learning rule when the number of neurons of the
+		 * network is also known (for learning rules storing the state per neuron). By default, it
+		 * calls InitializeConnectionState(NumberOfSynapses).
+		 *
+		 * \param NumberOfSynapses the number of synapses that implement this learning rule.
+		 * \param NumberOfNeurons the number of neurons of the network.
+		 */
+		virtual void InitializeConnectionState(unsigned int NumberOfSynapses, unsigned int NumberOfNeurons);
+
+		/*!
+		 * \brief It sets the input synapses of a target neuron.
+		 *
+		 * It sets the consecutive synapses with this learning rule which have the same target
+		 * neuron. It is called once for each target neuron after the state has been initialized.
+		 * By default, it does nothing.
+		 *
+		 * \param FirstIndex The index of the first synapse.
+		 * \param NumberOfSynapses The number of synapses.
+		 */
+		virtual void SetTargetSynapses(unsigned int FirstIndex, unsigned int NumberOfSynapses);
+
 		/*!
 		 * \brief It return the state associated to the learning rule for all the synapses.
 		 *
@@ -121,6 +179,20 @@ class LearningRule : public PrintableObject {
 		 */
 		virtual void ApplyPostSynapticSpike(Interconnection * Connection,double SpikeTime) = 0;
 
+   		/*!
+		 * \brief It applies the weight change function to all the input connections of a neuron when it fires.
+		 *
+		 * It applies the weight change function to a set of input connections of the same neuron
+		 * (all of them with this learning rule) when the neuron fires. By default, it calls
+		 * ApplyPostSynapticSpike for each connection, but the learning rules can update
+		 * all the connections at once.
+		 *
+		 * \param Connections The input connections where the learning rule happens.
+		 * \param NumberOfConnections The number of connections.
+		 * \param SpikeTime The spike time of the postsynaptic spike.
+		 */
+		virtual void ApplyPostSynapticSpikes(Interconnection ** Connections, unsigned int NumberOfConnections, double SpikeTime);
+
    		/*!
 		 * \brief It prints the learning rule info.
 		 *
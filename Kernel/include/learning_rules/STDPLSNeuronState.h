@@ -0,0 +1,86 @@
+/***************************************************************************
+ *                           STDPLSNeuronState.h                           *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef STDPLSNEURONSTATE_H_
+#define STDPLSNEURONSTATE_H_
+
+#include "STDPNeuronState.h"
+
+/*!
+ * \file STDPLSNeuronState.h
+ *
+ * \author Jesus Garrido
+ * \date June 2013
+ *
+ * This file declares a class which abstracts the STDP (only accounting the last previous spike)
+ * traces of the neurons of a network.
+ */
+
+/*!
+ * \class STDPLSNeuronState
+ *
+ * \brief STDP (only accounting the last previous spike) traces stored per neuron.
+ *
+ * This class abstracts the state of a STDP (only accounting the last previous spike) learning rule
+ * when the traces are stored per neuron instead of per synapse.
+ *
+ * \author Jesus Garrido
+ * \date June 2013
+ */
+
+class STDPLSNeuronState : public STDPNeuronState{
+
+	public:
+
+		/*!
+		 * \brief Default constructor with parameters.
+		 *
+		 * It generates a new state of the neurons.
+		 *
+		 * \param NumNeurons Number of neurons of the network.
+		 * \param LTPtau Time constant of the LTP component.
+		 * \param LTDtau Time constant of the LTD component.
+		 */
+		STDPLSNeuronState(unsigned int NumNeurons, float LTPtau, float LTDtau);
+
+		/*!
+		 * \brief Class destructor.
+		 *
+		 * It destroys an object of this class.
+		 */
+		virtual ~STDPLSNeuronState();
+
+		/*!
+		 * \brief It implements the behaviour when the neuron transmits a spike.
+		 *
+		 * It implements the behaviour when the neuron transmits a spike.
+		 *
+		 * \param index The neuron index.
+		 */
+		virtual void ApplyPresynapticSpike(unsigned int index);
+
+		/*!
+		 * \brief It implements the behaviour when the neuron fires a spike.
+		 *
+		 * It implements the behaviour when the neuron fires a spike (as target of the connections).
+		 *
+		 * \param index The neuron index.
+		 */
+		virtual void ApplyPostsynapticSpike(unsigned int index);
+
+};
+
+#endif /* STDPLSNEURONSTATE_H_ */
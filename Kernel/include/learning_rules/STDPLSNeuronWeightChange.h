@@ -0,0 +1,68 @@
+/***************************************************************************
+ *                           STDPLSNeuronWeightChange.h                    *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef STDPLSNEURONWEIGHTCHANGE_H_
+#define STDPLSNEURONWEIGHTCHANGE_H_
+
+#include "./STDPNeuronWeightChange.h"
+
+/*!
+ * \file STDPLSNeuronWeightChange.h
+ *
+ * \author Jesus Garrido
+ * \date June 2013
+ *
+ * This file declares a class which abstracts a STDP learning rule (accounting only the last spike)
+ * with the traces stored per neuron.
+ */
+
+/*!
+ * \class STDPLSNeuronWeightChange
+ *
+ * \brief Learning rule.
+ *
+ * This class abstract the behaviour of a STDP learning rule (accounting only the last spike)
+ * with the traces stored per neuron (see STDPNeuronWeightChange).
+ *
+ * \author Jesus Garrido
+ * \date June 2013
+ */
+class STDPLSNeuronWeightChange: public STDPNeuronWeightChange {
+	public:
+
+		/*!
+		 * \brief It initialize the state associated to the learning rule for all the neurons.
+		 *
+		 * It initialize the state associated to the learning rule for all the neurons.
+		 *
+		 * \param NumberOfSynapses the number of synapses that implement this learning rule.
+		 * \param NumberOfNeurons the number of neurons of the network.
+		 */
+		virtual void InitializeConnectionState(unsigned int NumberOfSynapses, unsigned int NumberOfNeurons);
+
+		/*!
+		 * \brief It prints the learning rule info.
+		 *
+		 * It prints the current learning rule characteristics.
+		 *
+		 * \param out The stream where it prints the information.
+		 *
+		 * \return The stream after the printer.
+		 */
+		virtual ostream & PrintInfo(ostream & out);
+};
+
+#endif /* STDPLSNEURONWEIGHTCHANGE_H_ */
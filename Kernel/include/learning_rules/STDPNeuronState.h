@@ -0,0 +1,220 @@
+/***************************************************************************
+ *                           STDPNeuronState.h                             *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef STDPNEURONSTATE_H_
+#define STDPNEURONSTATE_H_
+
+#include "ConnectionState.h"
+
+#include "../simulation/ExponentialTable.h"
+
+/*!
+ * \file STDPNeuronState.h
+ *
+ * \author Jesus Garrido
+ * \date June 2013
+ *
+ * This file declares a class which abstracts the STDP traces of the neurons of a network.
+ */
+
+/*!
+ * \class STDPNeuronState
+ *
+ * \brief STDP traces stored per neuron.
+ *
+ * This class abstracts the state of a STDP learning rule when the traces are stored per neuron
+ * instead of per synapse. The STDP traces only depend on the spike times of the presynaptic and
+ * postsynaptic neurons, so every neuron keeps a presynaptic trace (its own spikes as source of the
+ * connections, decayed with the LTP time constant) and a postsynaptic trace (its own spikes as
+ * target of the connections, decayed with the LTD time constant). The index of the state is the
+ * neuron index in the network.
+ *
+ * The presynaptic trace is updated at the emission time of the spikes and its last update time
+ * is stored in LastUpdate. The postsynaptic trace uses LastPostUpdate.
+ *
+ * \author Jesus Garrido
+ * \date June 2013
+ */
+
+class STDPNeuronState : public ConnectionState{
+
+	protected:
+		/*!
+		 * \brief Last update time of the postsynaptic trace of each neuron.
+		 */
+		double * LastPostUpdate;
+
+	public:
+		/*!
+		 * LTP time constant.
+		 */
+		float LTPTau;
+		float inv_LTPTau;
+
+		/*!
+		 * LTD time constant.
+		 */
+		float LTDTau;
+		float inv_LTDTau;
+
+		/*!
+		 * \brief Default constructor with parameters.
+		 *
+		 * It generates a new state of the neurons.
+		 *
+		 * \param NumNeurons Number of neurons of the network.
+		 * \param LTPtau Time constant of the LTP component.
+		 * \param LTDtau Time constant of the LTD component.
+		 */
+		STDPNeuronState(unsigned int NumNeurons, float LTPtau, float LTDtau);
+
+		/*!
+		 * \brief Class destructor.
+		 *
+		 * It destroys an object of this class.
+		 */
+		virtual ~STDPNeuronState();
+
+		/*!
+		 * \brief It gets the value of the accumulated presynaptic activity.
+		 *
+		 * It gets the value of the accumulated presynaptic activity at the last update time.
+		 *
+		 * \param index The neuron index.
+		 *
+		 * \return The accumulated presynaptic activity.
+		 */
+		inline float GetPresynapticActivity(unsigned int index){
+			return this->GetStateVariableAt(index, 0);
+		}
+
+		/*!
+		 * \brief It gets the value of the accumulated postsynaptic activity.
+		 *
+		 * It gets the value of the accumulated postsynaptic activity at the last update time.
+		 *
+		 * \param index The neuron index.
+		 *
+		 * \return The accumulated postsynaptic activity.
+		 */
+		inline float GetPostsynapticActivity(unsigned int index){
+			return this->GetStateVariableAt(index, 1);
+		}
+
+		/*!
+		 * \brief It gets the value of the accumulated presynaptic activity at a time.
+		 *
+		 * It gets the value of the accumulated presynaptic activity decayed until a time
+		 * (without modifying the state). The activity is not decayed if the time is previous
+		 * to the last update.
+		 *
+		 * \param index The neuron index.
+		 * \param Time The time.
+		 *
+		 * \return The accumulated presynaptic activity.
+		 */
+		inline float GetPresynapticActivityAt(unsigned int index, double Time){
+			float ElapsedTime=(float)(Time - this->GetLastUpdateTime(index));
+			if (ElapsedTime>0.0f){
+				return this->GetStateVariableAt(index, 0)*ExponentialTable::GetResult(-ElapsedTime*this->inv_LTPTau);
+			}
+			return this->GetStateVariableAt(index, 0);
+		}
+
+		/*!
+		 * \brief It gets the value of the accumulated postsynaptic activity at a time.
+		 *
+		 * It gets the value of the accumulated postsynaptic activity decayed until a time
+		 * (without modifying the state). The activity is not decayed if the time is previous
+		 * to the last update.
+		 *
+		 * \param index The neuron index.
+		 * \param Time The time.
+		 *
+		 * \return The accumulated postsynaptic activity.
+		 */
+		inline float GetPostsynapticActivityAt(unsigned int index, double Time){
+			float ElapsedTime=(float)(Time - this->LastPostUpdate[index]);
+			if (ElapsedTime>0.0f){
+				return this->GetStateVariableAt(index, 1)*ExponentialTable::GetResult(-ElapsedTime*this->inv_LTDTau);
+			}
+			return this->GetStateVariableAt(index, 1);
+		}
+
+		/*!
+		 * \brief It gets the last update time of the postsynaptic trace.
+		 *
+		 * It gets the last update time of the postsynaptic trace.
+		 *
+		 * \param index The neuron index.
+		 *
+		 * \return The last update time of the postsynaptic trace.
+		 */
+		inline double GetLastPostUpdateTime(unsigned int index){
+			return this->LastPostUpdate[index];
+		}
+
+		/*!
+		 * \brief It gets the number of variables that you can print in this state.
+		 *
+		 * It gets the number of variables that you can print in this state.
+		 *
+		 * \return The number of variables that you can print in this state.
+		 */
+		virtual unsigned int GetNumberOfPrintableValues();
+
+		/*!
+		 * \brief It gets a value to be printed from this state.
+		 *
+		 * It gets a value to be printed from this state.
+		 *
+		 * \return The value at position-th position in this state.
+		 */
+		virtual double GetPrintableValuesAt(unsigned int position);
+
+		/*!
+		 * \brief set new time to spikes.
+		 *
+		 * It decays the presynaptic trace (pre_post false) or the postsynaptic trace (pre_post
+		 * true) of a neuron until a new time.
+		 *
+		 * \param index The neuron index.
+		 * \param NewTime new time.
+		 * \param pre_post The updated trace.
+		 */
+		virtual void SetNewUpdateTime(unsigned int index, double NewTime, bool pre_post);
+
+		/*!
+		 * \brief It implements the behaviour when the neuron transmits a spike.
+		 *
+		 * It implements the behaviour when the neuron transmits a spike.
+		 *
+		 * \param index The neuron index.
+		 */
+		virtual void ApplyPresynapticSpike(unsigned int index);
+
+		/*!
+		 * \brief It implements the behaviour when the neuron fires a spike.
+		 *
+		 * It implements the behaviour when the neuron fires a spike (as target of the connections).
+		 *
+		 * \param index The neuron index.
+		 */
+		virtual void ApplyPostsynapticSpike(unsigned int index);
+
+};
+
+#endif /* STDPNEURONSTATE_H_ */
@@ -0,0 +1,123 @@
+/***************************************************************************
+ *                           STDPNeuronWeightChange.h                      *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef STDPNEURONWEIGHTCHANGE_H_
+#define STDPNEURONWEIGHTCHANGE_H_
+
+#include "./STDPWeightChange.h"
+
+#include "../spike/EDLUTException.h"
+
+/*!
+ * \file STDPNeuronWeightChange.h
+ *
+ * \author Jesus Garrido
+ * \date June 2013
+ *
+ * This file declares a class which abstracts a STDP learning rule with the traces stored per neuron.
+ */
+
+class Interconnection;
+
+/*!
+ * \class STDPNeuronWeightChange
+ *
+ * \brief Learning rule.
+ *
+ * This class abstract the behaviour of a STDP learning rule with the traces stored per neuron
+ * (see STDPNeuronState) instead of per synapse. It has the same parameters as STDPWeightChange,
+ * but the state memory is proportional to the number of neurons and a postsynaptic spike
+ * only reads the presynaptic traces of the source neurons.
+ *
+ * The presynaptic trace of a neuron is updated once per spike (at the emission time of the
+ * spike, when it reaches its first connection with this learning rule). The result is the
+ * same as with STDPWeightChange when all the connections with this learning rule of a source
+ * neuron have the same delay. Otherwise, a postsynaptic spike can account for source spikes
+ * which have not reached the connection yet.
+ *
+ * \author Jesus Garrido
+ * \date June 2013
+ */
+class STDPNeuronWeightChange: public STDPWeightChange {
+	public:
+
+		/*!
+		 * \brief It initialize the state associated to the learning rule.
+		 *
+		 * It can not be used: this learning rule needs the number of neurons (see
+		 * InitializeConnectionState(NumberOfSynapses, NumberOfNeurons)).
+		 *
+		 * \param NumberOfSynapses the number of synapses that implement this learning rule.
+		 *
+		 * \throw EDLUTException Always (the state would not be initialized).
+		 */
+		virtual void InitializeConnectionState(unsigned int NumberOfSynapses) throw (EDLUTException);
+
+		/*!
+		 * \brief It initialize the state associated to the learning rule for all the neurons.
+		 *
+		 * It initialize the state associated to the learning rule for all the neurons.
+		 *
+		 * \param NumberOfSynapses the number of synapses that implement this learning rule.
+		 * \param NumberOfNeurons the number of neurons of the network.
+		 */
+		virtual void InitializeConnectionState(unsigned int NumberOfSynapses, unsigned int NumberOfNeurons);
+
+   		/*!
+   		 * \brief It applies the weight change function when a presynaptic spike arrives.
+   		 *
+   		 * It applies the weight change function when a presynaptic spike arrives.
+   		 *
+   		 * \param Connection The connection where the spike happened.
+   		 * \param SpikeTime The spike time.
+   		 */
+   		virtual void ApplyPreSynapticSpike(Interconnection * Connection,double SpikeTime);
+
+   		/*!
+		 * \brief It applies the weight change function when a postsynaptic spike arrives.
+		 *
+		 * It applies the weight change function when a postsynaptic spike arrives.
+		 *
+		 * \param Connection The connection where the learning rule happens.
+		 * \param SpikeTime The spike time of the postsynaptic spike.
+		 */
+		virtual void ApplyPostSynapticSpike(Interconnection * Connection,double SpikeTime);
+
+   		/*!
+		 * \brief It applies the weight change function to all the input connections of a neuron when it fires.
+		 *
+		 * It updates the postsynaptic trace of the neuron once and applies the weight change
+		 * of each connection with the presynaptic trace of its source neuron.
+		 *
+		 * \param Connections The input connections where the learning rule happens.
+		 * \param NumberOfConnections The number of connections.
+		 * \param SpikeTime The spike time of the postsynaptic spike.
+		 */
+		virtual void ApplyPostSynapticSpikes(Interconnection ** Connections, unsigned int NumberOfConnections, double SpikeTime);
+
+		/*!
+		 * \brief It prints the learning rule info.
+		 *
+		 * It prints the current learning rule characteristics.
+		 *
+		 * \param out The stream where it prints the information.
+		 *
+		 * \return The stream after the printer.
+		 */
+		virtual ostream & PrintInfo(ostream & out);
+};
+
+#endif /* STDPNEURONWEIGHTCHANGE_H_ */
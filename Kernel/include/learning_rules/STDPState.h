@@ -143,6 +143,21 @@ class STDPState : public ConnectionState{
 		 */
 		virtual void ApplyPostsynapticSpike(unsigned int index);
 
+		/*!
+		 * \brief It implements the behaviour when the target cell fires a spike for consecutive synapses.
+		 *
+		 * It decays the activity of the consecutive synapses [FirstIndex, FirstIndex+NumberOfIndexes)
+		 * until the spike time, applies the postsynaptic spike and returns the presynaptic activity
+		 * of each synapse. It is equivalent to call SetNewUpdateTime, ApplyPostsynapticSpike and
+		 * GetPresynapticActivity for each synapse, but the state is traversed only once.
+		 *
+		 * \param FirstIndex The index of the first synapse.
+		 * \param NumberOfIndexes The number of synapses.
+		 * \param NewTime The spike time.
+		 * \param PresynapticActivity The presynaptic activity of each synapse (output).
+		 */
+		virtual void ApplyPostsynapticSpikes(unsigned int FirstIndex, unsigned int NumberOfIndexes, double NewTime, float * PresynapticActivity);
+
 };
 
 #endif /* NEURONSTATE_H_ */
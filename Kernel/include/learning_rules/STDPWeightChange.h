@@ -63,8 +63,32 @@ class STDPWeightChange: public WithPostSynaptic {
 		 */
 		float MaxChangeLTP;
 
+		/*!
+		 * \brief Presynaptic activity of the connections updated at once (see ApplyPostSynapticSpikes).
+		 */
+		float * PresynapticActivity;
+
+		/*!
+		 * \brief Size of PresynapticActivity
+		 */
+		unsigned int PresynapticActivitySize;
+
 	public:
 
+		/*!
+		 * \brief Default constructor.
+		 *
+		 * It creates a new STDPWeightChange object.
+		 */
+		STDPWeightChange();
+
+		/*!
+		 * \brief Object destructor.
+		 *
+		 * It remove a STDPWeightChange object.
+		 */
+		virtual ~STDPWeightChange();
+
 		virtual void InitializeConnectionState(unsigned int NumberOfSynapses);
 
 		/*!
@@ -136,6 +160,19 @@ class STDPWeightChange: public WithPostSynaptic {
 		 */
 		virtual void ApplyPostSynapticSpike(Interconnection * Connection,double SpikeTime);
 
+   		/*!
+		 * \brief It applies the weight change function to all the input connections of a neuron when it fires.
+		 *
+		 * It applies the weight change function to a set of input connections of the same neuron.
+		 * The states of the connections are updated at once (see STDPState::ApplyPostsynapticSpikes)
+		 * when they are consecutive.
+		 *
+		 * \param Connections The input connections where the learning rule happens.
+		 * \param NumberOfConnections The number of connections.
+		 * \param SpikeTime The spike time of the postsynaptic spike.
+		 */
+		virtual void ApplyPostSynapticSpikes(Interconnection ** Connections, unsigned int NumberOfConnections, double SpikeTime);
+
 		/*!
 		 * \brief It prints the learning rule info.
 		 *
@@ -17,7 +17,7 @@
 #ifndef SINSTATE_H_
 #define SINSTATE_H_
 
-#include "ConnectionState.h"
+#include "AdditiveKernelState.h"
 
 /*!
  * \file SinState.h
@@ -38,11 +38,16 @@
  * that connection. The kernel function is f(t) = exp(-t/tau)*Sin(-t/tau)^exponent, where t represents the time since
  * the last presynaptic spike reached the cell.
  *
+ * The kernel is a linear combination of exp(-x) and exp(-x)*cos(k*x) (k=1..exponent/2), where
+ * x=(t-epoch)/tau. The coefficients of each synapse are the coefficient of exp(-x) (state variable 0)
+ * and the pairs (C_k,S_k) (state variables 2k-1 and 2k) of the rotating terms
+ * exp(-x)*(C_k*cos(k*x)-S_k*sin(k*x)).
+ *
  * \author Jesus Garrido
  * \date October 2011
  */
 
-class SinState : public ConnectionState{
+class SinState : public AdditiveKernelState{
 
 	private:
 		/*!
@@ -77,15 +82,43 @@ class SinState : public ConnectionState{
 		float maxpos;
 
 		/*!
-		 * Tau constant of the learning rule.
+		 * Corrective factor to adjust the maximum to 1.
 		 */
-		float tau;
-		float inv_tau;
+		float factor;
 
+	protected:
 		/*!
-		 * Corrective factor to adjust the maximum to 1.
+		 * \brief It moves the epoch of consecutive synapses.
+		 *
+		 * It decays and rotates the coefficients of the synapses [FirstIndex, FirstIndex+NumberOfIndexes).
+		 *
+		 * \param FirstIndex The index of the first synapse.
+		 * \param NumberOfIndexes The number of synapses.
+		 * \param ElapsedRelative The time elapsed since the former epoch (relative to tau).
 		 */
-		float factor;
+		virtual void MoveEpoch(unsigned int FirstIndex, unsigned int NumberOfIndexes, float ElapsedRelative);
+
+		/*!
+		 * \brief It adds a presynaptic spike to the coefficients of a synapse.
+		 *
+		 * It adds a presynaptic spike to the coefficients of a synapse.
+		 *
+		 * \param index The synapse's index inside the learning rule.
+		 * \param ElapsedRelative The time of the spike since the epoch (relative to tau).
+		 */
+		virtual void AddSpike(unsigned int index, float ElapsedRelative);
+
+		/*!
+		 * \brief It evaluates the kernel of consecutive synapses.
+		 *
+		 * It evaluates the kernel of the synapses [FirstIndex, FirstIndex+NumberOfIndexes).
+		 *
+		 * \param FirstIndex The index of the first synapse.
+		 * \param NumberOfIndexes The number of synapses.
+		 * \param ElapsedRelative The time since the epoch (relative to tau).
+		 * \param Activity The kernel of each synapse (output).
+		 */
+		virtual void EvaluateKernels(unsigned int FirstIndex, unsigned int NumberOfIndexes, float ElapsedRelative, float * Activity);
 
 	public:
 
@@ -107,25 +140,6 @@ class SinState : public ConnectionState{
 		 */
 		virtual ~SinState();
 
-		/*!
-		 * \brief It gets the value of the accumulated presynaptic activity.
-		 *
-		 * It gets the value of the accumulated presynaptic activity.
-		 *
-		 * \return The accumulated presynaptic activity.
-		 */
-		virtual float GetPresynapticActivity(unsigned int index);
-
-		/*!
-		 * \brief It gets the value of the accumulated postsynaptic activity.
-		 *
-		 * It gets the value of the accumulated postsynaptic activity.
-		 *
-		 * \return The accumulated postsynaptic activity.
-		 */
-		virtual float GetPostsynapticActivity(unsigned int index);
-
-
 		/*!
 		 * \brief It gets the number of variables that you can print in this state.
 		 *
@@ -138,39 +152,14 @@ class SinState : public ConnectionState{
 		/*!
 		 * \brief It gets a value to be printed from this state.
 		 *
-		 * It gets a value to be printed from this state.
+		 * It gets a value of the first synapse: the kernel and its exponential and harmonic terms at
+		 * the last update time (not the coefficients referred to the epoch), the last update time,
+		 * the exponent and the maximum position.
 		 *
 		 * \return The value at position-th position in this state.
 		 */
 		virtual double GetPrintableValuesAt(unsigned int position);
 
-
-		/*!
-		 * \brief set new time to spikes.
-		 *
-		 * It set new time to spikes.
-		 *
-		 * \param NewTime new time.
-		 */
-		virtual void SetNewUpdateTime(unsigned int index, double NewTime, bool pre_post);
-
-
-		/*!
-		 * \brief It implements the behaviour when it transmits a spike.
-		 *
-		 * It implements the behaviour when it transmits a spike. It must be implemented
-		 * by any inherited class.
-		 */
-		virtual void ApplyPresynapticSpike(unsigned int index);
-
-		/*!
-		 * \brief It implements the behaviour when the target cell fires a spike.
-		 *
-		 * It implements the behaviour when it the target cell fires a spike. It must be implemented
-		 * by any inherited class.
-		 */
-		virtual void ApplyPostsynapticSpike(unsigned int index);
-
 };
 
 #endif /* NEURONSTATE_H_ */
@@ -0,0 +1,327 @@
+/***************************************************************************
+ *                           ActivityBuffer.h                              *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef ACTIVITYBUFFER_H_
+#define ACTIVITYBUFFER_H_
+
+/*!
+ * \file ActivityBuffer.h
+ *
+ * \author Jesus Garrido
+ * \date July 2013
+ *
+ * This file declares a class which stores the input spikes received by a channel of a cell
+ * in a ring buffer.
+ */
+
+#include <utility>
+
+using namespace std;
+
+class Interconnection;
+
+/*!
+ * Input spike (time and connection).
+ */
+typedef pair<double,Interconnection *> InputActivity;
+
+/*!
+ * Expected maximum input rate (in spikes per second) of a channel. It is used to size the
+ * activity buffers (they grow if more spikes are stored).
+ */
+#define MAXBUFFEREDINPUTRATE 1000.0f
+
+/*!
+ * Minimum capacity of an activity buffer.
+ */
+#define MINACTIVITYBUFFERSIZE 16
+
+/*!
+ * \class ActivityBuffer
+ *
+ * \brief Ring buffer of input spikes.
+ *
+ * This class stores the input spikes of a channel in arrival order in a fixed-capacity ring buffer
+ * (a power of two, so no allocation happens for each spike). The capacity is doubled if the
+ * buffer gets full. The spike times are stored in the time base of the cell state, so the elapsed
+ * time since each spike does not need to be updated.
+ *
+ * \author Jesus Garrido
+ * \date July 2013
+ */
+class ActivityBuffer {
+
+	private:
+
+		/*!
+		 * \brief Stored spikes.
+		 */
+		InputActivity * Elements;
+
+		/*!
+		 * \brief Capacity of the buffer (a power of two).
+		 */
+		unsigned int Capacity;
+
+		/*!
+		 * \brief Position of the first (oldest) spike.
+		 */
+		unsigned int First;
+
+		/*!
+		 * \brief Number of stored spikes.
+		 */
+		unsigned int NumberOfElements;
+
+		/*!
+		 * \brief It changes the capacity of the buffer.
+		 *
+		 * It changes the capacity of the buffer keeping the stored spikes.
+		 *
+		 * \param NewCapacity The new capacity (a power of two not lower than the number of spikes).
+		 */
+		void Resize(unsigned int NewCapacity);
+
+	public:
+
+		/*!
+		 * \brief Iterator over the stored spikes.
+		 *
+		 * It visits the stored spikes from the oldest to the youngest one.
+		 */
+		class Iterator {
+			private:
+				/*!
+				 * \brief Stored spikes.
+				 */
+				const InputActivity * Elements;
+
+				/*!
+				 * \brief Capacity of the buffer minus one.
+				 */
+				unsigned int Mask;
+
+				/*!
+				 * \brief Position of the current spike.
+				 */
+				unsigned int Position;
+
+				/*!
+				 * \brief Number of spikes not visited yet (including the current one).
+				 */
+				unsigned int Remaining;
+
+				/*!
+				 * \brief Current time in the time base of the buffer.
+				 */
+				double CurrentTime;
+
+			public:
+				/*!
+				 * \brief Default class constructor
+				 *
+				 * Default class constructor. It creates a new iterator after the last element.
+				 */
+				Iterator(): Elements(0), Mask(0), Position(0), Remaining(0), CurrentTime(0){
+				}
+
+				/*!
+				 * \brief Class constructor with parameters.
+				 *
+				 * It creates a new iterator pointing to a spike of a buffer.
+				 *
+				 * \param NewElements Stored spikes.
+				 * \param NewMask Capacity of the buffer minus one.
+				 * \param NewPosition Position of the first spike to visit.
+				 * \param NewRemaining Number of spikes to visit.
+				 * \param NewCurrentTime Current time in the time base of the buffer.
+				 */
+				Iterator(const InputActivity * NewElements, unsigned int NewMask, unsigned int NewPosition, unsigned int NewRemaining, double NewCurrentTime):
+					Elements(NewElements), Mask(NewMask), Position(NewPosition), Remaining(NewRemaining), CurrentTime(NewCurrentTime){
+				}
+
+				/*!
+				 * \brief It gets the next element stored in the activity buffer.
+				 *
+				 * It gets the next element stored in the activity buffer.
+				 *
+				 * \return An iterator pointing to the next element in the buffer.
+				 */
+				inline Iterator & operator++(){
+					this->Position = (this->Position+1) & this->Mask;
+					this->Remaining--;
+					return *this;
+				}
+
+				/*!
+				 * \brief It compares if two iterators point the same element.
+				 *
+				 * It compares if two iterators point the same element.
+				 *
+				 * \return True if the two iterators point the same element. False otherwise.
+				 */
+				inline bool operator==(const Iterator & Aux) const{
+					return this->Remaining==Aux.Remaining && (this->Remaining==0 || (this->Elements==Aux.Elements && this->Position==Aux.Position));
+				}
+
+				/*!
+				 * \brief It compares if two iterators point different elements.
+				 *
+				 * It compares if two iterators point different elements.
+				 *
+				 * \return True if the two iterators point different elements. False otherwise.
+				 */
+				inline bool operator!=(const Iterator & Aux) const{
+					return !(*this==Aux);
+				}
+
+				/*!
+				 * \brief It gets the spike time of the current element pointed by the iterator.
+				 *
+				 * It gets the time elapsed since the spike of the current element pointed by the iterator.
+				 *
+				 * \return The time elapsed since the spike.
+				 */
+				inline double GetSpikeTime() const{
+					return this->CurrentTime-this->Elements[this->Position].first;
+				}
+
+				/*!
+				 * \brief It gets the connection of the current element pointed by the iterator.
+				 *
+				 * It gets the connection of the current element pointed by the iterator.
+				 *
+				 * \return The connection of the current element pointed by the iterator.
+				 */
+				inline Interconnection * GetConnection() const{
+					return this->Elements[this->Position].second;
+				}
+		};
+
+		/*!
+		 * \brief Default constructor.
+		 *
+		 * It creates a new empty buffer with the minimum capacity.
+		 */
+		ActivityBuffer();
+
+		/*!
+		 * \brief Copy constructor.
+		 *
+		 * It creates a new buffer with the same spikes.
+		 *
+		 * \param OldBuffer Buffer being copied.
+		 */
+		ActivityBuffer(const ActivityBuffer & OldBuffer);
+
+		/*!
+		 * \brief Assignment operator.
+		 *
+		 * It copies the spikes of other buffer.
+		 *
+		 * \param OldBuffer Buffer being copied.
+		 *
+		 * \return This buffer.
+		 */
+		ActivityBuffer & operator=(const ActivityBuffer & OldBuffer);
+
+		/*!
+		 * \brief Class destructor.
+		 *
+		 * It destroys an object of this class.
+		 */
+		~ActivityBuffer();
+
+		/*!
+		 * \brief It reserves space for a number of spikes.
+		 *
+		 * It increases the capacity (if needed) to store a number of spikes.
+		 *
+		 * \param NumberOfSpikes Number of spikes.
+		 */
+		void Reserve(unsigned int NumberOfSpikes);
+
+		/*!
+		 * \brief It adds a new spike.
+		 *
+		 * It adds a new spike after the youngest one. The capacity is doubled if the buffer is full.
+		 *
+		 * \param SpikeTime Time of the spike in the time base of the buffer.
+		 * \param InputConnection Interconnection in which the spike was received.
+		 */
+		inline void AddActivity(double SpikeTime, Interconnection * InputConnection){
+			if (this->NumberOfElements==this->Capacity){
+				this->Resize(2*this->Capacity);
+			}
+			InputActivity & NewElement = this->Elements[(this->First+this->NumberOfElements) & (this->Capacity-1)];
+			NewElement.first = SpikeTime;
+			NewElement.second = InputConnection;
+			this->NumberOfElements++;
+		}
+
+		/*!
+		 * \brief It removes the old spikes.
+		 *
+		 * It removes the spikes which happened before a time.
+		 *
+		 * \param Time Time in the time base of the buffer.
+		 */
+		inline void RemoveActivityBefore(double Time){
+			while (this->NumberOfElements>0 && this->Elements[this->First].first<Time){
+				this->First = (this->First+1) & (this->Capacity-1);
+				this->NumberOfElements--;
+			}
+		}
+
+		/*!
+		 * \brief It gets the number of stored spikes.
+		 *
+		 * It gets the number of stored spikes.
+		 *
+		 * \return The number of stored spikes.
+		 */
+		inline unsigned int GetNumberOfSpikes() const{
+			return this->NumberOfElements;
+		}
+
+		/*!
+		 * \brief It gets a stored spike.
+		 *
+		 * It gets a stored spike. The first spike is the oldest one.
+		 *
+		 * \param Position Position of the spike (lower than the number of stored spikes).
+		 *
+		 * \return The Position-th stored spike.
+		 */
+		inline const InputActivity & GetActivityAt(unsigned int Position) const{
+			return this->Elements[(this->First+Position) & (this->Capacity-1)];
+		}
+
+		/*!
+		 * \brief It gets an iterator to the oldest spike.
+		 *
+		 * It gets an iterator to the oldest spike.
+		 *
+		 * \param CurrentTime Current time in the time base of the buffer.
+		 *
+		 * \return An iterator pointing to the first element in the buffer.
+		 */
+		inline Iterator Begin(double CurrentTime) const{
+			return Iterator(this->Elements, this->Capacity-1, this->First, this->NumberOfElements, CurrentTime);
+		}
+};
+
+#endif /* ACTIVITYBUFFER_H_ */
@@ -0,0 +1,361 @@
+/***************************************************************************
+ *                           LIFEventDrivenModel.h                         *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef LIFEVENTDRIVENMODEL_H_
+#define LIFEVENTDRIVENMODEL_H_
+
+/*!
+ * \file LIFEventDrivenModel.h
+ *
+ * \author Jesus Garrido
+ * \date June 2013
+ *
+ * This file declares a class which abstracts a Leaky Integrate-And-Fire neuron model with
+ * exponential synaptic currents simulated event-driven without look-up tables.
+ */
+
+#include "./EventDrivenNeuronModel.h"
+
+#include "../spike/EDLUTFileException.h"
+
+#include <string>
+
+using namespace std;
+
+class VectorNeuronState;
+class Interconnection;
+
+/*!
+ * \class LIFEventDrivenModel
+ *
+ * \brief Leaky Integrate-And-Fire Event-Driven neuron model with a membrane potential and
+ * two exponential synaptic currents.
+ *
+ * This class abstracts the behavior of a neuron in an event-driven spiking neural network.
+ * The evolution of the membrane potential between two events is calculated in closed form
+ * (it is a sum of exponentials), so no precalculated tables are needed. The next firing time
+ * is the first threshold crossing of this expression. The potential has at most two critical
+ * points, so it is split in monotonic pieces and the crossing is found in the first increasing
+ * piece which reaches the threshold with a bracketed Newton-Raphson method.
+ *
+ * \author Jesus Garrido
+ * \date June 2013
+ */
+class LIFEventDrivenModel : public EventDrivenNeuronModel {
+	protected:
+		/*!
+		 * \brief Resting potential
+		 */
+		float erest;
+
+		/*!
+		 * \brief Firing threshold
+		 */
+		float vthr;
+
+		/*!
+		 * \brief Reset potential
+		 */
+		float vreset;
+
+		/*!
+		 * \brief Membrane capacitance
+		 */
+		float cm;
+
+		/*!
+		 * \brief Resting conductance
+		 */
+		float grest;
+
+		/*!
+		 * \brief Excitatory current time constant
+		 */
+		float texc;
+
+		/*!
+		 * \brief Inhibitory current time constant
+		 */
+		float tinh;
+
+		/*!
+		 * \brief Refractory period
+		 */
+		float tref;
+
+		/*!
+		 * \brief Bias current
+		 */
+		float ibias;
+
+		/*!
+		 * \brief Membrane time constant (cm/grest)
+		 */
+		double tmem;
+
+		/*!
+		 * \brief Steady-state potential without synaptic currents (erest+ibias/grest)
+		 */
+		double vinf;
+
+		/*!
+		 * \brief Initial length of the unbounded intervals of the threshold crossing search
+		 */
+		double horizon;
+
+		/*!
+		 * \brief It loads the neuron model description.
+		 *
+		 * It loads the neuron type description from the file .cfg.
+		 *
+		 * \param ConfigFile Name of the neuron description file (*.cfg).
+		 *
+		 * \throw EDLUTFileException If something wrong has happened in the file load.
+		 */
+		virtual void LoadNeuronModel(string ConfigFile) throw (EDLUTFileException);
+
+		/*!
+		 * \brief It calculates the exponential terms of the membrane potential.
+		 *
+		 * It calculates the terms of the membrane potential V(t)=vinf+sum(Coeffs[i]*exp(-Rates[i]*t))
+		 * from the current state. The terms are sorted by rate (terms with the same rate are merged
+		 * and null terms are removed).
+		 *
+		 * \param vm Membrane potential.
+		 * \param iexc Excitatory current.
+		 * \param iinh Inhibitory current.
+		 * \param Coeffs The coefficients of the terms (output, 3 elements).
+		 * \param Rates The decay rates of the terms (output, 3 elements).
+		 *
+		 * \return The number of terms.
+		 */
+		int PotentialTerms(double vm, double iexc, double iinh, double * Coeffs, double * Rates);
+
+		/*!
+		 * \brief It evaluates a sum of exponential terms.
+		 *
+		 * It evaluates Constant+sum(Coeffs[i]*exp(-Rates[i]*Time)) (and its derivative).
+		 *
+		 * \param Constant The constant term.
+		 * \param Coeffs The coefficients of the terms.
+		 * \param Rates The decay rates of the terms.
+		 * \param N The number of terms.
+		 * \param Time Time where the sum is evaluated.
+		 * \param Derivative The derivative of the sum (output, it can be 0).
+		 *
+		 * \return The value of the sum.
+		 */
+		static double EvaluateTerms(double Constant, const double * Coeffs, const double * Rates, int N, double Time, double * Derivative);
+
+		/*!
+		 * \brief It finds the root of a sum of exponential terms.
+		 *
+		 * It finds the root of a sum of exponential terms with a bracketed Newton-Raphson method.
+		 *
+		 * \pre The sum has a single root in [a,b] (it changes its sign).
+		 *
+		 * \param Constant The constant term.
+		 * \param Coeffs The coefficients of the terms.
+		 * \param Rates The decay rates of the terms.
+		 * \param N The number of terms.
+		 * \param a Start of the bracket.
+		 * \param b End of the bracket.
+		 *
+		 * \return The root.
+		 */
+		static double FindRoot(double Constant, const double * Coeffs, const double * Rates, int N, double a, double b);
+
+		/*!
+		 * \brief It returns the first threshold crossing of the membrane potential.
+		 *
+		 * It returns the first threshold crossing of the membrane potential.
+		 *
+		 * \param vm Membrane potential.
+		 * \param iexc Excitatory current.
+		 * \param iinh Inhibitory current.
+		 *
+		 * \return The time (relative to the state) of the crossing. NO_SPIKE_PREDICTED if the threshold is not reached.
+		 */
+		double ThresholdCrossing(double vm, double iexc, double iinh);
+
+		/*!
+		 * \brief It updates the neuron state after the evolution of the time.
+		 *
+		 * It updates the neuron state after the evolution of the time. The membrane potential
+		 * is held at the reset potential until the end of the refractory period.
+		 *
+		 * \param index The cell index inside the VectorNeuronState.
+		 * \param State Cell current state.
+		 * \param CurrentTime Current simulation time.
+		 */
+		virtual void UpdateState(int index, VectorNeuronState * State, double CurrentTime);
+
+		/*!
+		 * \brief It abstracts the effect of an input spike in the cell.
+		 *
+		 * It abstracts the effect of an input spike in the cell.
+		 *
+		 * \param index The cell index inside the VectorNeuronState.
+		 * \param State Cell current state.
+		 * \param InputConnection Input connection from which the input spike has got the cell.
+		 */
+		virtual void SynapsisEffect(int index, VectorNeuronState * State, Interconnection * InputConnection);
+
+		/*!
+		 * \brief It returns the next spike time.
+		 *
+		 * It returns the next spike time (after the refractory period if the cell is refractory).
+		 *
+		 * \param index The cell index inside the VectorNeuronState.
+		 * \param State Cell current state.
+		 * \return The next firing spike time (relative to the last update). -1 if no spike is predicted.
+		 */
+		virtual double NextFiringPrediction(int index, VectorNeuronState * State);
+
+		/*!
+		 * \brief It predicts the next spike of a cell after an input.
+		 *
+		 * It predicts the next spike of a cell and stores the prediction in the state.
+		 *
+		 * \param Cell The cell.
+		 *
+		 * \return A new internal spike if someone is predicted. 0 if none is predicted.
+		 */
+		InternalSpike * PredictSpike(Neuron * Cell);
+
+	public:
+		/*!
+		 * \brief Default constructor with parameters.
+		 *
+		 * It generates a new neuron model object without being initialized.
+		 *
+		 * \param NeuronTypeID Neuron type identificator.
+		 * \param NeuronModelID Neuron model identificator.
+		 */
+		LIFEventDrivenModel(string NeuronTypeID, string NeuronModelID);
+
+		/*!
+		 * \brief Class destructor.
+		 *
+		 * It destroys an object of this class.
+		 */
+		virtual ~LIFEventDrivenModel();
+
+		/*!
+		 * \brief It loads the neuron model description and tables (if necessary).
+		 *
+		 * It loads the neuron model description and tables (if necessary).
+		 */
+		virtual void LoadNeuronModel() throw (EDLUTFileException);
+
+		/*!
+		 * \brief It return the neuron state.
+		 *
+		 * It return the neuron state.
+		 *
+		 * \return The object with the neuron state.
+		 */
+		virtual VectorNeuronState * InitializeState();
+
+		/*!
+		 * \brief It generates the first spike (if any) in a cell.
+		 *
+		 * It generates the first spike (if any) in a cell.
+		 *
+		 * \param Cell The cell to check if activity is generated.
+		 *
+		 * \return A new internal spike if someone is predicted. 0 if none is predicted.
+		 */
+		virtual InternalSpike * GenerateInitialActivity(Neuron *  Cell);
+
+		/*!
+		 * \brief It processes a propagated spike (input spike in the cell).
+		 *
+		 * It processes a propagated spike (input spike in the cell).
+		 *
+		 * \note This function doesn't generate the next propagated spike. It must be externally done.
+		 *
+		 * \param InputSpike The spike happened.
+		 *
+		 * \return A new internal spike if someone is predicted. 0 if none is predicted.
+		 */
+		virtual InternalSpike * ProcessInputSpike(PropagatedSpike *  InputSpike);
+
+		/*!
+		 * \brief It processes a propagated spike (input spike in the cell).
+		 *
+		 * It processes a propagated spike (input spike in the cell).
+		 *
+		 * \note This function doesn't generate the next propagated spike. It must be externally done.
+		 *
+		 * \param inter the interconection which propagate the spike
+		 * \param target the neuron which receives the spike
+		 * \param time the time of the spike.
+		 *
+		 * \return A new internal spike if someone is predicted. 0 if none is predicted.
+		 */
+		virtual InternalSpike * ProcessInputSpike(Interconnection * inter, Neuron * target, double time);
+
+		/*!
+		 * \brief It processes an internal spike (generated spike in the cell).
+		 *
+		 * It processes an internal spike (generated spike in the cell).
+		 *
+		 * \note This function doesn't generate the next propagated (output) spike. It must be externally done.
+		 * \note Before generating next spike, you should check if this spike must be discard.
+		 *
+		 * \see DiscardSpike
+		 *
+		 * \param OutputSpike The spike happened.
+		 *
+		 * \return A new internal spike if someone is predicted. 0 if none is predicted.
+		 */
+		virtual InternalSpike * GenerateNextSpike(InternalSpike *  OutputSpike);
+
+		/*!
+		 * \brief Check if the spike must be discard.
+		 *
+		 * Check if the spike must be discard. A spike must be discard if there are discrepancies between
+		 * the next predicted spike and the spike time.
+		 *
+		 * \param OutputSpike The spike happened.
+		 *
+		 * \return True if the spike must be discard. False in otherwise.
+		 */
+		virtual bool DiscardSpike(InternalSpike *  OutputSpike);
+
+		/*!
+		 * \brief It prints the neuron model info.
+		 *
+		 * It prints the current neuron model characteristics.
+		 *
+		 * \param out The stream where it prints the information.
+		 *
+		 * \return The stream after the printer.
+		 */
+		virtual ostream & PrintInfo(ostream & out);
+
+		/*!
+		 * \brief It initialice VectorNeuronState.
+		 *
+		 * It initialice VectorNeuronState.
+		 *
+		 * \param N_neurons cell number inside the VectorNeuronState.
+		 */
+		virtual void InitializeStates(int N_neurons);
+};
+
+#endif /* LIFEVENTDRIVENMODEL_H_ */
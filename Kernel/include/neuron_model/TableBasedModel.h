@@ -104,6 +104,15 @@ class TableBasedModel: public EventDrivenNeuronModel {
 		 */
 		float * TempStateVars;
 
+		/*!
+		 * \brief Single-cell state used to check the activity after the refractory period.
+		 *
+		 * It is created when the states are initialized and reused for every spike, so that
+		 * processing a spike does not allocate a temporary state (like TempStateVars, it is
+		 * shared by all the cells of this model).
+		 */
+		VectorNeuronState * PostFiringState;
+
 /*!
  * \brief Vector where we temporary store initial values
  */
@@ -174,6 +183,19 @@ float * InitValues;
 		 */
 		virtual double NextFiringPrediction(int index, VectorNeuronState * State);
 
+		/*!
+		 * \brief It returns the next spike time after the refractory period.
+		 *
+		 * It evolves a copy of the cell state until the end of the refractory period and
+		 * predicts the next spike from there. The cell state is not modified.
+		 *
+		 * \param index The cell index inside the vector.
+		 * \param State Cell current state.
+		 * \param EndRefractory Time when the refractory period finishes.
+		 * \return The next firing spike time (relative to EndRefractory). -1 if no spike is predicted.
+		 */
+		double PostFiringPrediction(int index, VectorNeuronState * State, double EndRefractory);
+
 	public:
 		/*!
 		 * \brief Default constructor with parameters.
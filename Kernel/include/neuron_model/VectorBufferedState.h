@@ -33,12 +33,10 @@
  */
 
 #include "VectorNeuronState.h"
+#include "ActivityBuffer.h"
 
 #include "../spike/Interconnection.h"
 
-#include <utility>
-#include <list>
-
 using namespace std;
 
 /*!
@@ -47,54 +45,31 @@ using namespace std;
  * \brief Spiking neuron current state with activity buffer.
  *
  * This class abstracts the state of a cell vector and stores the last activity happened.
+ * The input spikes of each channel of each cell are stored in a ring buffer (ActivityBuffer).
  *
  * \author Jesus Garrido
  * \author Francisco Naveros
  * \date February 2012
  */
 
-typedef pair<double,Interconnection *> InputActivity;
-
-/*!
- * Define a node of the activity list
- */
-struct Activity{
-	/*!
-	 * The input activity
-	 */
-	InputActivity Spike;
-
-	/*!
-	 * The next node in the list
-	 */
-	struct Activity * NextNode;
-};
-
-typedef struct Activity ActivityNode;
-
 class VectorBufferedState: public VectorNeuronState {
 
 	private:
 
 		/*!
-		 * \brief First node of the activity list (the oldest one) for all neuron model cell vector.
-		 */
-		ActivityNode *** FirstElement;
-
-		/*!
-		 * \brief Last node of the activity list (the youngest one) for all neuron model cell vector.
+		 * \brief Activity buffers for all neuron model cell vector (NumberOfBuffers per cell).
 		 */
-		ActivityNode *** LastElement;
+		ActivityBuffer * Buffers;
 
 		/*!
-		 * \brief Time in which the activity will be removed for all neuron model cell vector.
+		 * \brief Time in which the activity will be removed for all neuron model cell vector (NumberOfBuffers per cell).
 		 */
-		float ** BufferAmplitude;
+		float * BufferAmplitude;
 
 		/*!
-		 * \brief Number of elements inside for all neuron model cell vector.
+		 * \brief Time base of the activity buffers for all neuron model cell vector (accumulated elapsed time).
 		 */
-		unsigned int ** NumberOfElements;
+		double * BufferTime;
 
 		/*!
 		 * \brief Number of buffers included.
@@ -127,7 +102,8 @@ class VectorBufferedState: public VectorNeuronState {
 		/*!
 		 * \brief It sets the amplitude of the selected buffer for a cell.
 		 *
-		 * It sets the amplitude of the selected buffer for a cell.
+		 * It sets the amplitude of the selected buffer for a cell. The buffer capacity is set to store the
+		 * spikes received in that amplitude at MAXBUFFEREDINPUTRATE.
 		 *
 		 * \param index The cell index inside the vector.
 		 * \param NumBuffer Number of the buffer to be set.
@@ -227,81 +203,10 @@ class VectorBufferedState: public VectorNeuronState {
 void InitializeBufferedStates(int size, float * initialization);
 
 
-		class Iterator {
-			private:
-				// Declaring buffer iterator
-				ActivityNode * element;
-
-			public:
-				/*!
-				 * \brief Default class constructor
-				 *
-				 * Default class constructor. It creates a new null-pointer iterator.
-				 */
-				Iterator();
-
-				/*!
-				 * \brief Copy class constructor
-				 *
-				 * Copy class constructor. It creates a new pointer pointing to the parameter.
-				 *
-				 * \param ElemAux Element to be copied.
-				 */
-				Iterator(const Iterator & ItAux);
-
-				/*!
-				 * \brief Copy class constructor
-				 *
-				 * Copy class constructor. It creates a new pointer pointing to the parameter.
-				 *
-				 * \param ElemAux Element to be copied.
-				 */
-				Iterator(ActivityNode * ElemAux);
-
-				/*!
-				 * \brief It gets the next element stored in the activity buffer.
-				 *
-				 * It gets the next element stored in the activity buffer.
-				 *
-				 * \return An iterator pointing to the next element in the buffer.
-				 */
-				Iterator & operator++();
-
-				/*!
-				 * \brief It compares if two iterators point the same element.
-				 *
-				 * It compares if two iterators point the same element.
-				 *
-				 * \return True if the two iterators point the same element. False otherwise.
-				 */
-				bool operator==(VectorBufferedState::Iterator Aux);
-
-				/*!
-				 * \brief It compares if two iterators point different elements.
-				 *
-				 * It compares if two iterators point different elements.
-				 *
-				 * \return True if the two iterators point different elements. False otherwise.
-				 */
-				bool operator!=(VectorBufferedState::Iterator Aux);
-
-				/*! It gets the spike time of the current element pointed by the iterator.
-				 *
-				 * It gets the spike time of the current element pointed by the iterator.
-				 *
-				 * \return The spike time of the current element pointed by the iterator.
-				 */
-				double GetSpikeTime();
-
-				/*! It gets the connection of the current element pointed by the iterator.
-				 *
-				 * It gets the connection of the current element pointed by the iterator.
-				 *
-				 * \return The connection of the current element pointed by the iterator.
-				 */
-				Interconnection * GetConnection();
-
-		};
+		/*!
+		 * \brief Iterator over the spikes stored in the activity buffer of a cell.
+		 */
+		typedef ActivityBuffer::Iterator Iterator;
 
 		/*!
 		 * \brief It gets the first element stored in the activity buffer for a cell.
@@ -152,6 +152,20 @@ class VectorNeuronState {
 		 */
 		VectorNeuronState(const VectorNeuronState & OldState, int index);
 
+		/*!
+		 * \brief It copies the state of only a cell into this state.
+		 *
+		 * It copies the state of the cell index of OldState into the first cell of this
+		 * state reusing the allocated memory (no new vectors are created).
+		 *
+		 * \pre This state must have been created with the single-cell copy constructor
+		 * from a state with the same number of variables.
+		 *
+		 * \param OldState State being copied.
+		 * \param index cell index.
+		 */
+		void CopyStateFrom(const VectorNeuronState & OldState, int index);
+
 		/*!
 		 * \brief It sets the state variable for a cell in a specified position.
 		 *
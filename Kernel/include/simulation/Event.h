@@ -49,6 +49,11 @@ class Event{
    		 * Time when the event happens.
    		 */
    		double time;
+
+   		/*!
+   		 * Position of the event inside the event queue heap (0 if it isn't in the queue).
+   		 */
+   		unsigned int QueuePosition;
    
    	public:
    		
@@ -92,6 +97,29 @@ class Event{
    		 * \param NewTime The new event time.
    		 */
    		void SetTime (double NewTime);
+
+   		/*!
+   		 * \brief It gets the position of the event in the event queue.
+   		 * 
+   		 * It gets the position of the event in the event queue. This position is used
+   		 * as a handle to cancel or reschedule the event without searching it.
+   		 * 
+   		 * \return The position of the event in the queue heap. 0 if the event isn't in the queue.
+   		 */
+   		inline unsigned int GetQueuePosition() const{
+   			return this->QueuePosition;
+   		}
+
+   		/*!
+   		 * \brief It sets the position of the event in the event queue.
+   		 * 
+   		 * It sets the position of the event in the event queue. Only the event queue should call it.
+   		 * 
+   		 * \param NewPosition The new position of the event in the queue heap.
+   		 */
+   		inline void SetQueuePosition(unsigned int NewPosition){
+   			this->QueuePosition = NewPosition;
+   		}
    	
    		/*!
    		 * \brief It process an event in the simulation.
@@ -35,6 +35,8 @@
 using namespace std;
 
 class Event;
+class InputSpike;
+class Neuron;
 
 /*!
  * \brief Auxiliary struct to take advantage of cache saving event time and pointer in the same array.
@@ -47,6 +49,17 @@ struct EventForQueue {
 	double Time;
  };
 
+/*!
+ * \brief Auxiliary struct to store the external input spikes without creating an event object.
+ *
+ * Auxiliary struct to store the external input spikes without creating an event object.
+ */
+struct InputSpikeForQueue {
+	double Time;
+
+	Neuron * Source;
+ };
+
 /*!
  * \class EventQueue
  *
@@ -54,6 +67,11 @@ struct EventForQueue {
  *
  * This class abstract the behaviour of an sorted by event time queue by using standard arrays.
  *
+ * The external input spikes are not inserted in the heap. They are stored (time and target
+ * neuron) in a separate array sorted by time, and RemoveEvent merges the head of this array
+ * with the head of the heap. The external inputs usually arrive sorted by time, so they are
+ * appended in constant time (and the array is only sorted when a batch arrives out of order).
+ *
  * \author Jesus Garrido
  * \author Richard Carrillo
  * \date August 2008
@@ -75,12 +93,65 @@ class EventQueue {
 		 * Number of elements allocated in the array.
 		 */
 		unsigned int AllocatedSize;
+
+		/*!
+		 * It tells if the position of each event in the heap is stored in the event (handles).
+		 */
+		bool TrackPositions;
+
+		/*!
+		 * External input spikes vector.
+		 */
+		InputSpikeForQueue * Inputs;
+
+		/*!
+		 * Position of the first pending external input spike.
+		 */
+		unsigned int FirstInput;
+
+		/*!
+		 * Position after the last pending external input spike.
+		 */
+		unsigned int LastInput;
+
+		/*!
+		 * Number of external input spikes allocated in the array.
+		 */
+		unsigned int AllocatedInputs;
+
+		/*!
+		 * It tells if the pending external input spikes are sorted by time.
+		 */
+		bool InputsSorted;
+
+		/*!
+		 * The event object which is returned for the external input spikes (it is reused).
+		 */
+		InputSpike * CurrentInput;
    
    		/*!
    		 * It swaps the position of two events.
    		 */
    		void SwapEvents(unsigned int c1, unsigned int c2);
 
+   		/*!
+   		 * \brief It moves an event up in the heap until its parent is earlier.
+   		 *
+   		 * It moves an event up in the heap until its parent is earlier.
+   		 *
+   		 * \param c The current position of the event.
+   		 */
+   		void SiftUp(unsigned int c);
+
+   		/*!
+   		 * \brief It moves an event down in the heap until its children are later.
+   		 *
+   		 * It moves an event down in the heap until its children are later.
+   		 *
+   		 * \param p The current position of the event.
+   		 */
+   		void SiftDown(unsigned int p);
+
 		/*!
    		 * \brief Resize the event queue to a new size keeping the same elements inside.
 		 *
@@ -89,6 +160,13 @@ class EventQueue {
 		 * \param NewSize The new size of the event queue.
    		 */
    		void Resize(unsigned int NewSize);
+
+		/*!
+   		 * \brief It sorts the pending external input spikes by time.
+		 *
+		 * It sorts the pending external input spikes by time.
+   		 */
+   		void SortInputs();
    		
    	public:
    	
@@ -109,11 +187,20 @@ class EventQueue {
    		/*!
    		 * \brief It gets the number of events in the queue.
    		 * 
-   		 * It gets the number of events in the queue.
+   		 * It gets the number of events in the heap (the pending external input spikes are not included).
    		 * 
    		 * \return The number of events in the queue.
    		 */
    		unsigned int Size() const;
+
+   		/*!
+   		 * \brief It gets the number of pending external input spikes.
+   		 * 
+   		 * It gets the number of pending external input spikes.
+   		 * 
+   		 * \return The number of pending external input spikes.
+   		 */
+   		unsigned int InputSize() const;
    		
    		/*!
    		 * \brief It inserts a spike in the event queue.
@@ -123,15 +210,37 @@ class EventQueue {
    		 * \param event The new event to insert in the queue.
    		 */
    		void InsertEvent(Event * event);
+
+   		/*!
+   		 * \brief It inserts an external input spike in the queue.
+   		 * 
+   		 * It stores an external input spike in the sorted input array (no event object is created).
+   		 * 
+   		 * \param Time The time of the input spike.
+   		 * \param Source The neuron which receives the input spike.
+   		 */
+   		void InsertInputSpike(double Time, Neuron * Source);
    		
    		/*!
    		 * \brief It removes the first event in the queue.
    		 * 
    		 * It removes the first event in the queue. It returns the first event sorted by time.
+   		 * If it is an external input spike, the returned event object is owned by the queue
+   		 * and it is valid until the next call.
    		 * 
    		 * \return The first event sorted by time.
    		 */
    		Event * RemoveEvent(void);
+
+   		/*!
+   		 * \brief It releases an event returned by RemoveEvent.
+   		 * 
+   		 * It deletes an event returned by RemoveEvent after processing it (the event objects
+   		 * of the external input spikes are owned by the queue and they are not deleted).
+   		 * 
+   		 * \param event The processed event.
+   		 */
+   		void ReleaseEvent(Event * event);
    		
    		/*!
    		 * \brief It returns the time of the first event.
@@ -146,9 +255,41 @@ class EventQueue {
 		/*!
    		 * \brief It remove all spike events.
    		 * 
-   		 * It remove all spike events.
+   		 * It remove all spike events (including the pending external input spikes).
    		 */
 		void RemoveSpikes(void);
+
+		/*!
+   		 * \brief It enables or disables the event handles.
+   		 * 
+   		 * It enables or disables storing the heap position of each event in the event itself.
+   		 * This is required by CancelEvent and UpdateEventTime, and it is disabled by default
+   		 * to avoid touching the events when the heap is reordered.
+   		 * 
+   		 * \param Track True to store the event positions.
+   		 */
+		void SetPositionTracking(bool Track);
+
+		/*!
+   		 * \brief It cancels an event which is still in the queue.
+   		 * 
+   		 * It removes the event from the queue by using its queue position as a handle.
+   		 * The event object is not deleted.
+   		 * 
+   		 * \param event The event to remove. It must be currently inserted in this queue.
+   		 */
+		void CancelEvent(Event * event);
+
+		/*!
+   		 * \brief It changes the time of an event which is still in the queue.
+   		 * 
+   		 * It changes the time of the event and restores the heap order in place (decrease
+   		 * or increase key) by using its queue position as a handle.
+   		 * 
+   		 * \param event The event to reschedule. It must be currently inserted in this queue.
+   		 * \param NewTime The new event time.
+   		 */
+		void UpdateEventTime(Event * event, double NewTime);
 };
 
 #endif /*EVENTQUEUE_H_*/
@@ -0,0 +1,97 @@
+/***************************************************************************
+ *                           GeneratorInputEvent.h                         *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef GENERATORINPUTEVENT_H_
+#define GENERATORINPUTEVENT_H_
+
+/*!
+ * \file GeneratorInputEvent.h
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ *
+ * This file declares a class which abstracts a simulation event for generating the next time
+ * window of an input spike generator.
+ */
+
+#include <iostream>
+
+#include "./Event.h"
+
+using namespace std;
+
+class Simulation;
+class GeneratorInputSpikeDriver;
+
+/*!
+ * \class GeneratorInputEvent
+ *
+ * \brief Simulation abstract event for generating the next time window of an input generator.
+ *
+ * This class abstract the concept of event for generating the input spikes of the next time
+ * window from a GeneratorInputSpikeDriver.
+ *
+ * \author Jesus Garrido
+ * \date November 2013
+ */
+class GeneratorInputEvent: public Event{
+
+	private:
+
+		/*!
+		 * The input driver which generates the next time window.
+		 */
+		GeneratorInputSpikeDriver * Driver;
+
+	public:
+
+		/*!
+		 * \brief Default constructor.
+		 *
+		 * It creates and initializes a new event object.
+		 */
+		GeneratorInputEvent();
+
+		/*!
+		 * \brief Constructor with parameters.
+		 *
+		 * It creates and initializes a new event with the parameters.
+		 *
+		 * \param NewTime Time of the new event.
+		 * \param NewDriver The input driver which generates the next time window.
+		 */
+		GeneratorInputEvent(double NewTime, GeneratorInputSpikeDriver * NewDriver);
+
+		/*!
+		 * \brief Class destructor.
+		 *
+		 * It destroies an object of this class.
+		 */
+		~GeneratorInputEvent();
+
+		/*!
+		 * \brief It process an event in the simulation.
+		 *
+		 * It generates the input spikes of the next time window (and the event of the following window).
+		 *
+		 * \param CurrentSimulation The simulation object where the event is working.
+		 * \param RealTimeRestriction This variable indicates whether we are making a
+		 * real-time simulation and the watchdog is enabled.
+		 */
+		virtual void ProcessEvent(Simulation * CurrentSimulation, bool RealTimeRestriction);
+};
+
+#endif /*GENERATORINPUTEVENT_H_*/
@@ -63,16 +63,32 @@ class Simulation;
  * 			
  * \note  parameters:
  * 			-info 	It shows the network information.
+ * 			-cancel 	It cancels the outdated spike predictions in the event queue instead of discarding them.
  * 			-sf File_Name	It saves the final weights in file File_Name.
  * 			-wt Save_Weight_Step	It sets the step time between weights saving.
+ * 			-wu Weight_Update_Step	It defers the weight changes of the learning rules and applies them every Weight_Update_Step seconds.
  * 			-st Step_Time(in_seconds) It sets the step time in simulation.
  * 			-log File_Name It saves the activity register in file File_Name.
  *          -logp File_Name It saves all events register in file File_Name.
+ * 			-logb File_Name It saves the activity register in the binary file File_Name.
+ * 			-logpb File_Name It saves all events register in the binary file File_Name.
+ * 			-logperiod Period	It writes the state of each neuron at most once per Period seconds in the previous -logp/-logpb file.
+ * 			-logwindow Start End	It writes the states only between Start and End seconds in the previous -logp/-logpb file (it can be repeated).
+ * 			-logvars Var1[,Var2...]	It writes only the given state variables (printable values) in the previous -logp/-logpb file.
+ * 			-logfiring	It writes the states only when the neurons fire in the previous -logp/-logpb file.
  * 			-if Input_File	It adds the Input_File file in the input sources of the simulation.
+ * 			-ifs Input_File	It adds the Input_File file (sorted by time) in the input sources of the simulation. It is loaded incrementally.
  * 			-of Output_File	It adds the Output_File file in the output targets of the simulation.
+ * 			-ofb Output_File	It adds the Output_File binary file in the output targets of the simulation.
  * 			-ic IPAddress:Port Server|Client	It adds the connection as a server or a client in the specified direction in the input sources of the simulation.
  * 			-oc IPAddress:Port Server|Client	It adds the connection as a server or a client in the specified direction in the output targets of the simulation.
  * 			-ioc IPAddress:Port Server|Client	It adds the connection as a server or a client in the specified direction in the input sources and in the output targets.	 
+ * 			-async	It writes the output and monitoring activity (except the -ioc connections) from background threads.
+ * 			-tcpv2	It uses the version 2 protocol (32-bit spike counts and the slot time in a frame header) in the TCP/IP connections. Server connections fall back to the previous protocol with older clients.
+ * 			-tcpdelta	It uses the version 2 protocol with delta-encoded spikes in the TCP/IP connections.
+ * 			-ism Name Server|Client	It adds the shared memory segment (for processes in the same host) as a server or a client in the input sources.
+ * 			-osm Name Server|Client	It adds the shared memory segment as a server or a client in the output targets.
+ * 			-iosm Name Server|Client	It adds the shared memory segment as a server or a client in the input sources and in the output targets.
  *
  *
  * \author Jesus Garrido
@@ -101,11 +117,21 @@ class Simulation;
  		 * Save weights step time
  		 */
  		double WeightTime;
+
+ 		/*!
+ 		 * Deferred weight changes update step time
+ 		 */
+ 		double WeightUpdateTime;
  		
  		/*!
  		 * Network info?
  		 */
  		bool NetworkInfo;
+
+ 		/*!
+ 		 * Cancel outdated spike predictions?
+ 		 */
+ 		bool CancelPredictions;
  		
  		/*!
  		 * Simulation step time. 
@@ -199,6 +225,16 @@ class Simulation;
  		 * \return The saving weights step time. -1 if the parameter isn't used.
  		 */
  		double GetSaveWeightStepTime();
+
+ 		/*!
+ 		 * \brief It gets the update step time of the deferred weight changes.
+ 		 * 
+ 		 * It gets the update step time of the deferred weight changes. The argument indicator for
+ 		 * this step time is -wu, so it searchs -wu and returns the value as a float.
+ 		 * 
+ 		 * \return The weight update step time. 0 if this option isn't enabled (immediate weight changes). 
+ 		 */
+ 		double GetWeightUpdateStepTime();
  		
  		/*!
  		 * \brief It gets the network configuration file.
@@ -229,6 +265,14 @@ class Simulation;
  		 * \return True if the -info option is enabled. False in other case. 
  		 */ 		
  		bool CheckInfo();
+
+ 		/*!
+ 		 * \brief It checks if the -cancel option is enabled.
+ 		 * It checks if the -cancel option is enabled. The argument indicator for cancelling the outdated
+ 		 * spike predictions is -cancel, so it searchs -cancel.
+ 		 * \return True if the -cancel option is enabled. False in other case. 
+ 		 */ 		
+ 		bool CheckCancelPredictions();
  		
  		/*!
  		 * \brief It gets the simulation step time.
@@ -275,7 +319,7 @@ class Simulation;
  		 * \brief It gets the output drivers.
  		 * 
  		 * It gets the output drivers of the simulation. It has two kinds of output drivers:
- 		 * -of Output_File, -oc IPAddress:Port Server|Client and -ioc IPAddress:Port Server|Client. It adds all the output drivers.
+ 		 * -of Output_File, -ofb Output_File, -oc IPAddress:Port Server|Client, -ioc IPAddress:Port Server|Client, -osm Name Server|Client and -iosm Name Server|Client. It adds all the output drivers.
  		 * 
  		 * \return A vector of the simulation output drivers. 
  		 */ 	
@@ -284,7 +328,8 @@ class Simulation;
  		/*!
  		 * \brief It gets the monitoring drivers.
  		 * 
- 		 * It gets the monitoring drivers of the simulation. -log Monitor_File.
+ 		 * It gets the monitoring drivers of the simulation. -log Monitor_File, -logp Monitor_File,
+ 		 * -logb Monitor_File and -logpb Monitor_File.
  		 * It adds all the monitoring drivers.
  		 * 
  		 * \return A vector of the simulation monitor drivers. 
@@ -47,6 +47,7 @@ class InputSpikeDriver;
 class OutputSpikeDriver;
 class OutputWeightDriver;
 class Spike;
+class InternalSpike;
 class Neuron;
 
 
@@ -120,6 +121,11 @@ class Simulation : public PrintableObject{
 		 * Save weight step
 		 */
 		double SaveWeightStep;
+
+		/*!
+		 * Deferred weight changes update step
+		 */
+		double WeightUpdateStep;
 		
 		/*!
 		 * Current simulation Time
@@ -156,6 +162,22 @@ class Simulation : public PrintableObject{
 		 */
 		long TotalSpikeCounter;
 
+		/*!
+		 * It tells if the outdated spike predictions are cancelled in the queue (true) or
+		 * discarded when they are processed (false).
+		 */
+		bool CancelPredictions;
+
+		/*!
+		 * Number of outdated predicted spikes discarded when they were processed.
+		 */
+		long DiscardedSpikeCounter;
+
+		/*!
+		 * Number of outdated predicted spikes cancelled or rescheduled in the queue.
+		 */
+		long CancelledSpikeCounter;
+
 	protected:
 		
 		/*!
@@ -222,6 +244,26 @@ class Simulation : public PrintableObject{
 		 * \return The saving step time (in seconds). 0 values don't save the weights.
 		 */
 		double GetSaveStep();
+
+		/*!
+		 * \brief It sets the step time of the deferred weight changes.
+		 *
+		 * It sets the step time of the deferred weight changes. The learning rules accumulate
+		 * the weight changes and they are applied to the synapses every step.
+		 *
+		 * \param NewWeightUpdateStep The weight update step time (in seconds). 0 values apply the weight
+		 * changes immediately.
+		 */
+		void SetWeightUpdateStep(double NewWeightUpdateStep);
+
+		/*!
+		 * \brief It gets the step time of the deferred weight changes.
+		 *
+		 * It gets the step time of the deferred weight changes.
+		 *
+		 * \return The weight update step time (in seconds). 0 values apply the weight changes immediately.
+		 */
+		double GetWeightUpdateStep();
 		
 		/*!
 		 * \brief It sets the simulation step time.
@@ -469,12 +511,14 @@ class Simulation : public PrintableObject{
 		/*!
 		 * \brief It writes a neuron potential.
 		 * 
-		 * It writes a neuron potential.
+		 * It writes a neuron potential in the monitors which accept it (each monitor can sample
+		 * the states by period, time windows or firing).
 		 * 
 		 * \param time The event time.
 		 * \param neuron The neuron of the event.
+		 * \param firing True if the event is a spike fired by the neuron.
 		 */
-		void WriteState(float time, Neuron * neuron);
+		void WriteState(float time, Neuron * neuron, bool firing);
 		
 		/*!
 		 * \brief It saves the current synaptic weights in the output weights driver.
@@ -514,6 +558,67 @@ class Simulation : public PrintableObject{
 		 */
 		long GetTotalSpikeCounter();
 
+		/*!
+		 * \brief It sets the spike prediction mode.
+		 *
+		 * It sets whether the outdated spike predictions are cancelled (or rescheduled) in
+		 * the event queue or discarded when they are processed.
+		 * \param Cancel True to cancel outdated predictions. False to discard them (default).
+		 */
+		void SetCancelPredictions(bool Cancel);
+
+		/*!
+		 * \brief It gets the spike prediction mode.
+		 *
+		 * It gets whether the outdated spike predictions are cancelled in the event queue.
+		 * \returns True if the outdated predictions are cancelled. False if they are discarded.
+		 */
+		bool GetCancelPredictions() const;
+
+		/*!
+		 * \brief It increments the discarded spike count.
+		 *
+		 * It increments the number of outdated predicted spikes discarded when processed.
+		 */
+		void IncrementDiscardedSpikeCounter();
+
+		/*!
+		 * \brief Get discarded spike count.
+		 *
+		 * Gets the number of outdated predicted spikes discarded when processed.
+		 * \returns the counter value.
+		 */
+		long GetDiscardedSpikeCounter() const;
+
+		/*!
+		 * \brief Get cancelled spike count.
+		 *
+		 * Gets the number of outdated predicted spikes cancelled or rescheduled in the queue.
+		 * \returns the counter value.
+		 */
+		long GetCancelledSpikeCounter() const;
+
+		/*!
+		 * \brief It schedules a new spike prediction of a neuron.
+		 *
+		 * It schedules the new spike prediction of an event-driven neuron. If the outdated
+		 * predictions are cancelled, the pending prediction of the neuron is rescheduled in place
+		 * (or removed if there is no new prediction). In other case, the new spike is inserted
+		 * and the outdated one will be discarded when it is processed.
+		 * \param neuron The neuron whose firing prediction has changed.
+		 * \param NewSpike The new predicted spike (0 if no spike is predicted). It can be
+		 * deleted by this method.
+		 */
+		void UpdatePredictedSpike(Neuron * neuron, InternalSpike * NewSpike);
+
+		/*!
+		 * \brief It forgets the pending spike predictions of every neuron.
+		 *
+		 * It forgets the pending spike predictions of every neuron. It must be called
+		 * when the spikes have been removed from the event queue.
+		 */
+		void ClearPredictedSpikes();
+
 		/*!
 		 * \brief It gets the input activity.
 		 * 
@@ -0,0 +1,97 @@
+/***************************************************************************
+ *                           StreamInputEvent.h                            *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef STREAMINPUTEVENT_H_
+#define STREAMINPUTEVENT_H_
+
+/*!
+ * \file StreamInputEvent.h
+ *
+ * \author Jesus Garrido
+ * \date July 2013
+ *
+ * This file declares a class which abstracts a simulation event for loading the next time
+ * window of a streamed input file.
+ */
+
+#include <iostream>
+
+#include "./Event.h"
+
+using namespace std;
+
+class Simulation;
+class StreamFileInputSpikeDriver;
+
+/*!
+ * \class StreamInputEvent
+ *
+ * \brief Simulation abstract event for loading the next time window of a streamed input file.
+ *
+ * This class abstract the concept of event for loading the input spikes of the next time
+ * window from a StreamFileInputSpikeDriver.
+ *
+ * \author Jesus Garrido
+ * \date July 2013
+ */
+class StreamInputEvent: public Event{
+
+	private:
+
+		/*!
+		 * The input driver which loads the next time window.
+		 */
+		StreamFileInputSpikeDriver * Driver;
+
+	public:
+
+		/*!
+		 * \brief Default constructor.
+		 *
+		 * It creates and initializes a new event object.
+		 */
+		StreamInputEvent();
+
+		/*!
+		 * \brief Constructor with parameters.
+		 *
+		 * It creates and initializes a new event with the parameters.
+		 *
+		 * \param NewTime Time of the new event.
+		 * \param NewDriver The input driver which loads the next time window.
+		 */
+		StreamInputEvent(double NewTime, StreamFileInputSpikeDriver * NewDriver);
+
+		/*!
+		 * \brief Class destructor.
+		 *
+		 * It destroies an object of this class.
+		 */
+		~StreamInputEvent();
+
+		/*!
+		 * \brief It process an event in the simulation.
+		 *
+		 * It loads the input spikes of the next time window (and the event of the following window).
+		 *
+		 * \param CurrentSimulation The simulation object where the event is working.
+		 * \param RealTimeRestriction This variable indicates whether we are making a
+		 * real-time simulation and the watchdog is enabled.
+		 */
+		virtual void ProcessEvent(Simulation * CurrentSimulation, bool RealTimeRestriction);
+};
+
+#endif /*STREAMINPUTEVENT_H_*/
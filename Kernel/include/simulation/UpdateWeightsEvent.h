@@ -0,0 +1,88 @@
+/***************************************************************************
+ *                           UpdateWeightsEvent.h                          *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef UPDATEWEIGHTSEVENT_H_
+#define UPDATEWEIGHTSEVENT_H_
+
+/*!
+ * \file UpdateWeightsEvent.h
+ *
+ * \author Jesus Garrido
+ * \date July 2013
+ *
+ * This file declares a class which abstracts a simulation event for applying the deferred
+ * weight changes.
+ */
+
+#include <iostream>
+
+#include "./Event.h"
+
+using namespace std;
+
+class Simulation;
+
+/*!
+ * \class UpdateWeightsEvent
+ *
+ * \brief Simulation abstract event for applying the deferred weight changes.
+ *
+ * This class abstract the concept of event for applying the weight changes which the
+ * learning rules have accumulated since the last update.
+ *
+ * \author Jesus Garrido
+ * \date July 2013
+ */
+class UpdateWeightsEvent: public Event{
+
+	public:
+
+		/*!
+		 * \brief Default constructor.
+		 *
+		 * It creates and initializes a new event object.
+		 */
+		UpdateWeightsEvent();
+
+		/*!
+		 * \brief Constructor with parameters.
+		 *
+		 * It creates and initializes a new event with the parameters.
+		 *
+		 * \param NewTime Time of the new event.
+		 */
+		UpdateWeightsEvent(double NewTime);
+
+		/*!
+		 * \brief Class destructor.
+		 *
+		 * It destroies an object of this class.
+		 */
+		~UpdateWeightsEvent();
+
+		/*!
+		 * \brief It process an event in the simulation.
+		 *
+		 * It applies the deferred weight changes and inserts the next update event.
+		 *
+		 * \param CurrentSimulation The simulation object where the event is working.
+		 * \param RealTimeRestriction This variable indicates whether we are making a
+		 * real-time simulation and the watchdog is enabled.
+		 */
+		virtual void ProcessEvent(Simulation * CurrentSimulation, bool RealTimeRestriction);
+};
+
+#endif /*UPDATEWEIGHTSEVENT_H_*/
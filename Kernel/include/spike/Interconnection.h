@@ -27,14 +27,102 @@
  * This file declares a class which abstracts a spiking neural network connection.
  */
 
-#include "../simulation/PrintableObject.h"
- 
+#include <ostream>
+
+using namespace std;
 
 class Neuron;
 class LearningRule;
 class ActivityRegister;
 class ConnectionState;
 
+/*!
+ * \brief Learning fields of a connection.
+ *
+ * They are only allocated for the connections with learning rules. These connections
+ * keep their index and their full precision weights here.
+ */
+struct InterconnectionLearning{
+	/*!
+	 * \brief The learning (or weight change) rule of the connection.
+	 */
+	LearningRule* wchange_withPost;
+
+	/*!
+	 * \brief The learning (or weight change) rule of the connection.
+	 */
+	LearningRule* wchange_withoutPost;
+
+	/*!
+	 * \brief The index of the connection in the network connections.
+	 */
+	long int index;
+
+	/*!
+	 * \brief Index inside the Learning Rule (withPost).
+	 *
+	 * The indexes and weights are stored after the pointers so the structure has no padding.
+	 */
+	int LearningRuleIndex_withPost;
+
+	/*!
+	 * \brief Index inside the Learning Rule (withoutPost).
+	 */
+	int LearningRuleIndex_withoutPost;
+
+	/*!
+	 * \brief The synaptic weight of the connection.
+	 */
+	float weight;
+
+	/*!
+	 * \brief The maximum weight of the connection.
+	 */
+	float maxweight;
+
+	/*!
+	 * \brief Default constructor (without learning rules).
+	 */
+	InterconnectionLearning(): wchange_withPost(0), wchange_withoutPost(0), index(0), LearningRuleIndex_withPost(0), LearningRuleIndex_withoutPost(0), weight(0), maxweight(0){
+	}
+};
+
+/*!
+ * \brief Weight scale shared by the static connections of a group.
+ *
+ * A group holds the connections defined in the same line of the network file. The
+ * static connections store their weights quantized to 16 bits in units of the scale.
+ */
+struct InterconnectionGroup{
+	/*!
+	 * \brief The weight of one quantization step (maxweight/MAX_QUANTIZED_WEIGHT).
+	 */
+	float scale;
+
+	/*!
+	 * \brief The maximum weight of the connections of the group.
+	 */
+	float maxweight;
+
+	/*!
+	 * \brief Default constructor (all the weights are 0).
+	 */
+	InterconnectionGroup(): scale(0), maxweight(0){
+	}
+
+	/*!
+	 * \brief Constructor with parameters.
+	 *
+	 * \param NewMaxWeight The maximum weight of the connections of the group.
+	 */
+	InterconnectionGroup(float NewMaxWeight);
+};
+
+/*!
+ * \brief Highest quantized weight of the static connections.
+ */
+#define MAX_QUANTIZED_WEIGHT 65535
+
 /*!
  * \class Interconnection
  *
@@ -42,12 +130,16 @@ class ConnectionState;
  *
  * This class abstract the behaviour of a spiking neural network connection.
  * It is composed by source and target neuron, an index, a connection delay...
+ * The learning fields are stored apart (InterconnectionLearning) and only the
+ * connections with learning rules have them. The static connections (without learning
+ * fields) store a 16-bit weight which is dequantized with the scale of their group
+ * (InterconnectionGroup) when the spikes are propagated.
  *
  * \author Jesus Garrido
  * \author Richard Carrillo
  * \date August 2008
  */
-class Interconnection : public PrintableObject {
+class Interconnection {
 	
 	private:
 		/*!
@@ -61,49 +153,34 @@ class Interconnection : public PrintableObject {
 		Neuron* target;
 		
 		/*!
-		 * \brief The index of the connection in the network connections.
-		 */
-		long int index;
-		
-		/*!
-		 * \brief The delay of the spike propagation.
-		 */
-		double delay;
-		
-		/*!
-		 * \brief The connection type (excitatory, inhibitory, electrical coupling...)
+		 * \brief The learning fields of the connection. 0 if the connection hasn't learning rules.
 		 */
-		int type;
-		
+		InterconnectionLearning * learning;
+
 		/*!
-		 * \brief The synaptic weight of the connection.
+		 * \brief The weight scale of the connection group (only used by static connections).
 		 */
-		float weight;
-		
+		const InterconnectionGroup * group;
+
 		/*!
-		 * \brief The maximum weight of the connection.
+		 * \brief The delay of the spike propagation.
 		 */
-		float maxweight;
+		float delay;
 		
 		/*!
-		 * \brief The learning (or weight change) rule of the connection.
+		 * \brief The connection type (excitatory, inhibitory, electrical coupling...)
 		 */
-		LearningRule* wchange_withPost;
+		short int type;
 		
 		/*!
-		 * \brief Index inside the Learning Rule.
+		 * \brief The quantized synaptic weight of the static connection (in units of the group scale).
 		 */
-		int LearningRuleIndex_withPost;
+		unsigned short int qweight;
 
 		/*!
-		 * \brief The learning (or weight change) rule of the connection.
+		 * \brief Group of the connections without group (all their weights are 0).
 		 */
-		LearningRule* wchange_withoutPost;
-		
-		/*!
-		 * \brief Index inside the Learning Rule.
-		 */
-		int LearningRuleIndex_withoutPost;
+		static const InterconnectionGroup NoGroup;
 		
 	public:
 	
@@ -119,17 +196,15 @@ class Interconnection : public PrintableObject {
 		 * 
 		 * It creates and initializes a new interconnection object with the parameters.
 		 * 
-		 * \param NewIndex The interconnection index in the network configuration file.
 		 * \param NewSource Source neuron of this connection.
 		 * \param NewTarget Target neuron of this connection.
 		 * \param NewDelay Delay of this connection.
 		 * \param NewType Connection type (excitatory, inhibitory, electrical coupling...) of this connection. The meaning of a value is depend on the neuron model.
 		 * \param NewWeight Synaptic weight of this connection.
-		 * \param NewMaxWeight Maximum synaptic weight of this connection.
-		 * \param NewWeightChange Learning (or weight change) rule associated to this connection.
-		 * \param NewLearningRuleIndex Current learning rule index.
+		 * \param NewGroup Connection group (weight scale and maximum weight of the static connections).
+		 * \param NewLearning Learning fields (rules, index and maximum weight) of this connection. 0 if it hasn't learning rules.
 		 */
-		Interconnection(int NewIndex, Neuron * NewSource, Neuron * NewTarget, float NewDelay, int NewType, float NewWeight, float NewMaxWeight, LearningRule* NewWeightChange_withPost, unsigned int NewLearningRuleIndex_withPost, LearningRule* NewWeightChange_withoutPost, unsigned int NewLearningRuleIndex_withoutPost);
+		Interconnection(Neuron * NewSource, Neuron * NewTarget, float NewDelay, int NewType, float NewWeight, const InterconnectionGroup * NewGroup, InterconnectionLearning * NewLearning);
 		
 		/*!
 		 * \brief Object destructor.
@@ -141,16 +216,18 @@ class Interconnection : public PrintableObject {
 		/*!
 		 * \brief It gets the connection index.
 		 * 
-		 * It gets the connection index in the network connections.
+		 * It gets the connection index in the network connections. Only the connections
+		 * with learning fields store their index.
 		 * 
-		 * \return The connection index.
+		 * \return The connection index (-1 if the connection has not learning fields).
 		 */
 		long int GetIndex() const;
 		
 		/*!
 		 * \brief It sets the connection index.
 		 * 
-		 * It sets the connection index in the network connections.
+		 * It sets the connection index in the network connections. It does nothing if the connection
+		 * has not learning fields.
 		 * 
 		 * \param NewIndex The new index of the connection.
 		 */
@@ -249,19 +326,28 @@ class Interconnection : public PrintableObject {
 		 */
 		//float GetWeight() const;
 		inline float GetWeight() const{
-			return weight;
+			if (this->learning!=0){
+				return this->learning->weight;
+			} else {
+				return this->qweight*this->group->scale;
+			}
 		}
 		
 		/*!
 		 * \brief It sets the synaptic weight.
 		 * 
-		 * It sets the synaptic weight of the connection.
+		 * It sets the synaptic weight of the connection. The weight of a static connection is
+		 * rounded to the nearest step of its group scale and limited to [0, maximum weight].
 		 * 
 		 * \param NewWeight The new synaptic weight of the connection.
 		 */
 		//void SetWeight(float NewWeight);
 		inline void SetWeight(float NewWeight){
-			this->weight = NewWeight;
+			if (this->learning!=0){
+				this->learning->weight = NewWeight;
+			} else {
+				this->qweight = QuantizeWeight(NewWeight);
+			}
 		}
 
 		/*!
@@ -273,36 +359,111 @@ class Interconnection : public PrintableObject {
 		 */
 		//void IncrementWeight(float Increment);
 		inline void IncrementWeight(float Increment){
-			this->weight += Increment;
-			if(this->weight > this->GetMaxWeight()){
-				this->weight = this->GetMaxWeight();
-			}else if(this->weight < 0.0f){
-				this->weight = 0.0f;
+			if (this->learning!=0){
+				this->learning->weight += Increment;
+				if(this->learning->weight > this->learning->maxweight){
+					this->learning->weight = this->learning->maxweight;
+				}else if(this->learning->weight < 0.0f){
+					this->learning->weight = 0.0f;
+				}
+			} else {
+				this->qweight = QuantizeWeight(this->GetWeight() + Increment);
+			}
+		}
+
+		/*!
+		 * \brief It quantizes a weight with the group scale.
+		 * 
+		 * It rounds a weight to the nearest step of the group scale and limits it to
+		 * [0, MAX_QUANTIZED_WEIGHT] steps.
+		 * 
+		 * \param Weight The synaptic weight.
+		 * 
+		 * \return The quantized weight. 0 if the group scale is 0.
+		 */
+		inline unsigned short int QuantizeWeight(float Weight) const{
+			if (Weight<=0.0f || this->group->scale<=0.0f){
+				return 0;
+			}
+
+			float Steps = Weight/this->group->scale + 0.5f;
+			if (Steps>=MAX_QUANTIZED_WEIGHT){
+				return MAX_QUANTIZED_WEIGHT;
+			} else {
+				return (unsigned short int) Steps;
 			}
 		}
 		
 		/*!
 		 * \brief It gets the maximum synaptic weight.
 		 * 
-		 * It gets the maximum synaptic weight of the connection.
+		 * It gets the maximum synaptic weight of the connection. The static connections
+		 * share the maximum weight of their group.
 		 * 
 		 * \return The maximum synaptic weight.
 		 */
 		//float GetMaxWeight() const;
 		inline float GetMaxWeight() const{
-			return this->maxweight;
+			if (this->learning!=0){
+				return this->learning->maxweight;
+			} else {
+				return this->group->maxweight;
+			}
 		}
 
 		
 		/*!
 		 * \brief It sets the maximum synaptic weight.
 		 * 
-		 * It sets the maximum synaptic weight of the connection.
+		 * It sets the maximum synaptic weight of the connection. It does nothing if the connection
+		 * has not learning fields (the maximum weight of the static connections is set by their group).
 		 * 
 		 * \param NewMaxWeight The new maximum synaptic weight of the connection.
 		 */
 		void SetMaxWeight(float NewMaxWeight);
+
+		/*!
+		 * \brief It gets the connection group.
+		 * 
+		 * It gets the connection group (weight scale of the static connections).
+		 * 
+		 * \return The connection group.
+		 */
+		inline const InterconnectionGroup * GetGroup() const{
+			return this->group;
+		}
+
+		/*!
+		 * \brief It sets the connection group.
+		 * 
+		 * It sets the connection group. It is not owned by the connection. The weight of a static
+		 * connection must be set again after changing its group.
+		 * 
+		 * \param NewGroup The connection group. 0 if the connection hasn't group (all its static weights are 0).
+		 */
+		void SetGroup(const InterconnectionGroup * NewGroup);
 		
+		/*!
+		 * \brief It gets the learning fields of this connection.
+		 * 
+		 * It gets the learning fields of this connection.
+		 * 
+		 * \return The learning fields of the connection. 0 if the connection hasn't learning rules.
+		 */
+		inline InterconnectionLearning * GetLearning() const{
+			return this->learning;
+		}
+
+		/*!
+		 * \brief It sets the learning fields of this connection.
+		 * 
+		 * It sets the learning fields of this connection. They are not owned by the connection.
+		 * The index and the weights of the connection must be set after the learning fields.
+		 * 
+		 * \param NewLearning The learning fields of the connection. 0 if the connection hasn't learning rules.
+		 */
+		void SetLearning(InterconnectionLearning * NewLearning);
+
 		/*!
 		 * \brief It gets the learning rule of this connection.
 		 * 
@@ -312,14 +473,15 @@ class Interconnection : public PrintableObject {
 		 */
 		//LearningRule * GetWeightChange() const;
 		inline LearningRule * GetWeightChange_withPost() const{
-			return this->wchange_withPost;
+			return (this->learning!=0)?this->learning->wchange_withPost:0;
 		}
 		
 		/*!
 		 * \brief It sets the learning rule of this connection.
 		 * 
-		 * It sets the learning rule of the connection.
-		 * 
+		 * It sets the learning rule of the connection. It does nothing if the connection
+		 * has not learning fields (see SetLearning).
+		 *
 		 * \param NewWeightChange The new learning rule of the connection. 0 if the connection hasn't learning rule.
 		 */
 		void SetWeightChange_withPost(LearningRule * NewWeightChange_withPost);
@@ -333,14 +495,15 @@ class Interconnection : public PrintableObject {
 		 */
 		//LearningRule * GetWeightChange() const;
 		inline LearningRule * GetWeightChange_withoutPost() const{
-			return this->wchange_withoutPost;
+			return (this->learning!=0)?this->learning->wchange_withoutPost:0;
 		}
 		
 		/*!
 		 * \brief It sets the learning rule of this connection.
 		 * 
-		 * It sets the learning rule of the connection.
-		 * 
+		 * It sets the learning rule of the connection. It does nothing if the connection
+		 * has not learning fields (see SetLearning).
+		 *
 		 * \param NewWeightChange The new learning rule of the connection. 0 if the connection hasn't learning rule.
 		 */
 		void SetWeightChange_withoutPost(LearningRule * NewWeightChange_withoutPost);
@@ -350,11 +513,11 @@ class Interconnection : public PrintableObject {
 		 * 
 		 * It gets the connection learning rule index in the network connections.
 		 * 
-		 * \return The connection learning rule index.
+		 * \return The connection learning rule index (-1 if the connection has not learning fields).
 		 */
 		//int GetLearningRuleIndex() const;
 		inline int GetLearningRuleIndex_withPost() const{
-			return this->LearningRuleIndex_withPost;
+			return (this->learning!=0)?this->learning->LearningRuleIndex_withPost:-1;
 		}
 
 		/*!
@@ -362,11 +525,11 @@ class Interconnection : public PrintableObject {
 		 * 
 		 * It gets the connection learning rule index in the network connections.
 		 * 
-		 * \return The connection learning rule index.
+		 * \return The connection learning rule index (-1 if the connection has not learning fields).
 		 */
 		//int GetLearningRuleIndex() const;
 		inline int GetLearningRuleIndex_withoutPost() const{
-			return this->LearningRuleIndex_withoutPost;
+			return (this->learning!=0)?this->learning->LearningRuleIndex_withoutPost:-1;
 		}
 
 
@@ -375,8 +538,9 @@ class Interconnection : public PrintableObject {
 		/*!
 		 * \brief It sets the connection learning rule index.
 		 * 
-		 * It sets the connection learning rule index in the network connections.
-		 * 
+		 * It sets the connection learning rule index in the network connections. It does nothing
+		 * if the connection has not learning fields (see SetLearning).
+		 *
 		 * \param NewIndex The new learning rule index of the connection.
 		 */
 		void SetLearningRuleIndex_withPost(int NewIndex);
@@ -384,8 +548,9 @@ class Interconnection : public PrintableObject {
 		/*!
 		 * \brief It sets the connection learning rule index.
 		 * 
-		 * It sets the connection learning rule index in the network connections.
-		 * 
+		 * It sets the connection learning rule index in the network connections. It does nothing
+		 * if the connection has not learning fields (see SetLearning).
+		 *
 		 * \param NewIndex The new learning rule index of the connection.
 		 */
 		void SetLearningRuleIndex_withoutPost(int NewIndex);
@@ -446,7 +611,7 @@ class Interconnection : public PrintableObject {
 		 *
 		 * \return The stream after the printer.
 		 */
-		virtual ostream & PrintInfo(ostream & out);
+		ostream & PrintInfo(ostream & out);
 };
   
 #endif /*INTERCONNECTION_H_*/
@@ -49,6 +49,18 @@ class Simulation;
  * \date November 2008
  */
 class InternalSpike: public Spike{
+
+	protected:
+
+   		/*!
+   		 * \brief It applies the postsynaptic learning of the input connections of the source neuron.
+   		 * 
+   		 * It applies the postsynaptic learning of the input connections of the source neuron (one
+   		 * call for each group of connections with the same learning rule).
+   		 * 
+   		 * \param neuron The neuron which fires the spike.
+   		 */
+   		void ApplyPostSynapticLearning(Neuron * neuron);
 	
 	public:
    		
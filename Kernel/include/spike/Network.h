@@ -45,9 +45,12 @@
 #include "../simulation/PrintableObject.h"
 
 class Interconnection;
+struct InterconnectionLearning;
+struct InterconnectionGroup;
 class NeuronModel;
 class Neuron;
 class LearningRule;
+class DeferredWeightChanges;
 class EventQueue;
 
 /*!
@@ -75,6 +78,26 @@ class Network : public PrintableObject{
    		 * \brief Number of interconnections.
    		 */
    		long int ninters;
+
+		/*!
+		 * \brief Learning fields of the interconnections with learning rules.
+		 */
+		InterconnectionLearning * learnings;
+
+		/*!
+		 * \brief Number of interconnections with learning rules.
+		 */
+		long int nlearnings;
+
+		/*!
+		 * \brief Weight scales of the interconnection groups (one group for each line of connections in the network file).
+		 */
+		InterconnectionGroup * groups;
+
+		/*!
+		 * \brief Number of interconnection groups.
+		 */
+		long int ngroups;
    
    		/*!
    		 * \brief Neuron types.
@@ -131,12 +154,19 @@ class Network : public PrintableObject{
    		 * \brief Initial connection ordenation.
    		 */
    		Interconnection ** wordination;
+
+   		/*!
+   		 * \brief Deferred weight changes. 0 if the learning rules change the weights immediately.
+   		 */
+   		DeferredWeightChanges * DeferredWeights;
    		
    		/*!
    		 * \brief It sorts the connections by the source neuron and the delay and add the output connections
    		 * 
    		 * It sorts the connections by the source neuron (from the lowest to the highest index) and by the connection
-   		 * delay. It adds the connections to the output connections of the source neuron.
+   		 * delay. It adds the connections to the output connections of the source neuron and keeps the connections
+   		 * in the initial (network file) order in wordination field. This ordination is the ordination needed for
+   		 * the weight load.
    		 * 
    		 * \post The connections will be sorted by source neuron and delay.
    		 */
@@ -153,15 +183,6 @@ class Network : public PrintableObject{
 
 		//void FindInConnections(int N_LearningRule, int * typeLearningRule);
    		
-   		/*!
-   		 * \brief It sorts the connections by the connection index.
-   		 * 
-   		 * It sorts the connections by the connection index. This ordination
-   		 * is the ordenation needed for the weight load. The ordination will be
-   		 * in wordination field.
-   		 */
-   		void SetWeightOrdination();
-   		
    		/*!
   		 * \brief It prints information about load tables.
   		 * 
@@ -184,7 +205,7 @@ class Network : public PrintableObject{
    		 * It checks if the neuron type has been loaded, and in other case,
    		 * it loads the characteristics from the neuron type files.
    		 * 
-   		 * \param ident_type Type of the neuron model. At this moment, only "SRMTimeDriven" and "TableBasedModel" are implemented.
+   		 * \param ident_type Type of the neuron model. At this moment, only "SRMTimeDriven", "TableBasedModel" and "LIFEventDrivenModel" are implemented.
    		 * \param neutype The name of the neuron type to load.
 		 * \param ni Index of the neuron type
    		 * 
@@ -231,7 +252,7 @@ class Network : public PrintableObject{
    		 * 
    		 * \pre The network connections are sorted by the index in the field wordenation.
    		 * 
-   		 * \see SetWeightOrdenation()
+   		 * \see FindOutConnections()
    		 * 
    		 * \throw EDLUTFileException If the weights file hasn't been able to be correctly readed.
    		 */
@@ -364,6 +385,34 @@ class Network : public PrintableObject{
 		 */
 		int GetLearningRuleNumber() const;
 
+		/*!
+		 * \brief It enables or disables the deferred weight changes.
+		 *
+		 * It enables or disables the deferred weight changes. When they are enabled, the learning
+		 * rules store the changed weights and they are applied to the connections by
+		 * ApplyDeferredWeights (the pending changes are applied before disabling them).
+		 *
+		 * \param Deferred True to defer the weight changes.
+		 */
+		void SetDeferredWeightChanges(bool Deferred);
+
+		/*!
+		 * \brief It checks if the weight changes are deferred.
+		 *
+		 * It checks if the weight changes are deferred.
+		 *
+		 * \return True if the weight changes are deferred.
+		 */
+		bool IsDeferredWeightChanges() const;
+
+		/*!
+		 * \brief It applies the deferred weight changes.
+		 *
+		 * It sets the weights changed since the last update in the connections. It does nothing if
+		 * the weight changes are not deferred.
+		 */
+		void ApplyDeferredWeights();
+
    		/*!
    		 * \brief It saves the weights in a file.
    		 * 
@@ -391,12 +440,13 @@ class Network : public PrintableObject{
 /*!
  * \brief It sorts two connections by the source neuron and the delay.
  * 
- * This functions sorts two connections by the source neuron and the delay.
+ * This functions sorts two connections by the source neuron and the delay. The connections with
+ * the same source neuron and delay keep their initial order.
  * 
- * \param e1 The firs connection.
- * \param e2 The second connection.
+ * \param e1 The pointer to the first connection.
+ * \param e2 The pointer to the second connection.
  * 
- * \return 0 if the two connections have the same index of the source neuron and the same delay. <0 if
+ * \return 0 if the two pointers point to the same connection. <0 if
  * the second connection have a higher index of the source neuron or the same index and lower delay.
  * >0 if the first connection have a higher index of the source neuron or the same index and lower delay.
  */
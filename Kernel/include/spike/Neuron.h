@@ -125,6 +125,11 @@ class Neuron : public PrintableObject {
    		 * It tells if neuron is output neuron
    		 */
    		bool isOutput;
+
+   		/*!
+   		 * Pending spike prediction of this neuron which is still in the event queue (0 if none).
+   		 */
+   		InternalSpike * PredictedSpike;
    		
    	public:
    		/*!
@@ -230,6 +235,18 @@ class Neuron : public PrintableObject {
    		 */
    		Interconnection * GetInputConnectionWithPostSynapticLearningAt(unsigned int index) const;
 
+		/*!
+   		 * \brief It gets the input connections which have associated postsynaptic learning.
+   		 * 
+   		 * It returns the input connections which have associated postsynaptic learning. The
+   		 * connections with the same learning rule are consecutive.
+   		 * 
+   		 * \return The input connections with postsynaptic learning.
+   		 */
+		inline Interconnection ** GetInputConnectionsWithPostSynapticLearning() const{
+			return this->InputLearningConnectionsWithPostSynapticLearning;
+		}
+
 		/*!
    		 * \brief It gets the input connection at an specified index.
    		 * 
@@ -239,6 +256,18 @@ class Neuron : public PrintableObject {
    		 * \return The input connection of index index.
    		 */
    		Interconnection * GetInputConnectionWithoutPostSynapticLearningAt(unsigned int index) const;
+
+		/*!
+   		 * \brief It gets the input connections which have associated learning without postsynaptic learning.
+   		 * 
+   		 * It returns the input connections which have associated learning without postsynaptic learning.
+   		 * The connections with the same learning rule are consecutive.
+   		 * 
+   		 * \return The input connections with learning without postsynaptic learning.
+   		 */
+		inline Interconnection ** GetInputConnectionsWithoutPostSynapticLearning() const{
+			return this->InputLearningConnectionsWithoutPostSynapticLearning;
+		}
    		
    		/*!
    		 * \brief It sets the input connections which have associated learning.
@@ -376,6 +405,29 @@ class Neuron : public PrintableObject {
 			return index_VectorNeuronState;
 		}
 
+		/*!
+		 * \brief It gets the pending spike prediction of the neuron.
+		 * 
+		 * It returns the predicted spike of this neuron which is still in the event queue.
+		 * It is only tracked when the predicted spikes are cancelled instead of discarded.
+		 * 
+		 * \return The pending predicted spike. 0 if there isn't any.
+		 */
+		inline InternalSpike * GetPredictedSpike() const{
+			return this->PredictedSpike;
+		}
+
+		/*!
+		 * \brief It sets the pending spike prediction of the neuron.
+		 * 
+		 * It sets the predicted spike of this neuron which is still in the event queue.
+		 * 
+		 * \param NewSpike The new pending predicted spike (0 if there isn't any).
+		 */
+		inline void SetPredictedSpike(InternalSpike * NewSpike){
+			this->PredictedSpike = NewSpike;
+		}
+
 
 };
   
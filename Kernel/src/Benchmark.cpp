@@ -0,0 +1,381 @@
+/***************************************************************************
+ *                           Benchmark.cpp                                 *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Francisco Naveros                    *
+ * email                : fnaveros@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <time.h>
+#include <math.h>
+
+#include <iostream>
+
+#include "../include/simulation/ExponentialTable.h"
+
+#include "../include/spike/Interconnection.h"
+
+#include "../include/learning_rules/LearningRule.h"
+#include "../include/learning_rules/AdditiveKernelChange.h"
+#include "../include/learning_rules/ExpWeightChange.h"
+#include "../include/learning_rules/SinWeightChange.h"
+#include "../include/learning_rules/STDPWeightChange.h"
+#include "../include/learning_rules/STDPLSWeightChange.h"
+
+using namespace std;
+
+/*!
+ *
+ *
+ * \note This software measures the cost and the accuracy of the kernel functions which are
+ * evaluated for every synapse, and the cost of each learning rule over a synthetic population
+ * of synapses (without loading any network).
+ * Usage: benchmark [number_of_evaluations]
+ */
+
+/*!
+ * \brief Former exponential look-up table (one 4M-element table per learning rule).
+ *
+ * It is only kept to compare the current implementation with it.
+ */
+class FormerExponentialTable{
+	public:
+		float Min, Max, aux;
+		int TableSize;
+		float * LookUpTable;
+
+		FormerExponentialTable(float minimum, float maximum, int size): Min(minimum), Max(maximum), TableSize(size){
+			LookUpTable=new float[TableSize];
+			for(int i=0; i<TableSize; i++){
+				float exponent = Min + ((Max-Min)*i)/(TableSize-1);
+				LookUpTable[i]=exp(exponent);
+			}
+			aux=1.0f/(Max-Min);
+		}
+
+		~FormerExponentialTable(){
+			delete [] LookUpTable;
+		}
+
+		float GetResult(float value){
+			if(value>=Min && value<=Max){
+				int position=((value-Min)*aux)*(TableSize-1);
+				return LookUpTable[position];
+			}else{
+				if(value<(-20)){
+					return 0.0f;
+				}else{
+					return exp(value);
+				}
+			}
+		}
+};
+
+/*!
+ * \brief It prints the accuracy of the exponential approximations.
+ *
+ * It compares the approximations with the double precision exponential in [-20,0].
+ *
+ * \param Former The former look-up table.
+ * \param NumberOfPoints Number of evaluated exponents.
+ */
+void ExponentialAccuracy(FormerExponentialTable * Former, int NumberOfPoints){
+	double MaxRelFormer = 0, MaxRelCurrent = 0, MaxRelFloat = 0;
+	double SumRelFormer = 0, SumRelCurrent = 0;
+
+	for (int i=0; i<NumberOfPoints; i++){
+		float value = -20.0f*rand()/(float)RAND_MAX;
+		double exact = exp((double)value);
+
+		double RelFormer = fabs(Former->GetResult(value)-exact)/exact;
+		double RelCurrent = fabs(ExponentialTable::GetResult(value)-exact)/exact;
+		double RelFloat = fabs(expf(value)-exact)/exact;
+
+		SumRelFormer += RelFormer;
+		SumRelCurrent += RelCurrent;
+		if (RelFormer>MaxRelFormer) MaxRelFormer = RelFormer;
+		if (RelCurrent>MaxRelCurrent) MaxRelCurrent = RelCurrent;
+		if (RelFloat>MaxRelFloat) MaxRelFloat = RelFloat;
+	}
+
+	cout << "Exponential accuracy (relative error in [-20,0], " << NumberOfPoints << " points)" << endl;
+	cout << "\tFormer table (" << Former->TableSize*sizeof(float) << " bytes per object):\tmax " << MaxRelFormer << "\tmean " << SumRelFormer/NumberOfPoints << endl;
+	cout << "\tShared table (" << EXPTABLESIZE*sizeof(float)+32*sizeof(float) << " bytes per process):\tmax " << MaxRelCurrent << "\tmean " << SumRelCurrent/NumberOfPoints << endl;
+	cout << "\tfloat expf:\tmax " << MaxRelFloat << endl;
+}
+
+/*!
+ * \brief It sums the results of an evaluation (so that it is not optimized away).
+ *
+ * It sums the results of an evaluation (so that it is not optimized away).
+ *
+ * \param Results The results.
+ * \param NumberOfResults Number of results.
+ *
+ * \return The sum of the results.
+ */
+float Checksum(float * Results, int NumberOfResults){
+	float sum = 0;
+	for (int i=0; i<NumberOfResults; i++){
+		sum += Results[i];
+	}
+	return sum;
+}
+
+/*!
+ * \brief It prints the cost of the exponential approximations.
+ *
+ * It measures the time per evaluation over a set of exponents (like the decays of the
+ * synaptic traces in a learning rule).
+ *
+ * \param Formers The former look-up tables (one per learning rule).
+ * \param NumberOfTables Number of former look-up tables.
+ * \param Values Exponents.
+ * \param NumberOfValues Number of exponents.
+ * \param Repetitions Number of evaluations of each exponent.
+ * \param Label Description of the exponents.
+ */
+void ExponentialCost(FormerExponentialTable ** Formers, int NumberOfTables, float * Values, int NumberOfValues, int Repetitions, const char * Label){
+	clock_t startt, endt;
+	float * Results = new float [NumberOfValues];
+	double Evaluations = (double) NumberOfValues*Repetitions;
+
+	startt = clock();
+	for (int r=0; r<Repetitions; r++){
+		for (int i=0; i<NumberOfValues; i++){
+			Results[i] = exp(Values[i]);
+		}
+	}
+	endt = clock();
+	double TimeExp = (endt-startt)/(double)CLOCKS_PER_SEC/Evaluations*1e9;
+	float check = Checksum(Results, NumberOfValues);
+
+	startt = clock();
+	for (int r=0; r<Repetitions; r++){
+		for (int i=0; i<NumberOfValues; i++){
+			// Each learning rule used its own table
+			Results[i] = Formers[i%NumberOfTables]->GetResult(Values[i]);
+		}
+	}
+	endt = clock();
+	double TimeFormer = (endt-startt)/(double)CLOCKS_PER_SEC/Evaluations*1e9;
+	check += Checksum(Results, NumberOfValues);
+
+	startt = clock();
+	for (int r=0; r<Repetitions; r++){
+		for (int i=0; i<NumberOfValues; i++){
+			Results[i] = ExponentialTable::GetResult(Values[i]);
+		}
+	}
+	endt = clock();
+	double TimeCurrent = (endt-startt)/(double)CLOCKS_PER_SEC/Evaluations*1e9;
+	check += Checksum(Results, NumberOfValues);
+
+	delete [] Results;
+
+	cout << "Exponential cost (" << Label << ", ns per evaluation)" << endl;
+	cout << "\texp: " << TimeExp << "\tFormer tables (" << NumberOfTables << "): " << TimeFormer << "\tShared table: " << TimeCurrent << "\t(checksum " << check << ")" << endl;
+}
+
+/*!
+ * \brief It loads the parameters of a learning rule.
+ *
+ * It loads the parameters of a learning rule from a string (with the format of the network file).
+ *
+ * \param Rule The learning rule.
+ * \param Parameters The parameters of the learning rule.
+ *
+ * \return True if the learning rule has been loaded. False otherwise.
+ */
+bool LoadRule(LearningRule * Rule, const char * Parameters){
+	FILE * fh = tmpfile();
+	if (fh==0){
+		cerr << "Error: temporary file could not be created" << endl;
+		return false;
+	}
+
+	fputs(Parameters, fh);
+	rewind(fh);
+
+	long Currentline = 1L;
+	bool Loaded = true;
+	try {
+		Rule->LoadLearningRule(fh, Currentline);
+	} catch (EDLUTFileException & Exc){
+		cerr << Exc << endl;
+		Loaded = false;
+	}
+
+	fclose(fh);
+	return Loaded;
+}
+
+/*!
+ * \brief It prints the cost of a learning rule.
+ *
+ * It measures the time per presynaptic spike, per postsynaptic spike (learning rules with
+ * postsynaptic learning) and per trigger sweep (additive kernel learning rules) over a
+ * synthetic population of synapses. The synapses of each neuron have consecutive states (as in
+ * Network::FindInConnections).
+ *
+ * \param Rule The learning rule (it is deleted).
+ * \param Parameters The parameters of the learning rule.
+ * \param Label Description of the learning rule.
+ * \param NumberOfNeurons Number of target neurons.
+ * \param NumberOfInputs Number of input synapses of each neuron.
+ * \param NumberOfPreSpikes Number of presynaptic spikes.
+ * \param NumberOfSweeps Number of postsynaptic spikes or trigger sweeps.
+ */
+void LearningRuleCost(LearningRule * Rule, const char * Parameters, const char * Label, int NumberOfNeurons, int NumberOfInputs, int NumberOfPreSpikes, int NumberOfSweeps){
+	clock_t startt, endt;
+
+	if (!LoadRule(Rule, Parameters)){
+		delete Rule;
+		return;
+	}
+
+	int NumberOfSynapses = NumberOfNeurons*NumberOfInputs;
+	bool WithPost = Rule->ImplementPostSynaptic();
+
+	Rule->InitializeConnectionState(NumberOfSynapses);
+
+	Interconnection * Connections = new Interconnection [NumberOfSynapses];
+	InterconnectionLearning * Learning = new InterconnectionLearning [NumberOfSynapses];
+	Interconnection ** Inputs = new Interconnection * [NumberOfSynapses];
+	for (int i=0; i<NumberOfSynapses; i++){
+		Connections[i].SetLearning(Learning+i);
+		Connections[i].SetIndex(i);
+		Connections[i].SetMaxWeight(1.0f);
+		Connections[i].SetWeight(0.5f);
+		if (WithPost){
+			Connections[i].SetWeightChange_withPost(Rule);
+			Connections[i].SetLearningRuleIndex_withPost(i);
+		} else {
+			Connections[i].SetWeightChange_withoutPost(Rule);
+			Connections[i].SetLearningRuleIndex_withoutPost(i);
+		}
+		Inputs[i] = Connections+i;
+	}
+
+	for (int n=0; n<NumberOfNeurons; n++){
+		Rule->SetTargetSynapses(n*NumberOfInputs, NumberOfInputs);
+	}
+
+	// The presynaptic spikes are precalculated (rand is not measured)
+	int * SpikeSynapse = new int [NumberOfPreSpikes];
+	for (int i=0; i<NumberOfPreSpikes; i++){
+		SpikeSynapse[i] = rand()%NumberOfSynapses;
+	}
+
+	// Mean input rate of 10 Hz per synapse
+	double PreInterval = 0.1/NumberOfSynapses;
+	double Time = 0;
+
+	startt = clock();
+	for (int i=0; i<NumberOfPreSpikes; i++){
+		Time += PreInterval;
+		Rule->ApplyPreSynapticSpike(Inputs[SpikeSynapse[i]], Time);
+	}
+	endt = clock();
+	double TimePre = (endt-startt)/(double)CLOCKS_PER_SEC/NumberOfPreSpikes*1e9;
+
+	// Postsynaptic spikes or trigger spikes of each neuron at 10 Hz
+	double SweepInterval = 0.1/NumberOfNeurons;
+
+	startt = clock();
+	for (int i=0; i<NumberOfSweeps; i++){
+		Time += SweepInterval;
+		Interconnection ** NeuronInputs = Inputs+(i%NumberOfNeurons)*NumberOfInputs;
+		if (WithPost){
+			Rule->ApplyPostSynapticSpikes(NeuronInputs, NumberOfInputs, Time);
+		} else {
+			// All the learning rules without postsynaptic learning are additive kernels
+			((AdditiveKernelChange *) Rule)->ApplyTeachingSignal(NeuronInputs, NumberOfInputs, Time);
+		}
+	}
+	endt = clock();
+	double TimeSweep = (endt-startt)/(double)CLOCKS_PER_SEC/NumberOfSweeps*1e9;
+
+	float check = 0;
+	for (int i=0; i<NumberOfSynapses; i++){
+		check += Connections[i].GetWeight();
+	}
+
+	cout << "Learning rule cost (" << Label << ", " << NumberOfNeurons << " neurons x " << NumberOfInputs << " synapses, ns)" << endl;
+	cout << "\tPresynaptic spike: " << TimePre;
+	if (WithPost){
+		cout << "\tPostsynaptic spike: " << TimeSweep;
+	} else {
+		cout << "\tTrigger sweep: " << TimeSweep;
+	}
+	cout << " (" << TimeSweep/NumberOfInputs << " per synapse)\t(checksum " << check << ")" << endl;
+
+	delete [] SpikeSynapse;
+	delete [] Inputs;
+	delete [] Connections;
+	delete [] Learning;
+	delete Rule;
+}
+
+int main(int ac, char *av[]) {
+	int NumberOfEvaluations = 10000000;
+	if (ac>1){
+		NumberOfEvaluations = atoi(av[1]);
+	}
+
+	srand(1);
+
+	// A network with six learning rules had six former tables
+	const int NumberOfTables = 6;
+	FormerExponentialTable * Formers[NumberOfTables];
+	for (int i=0; i<NumberOfTables; i++){
+		Formers[i] = new FormerExponentialTable(-20, 0, 4*1024*1024);
+	}
+
+	ExponentialAccuracy(Formers[0], NumberOfEvaluations);
+
+	const int NumberOfValues = 4096;
+	float * Values = new float [NumberOfValues];
+	int Repetitions = NumberOfEvaluations/NumberOfValues+1;
+
+	for (int i=0; i<NumberOfValues; i++){
+		Values[i] = -20.0f*rand()/(float)RAND_MAX;
+	}
+	ExponentialCost(Formers, NumberOfTables, Values, NumberOfValues, Repetitions, "uniform exponents in [-20,0]");
+
+	for (int i=0; i<NumberOfValues; i++){
+		Values[i] = -0.1f*rand()/(float)RAND_MAX;
+	}
+	ExponentialCost(Formers, NumberOfTables, Values, NumberOfValues, Repetitions, "short intervals, exponents in [-0.1,0]");
+
+	delete [] Values;
+	for (int i=0; i<NumberOfTables; i++){
+		delete Formers[i];
+	}
+
+	const int NumberOfNeurons = 100;
+	const int NumberOfInputs = 1000;
+	int NumberOfPreSpikes = NumberOfEvaluations/10+1;
+	int NumberOfSweeps = NumberOfPreSpikes/NumberOfInputs+1;
+
+	LearningRuleCost(new ExpWeightChange(), "0 0.1 0.0001 -0.001", "ExpAdditiveKernel", NumberOfNeurons, NumberOfInputs, NumberOfPreSpikes, NumberOfSweeps);
+	LearningRuleCost(new SinWeightChange(), "0 0.1 0.0001 -0.001 2", "SinAdditiveKernel, exponent 2", NumberOfNeurons, NumberOfInputs, NumberOfPreSpikes, NumberOfSweeps);
+	LearningRuleCost(new SinWeightChange(), "0 0.1 0.0001 -0.001 4", "SinAdditiveKernel, exponent 4", NumberOfNeurons, NumberOfInputs, NumberOfPreSpikes, NumberOfSweeps);
+	LearningRuleCost(new SinWeightChange(), "0 0.1 0.0001 -0.001 8", "SinAdditiveKernel, exponent 8", NumberOfNeurons, NumberOfInputs, NumberOfPreSpikes, NumberOfSweeps);
+	LearningRuleCost(new SinWeightChange(), "0 0.1 0.0001 -0.001 16", "SinAdditiveKernel, exponent 16", NumberOfNeurons, NumberOfInputs, NumberOfPreSpikes, NumberOfSweeps);
+	LearningRuleCost(new STDPWeightChange(), "0.0005 0.02 0.0006 0.02", "STDP", NumberOfNeurons, NumberOfInputs, NumberOfPreSpikes, NumberOfSweeps);
+	LearningRuleCost(new STDPLSWeightChange(), "0.0005 0.02 0.0006 0.02", "STDPLS", NumberOfNeurons, NumberOfInputs, NumberOfPreSpikes, NumberOfSweeps);
+
+	return 0;
+}
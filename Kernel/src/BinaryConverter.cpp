@@ -0,0 +1,132 @@
+/***************************************************************************
+ *                           BinaryConverter.cpp                           *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+
+#include <iostream>
+
+#include "../include/communication/BinaryFileOutputSpikeDriver.h"
+
+using namespace std;
+
+/*!
+ * 
+ * It converts a binary activity file (written by BinaryFileOutputSpikeDriver) to the text
+ * layout of FileOutputSpikeDriver.
+ * 
+ * \note Obligatory parameters:
+ * 			Binary_File	The binary activity file (-ofb, -logb and -logpb options).
+ * 			
+ * \note  parameters:
+ * 			Text_File	The output text file. If it is not specified, the events are written in the standard output.
+ * 
+ */ 
+int main(int ac, char *av[]) {
+	if (ac<2 || ac>3){
+		cerr << "Usage: " << av[0] << " Binary_File [Text_File]" << endl;
+		return 1;
+	}
+
+	FILE * Input = fopen(av[1],"rb");
+	if (!Input){
+		cerr << "Error: the file " << av[1] << " can not be opened" << endl;
+		return 1;
+	}
+
+	char Header[BINARYOUTPUTHEADERSIZE];
+	unsigned int Version, ByteOrder;
+	if (fread(Header, 1, BINARYOUTPUTHEADERSIZE, Input)!=BINARYOUTPUTHEADERSIZE || memcmp(Header, BINARYOUTPUTSIGNATURE, 8)!=0){
+		cerr << "Error: " << av[1] << " is not an EDLUT binary activity file" << endl;
+		fclose(Input);
+		return 1;
+	}
+
+	memcpy(&Version, Header+8, sizeof(unsigned int));
+	memcpy(&ByteOrder, Header+12, sizeof(unsigned int));
+	if (ByteOrder!=BINARYOUTPUTBYTEORDER){
+		cerr << "Error: " << av[1] << " has been written in an architecture with a different byte order" << endl;
+		fclose(Input);
+		return 1;
+	}
+
+	if (Version!=BINARYOUTPUTVERSION){
+		cerr << "Error: unsupported binary activity file version " << Version << endl;
+		fclose(Input);
+		return 1;
+	}
+
+	FILE * Output = stdout;
+	if (ac==3){
+		Output = fopen(av[2],"wt");
+		if (!Output){
+			cerr << "Error: the file " << av[2] << " can not be created" << endl;
+			fclose(Input);
+			return 1;
+		}
+	}
+
+	char Record[BINARYOUTPUTRECORDSIZE];
+	double Time;
+	int Index;
+	unsigned int NumberOfValues;
+
+	unsigned int MaxNumberOfValues = 16;
+	double * Values = new double [MaxNumberOfValues];
+
+	int Result = 0;
+
+	size_t ReadBytes;
+	while ((ReadBytes=fread(Record, 1, BINARYOUTPUTRECORDSIZE, Input))==BINARYOUTPUTRECORDSIZE){
+		memcpy(&Time, Record, sizeof(double));
+		memcpy(&Index, Record+8, sizeof(int));
+		memcpy(&NumberOfValues, Record+12, sizeof(unsigned int));
+
+		if (NumberOfValues>MaxNumberOfValues){
+			delete [] Values;
+			while (NumberOfValues>MaxNumberOfValues){
+				MaxNumberOfValues *= 2;
+			}
+			Values = new double [MaxNumberOfValues];
+		}
+
+		if (fread(Values, sizeof(double), NumberOfValues, Input)!=NumberOfValues){
+			ReadBytes = 1;
+			break;
+		}
+
+		fprintf(Output,"%f\t%li",Time,(long int) Index);
+		for (unsigned int i=0; i<NumberOfValues; ++i){
+			fprintf(Output,"\t%1.12f",Values[i]);
+		}
+		fprintf(Output,"\n");
+	}
+
+	if (ReadBytes!=0){
+		cerr << "Error: the file " << av[1] << " is truncated" << endl;
+		Result = 1;
+	}
+
+	delete [] Values;
+
+	fclose(Input);
+	if (Output!=stdout){
+		fclose(Output);
+	}
+
+	return Result;
+}
@@ -0,0 +1,354 @@
+/***************************************************************************
+ *                           DeferredWeightTest.cpp                        *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cmath>
+
+#include "../include/simulation/Simulation.h"
+
+#include "../include/communication/FileInputSpikeDriver.h"
+#include "../include/communication/FileOutputSpikeDriver.h"
+#include "../include/communication/FileOutputWeightDriver.h"
+
+#include "../include/spike/EDLUTFileException.h"
+#include "../include/spike/EDLUTException.h"
+
+using namespace std;
+
+/*!
+ * Prefix of the temporary files (created in the working directory).
+ */
+#define TESTPREFIX "deferredweighttest_"
+
+/*!
+ * Default step of the deferred weight updates. The runs only match while no spike reads a weight
+ * changed earlier in the same step (the inputs are given with microsecond resolution).
+ */
+#define DEFAULTWEIGHTUPDATESTEP 1e-7
+
+/*!
+ * Simulation (communication) step of every run. The deferred weight updates are also run with this
+ * step, but they can't match the immediate ones: a postsynaptic spike changes the weights of all the
+ * inputs of its neuron and the presynaptic spikes which arrive before the end of the step still read
+ * the former weights (as a neuron reading the weights at the communication step would). These runs
+ * only report how much the spikes and the final weights differ.
+ */
+#define TESTSIMULATIONSTEP 1e-3
+
+/*!
+ * Number of input neurons and input spikes per neuron.
+ */
+#define TESTINPUTNEURONS 200
+#define TESTINPUTSPIKES 50
+
+/*!
+ * Configuration of a test network.
+ */
+struct TestNet {
+	const char * Name;
+	const char * Rules;
+	bool Kernel;
+	double SimulationTime;
+	double SaveStep;
+};
+
+/*!
+ * It writes the text in the file.
+ */
+static void WriteFile(const string & FileName, const string & Text){
+	ofstream File(FileName.c_str());
+	File << Text;
+}
+
+/*!
+ * It writes the neuron model, the weights and the inputs shared by every network.
+ */
+static void WriteCommonFiles(){
+	WriteFile(TESTPREFIX "lif.cfg",
+		"// Resting potential (V)\n-0.070\n"
+		"// Firing threshold (V)\n-0.050\n"
+		"// Reset potential (V)\n-0.070\n"
+		"// Membrane capacitance (F)\n2e-12\n"
+		"// Resting conductance (S)\n0.2e-9\n"
+		"// Excitatory current time constant (s)\n0.5e-3\n"
+		"// Inhibitory current time constant (s)\n10e-3\n"
+		"// Refractory period (s)\n1e-3\n"
+		"// Bias current (A)\n0.0\n");
+
+	WriteFile(TESTPREFIX "weights.cfg", "0 0.005\n");
+	WriteFile(TESTPREFIX "kweights.cfg", "1910 1.0\n");
+
+	// Input neurons firing every 20 ms from a fixed pseudorandom phase
+	ostringstream Inputs;
+	Inputs << TESTINPUTNEURONS*TESTINPUTSPIKES << "\n";
+	unsigned int Seed = 12345;
+	for (int i=0; i<TESTINPUTNEURONS; ++i){
+		Seed = Seed*1103515245 + 12345;
+		Inputs << ((Seed>>8)%20000)*1e-6 << " " << TESTINPUTSPIKES << " 0.02 " << i << " 1\n";
+	}
+	WriteFile(TESTPREFIX "inputs.cfg", Inputs.str());
+}
+
+/*!
+ * It writes the network file and returns its name.
+ */
+static string WriteNetwork(const TestNet & Net){
+	ostringstream Text;
+	Text << "// types\n1\n// neurons\n";
+	if (Net.Kernel){
+		Text << "210\n";
+		Text << "190 LIFEventDrivenModel " TESTPREFIX "lif 0 0\n";
+		Text << "10 LIFEventDrivenModel " TESTPREFIX "lif 0 0\n";
+		Text << "10 LIFEventDrivenModel " TESTPREFIX "lif 1 0\n";
+		Text << "// learning rules\n2\n" << Net.Rules;
+		Text << "// connections\n1910\n";
+		Text << "0 190 200 10 1 0.001 0.0 0 5.0 0\n";
+		Text << "190 1 200 1 10 0.001 0.0 0 5.0 1\n";
+	} else {
+		Text << "1200\n";
+		Text << "200 LIFEventDrivenModel " TESTPREFIX "lif 0 0\n";
+		Text << "1000 LIFEventDrivenModel " TESTPREFIX "lif 1 0\n";
+		Text << "// learning rules\n1\n" << Net.Rules;
+		Text << "// connections\n200000\n";
+		Text << "0 200 200 1000 1 0.001 0.0 0 5.0 0\n";
+	}
+
+	string FileName = string(TESTPREFIX) + Net.Name + ".cfg";
+	WriteFile(FileName, Text.str());
+	return FileName;
+}
+
+/*!
+ * It reads the lines of a file (sorted if requested).
+ */
+static vector<string> ReadLines(const string & FileName, bool Sort){
+	vector<string> Lines;
+	ifstream File(FileName.c_str());
+	string Line;
+	while (getline(File, Line)){
+		Lines.push_back(Line);
+	}
+	if (Sort){
+		sort(Lines.begin(), Lines.end());
+	}
+	return Lines;
+}
+
+/*!
+ * It reads the weights of a weight file (pairs of number of connections and weight).
+ */
+static vector<float> ReadWeights(const string & FileName){
+	vector<float> Weights;
+	ifstream File(FileName.c_str());
+	int Number;
+	float Weight;
+	while (File >> Number >> Weight){
+		Weights.insert(Weights.end(), Number, Weight);
+	}
+	return Weights;
+}
+
+/*!
+ * It returns the names of the weight files saved during a run (as FileOutputWeightDriver names them)
+ * followed by the name of the final weight file.
+ */
+static vector<string> WeightFileNames(const TestNet & Net, const string & Prefix){
+	vector<string> Names;
+	for (int i=1; i*Net.SaveStep<Net.SimulationTime; ++i){
+		char Time[30];
+		sprintf(Time, "%.6g", (float) (i*Net.SaveStep));
+		Names.push_back(Prefix + Time + ".txt");
+	}
+	Names.push_back(Prefix + ".txt");
+	return Names;
+}
+
+/*!
+ * It runs a network and writes the output spikes and the saved weights.
+ */
+static void RunNetwork(const TestNet & Net, const string & NetworkFile, double WeightUpdateStep, const string & SpikeFile, const string & WeightFile) throw (EDLUTException){
+	Simulation Simul(NetworkFile.c_str(), (Net.Kernel)?TESTPREFIX "kweights.cfg":TESTPREFIX "weights.cfg", Net.SimulationTime, TESTSIMULATIONSTEP);
+
+	FileInputSpikeDriver Input(TESTPREFIX "inputs.cfg");
+	FileOutputSpikeDriver Output(SpikeFile.c_str(), false);
+	FileOutputWeightDriver Weights(WeightFile.c_str());
+
+	Simul.AddInputSpikeDriver(&Input);
+	Simul.AddOutputSpikeDriver(&Output);
+	Simul.AddOutputWeightDriver(&Weights);
+	Simul.SetSaveStep(Net.SaveStep);
+	Simul.SetWeightUpdateStep(WeightUpdateStep);
+
+	Simul.RunSimulation();
+
+	// The final weights include the pending changes (applied at the end of the simulation)
+	Weights.WriteWeights(Simul.GetNetwork());
+}
+
+/*!
+ * It prints how much a run with the weight updates at the simulation step differs from the immediate one.
+ */
+static void ReportDifferences(const vector<string> & ImmediateSpikes, const vector<string> & DeferredSpikes, const vector<float> & ImmediateWeights, const vector<float> & DeferredWeights){
+	vector<string> Differences;
+	set_symmetric_difference(ImmediateSpikes.begin(), ImmediateSpikes.end(), DeferredSpikes.begin(), DeferredSpikes.end(), back_inserter(Differences));
+
+	unsigned int DifferentWeights = 0;
+	float MaxDifference = 0;
+	for (unsigned int i=0; i<ImmediateWeights.size() && i<DeferredWeights.size(); ++i){
+		float Difference = fabs(ImmediateWeights[i]-DeferredWeights[i]);
+		if (Difference!=0){
+			DifferentWeights++;
+			MaxDifference = max(MaxDifference, Difference);
+		}
+	}
+
+	cout << "  step " << TESTSIMULATIONSTEP << " s: " << DeferredSpikes.size() << " spikes (" << Differences.size() << " not in both runs), " << DifferentWeights << " of " << ImmediateWeights.size() << " final weights differ (up to " << MaxDifference << ")" << endl;
+}
+
+/*!
+ * It compares two runs and returns the number of mismatches.
+ */
+static int Compare(const char * What, const vector<string> & Immediate, const vector<string> & Deferred){
+	if (Immediate.size()!=Deferred.size()){
+		cout << "  " << What << ": " << Immediate.size() << " lines in immediate mode and " << Deferred.size() << " in deferred mode" << endl;
+		return 1;
+	}
+
+	unsigned int Mismatches = 0;
+	for (unsigned int i=0; i<Immediate.size(); ++i){
+		if (Immediate[i]!=Deferred[i]){
+			if (Mismatches==0){
+				cout << "  " << What << ": first mismatch \"" << Immediate[i] << "\" vs \"" << Deferred[i] << "\"" << endl;
+			}
+			Mismatches++;
+		}
+	}
+
+	if (Mismatches!=0){
+		cout << "  " << What << ": " << Mismatches << " of " << Immediate.size() << " lines differ" << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int ac, char *av[]) {
+	double WeightUpdateStep = DEFAULTWEIGHTUPDATESTEP;
+	if (ac>1){
+		WeightUpdateStep = atof(av[1]);
+		if (WeightUpdateStep<=0){
+			cerr << av[0] << " [Weight_Update_Step]" << endl;
+			return 1;
+		}
+	}
+
+	const TestNet Nets[] = {
+		{"STDP", "STDP 0.0005 0.02 0.0006 0.02\n", false, 0.2, 0.09},
+		{"STDPLS", "STDPLS 0.0005 0.02 0.0006 0.02\n", false, 0.2, 0.09},
+		{"STDPNeuron", "STDPNeuron 0.0005 0.02 0.0006 0.02\n", false, 0.2, 0.09},
+		{"STDPLSNeuron", "STDPLSNeuron 0.0005 0.02 0.0006 0.02\n", false, 0.2, 0.09},
+		{"ExpAdditiveKernel", "ExpAdditiveKernel 0 0.1 0.0001 -0.001\nExpAdditiveKernel 1 0.1 0.0 -0.001\n", true, 1.01, 0.5},
+		{"SinAdditiveKernel", "SinAdditiveKernel 0 0.1 0.0001 -0.001 4\nSinAdditiveKernel 1 0.1 0.0 -0.001 4\n", true, 1.01, 0.5}
+	};
+	const unsigned int NumberOfNets = sizeof(Nets)/sizeof(Nets[0]);
+
+	cout << "Comparing immediate and deferred weight updates (step " << WeightUpdateStep << " s)" << endl;
+
+	WriteCommonFiles();
+
+	int Failures = 0;
+	try {
+		for (unsigned int i=0; i<NumberOfNets; ++i){
+			string NetworkFile = WriteNetwork(Nets[i]);
+			string Prefix = string(TESTPREFIX) + Nets[i].Name;
+
+			RunNetwork(Nets[i], NetworkFile, 0.0, Prefix + "_spikes0.txt", Prefix + "_weights0.txt");
+			RunNetwork(Nets[i], NetworkFile, WeightUpdateStep, Prefix + "_spikes1.txt", Prefix + "_weights1.txt");
+			RunNetwork(Nets[i], NetworkFile, TESTSIMULATIONSTEP, Prefix + "_spikes2.txt", Prefix + "_weights2.txt");
+
+			// Spikes with the same time can be written in different order
+			vector<string> ImmediateSpikes = ReadLines(Prefix + "_spikes0.txt", true);
+			vector<string> DeferredSpikes = ReadLines(Prefix + "_spikes1.txt", true);
+			vector<string> StepSpikes = ReadLines(Prefix + "_spikes2.txt", true);
+			int Result = Compare("output spikes", ImmediateSpikes, DeferredSpikes);
+			remove((Prefix + "_spikes0.txt").c_str());
+			remove((Prefix + "_spikes1.txt").c_str());
+			remove((Prefix + "_spikes2.txt").c_str());
+
+			vector<string> ImmediateWeightFiles = WeightFileNames(Nets[i], Prefix + "_weights0");
+			vector<string> DeferredWeightFiles = WeightFileNames(Nets[i], Prefix + "_weights1");
+			vector<string> StepWeightFiles = WeightFileNames(Nets[i], Prefix + "_weights2");
+			vector<float> ImmediateFinalWeights = ReadWeights(ImmediateWeightFiles.back());
+			vector<float> StepFinalWeights = ReadWeights(StepWeightFiles.back());
+			unsigned int WeightLines = 0;
+			for (unsigned int j=0; j<ImmediateWeightFiles.size(); ++j){
+				vector<string> ImmediateWeights = ReadLines(ImmediateWeightFiles[j], false);
+				vector<string> DeferredWeights = ReadLines(DeferredWeightFiles[j], false);
+				if (ImmediateWeights.empty()){
+					cout << "  missing weight file " << ImmediateWeightFiles[j] << endl;
+					Result++;
+				}
+				Result += Compare(ImmediateWeightFiles[j].c_str(), ImmediateWeights, DeferredWeights);
+				WeightLines += ImmediateWeights.size();
+				remove(ImmediateWeightFiles[j].c_str());
+				remove(DeferredWeightFiles[j].c_str());
+				remove(StepWeightFiles[j].c_str());
+			}
+
+			if (ImmediateSpikes.empty()){
+				cout << "  no output spikes" << endl;
+				Result++;
+			}
+
+			cout << Nets[i].Name << ": " << ImmediateSpikes.size() << " spikes, " << ImmediateWeightFiles.size() << " weight files (" << WeightLines << " lines): " << ((Result==0)?"PASS":"FAIL") << endl;
+			ReportDifferences(ImmediateSpikes, StepSpikes, ImmediateFinalWeights, StepFinalWeights);
+			if (Result!=0){
+				Failures++;
+			}
+
+			remove(NetworkFile.c_str());
+		}
+	} catch (EDLUTFileException Exc){
+		cerr << Exc << endl;
+		Failures++;
+	} catch (EDLUTException Exc){
+		cerr << Exc << endl;
+		Failures++;
+	}
+
+	remove(TESTPREFIX "lif.cfg");
+	remove(TESTPREFIX "weights.cfg");
+	remove(TESTPREFIX "kweights.cfg");
+	remove(TESTPREFIX "inputs.cfg");
+
+	if (Failures!=0){
+		cout << Failures << " of " << NumberOfNets << " networks differ" << endl;
+		return 1;
+	}
+
+	cout << "All networks match" << endl;
+	return 0;
+}
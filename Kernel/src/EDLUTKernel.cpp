@@ -55,16 +55,32 @@ using namespace std;
  * 			
  * \note  parameters:
  * 			-info 	It shows the network information.
+ * 			-cancel 	It cancels the outdated spike predictions in the event queue instead of discarding them.
  * 			-sf File_Name	It saves the final weights in file File_Name.
  * 			-wt Save_Weight_Step	It sets the step time between weights saving.
+ * 			-wu Weight_Update_Step	It defers the weight changes and applies them every Weight_Update_Step seconds.
  * 			-st Step_Time(in_seconds) It sets the step time in simulation.
  * 			-log File_Name It saves the activity register in file File_Name.
  *          -logp File_Name It saves all events register in file File_Name.
+ * 			-logb File_Name It saves the activity register in the binary file File_Name.
+ * 			-logpb File_Name It saves all events register in the binary file File_Name.
+ * 			-logperiod Period	It writes the state of each neuron at most once per Period seconds in the previous -logp/-logpb file.
+ * 			-logwindow Start End	It writes the states only between Start and End seconds in the previous -logp/-logpb file (it can be repeated).
+ * 			-logvars Var1[,Var2...]	It writes only the given state variables (printable values) in the previous -logp/-logpb file.
+ * 			-logfiring	It writes the states only when the neurons fire in the previous -logp/-logpb file.
  * 			-if Input_File	It adds the Input_File file in the input sources of the simulation.
+ * 			-ifs Input_File	It adds the Input_File file (sorted by time) in the input sources of the simulation. It is loaded incrementally.
  * 			-of Output_File	It adds the Output_File file in the output targets of the simulation.
+ * 			-ofb Output_File	It adds the Output_File binary file in the output targets of the simulation.
  * 			-ic IPAddress:Port Server|Client	It adds the connection as a server or a client in the specified direction in the input sources of the simulation.
  * 			-oc IPAddress:Port Server|Client	It adds the connection as a server or a client in the specified direction in the output targets of the simulation.
  * 			-ioc IPAddress:Port Server|Client	It adds the connection as a server or a client in the specified direction in the input sources and in the output targets.	 
+ * 			-async	It writes the output and monitoring activity (except the -ioc connections) from background threads.
+ * 			-tcpv2	It uses the version 2 protocol (32-bit spike counts and the slot time in a frame header) in the TCP/IP connections. Server connections fall back to the previous protocol with older clients.
+ * 			-tcpdelta	It uses the version 2 protocol with delta-encoded spikes in the TCP/IP connections.
+ * 			-ism Name Server|Client	It adds the shared memory segment (for processes in the same host) as a server or a client in the input sources.
+ * 			-osm Name Server|Client	It adds the shared memory segment as a server or a client in the output targets.
+ * 			-iosm Name Server|Client	It adds the shared memory segment as a server or a client in the input sources and in the output targets.
  * 
   */ 
 int main(int ac, char *av[]) {
@@ -97,6 +113,10 @@ int main(int ac, char *av[]) {
 		}
 		Simul.SetSaveStep(Reader.GetSaveWeightStepTime());
 
+		Simul.SetWeightUpdateStep(Reader.GetWeightUpdateStepTime());
+
+		Simul.SetCancelPredictions(Reader.CheckCancelPredictions());
+
 		if (Reader.GetTimeDrivenStepTime()!=-1){
 			Simul.SetTimeDrivenStep(Reader.GetTimeDrivenStepTime());
 		}
@@ -145,6 +165,8 @@ int main(int ac, char *av[]) {
 		cout << "Elapsed time: " << (endt-startt)/(float)CLOCKS_PER_SEC << " sec" << endl;
 		cout << "Number of updates: " << Simul.GetSimulationUpdates() << endl;
 		cout << "Number of InternalSpike: " << Simul.GetTotalSpikeCounter() << endl;
+		cout << "Number of discarded InternalSpike: " << Simul.GetDiscardedSpikeCounter() << endl;
+		cout << "Number of cancelled InternalSpike: " << Simul.GetCancelledSpikeCounter() << endl;
 		cout << "Mean number of spikes in heap: " << Simul.GetHeapAcumSize()/(float)Simul.GetSimulationUpdates() << endl;
 		cout << "Updates per second: " << Simul.GetSimulationUpdates()/((endt-startt)/(float)CLOCKS_PER_SEC) << endl;
 		
@@ -156,9 +178,9 @@ int main(int ac, char *av[]) {
 	} catch (ParameterException Exc){
 		cerr << Exc << endl;
 		cerr << av[0] << " -time Simulation_Time -nf Network_File -wf Weights_File";
-		cerr << " [-info] [-sf Final_Weights_File] [-wt Save_Weight_Step] [-st Simulation_Step_Time] [-ts Time_Driven_Step]"; 
-		cerr << " [-tsGPU Time_Driven_Step_GPU] [-log Activity_Register_File] [-logp Activity_Register_File] [-if Input_File]";
-		cerr << " [-ic IPAddress:Port Server|Client] [-of Output_File] [-oc IPAddress:Port Server|Client] [-ioc IPAddress:Port Server|Client]" << endl;	
+		cerr << " [-info] [-cancel] [-sf Final_Weights_File] [-wt Save_Weight_Step] [-wu Weight_Update_Step] [-st Simulation_Step_Time] [-ts Time_Driven_Step]"; 
+		cerr << " [-tsGPU Time_Driven_Step_GPU] [-log Activity_Register_File] [-logp Activity_Register_File] [-logb Activity_Register_File] [-logpb Activity_Register_File] [-logperiod Period] [-logwindow Start End] [-logvars Var1[,Var2...]] [-logfiring] [-if Input_File] [-ifs Input_File]";
+		cerr << " [-ic IPAddress:Port Server|Client] [-of Output_File] [-ofb Output_File] [-oc IPAddress:Port Server|Client] [-ioc IPAddress:Port Server|Client] [-async] [-tcpv2] [-tcpdelta] [-ism Name Server|Client] [-osm Name Server|Client] [-iosm Name Server|Client]" << endl;	
 	} catch (ConnectionException Exc){
 		cerr << Exc << endl;
 		return 1;
@@ -105,8 +105,8 @@ void mexFunction (int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
 
 	clock_t startt,endt;
 
-	double * OutputSpikeTimes;
-	long int * OutputSpikeCells;
+	const double * OutputSpikeTimes;
+	const long int * OutputSpikeCells;
 
 
 	cout << "Int size: " << sizeof(int) << endl;
@@ -139,7 +139,7 @@ void mexFunction (int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
 		endt=clock();
 
 		// Get outputs and print them
-		int OutputNumber = OutputDriver->GetBufferedSpikes(OutputSpikeTimes,OutputSpikeCells);
+		int OutputNumber = OutputDriver->GetSlotSpikes(OutputSpikeTimes,OutputSpikeCells);
 
 		// Create the output. It is also a double-precision scalar.
 		double* SpikeTimes = createMatlabDoubleArray(plhs[0],OutputNumber);
@@ -148,9 +148,6 @@ void mexFunction (int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
 		if (OutputNumber>0){
 			memcpy(SpikeTimes, OutputSpikeTimes, OutputNumber*sizeof(double));
 			memcpy(SpikeCells, OutputSpikeCells, OutputNumber*sizeof(long int));
-
-			delete [] OutputSpikeTimes;
-			delete [] OutputSpikeCells;
 		}
 
 		cout << "Oky doky" << endl;
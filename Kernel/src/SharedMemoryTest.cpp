@@ -0,0 +1,297 @@
+/***************************************************************************
+ *                           SharedMemoryTest.cpp                          *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+
+#include <iostream>
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <pthread.h>
+	#include <unistd.h>
+	#include <sys/time.h>
+#endif
+
+#include "../include/communication/SharedMemorySpikeChannel.h"
+#include "../include/communication/ServerSocket.h"
+#include "../include/communication/ClientSocket.h"
+#include "../include/communication/TCPIPSpikeProtocol.h"
+
+#include "../include/spike/EDLUTException.h"
+
+using namespace std;
+
+/*!
+ * Kinds of test.
+ */
+#define TESTTHROUGHPUT 0
+#define TESTROUNDTRIP 1
+
+/*!
+ * Configuration of a test (shared by both ends).
+ */
+struct TestRun {
+	int Kind;
+	bool TCPIP;
+	string Name;
+	unsigned short Port;
+	unsigned int SpikesPerStep;
+	unsigned int Steps;
+
+	/*!
+	 * Results of the server.
+	 */
+	unsigned long long Received;
+	unsigned long long Checksum;
+	bool Closed;
+	bool Failed;
+};
+
+/*!
+ * It returns the wall clock time in seconds.
+ */
+static double WallTime(){
+#ifdef _WIN32
+	LARGE_INTEGER Counter, Frequency;
+	QueryPerformanceCounter(&Counter);
+	QueryPerformanceFrequency(&Frequency);
+	return (double) Counter.QuadPart/Frequency.QuadPart;
+#else
+	struct timeval Time;
+	gettimeofday(&Time, 0);
+	return Time.tv_sec+Time.tv_usec*1e-6;
+#endif
+}
+
+/*!
+ * It returns the checksum of a spike (exact, so the order of the sum doesn't matter).
+ */
+static unsigned long long SpikeChecksum(const SharedMemorySpike & Spike){
+	unsigned int Bits;
+	memcpy(&Bits, &Spike.Time, sizeof(float));
+	return (unsigned long long) Spike.Neuron + Bits;
+}
+
+/*!
+ * It fills a batch of spikes.
+ */
+static void FillBatch(SharedMemorySpike * Spikes, unsigned int Number, double Time){
+	for (unsigned int i=0; i<Number; ++i){
+		Spikes[i].Neuron = rand()%100000;
+		Spikes[i].Time = (float) (Time + 0.001*i/Number);
+	}
+}
+
+/*!
+ * It runs the server end of a test: it receives the batches (and sends them back in the
+ * round trip test) and it checks that the client closes the connection.
+ */
+#ifdef _WIN32
+DWORD WINAPI Server(LPVOID Object){
+#else
+void * Server(void * Object){
+#endif
+	TestRun * Run = (TestRun *) Object;
+
+	try{
+		if (Run->TCPIP){
+			ServerSocket Socket(Run->Port);
+			TCPIPSpikeProtocol Protocol(&Socket, SERVER, 2, false);
+			for (unsigned int i=0; i<Run->Steps; ++i){
+				double Time;
+				unsigned int N = Protocol.ReceiveSpikes(Time);
+				const SharedMemorySpike * Spikes = (const SharedMemorySpike *) Protocol.GetSpikes();
+				if (Run->Kind==TESTROUNDTRIP){
+					Protocol.SendSpikes(Time, Protocol.GetSpikes(), N);
+				}
+				for (unsigned int j=0; j<N; ++j){
+					Run->Checksum += SpikeChecksum(Spikes[j]);
+				}
+				Run->Received += N;
+			}
+		} else {
+			SharedMemorySpikeChannel Channel(Run->Name, SERVER);
+			for (unsigned int i=0; i<Run->Steps; ++i){
+				double Time;
+				unsigned int N = Channel.ReceiveSpikes(Time);
+				const SharedMemorySpike * Spikes = Channel.GetSpikes();
+				if (Run->Kind==TESTROUNDTRIP){
+					Channel.SendSpikes(Time, Spikes, N);
+				}
+				for (unsigned int j=0; j<N; ++j){
+					Run->Checksum += SpikeChecksum(Spikes[j]);
+				}
+				Run->Received += N;
+			}
+
+			// The client has finished
+			double Time;
+			Run->Closed = (Channel.ReceiveSpikes(Time)==0 && Channel.IsClosed());
+		}
+	} catch (EDLUTException Exc){
+		cerr << Exc << endl;
+		Run->Failed = true;
+	}
+
+	return 0;
+}
+
+/*!
+ * It runs the client end of a test.
+ *
+ * \return The wall clock time (in seconds) of the test. A negative value if it has failed.
+ */
+static double RunTest(TestRun & Run){
+	Run.Received = 0;
+	Run.Checksum = 0;
+	// The closing is only checked in the shared memory runs
+	Run.Closed = Run.TCPIP;
+	Run.Failed = false;
+
+	SharedMemorySpike * Batch = new SharedMemorySpike [Run.SpikesPerStep];
+	FillBatch(Batch, Run.SpikesPerStep, 0.0);
+
+	unsigned long long Checksum = 0;
+	for (unsigned int j=0; j<Run.SpikesPerStep; ++j){
+		Checksum += SpikeChecksum(Batch[j]);
+	}
+	Checksum *= Run.Steps;
+
+#ifdef _WIN32
+	HANDLE Thread = CreateThread(NULL, 0, Server, &Run, 0, NULL);
+#else
+	pthread_t Thread;
+	pthread_create(&Thread, NULL, Server, &Run);
+#endif
+
+	double Start, End;
+	bool Correct = true;
+	try{
+		if (Run.TCPIP){
+			// Let the server start listening
+#ifdef _WIN32
+			Sleep(200);
+#else
+			usleep(200000);
+#endif
+			ClientSocket Socket("127.0.0.1", Run.Port);
+			TCPIPSpikeProtocol Protocol(&Socket, CLIENT, 2, false);
+			Start = WallTime();
+			for (unsigned int i=0; i<Run.Steps; ++i){
+				// Both spike structs have the same layout
+				Protocol.SendSpikes(i*0.001, (TCPIPSpike *) Batch, Run.SpikesPerStep);
+				if (Run.Kind==TESTROUNDTRIP){
+					double Time;
+					Correct = Correct && (Protocol.ReceiveSpikes(Time)==Run.SpikesPerStep);
+				}
+			}
+			End = WallTime();
+		} else {
+			SharedMemorySpikeChannel Channel(Run.Name, CLIENT);
+			Start = WallTime();
+			for (unsigned int i=0; i<Run.Steps; ++i){
+				Channel.SendSpikes(i*0.001, Batch, Run.SpikesPerStep);
+				if (Run.Kind==TESTROUNDTRIP){
+					double Time;
+					Correct = Correct && (Channel.ReceiveSpikes(Time)==Run.SpikesPerStep) && Time==i*0.001 &&
+						memcmp(Channel.GetSpikes(), Batch, Run.SpikesPerStep*sizeof(SharedMemorySpike))==0;
+				}
+			}
+			End = WallTime();
+		}
+	} catch (EDLUTException Exc){
+		cerr << Exc << endl;
+		Correct = false;
+	}
+
+#ifdef _WIN32
+	WaitForSingleObject(Thread, INFINITE);
+	CloseHandle(Thread);
+#else
+	pthread_join(Thread, NULL);
+#endif
+	if (Run.Kind==TESTTHROUGHPUT){
+		End = WallTime();
+	}
+
+	delete [] Batch;
+
+	if (!Correct || Run.Failed || Run.Received!=(unsigned long long)Run.Steps*Run.SpikesPerStep || Checksum!=Run.Checksum || !Run.Closed){
+		cerr << "Error: the received spikes do not match the sent spikes" << endl;
+		return -1;
+	}
+
+	return End-Start;
+}
+
+/*!
+ * 
+ * It checks the shared memory spike channel with both ends in the same machine (two threads)
+ * and it compares it with a TCP/IP connection through the loopback interface (version 2 protocol):
+ * the throughput with big batches (bigger than the ring) and the round trip time of small
+ * batches (as a co-simulation which exchanges the spikes in every step).
+ * 
+ * \note  parameters:
+ * 			Name	Name of the shared memory segment. edlut_test by default.
+ * 			Port	TCP port of the TCP/IP runs. 5700 by default.
+ * 
+ */ 
+int main(int ac, char *av[]) {
+	string Name = "edlut_test";
+	unsigned int Port = 5700;
+
+	if (ac>3){
+		cerr << "Usage: " << av[0] << " [Name] [Port]" << endl;
+		return 1;
+	}
+
+	if (ac>1) Name = av[1];
+	if (ac>2) Port = atoi(av[2]);
+
+	const char * Names[] = {"Throughput (shared memory)", "Throughput (TCP/IP)", "Round trip (shared memory)", "Round trip (TCP/IP)"};
+	const int Kinds[] = {TESTTHROUGHPUT, TESTTHROUGHPUT, TESTROUNDTRIP, TESTROUNDTRIP};
+	const bool TCPIP[] = {false, true, false, true};
+	const unsigned int SpikesPerStep[] = {500000, 500000, 100, 100};
+	const unsigned int Steps[] = {40, 40, 20000, 20000};
+
+	for (unsigned int i=0; i<4; ++i){
+		TestRun Run;
+		Run.Kind = Kinds[i];
+		Run.TCPIP = TCPIP[i];
+		Run.Name = Name;
+		Run.Port = Port+i;
+		Run.SpikesPerStep = SpikesPerStep[i];
+		Run.Steps = Steps[i];
+
+		cout << Names[i] << ", " << Steps[i] << " steps of " << SpikesPerStep[i] << " spikes:\t";
+
+		double Time = RunTest(Run);
+		if (Time<0){
+			return 1;
+		}
+
+		if (Kinds[i]==TESTTHROUGHPUT){
+			cout << Time << " s\t" << (double)SpikesPerStep[i]*Steps[i]/Time*1e-6 << " Mspikes/s" << endl;
+		} else {
+			cout << Time << " s\t" << Time/Steps[i]*1e6 << " us per step" << endl;
+		}
+	}
+
+	return 0;
+}
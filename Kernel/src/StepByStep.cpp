@@ -93,8 +93,8 @@ int main(int ac, char *av[]) {
 	double InputSpikeTimes [NumberInputCells];
 	long int InputSpikeCells [NumberInputCells];
 
-	double * OutputSpikeTimes;
-	long int * OutputSpikeCells;
+	const double * OutputSpikeTimes;
+	const long int * OutputSpikeCells;
 		
 	// Simulate step by step.
 	for (double CurrentTime = 0; CurrentTime<SimulationTime; CurrentTime+=StepTime){
@@ -114,15 +114,10 @@ int main(int ac, char *av[]) {
 		Simul->RunSimulationSlot(CurrentTime+StepTime);
 
 		// Get outputs and print them
-		int OutputNumber = OutputDriver->GetBufferedSpikes(OutputSpikeTimes,OutputSpikeCells);
+		int OutputNumber = OutputDriver->GetSlotSpikes(OutputSpikeTimes,OutputSpikeCells);
 
-		if (OutputNumber>0){
-			for (int i=0; i< OutputNumber; ++i){
-				cout << "Output spike at time " << OutputSpikeTimes[i] << " from cell " << OutputSpikeCells[i] << endl;
-			}
-
-			delete [] OutputSpikeTimes;
-			delete [] OutputSpikeCells;
+		for (int i=0; i< OutputNumber; ++i){
+			cout << "Output spike at time " << OutputSpikeTimes[i] << " from cell " << OutputSpikeCells[i] << endl;
 		}
 	}
 	
@@ -0,0 +1,226 @@
+/***************************************************************************
+ *                           TCPIPBenchmark.cpp                            *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <time.h>
+
+#include <iostream>
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <pthread.h>
+	#include <unistd.h>
+#endif
+
+#include "../include/communication/ServerSocket.h"
+#include "../include/communication/ClientSocket.h"
+#include "../include/communication/TCPIPSpikeProtocol.h"
+
+#include "../include/spike/EDLUTException.h"
+
+using namespace std;
+
+/*!
+ * Configuration of a benchmark run (shared by the sender and the receiver).
+ */
+struct BenchmarkRun {
+	unsigned short Port;
+	unsigned int Version;
+	bool Delta;
+	unsigned int SpikesPerStep;
+	unsigned int Steps;
+
+	/*!
+	 * Results of the receiver.
+	 */
+	unsigned long long Received;
+	double Checksum;
+	bool Failed;
+};
+
+/*!
+ * It receives all the batches of a benchmark run (server side of the connection).
+ */
+#ifdef _WIN32
+DWORD WINAPI Receiver(LPVOID Object){
+#else
+void * Receiver(void * Object){
+#endif
+	BenchmarkRun * Run = (BenchmarkRun *) Object;
+
+	try{
+		ServerSocket Socket(Run->Port);
+		TCPIPSpikeProtocol Protocol(&Socket, SERVER, Run->Version, Run->Delta);
+
+		for (unsigned int i=0; i<Run->Steps; ++i){
+			double Time;
+			unsigned int N = Protocol.ReceiveSpikes(Time);
+			const TCPIPSpike * Spikes = Protocol.GetSpikes();
+			for (unsigned int j=0; j<N; ++j){
+				Run->Checksum += Spikes[j].Neuron + Spikes[j].Time;
+			}
+			Run->Received += N;
+		}
+	} catch (EDLUTException Exc){
+		cerr << Exc << endl;
+		Run->Failed = true;
+	}
+
+	return 0;
+}
+
+/*!
+ * It fills a batch of sorted spikes (like the output of a simulation step).
+ */
+static void FillBatch(TCPIPSpike * Spikes, unsigned int Number, unsigned int NumberOfNeurons, double Time, double Step){
+	for (unsigned int i=0; i<Number; ++i){
+		Spikes[i].Neuron = rand()%NumberOfNeurons;
+		Spikes[i].Time = (float) (Time + Step*i/Number);
+	}
+}
+
+/*!
+ * It runs the sender and the receiver of a benchmark run through the loopback interface.
+ *
+ * \return The time (in seconds) of the run. A negative value if it has failed.
+ */
+static double RunBenchmark(BenchmarkRun & Run){
+	const unsigned int NumberOfNeurons = 100000;
+	const double Step = 0.002;
+
+	Run.Received = 0;
+	Run.Checksum = 0;
+	Run.Failed = false;
+
+#ifdef _WIN32
+	HANDLE Thread = CreateThread(NULL, 0, Receiver, &Run, 0, NULL);
+	// Let the receiver start listening
+	Sleep(200);
+#else
+	pthread_t Thread;
+	pthread_create(&Thread, NULL, Receiver, &Run);
+	// Let the receiver start listening
+	usleep(200000);
+#endif
+
+	// Several batches are precalculated, so the sender only measures the communication
+	const unsigned int NumberOfBatches = 8;
+	TCPIPSpike * Batches = new TCPIPSpike [NumberOfBatches*Run.SpikesPerStep];
+	for (unsigned int i=0; i<NumberOfBatches; ++i){
+		FillBatch(Batches+i*Run.SpikesPerStep, Run.SpikesPerStep, NumberOfNeurons, i*Step, Step);
+	}
+
+	clock_t startt, endt;
+
+	double Checksum = 0;
+	try{
+		ClientSocket Socket("127.0.0.1", Run.Port);
+		TCPIPSpikeProtocol Protocol(&Socket, CLIENT, Run.Version, Run.Delta);
+
+		startt = clock();
+		for (unsigned int i=0; i<Run.Steps; ++i){
+			TCPIPSpike * Batch = Batches+(i%NumberOfBatches)*Run.SpikesPerStep;
+			Protocol.SendSpikes((i%NumberOfBatches)*Step, Batch, Run.SpikesPerStep);
+		}
+
+#ifdef _WIN32
+		WaitForSingleObject(Thread, INFINITE);
+		CloseHandle(Thread);
+#else
+		pthread_join(Thread, NULL);
+#endif
+		endt = clock();
+	} catch (EDLUTException Exc){
+		cerr << Exc << endl;
+		delete [] Batches;
+		return -1;
+	}
+
+	for (unsigned int i=0; i<Run.Steps; ++i){
+		TCPIPSpike * Batch = Batches+(i%NumberOfBatches)*Run.SpikesPerStep;
+		for (unsigned int j=0; j<Run.SpikesPerStep; ++j){
+			Checksum += Batch[j].Neuron + Batch[j].Time;
+		}
+	}
+
+	delete [] Batches;
+
+	if (Run.Failed || Run.Received!=(unsigned long long)Run.Steps*Run.SpikesPerStep || Checksum!=Run.Checksum){
+		cerr << "Error: the received spikes do not match the sent spikes" << endl;
+		return -1;
+	}
+
+	return (endt-startt)/(double)CLOCKS_PER_SEC;
+}
+
+/*!
+ * 
+ * It measures the throughput of the TCP/IP spike protocols through the loopback interface
+ * (version 1 protocol, version 2 protocol and version 2 protocol with delta-encoded payloads).
+ * The time is the processor time of both ends of the connection.
+ * 
+ * \note  parameters:
+ * 			Port	The first TCP port of the runs (each run uses the next port). 5600 by default.
+ * 			Spikes_Per_Step	Number of spikes of each batch. 50000 by default.
+ * 			Steps	Number of batches of each run. 200 by default.
+ * 
+ */ 
+int main(int ac, char *av[]) {
+	unsigned int Port = 5600, SpikesPerStep = 50000, Steps = 200;
+
+	if (ac>4){
+		cerr << "Usage: " << av[0] << " [Port] [Spikes_Per_Step] [Steps]" << endl;
+		return 1;
+	}
+
+	if (ac>1) Port = atoi(av[1]);
+	if (ac>2) SpikesPerStep = atoi(av[2]);
+	if (ac>3) Steps = atoi(av[3]);
+
+	cout << "TCP/IP loopback benchmark: " << Steps << " steps of " << SpikesPerStep << " spikes" << endl;
+
+	const char * Names[] = {"Version 1", "Version 2", "Version 2 (delta)"};
+	const unsigned int Versions[] = {1, 2, 2};
+	const bool Deltas[] = {false, false, true};
+
+	for (unsigned int i=0; i<3; ++i){
+		cout << Names[i] << ":\t";
+
+		if (Versions[i]==1 && SpikesPerStep>TCPIPVERSION1MAXSPIKES){
+			cout << "not available (more than " << TCPIPVERSION1MAXSPIKES << " spikes per step)" << endl;
+			continue;
+		}
+
+		BenchmarkRun Run;
+		Run.Port = Port+i;
+		Run.Version = Versions[i];
+		Run.Delta = Deltas[i];
+		Run.SpikesPerStep = SpikesPerStep;
+		Run.Steps = Steps;
+
+		double Time = RunBenchmark(Run);
+		if (Time<0){
+			return 1;
+		}
+
+		cout << Time << " s\t" << (double)SpikesPerStep*Steps/Time*1e-6 << " Mspikes/s" << endl;
+	}
+
+	return 0;
+}
@@ -18,7 +18,6 @@
 
 #include "../../include/simulation/EventQueue.h"
 
-#include "../../include/spike/InputSpike.h"
 #include "../../include/spike/Network.h"
 
 ArrayInputSpikeDriver::ArrayInputSpikeDriver() {
@@ -37,9 +36,7 @@ void ArrayInputSpikeDriver::LoadInputs(EventQueue * Queue, Network * Net) throw
 void ArrayInputSpikeDriver::LoadInputs(EventQueue * Queue, Network * Net, int NumSpikes, double * Times, long int * Cells) throw (EDLUTFileException){
 	if (NumSpikes>0){
 		for (int i=0; i<NumSpikes; ++i){
-			InputSpike * NewSpike = new InputSpike(Times[i], Net->GetNeuronAt(Cells[i]));
-
-			Queue->InsertEvent(NewSpike);
+			Queue->InsertInputSpike(Times[i], Net->GetNeuronAt(Cells[i]));
 		}
 
 	}
@@ -19,19 +19,50 @@
 #include "../../include/spike/Spike.h"
 #include "../../include/spike/Neuron.h"
 
-ArrayOutputSpikeDriver::ArrayOutputSpikeDriver() {
-	// TODO Auto-generated constructor stub
-
+#include <cstring>
+
+ArrayOutputSpikeDriver::ArrayOutputSpikeDriver(): WriteBuffer(0), ReadPosition(0) {
+	for (int i=0; i<2; ++i){
+		this->BufferTimes[i] = 0;
+		this->BufferCells[i] = 0;
+		this->BufferSize[i] = 0;
+		this->BufferCapacity[i] = 0;
+	}
 }
 
 ArrayOutputSpikeDriver::~ArrayOutputSpikeDriver() {
-	// TODO Auto-generated destructor stub
+	for (int i=0; i<2; ++i){
+		if (this->BufferTimes[i]){
+			delete [] this->BufferTimes[i];
+			delete [] this->BufferCells[i];
+		}
+	}
 }
 
 void ArrayOutputSpikeDriver::WriteSpike(const Spike * NewSpike) throw (EDLUTException){
-	OutputSpike spike(NewSpike->GetSource()->GetIndex(),NewSpike->GetTime());
+	int Buffer = this->WriteBuffer;
+	int Size = this->BufferSize[Buffer];
+
+	if (Size==this->BufferCapacity[Buffer]){
+		// The buffer grows geometrically (it is reused in the following slots)
+		int NewCapacity = (Size>0)?2*Size:1024;
+		double * NewTimes = new double [NewCapacity];
+		long int * NewCells = new long int [NewCapacity];
+		if (Size>0){
+			memcpy(NewTimes, this->BufferTimes[Buffer], Size*sizeof(double));
+			memcpy(NewCells, this->BufferCells[Buffer], Size*sizeof(long int));
+			delete [] this->BufferTimes[Buffer];
+			delete [] this->BufferCells[Buffer];
+		}
+		this->BufferTimes[Buffer] = NewTimes;
+		this->BufferCells[Buffer] = NewCells;
+		this->BufferCapacity[Buffer] = NewCapacity;
+	}
 
-	this->OutputBuffer.push_back(spike);
+	// The times keep the single precision of the former output buffer
+	this->BufferTimes[Buffer][Size] = (float) NewSpike->GetTime();
+	this->BufferCells[Buffer][Size] = NewSpike->GetSource()->GetIndex();
+	this->BufferSize[Buffer] = Size+1;
 }
 
 void ArrayOutputSpikeDriver::WriteState(float Time, Neuron * Source) throw (EDLUTException){
@@ -52,7 +83,9 @@ void ArrayOutputSpikeDriver::FlushBuffers() throw (EDLUTException){
 }
 
 int ArrayOutputSpikeDriver::GetBufferedSpikes(double *& Times, long int *& Cells){
-	int size = this->OutputBuffer.size();
+	const double * SlotTimes;
+	const long int * SlotCells;
+	int size = this->GetSlotSpikes(SlotTimes, SlotCells);
 
 	if (size>0){
 		Times = (double *) new double [size];
@@ -67,24 +100,40 @@ int ArrayOutputSpikeDriver::GetBufferedSpikes(double *& Times, long int *& Cells
 			cerr << "Error: Not enough memory" << endl;
 		}
 
-		for (int i=0; i<size; ++i){
-			Times[i] = this->OutputBuffer[i].Time;
-			Cells[i] = this->OutputBuffer[i].Neuron;
-		}
-
-		this->OutputBuffer.clear();
+		memcpy(Times, SlotTimes, size*sizeof(double));
+		memcpy(Cells, SlotCells, size*sizeof(long int));
 	}
 
 	return size;
 
 }
 
+int ArrayOutputSpikeDriver::GetSlotSpikes(const double *& Times, const long int *& Cells){
+	int Buffer = this->WriteBuffer;
+	int size = this->BufferSize[Buffer]-this->ReadPosition;
+
+	Times = this->BufferTimes[Buffer]+this->ReadPosition;
+	Cells = this->BufferCells[Buffer]+this->ReadPosition;
+
+	// The new spikes are written in the other buffer
+	this->WriteBuffer = 1-Buffer;
+	this->BufferSize[this->WriteBuffer] = 0;
+	this->ReadPosition = 0;
+
+	return size;
+}
+
 bool ArrayOutputSpikeDriver::RemoveBufferedSpike(double & Time, long int & Cell){
-	bool noempty = !this->OutputBuffer.empty();
+	int Buffer = this->WriteBuffer;
+	bool noempty = (this->ReadPosition<this->BufferSize[Buffer]);
 	if (noempty){
-		Time = this->OutputBuffer[0].Time;
-		Cell = this->OutputBuffer[0].Neuron;
-		this->OutputBuffer.erase(this->OutputBuffer.begin());
+		Time = this->BufferTimes[Buffer][this->ReadPosition];
+		Cell = this->BufferCells[Buffer][this->ReadPosition];
+		if (++this->ReadPosition==this->BufferSize[Buffer]){
+			// All the spikes have been removed
+			this->BufferSize[Buffer] = 0;
+			this->ReadPosition = 0;
+		}
 	}
 	return noempty;
 }
@@ -0,0 +1,351 @@
+/***************************************************************************
+ *                           AsynchronousOutputSpikeDriver.cpp             *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/communication/AsynchronousOutputSpikeDriver.h"
+
+#include "../../include/neuron_model/VectorNeuronState.h"
+
+#include "../../include/spike/InternalSpike.h"
+#include "../../include/spike/Neuron.h"
+
+#ifndef _WIN32
+	#include <sched.h>
+	#include <unistd.h>
+	#ifdef __linux__
+		#include <climits>
+		#include <time.h>
+		#include <linux/futex.h>
+		#include <sys/syscall.h>
+	#endif
+#endif
+
+/*!
+ * Kinds of records (any other value is the number of state values of a state record).
+ */
+#define ASYNCSPIKERECORD 0xFFFFFFFF
+#define ASYNCFLUSHRECORD 0xFFFFFFFE
+#define ASYNCENDRECORD 0xFFFFFFFD
+
+/*!
+ * It orders the memory accesses of the producer and the consumer.
+ */
+static inline void MemoryFence(){
+#ifdef _WIN32
+	MemoryBarrier();
+#else
+	__sync_synchronize();
+#endif
+}
+
+AsynchronousOutputSpikeDriver::AsynchronousOutputSpikeDriver(OutputSpikeDriver * NewDriver, unsigned long NewRingSize) throw (EDLUTException): Driver(NewDriver), Ring(0), RingSize(1), Head(0), WakeSequence(0), Tail(0), WriterWaiting(0), HighWaterMark(0), Stalls(0), FlushTime(0.0), Error(0){
+	while (this->RingSize<NewRingSize){
+		this->RingSize *= 2;
+	}
+
+	this->Ring = new AsynchronousOutputSlot [this->RingSize];
+
+	// The states are filtered before they are stored in the ring
+	this->CopyStateMonitoring(NewDriver);
+
+#ifdef _WIN32
+	this->WriterEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+	this->Writer = CreateThread(NULL, 0, WriterThread, this, 0, NULL);
+	if (this->Writer==NULL){
+		CloseHandle(this->WriterEvent);
+#else
+	if (pthread_create(&this->Writer, NULL, WriterThread, this)!=0){
+#endif
+		delete [] this->Ring;
+		throw EDLUTException(2,73,32,0);
+	}
+}
+		
+AsynchronousOutputSpikeDriver::~AsynchronousOutputSpikeDriver(){
+	unsigned long Position = this->Head;
+	while (this->RingSize-(Position-this->Tail)<1){
+#ifdef _WIN32
+		SwitchToThread();
+#else
+		sched_yield();
+#endif
+	}
+	this->Ring[Position&(this->RingSize-1)].Kind = ASYNCENDRECORD;
+	this->PublishSlots(1);
+	this->WakeWriter();
+
+#ifdef _WIN32
+	WaitForSingleObject(this->Writer, INFINITE);
+	CloseHandle(this->Writer);
+	CloseHandle(this->WriterEvent);
+#else
+	pthread_join(this->Writer, NULL);
+#endif
+
+	cout << "Asynchronous output: ring high-water mark " << this->HighWaterMark << " of " << this->RingSize << " slots, " << this->Stalls << " stalls" << endl;
+
+	if (this->Error){
+		delete this->Error;
+	}
+
+	delete [] this->Ring;
+	delete this->Driver;
+}
+
+unsigned long AsynchronousOutputSpikeDriver::ReserveSlots(unsigned long Slots) throw (EDLUTException){
+	if (this->Error){
+		throw *this->Error;
+	}
+
+	if (Slots>this->RingSize){
+		throw EDLUTException(3,3,2,0);
+	}
+
+	unsigned long Position = this->Head;
+	unsigned long Used = Position-this->Tail+Slots;
+	if (Used>this->RingSize){
+		this->Stalls++;
+		this->WakeWriter();
+		do {
+#ifdef _WIN32
+			SwitchToThread();
+#else
+			sched_yield();
+#endif
+			Used = Position-this->Tail+Slots;
+		} while (Used>this->RingSize);
+	}
+
+	if (Used>this->HighWaterMark){
+		this->HighWaterMark = Used;
+	}
+
+	return Position;
+}
+
+void AsynchronousOutputSpikeDriver::PublishSlots(unsigned long Slots){
+	// The records must be visible before the new position
+	MemoryFence();
+	this->Head = this->Head+Slots;
+}
+
+void AsynchronousOutputSpikeDriver::WakeWriter(){
+	// The new position must be visible before the writer state is checked
+	MemoryFence();
+	if (this->WriterWaiting){
+		this->WakeSequence = this->WakeSequence+1;
+#if defined(_WIN32)
+		SetEvent(this->WriterEvent);
+#elif defined(__linux__)
+		syscall(SYS_futex, (unsigned int *) &this->WakeSequence, FUTEX_WAKE, INT_MAX, 0, 0, 0);
+#endif
+	}
+}
+
+void AsynchronousOutputSpikeDriver::DrainRing(){
+	unsigned long Mask = this->RingSize-1;
+	unsigned long Position = this->Tail;
+
+	unsigned int MaxNumberOfValues = 16;
+	double * Values = new double [MaxNumberOfValues];
+
+	unsigned int Spins = 0;
+
+	while (true){
+		unsigned long Last = this->Head;
+		if (Position==Last){
+			if (Spins<ASYNCOUTPUTSPINS){
+				++Spins;
+#ifdef _WIN32
+				SwitchToThread();
+#else
+				sched_yield();
+#endif
+			} else {
+				// Sleep until the producer wakes the writer up (at most 1 ms)
+				unsigned int Sequence = this->WakeSequence;
+				this->WriterWaiting = 1;
+				MemoryFence();
+				if (this->Head==Last){
+#if defined(_WIN32)
+					WaitForSingleObject(this->WriterEvent, 1);
+#elif defined(__linux__)
+					struct timespec Timeout = {0, 1000000};
+					syscall(SYS_futex, (unsigned int *) &this->WakeSequence, FUTEX_WAIT, Sequence, &Timeout, 0, 0);
+#else
+					usleep(1000);
+#endif
+				}
+				this->WriterWaiting = 0;
+			}
+			continue;
+		}
+
+		Spins = 0;
+
+		// The records must be read after the new position
+		MemoryFence();
+
+		bool End = false;
+		while (Position!=Last){
+			unsigned int Kind = this->Ring[Position&Mask].Kind;
+			double Time = 0.0;
+			Neuron * Source = 0;
+			if (Kind==ASYNCENDRECORD){
+				End = true;
+				Position++;
+				break;
+			} else if (Kind==ASYNCFLUSHRECORD){
+				Time = this->Ring[(Position+1)&Mask].Value;
+				Position += 2;
+			} else {
+				Time = this->Ring[(Position+1)&Mask].Value;
+				Source = this->Ring[(Position+2)&Mask].Source;
+				Position += 3;
+
+				if (Kind!=ASYNCSPIKERECORD){
+					if (Kind>MaxNumberOfValues){
+						delete [] Values;
+						while (Kind>MaxNumberOfValues){
+							MaxNumberOfValues *= 2;
+						}
+						Values = new double [MaxNumberOfValues];
+					}
+
+					for (unsigned int i=0; i<Kind; ++i){
+						Values[i] = this->Ring[(Position+i)&Mask].Value;
+					}
+					Position += Kind;
+				}
+			}
+
+			// After an error the records are discarded
+			if (!this->Error){
+				try {
+					if (Kind==ASYNCFLUSHRECORD){
+						this->Driver->SetFlushTime(Time);
+						this->Driver->FlushBuffers();
+					} else if (Kind==ASYNCSPIKERECORD){
+						InternalSpike Event(Time, Source);
+						this->Driver->WriteSpike(&Event);
+					} else {
+						this->Driver->WriteStateValues((float) Time, Source, Kind, Values);
+					}
+				} catch (EDLUTException Exc){
+					EDLUTException * NewError = new EDLUTException(Exc);
+					MemoryFence();
+					this->Error = NewError;
+				}
+			}
+		}
+
+		// The slots must be read before they are released
+		MemoryFence();
+		this->Tail = Position;
+
+		if (End){
+			break;
+		}
+	}
+
+	delete [] Values;
+}
+
+#ifdef _WIN32
+DWORD WINAPI AsynchronousOutputSpikeDriver::WriterThread(LPVOID Object){
+	((AsynchronousOutputSpikeDriver *) Object)->DrainRing();
+	return 0;
+}
+#else
+void * AsynchronousOutputSpikeDriver::WriterThread(void * Object){
+	((AsynchronousOutputSpikeDriver *) Object)->DrainRing();
+	return NULL;
+}
+#endif
+
+void AsynchronousOutputSpikeDriver::WriteSpike(const Spike * NewSpike) throw (EDLUTException){
+	unsigned long Position = this->ReserveSlots(3);
+	unsigned long Mask = this->RingSize-1;
+
+	this->Ring[Position&Mask].Kind = ASYNCSPIKERECORD;
+	this->Ring[(Position+1)&Mask].Value = NewSpike->GetTime();
+	this->Ring[(Position+2)&Mask].Source = NewSpike->GetSource();
+
+	this->PublishSlots(3);
+}
+		
+void AsynchronousOutputSpikeDriver::WriteState(float Time, Neuron * Source) throw (EDLUTException){
+	VectorNeuronState * State = Source->GetVectorNeuronState();
+	int StateIndex = Source->GetIndex_VectorNeuronState();
+	unsigned int NumberOfValues = State->GetNumberOfPrintableValues();
+
+	unsigned long Position = this->ReserveSlots(3+NumberOfValues);
+	unsigned long Mask = this->RingSize-1;
+
+	this->Ring[Position&Mask].Kind = NumberOfValues;
+	this->Ring[(Position+1)&Mask].Value = Time;
+	this->Ring[(Position+2)&Mask].Source = Source;
+	for (unsigned int i=0; i<NumberOfValues; ++i){
+		this->Ring[(Position+3+i)&Mask].Value = State->GetPrintableValuesAt(StateIndex,i);
+	}
+
+	this->PublishSlots(3+NumberOfValues);
+}
+
+void AsynchronousOutputSpikeDriver::WriteStateValues(float Time, Neuron * Source, unsigned int NumberOfValues, const double * Values) throw (EDLUTException){
+	unsigned long Position = this->ReserveSlots(3+NumberOfValues);
+	unsigned long Mask = this->RingSize-1;
+
+	this->Ring[Position&Mask].Kind = NumberOfValues;
+	this->Ring[(Position+1)&Mask].Value = Time;
+	this->Ring[(Position+2)&Mask].Source = Source;
+	for (unsigned int i=0; i<NumberOfValues; ++i){
+		this->Ring[(Position+3+i)&Mask].Value = Values[i];
+	}
+
+	this->PublishSlots(3+NumberOfValues);
+}
+
+bool AsynchronousOutputSpikeDriver::IsBuffered() const{
+	return this->Driver->IsBuffered();
+}
+
+bool AsynchronousOutputSpikeDriver::IsWritePotentialCapable() const{
+	return this->Driver->IsWritePotentialCapable();
+}
+
+void AsynchronousOutputSpikeDriver::FlushBuffers() throw (EDLUTException){
+	unsigned long Position = this->ReserveSlots(2);
+	unsigned long Mask = this->RingSize-1;
+
+	this->Ring[Position&Mask].Kind = ASYNCFLUSHRECORD;
+	this->Ring[(Position+1)&Mask].Value = this->FlushTime;
+
+	this->PublishSlots(2);
+	this->WakeWriter();
+}
+
+void AsynchronousOutputSpikeDriver::SetFlushTime(double Time){
+	this->FlushTime = Time;
+}
+
+ostream & AsynchronousOutputSpikeDriver::PrintInfo(ostream & out){
+
+	out << "- Asynchronous Output Spike Driver: " << this->RingSize << " slots" << endl;
+
+	this->Driver->PrintInfo(out);
+
+	return out;
+}
@@ -0,0 +1,147 @@
+/***************************************************************************
+ *                           BinaryFileOutputSpikeDriver.cpp               *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/communication/BinaryFileOutputSpikeDriver.h"
+
+#include "../../include/neuron_model/VectorNeuronState.h"
+
+#include "../../include/spike/Spike.h"
+#include "../../include/spike/Neuron.h"
+
+#include <cstring>
+
+BinaryFileOutputSpikeDriver::BinaryFileOutputSpikeDriver(const char * NewFileName, bool WritePotential) throw (EDLUTException): FileName(NewFileName){
+	this->PotentialWriteable = WritePotential;
+	this->Handler = fopen(NewFileName,"wb");
+	if (!this->Handler){
+		throw EDLUTException(2,2,2,0);
+	}
+
+	this->BufferSize = BINARYOUTPUTBUFFERSIZE;
+	this->BufferUsed = 0;
+	this->Buffer = new char [this->BufferSize];
+
+	char * Record = this->ReserveRecord(BINARYOUTPUTHEADERSIZE);
+	unsigned int Version = BINARYOUTPUTVERSION;
+	unsigned int ByteOrder = BINARYOUTPUTBYTEORDER;
+	memcpy(Record, BINARYOUTPUTSIGNATURE, 8);
+	memcpy(Record+8, &Version, sizeof(unsigned int));
+	memcpy(Record+12, &ByteOrder, sizeof(unsigned int));
+}
+		
+BinaryFileOutputSpikeDriver::~BinaryFileOutputSpikeDriver(){
+	if (this->Handler){
+		if (this->BufferUsed>0){
+			fwrite(this->Buffer, 1, this->BufferUsed, this->Handler);
+		}
+		fclose(this->Handler);
+		this->Handler=NULL;
+	}
+
+	delete [] this->Buffer;
+}
+
+char * BinaryFileOutputSpikeDriver::ReserveRecord(unsigned int Size) throw (EDLUTException){
+	if (this->BufferUsed+Size>this->BufferSize){
+		this->FlushBuffers();
+
+		if (Size>this->BufferSize){
+			delete [] this->Buffer;
+			while (Size>this->BufferSize){
+				this->BufferSize *= 2;
+			}
+			this->Buffer = new char [this->BufferSize];
+		}
+	}
+
+	char * Record = this->Buffer+this->BufferUsed;
+	this->BufferUsed += Size;
+	return Record;
+}
+
+void BinaryFileOutputSpikeDriver::WriteSpike(const Spike * NewSpike) throw (EDLUTException){
+	char * Record = this->ReserveRecord(BINARYOUTPUTRECORDSIZE);
+
+	double Time = NewSpike->GetTime();
+	int Index = (int) NewSpike->GetSource()->GetIndex();
+	unsigned int NumberOfValues = 0;
+	memcpy(Record, &Time, sizeof(double));
+	memcpy(Record+8, &Index, sizeof(int));
+	memcpy(Record+12, &NumberOfValues, sizeof(unsigned int));
+}
+		
+void BinaryFileOutputSpikeDriver::WriteState(float Time, Neuron * Source) throw (EDLUTException){
+	VectorNeuronState * State = Source->GetVectorNeuronState();
+	int StateIndex = Source->GetIndex_VectorNeuronState();
+	unsigned int NumberOfValues = State->GetNumberOfPrintableValues();
+
+	char * Record = this->ReserveRecord(BINARYOUTPUTRECORDSIZE+NumberOfValues*sizeof(double));
+
+	double RecordTime = Time;
+	int Index = (int) Source->GetIndex();
+	memcpy(Record, &RecordTime, sizeof(double));
+	memcpy(Record+8, &Index, sizeof(int));
+	memcpy(Record+12, &NumberOfValues, sizeof(unsigned int));
+
+	Record += BINARYOUTPUTRECORDSIZE;
+	for (unsigned int i=0; i<NumberOfValues; ++i){
+		double Value = State->GetPrintableValuesAt(StateIndex,i);
+		memcpy(Record, &Value, sizeof(double));
+		Record += sizeof(double);
+	}
+}
+
+void BinaryFileOutputSpikeDriver::WriteStateValues(float Time, Neuron * Source, unsigned int NumberOfValues, const double * Values) throw (EDLUTException){
+	char * Record = this->ReserveRecord(BINARYOUTPUTRECORDSIZE+NumberOfValues*sizeof(double));
+
+	double RecordTime = Time;
+	int Index = (int) Source->GetIndex();
+	memcpy(Record, &RecordTime, sizeof(double));
+	memcpy(Record+8, &Index, sizeof(int));
+	memcpy(Record+12, &NumberOfValues, sizeof(unsigned int));
+	memcpy(Record+BINARYOUTPUTRECORDSIZE, Values, NumberOfValues*sizeof(double));
+}
+
+bool BinaryFileOutputSpikeDriver::IsBuffered() const{
+	return false;	
+}
+
+bool BinaryFileOutputSpikeDriver::IsWritePotentialCapable() const{
+	return this->PotentialWriteable;	
+}
+
+void BinaryFileOutputSpikeDriver::FlushBuffers() throw (EDLUTException){
+	if (this->BufferUsed>0){
+		if (fwrite(this->Buffer, 1, this->BufferUsed, this->Handler)!=this->BufferUsed){
+			throw EDLUTException(3,3,2,0);
+		}
+		this->BufferUsed = 0;
+	}
+}
+
+ostream & BinaryFileOutputSpikeDriver::PrintInfo(ostream & out){
+
+	out << "- Binary File Output Spike Driver: " << this->FileName << endl;
+
+	if (this->PotentialWriteable) out << "\tWriteable Potential" << endl;
+	else out << "\tNon-writeable Potential" << endl;
+
+	this->PrintStateMonitoring(out);
+
+	out << "\tBuffer size: " << this->BufferSize << " bytes" << endl;
+
+	return out;
+}
@@ -35,6 +35,9 @@
 	#include <unistd.h> // misc symbolic constants and types
 	#include <netdb.h>
 	#include <netinet/tcp.h>
+	#include <sys/uio.h> // writev
+	#include <sys/select.h>
+	#include <errno.h>
 #endif
 
 #define SERVER_PATH "server"
@@ -239,4 +242,69 @@ int CdSocket::sendBuffer(void* buffer, int buffer_size){
 	return int(send(socket_fd,(char *)buffer,buffer_size,0));
 }
 
+int CdSocket::sendBuffers(void** buffers, int* buffer_sizes, int buffer_number){
+	int total=0;
+#ifdef _WIN32
+	WSABUF blocks[CDSOCKETMAXBUFFERS];
+	DWORD sent;
+	for(int i=0;i<buffer_number;i++){
+		blocks[i].buf=(char *)buffers[i];
+		blocks[i].len=buffer_sizes[i];
+		total+=buffer_sizes[i];
+	}
+	// A blocking WSASend doesn't return until every block has been sent
+	if(WSASend(socket_fd,blocks,buffer_number,&sent,0,NULL,NULL)!=0){
+		return -1;
+	}
+	return int(sent);
+#else
+	struct iovec blocks[CDSOCKETMAXBUFFERS];
+	for(int i=0;i<buffer_number;i++){
+		blocks[i].iov_base=buffers[i];
+		blocks[i].iov_len=buffer_sizes[i];
+	}
+	/*** writev can send only part of the blocks ***/
+	struct iovec * first=blocks;
+	int remaining=buffer_number;
+	while(remaining>0){
+		ssize_t sent=writev(socket_fd,first,remaining);
+		if(sent<0){
+			if(errno==EINTR)
+				continue;
+			return -1;
+		}
+		total+=int(sent);
+		while(remaining>0 && (size_t)sent>=first->iov_len){
+			sent-=first->iov_len;
+			first++;
+			remaining--;
+		}
+		if(remaining>0){
+			first->iov_base=((char *)first->iov_base)+sent;
+			first->iov_len-=sent;
+		}
+	}
+	return total;
+#endif
+}
+
+bool CdSocket::waitForData(int timeout){
+	fd_set descriptors;
+	struct timeval wait_time;
+	FD_ZERO(&descriptors);
+	FD_SET(socket_fd,&descriptors);
+	wait_time.tv_sec=timeout/1000;
+	wait_time.tv_usec=(timeout%1000)*1000;
+	return select(int(socket_fd)+1,&descriptors,NULL,NULL,&wait_time)>0;
+}
+
+int CdSocket::peekBuffer(void* buffer, int buffer_size){
+#ifdef _WIN32
+	// It is only called after waitForData, so the data is already available
+	return int(recv(socket_fd,(char *)buffer,buffer_size,MSG_PEEK));
+#else
+	return int(recv(socket_fd,(char *)buffer,buffer_size,MSG_PEEK|MSG_DONTWAIT));
+#endif
+}
+
 
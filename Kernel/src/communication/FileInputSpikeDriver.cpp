@@ -21,7 +21,6 @@
 
 #include "../../include/spike/EDLUTFileException.h"
 #include "../../include/spike/Network.h"
-#include "../../include/spike/InputSpike.h"
 
 FileInputSpikeDriver::FileInputSpikeDriver(const char * NewFileName) throw (EDLUTException): FileName(NewFileName), Currentline(1L){
 	this->Finished = false;
@@ -55,9 +54,7 @@ void FileInputSpikeDriver::LoadInputs(EventQueue * Queue, Network * Net) throw (
 						if(i<=ninputs){
 							for(itime=0;itime<nspikes;itime++){
 								for(ineuron=0;ineuron<nreps;ineuron++){
-									InputSpike * ispike = new InputSpike(time+itime*interv, Net->GetNeuronAt(nneuron+ineuron));
-									
-									Queue->InsertEvent(ispike);
+									Queue->InsertInputSpike(time+itime*interv, Net->GetNeuronAt(nneuron+ineuron));
 								}
 							}
 						}else{
@@ -54,6 +54,19 @@ void FileOutputSpikeDriver::WriteState(float Time, Neuron * Source) throw (EDLUT
 		throw EDLUTException(3,3,2,0);
 }
 
+void FileOutputSpikeDriver::WriteStateValues(float Time, Neuron * Source, unsigned int NumberOfValues, const double * Values) throw (EDLUTException){
+	if(fprintf(this->Handler,"%f\t%li",Time,Source->GetIndex()) < 0)
+		throw EDLUTException(3,3,2,0);
+
+	for (unsigned int i=0; i<NumberOfValues; ++i){
+		if(fprintf(this->Handler,"\t%1.12f",Values[i]) < 0)
+				throw EDLUTException(3,3,2,0);
+	}
+
+	if(fprintf(this->Handler,"\n") < 0)
+		throw EDLUTException(3,3,2,0);
+}
+
 bool FileOutputSpikeDriver::IsBuffered() const{
 	return false;	
 }
@@ -73,6 +86,8 @@ ostream & FileOutputSpikeDriver::PrintInfo(ostream & out){
 	if (this->PotentialWriteable) out << "\tWriteable Potential" << endl;
 	else out << "\tNon-writeable Potential" << endl;
 
+	this->PrintStateMonitoring(out);
+
 	return out;
 }
 	
@@ -0,0 +1,107 @@
+/***************************************************************************
+ *                           GeneratorInputSpikeDriver.cpp                 *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/communication/GeneratorInputSpikeDriver.h"
+
+#include "../../include/simulation/EventQueue.h"
+#include "../../include/simulation/GeneratorInputEvent.h"
+
+#include "../../include/spike/Network.h"
+
+GeneratorInputSpikeDriver::GeneratorInputSpikeDriver(int NewFirstNeuron, int NewNumberOfNeurons, double NewStep, double NewStartTime, unsigned int Seed): FirstNeuron(NewFirstNeuron), NumberOfNeurons(NewNumberOfNeurons), Step(NewStep), StartTime(NewStartTime), Windows(0), Scheduled(false){
+	this->Finished = false;
+	this->Rates = new double [this->NumberOfNeurons];
+	this->Remaining = new double [this->NumberOfNeurons];
+	for (int i=0; i<this->NumberOfNeurons; ++i){
+		this->Rates[i] = 0.0;
+		this->Remaining[i] = 0.0;
+	}
+
+	// The state of the xorshift generator can't be zero
+	this->RandomState = (Seed!=0)?Seed:88172645463325252ULL;
+}
+		
+GeneratorInputSpikeDriver::~GeneratorInputSpikeDriver(){
+	delete [] this->Rates;
+	delete [] this->Remaining;
+}
+
+double GeneratorInputSpikeDriver::RandomUniform(){
+	// xorshift64* generator (the 53 upper bits are used as mantissa)
+	this->RandomState ^= this->RandomState >> 12;
+	this->RandomState ^= this->RandomState << 25;
+	this->RandomState ^= this->RandomState >> 27;
+	return ((this->RandomState * 2685821657736338717ULL) >> 11) * (1.0/9007199254740992.0);
+}
+
+void GeneratorInputSpikeDriver::LoadInputs(EventQueue * Queue, Network * Net) throw (EDLUTException){
+	if (!this->Scheduled){
+		if (this->FirstNeuron<0 || this->NumberOfNeurons<0 || this->FirstNeuron+this->NumberOfNeurons>Net->GetNeuronNumber()){
+			throw EDLUTException(14,17,34,0);
+		}
+
+		for (int i=0; i<this->NumberOfNeurons; ++i){
+			this->Remaining[i] = this->NextSpikeMass();
+		}
+
+		this->Scheduled = true;
+
+		this->LoadWindow(Queue, Net, this->StartTime);
+	}
+}
+
+void GeneratorInputSpikeDriver::LoadWindow(EventQueue * Queue, Network * Net, double CurrentTime){
+	this->Windows++;
+	double EndTime = this->StartTime+this->Windows*this->Step;
+
+	for (int i=0; i<this->NumberOfNeurons; ++i){
+		double Rate = this->Rates[i];
+		if (Rate>0.0){
+			double Time = CurrentTime;
+			double Mass = this->Remaining[i];
+			while (Mass<Rate*(EndTime-Time)){
+				Time += Mass/Rate;
+				Queue->InsertInputSpike(Time, Net->GetNeuronAt(this->FirstNeuron+i));
+				Mass = this->NextSpikeMass();
+			}
+			this->Remaining[i] = Mass-Rate*(EndTime-Time);
+		}
+	}
+
+	Queue->InsertEvent(new GeneratorInputEvent(EndTime, this));
+}
+
+void GeneratorInputSpikeDriver::SetRate(int Index, double Rate){
+	this->Rates[Index] = Rate;
+}
+
+void GeneratorInputSpikeDriver::SetRates(const double * NewRates){
+	for (int i=0; i<this->NumberOfNeurons; ++i){
+		this->Rates[i] = NewRates[i];
+	}
+}
+
+double GeneratorInputSpikeDriver::GetRate(int Index) const{
+	return this->Rates[Index];
+}
+
+int GeneratorInputSpikeDriver::GetFirstNeuron() const{
+	return this->FirstNeuron;
+}
+
+int GeneratorInputSpikeDriver::GetNumberOfNeurons() const{
+	return this->NumberOfNeurons;
+}
@@ -18,7 +18,6 @@
 
 #include "../../include/simulation/EventQueue.h"
 
-#include "../../include/spike/InputSpike.h"
 #include "../../include/spike/Network.h"
 
 InputBooleanArrayDriver::InputBooleanArrayDriver(unsigned int InputLines, int * Associated):AssociatedCells(0),NumInputLines(InputLines){
@@ -38,9 +37,7 @@ InputBooleanArrayDriver::~InputBooleanArrayDriver() {
 void InputBooleanArrayDriver::LoadInputs(EventQueue * Queue, Network * Net, bool * InputLines, double CurrentTime) throw (EDLUTFileException){
 	for (unsigned int i=0; i<NumInputLines; ++i){
 		if (InputLines[i]){
-			InputSpike * NewSpike = new InputSpike(CurrentTime, Net->GetNeuronAt(this->AssociatedCells[i]));
-
-			Queue->InsertEvent(NewSpike);
+			Queue->InsertInputSpike(CurrentTime, Net->GetNeuronAt(this->AssociatedCells[i]));
 		}
 	}
 }
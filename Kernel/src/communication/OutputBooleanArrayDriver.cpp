@@ -19,38 +19,64 @@
 #include "../../include/spike/InputSpike.h"
 #include "../../include/spike/Network.h"
 
-OutputBooleanArrayDriver::OutputBooleanArrayDriver(unsigned int OutputLines, int * Associated):AssociatedCells(0),NumOutputLines(OutputLines){
+OutputBooleanArrayDriver::OutputBooleanArrayDriver(unsigned int OutputLines, int * Associated):AssociatedCells(0),NumOutputLines(OutputLines),FirstCell(0),CellRange(0),FirstLine(0),NextLine(0){
 	AssociatedCells = new int [this->NumOutputLines];
 
 	for (unsigned int i=0; i<this->NumOutputLines; ++i){
 		AssociatedCells[i] = Associated[i];
 	}
 
+	if (this->NumOutputLines>0){
+		long int LastCell = AssociatedCells[0];
+		this->FirstCell = AssociatedCells[0];
+		for (unsigned int i=1; i<this->NumOutputLines; ++i){
+			if (AssociatedCells[i]<this->FirstCell){
+				this->FirstCell = AssociatedCells[i];
+			}
+			if (AssociatedCells[i]>LastCell){
+				LastCell = AssociatedCells[i];
+			}
+		}
+		this->CellRange = LastCell-this->FirstCell+1;
+	}
+
+	// Index from cells to output lines (a cell can be associated to several lines)
+	this->FirstLine = new int [this->CellRange];
+	for (long int c=0; c<this->CellRange; ++c){
+		this->FirstLine[c] = -1;
+	}
+
+	this->NextLine = new int [this->NumOutputLines];
+	for (int i=this->NumOutputLines-1; i>=0; --i){
+		long int Cell = AssociatedCells[i]-this->FirstCell;
+		this->NextLine[i] = this->FirstLine[Cell];
+		this->FirstLine[Cell] = i;
+	}
+
 	return;
 }
 
 OutputBooleanArrayDriver::~OutputBooleanArrayDriver() {
 	delete [] AssociatedCells;
+	delete [] FirstLine;
+	delete [] NextLine;
 }
 
 void OutputBooleanArrayDriver::GetBufferedSpikes(bool * OutputLines){
 	memset(OutputLines,0,this->NumOutputLines*sizeof(bool));
 
-	int size = this->OutputBuffer.size();
+	const double * Times;
+	const long int * Cells;
+	int size = this->GetSlotSpikes(Times, Cells);
 
-	if (size>0){
+	for (int i=0; i<size; ++i){
+		long int Cell = Cells[i]-this->FirstCell;
 
-		for (int i=0; i<size; ++i){
-			int CellNumber = this->OutputBuffer[i].Neuron;
-
-			for (unsigned int j=0; j<this->NumOutputLines; ++j){
-				if (CellNumber==this->AssociatedCells[j]){
-					OutputLines[j] = true;
-				}
+		if (Cell>=0 && Cell<this->CellRange){
+			for (int j=this->FirstLine[Cell]; j>=0; j=this->NextLine[j]){
+				OutputLines[j] = true;
 			}
 		}
-
-		this->OutputBuffer.clear();
 	}
 
 	return;
@@ -16,5 +16,206 @@
 
 #include "../../include/communication/OutputSpikeDriver.h"
 
+#include "../../include/neuron_model/VectorNeuronState.h"
+
+#include "../../include/spike/Neuron.h"
+
+#include <cmath>
+
+OutputSpikeDriver::OutputSpikeDriver(): StateFiltered(false), StatePeriod(0.0), NextStateTime(0), NumberOfStateNeurons(0),
+	StateWindows(0), NumberOfStateWindows(0), StateVariables(0), NumberOfStateVariables(0), StateValues(0), StateOnlyAtFiring(false){
+}
+
 OutputSpikeDriver::~OutputSpikeDriver(){
+	if (this->NextStateTime!=0){
+		delete [] this->NextStateTime;
+	}
+
+	if (this->StateWindows!=0){
+		delete [] this->StateWindows;
+	}
+
+	if (this->StateVariables!=0){
+		delete [] this->StateVariables;
+		delete [] this->StateValues;
+	}
+}
+
+void OutputSpikeDriver::UpdateStateFiltered(){
+	this->StateFiltered = (this->StatePeriod>0.0 || this->NumberOfStateWindows>0 || this->NumberOfStateVariables>0 || this->StateOnlyAtFiring);
+}
+
+void OutputSpikeDriver::WriteStateValues(float Time, Neuron * Source, unsigned int NumberOfValues, const double * Values) throw (EDLUTException){
+	return;
+}
+
+void OutputSpikeDriver::SetFlushTime(double Time){
+	return;
+}
+
+void OutputSpikeDriver::MonitorState(float Time, Neuron * Source, bool Firing) throw (EDLUTException){
+	if (!this->StateFiltered){
+		this->WriteState(Time, Source);
+		return;
+	}
+
+	if (this->StateOnlyAtFiring && !Firing){
+		return;
+	}
+
+	if (this->NumberOfStateWindows>0){
+		unsigned int i = 0;
+		while (i<this->NumberOfStateWindows && !(Time>=this->StateWindows[2*i] && Time<this->StateWindows[2*i+1])){
+			i++;
+		}
+
+		if (i==this->NumberOfStateWindows){
+			return;
+		}
+	}
+
+	if (this->StatePeriod>0.0){
+		long int Index = Source->GetIndex();
+		if (Index>=this->NumberOfStateNeurons){
+			long int NewNumber = 2*this->NumberOfStateNeurons;
+			if (NewNumber<=Index){
+				NewNumber = Index+1;
+			}
+
+			float * NewTimes = new float [NewNumber];
+			for (long int i=0; i<this->NumberOfStateNeurons; ++i){
+				NewTimes[i] = this->NextStateTime[i];
+			}
+			for (long int i=this->NumberOfStateNeurons; i<NewNumber; ++i){
+				NewTimes[i] = 0.0f;
+			}
+
+			if (this->NextStateTime!=0){
+				delete [] this->NextStateTime;
+			}
+			this->NextStateTime = NewTimes;
+			this->NumberOfStateNeurons = NewNumber;
+		}
+
+		if (Time<this->NextStateTime[Index]){
+			return;
+		}
+
+		// The sample times are rounded as the event times (float) to compare them exactly
+		double Sample = floor(Time/this->StatePeriod)+1.0;
+		this->NextStateTime[Index] = (float) (Sample*this->StatePeriod);
+		if (this->NextStateTime[Index]<=Time){
+			this->NextStateTime[Index] = (float) ((Sample+1.0)*this->StatePeriod);
+		}
+	}
+
+	if (this->NumberOfStateVariables>0){
+		VectorNeuronState * State = Source->GetVectorNeuronState();
+		int StateIndex = Source->GetIndex_VectorNeuronState();
+		unsigned int NumberOfValues = State->GetNumberOfPrintableValues();
+		unsigned int Written = 0;
+		for (unsigned int i=0; i<this->NumberOfStateVariables; ++i){
+			if (this->StateVariables[i]<NumberOfValues){
+				this->StateValues[Written++] = State->GetPrintableValuesAt(StateIndex,this->StateVariables[i]);
+			}
+		}
+
+		this->WriteStateValues(Time, Source, Written, this->StateValues);
+	} else {
+		this->WriteState(Time, Source);
+	}
+}
+
+void OutputSpikeDriver::SetStateSamplingPeriod(double Period){
+	this->StatePeriod = (Period>0.0)?Period:0.0;
+
+	// The sampling starts again
+	for (long int i=0; i<this->NumberOfStateNeurons; ++i){
+		this->NextStateTime[i] = 0.0f;
+	}
+
+	this->UpdateStateFiltered();
+}
+
+void OutputSpikeDriver::AddStateWindow(double Start, double End){
+	double * NewWindows = new double [2*(this->NumberOfStateWindows+1)];
+	for (unsigned int i=0; i<2*this->NumberOfStateWindows; ++i){
+		NewWindows[i] = this->StateWindows[i];
+	}
+	NewWindows[2*this->NumberOfStateWindows] = Start;
+	NewWindows[2*this->NumberOfStateWindows+1] = End;
+
+	if (this->StateWindows!=0){
+		delete [] this->StateWindows;
+	}
+	this->StateWindows = NewWindows;
+	this->NumberOfStateWindows++;
+
+	this->UpdateStateFiltered();
+}
+
+void OutputSpikeDriver::SetStateVariables(unsigned int Number, const unsigned int * Variables){
+	if (this->StateVariables!=0){
+		delete [] this->StateVariables;
+		delete [] this->StateValues;
+		this->StateVariables = 0;
+		this->StateValues = 0;
+	}
+
+	this->NumberOfStateVariables = Number;
+	if (Number>0){
+		this->StateVariables = new unsigned int [Number];
+		this->StateValues = new double [Number];
+		for (unsigned int i=0; i<Number; ++i){
+			this->StateVariables[i] = Variables[i];
+		}
+	}
+
+	this->UpdateStateFiltered();
+}
+
+void OutputSpikeDriver::SetStateOnlyAtFiring(bool OnlyAtFiring){
+	this->StateOnlyAtFiring = OnlyAtFiring;
+
+	this->UpdateStateFiltered();
+}
+
+void OutputSpikeDriver::CopyStateMonitoring(const OutputSpikeDriver * Driver){
+	this->SetStateSamplingPeriod(Driver->StatePeriod);
+
+	if (this->StateWindows!=0){
+		delete [] this->StateWindows;
+		this->StateWindows = 0;
+	}
+	this->NumberOfStateWindows = 0;
+	for (unsigned int i=0; i<Driver->NumberOfStateWindows; ++i){
+		this->AddStateWindow(Driver->StateWindows[2*i], Driver->StateWindows[2*i+1]);
+	}
+
+	this->SetStateVariables(Driver->NumberOfStateVariables, Driver->StateVariables);
+	this->SetStateOnlyAtFiring(Driver->StateOnlyAtFiring);
+}
+
+ostream & OutputSpikeDriver::PrintStateMonitoring(ostream & out){
+	if (this->StatePeriod>0.0){
+		out << "\tState sampling period: " << this->StatePeriod << "s" << endl;
+	}
+
+	for (unsigned int i=0; i<this->NumberOfStateWindows; ++i){
+		out << "\tState window: [" << this->StateWindows[2*i] << "s, " << this->StateWindows[2*i+1] << "s)" << endl;
+	}
+
+	if (this->NumberOfStateVariables>0){
+		out << "\tState variables:";
+		for (unsigned int i=0; i<this->NumberOfStateVariables; ++i){
+			out << " " << this->StateVariables[i];
+		}
+		out << endl;
+	}
+
+	if (this->StateOnlyAtFiring){
+		out << "\tState written only when the neuron fires" << endl;
+	}
+
+	return out;
 }
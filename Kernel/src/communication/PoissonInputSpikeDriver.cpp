@@ -0,0 +1,38 @@
+/***************************************************************************
+ *                           PoissonInputSpikeDriver.cpp                   *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/communication/PoissonInputSpikeDriver.h"
+
+#include <cmath>
+
+PoissonInputSpikeDriver::PoissonInputSpikeDriver(int NewFirstNeuron, int NewNumberOfNeurons, double NewStep, double NewStartTime, unsigned int Seed): GeneratorInputSpikeDriver(NewFirstNeuron, NewNumberOfNeurons, NewStep, NewStartTime, Seed){
+}
+		
+PoissonInputSpikeDriver::~PoissonInputSpikeDriver(){
+}
+
+double PoissonInputSpikeDriver::NextSpikeMass(){
+	return -log(1.0-this->RandomUniform());
+}
+
+ostream & PoissonInputSpikeDriver::PrintInfo(ostream & out){
+
+	out << "- Poisson Input Spike Driver: " << this->NumberOfNeurons << " neurons from " << this->FirstNeuron << endl;
+
+	out << "\tTime window: " << this->Step << "s" << endl;
+
+	return out;
+}
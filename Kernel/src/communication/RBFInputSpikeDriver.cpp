@@ -0,0 +1,61 @@
+/***************************************************************************
+ *                           RBFInputSpikeDriver.cpp                       *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/communication/RBFInputSpikeDriver.h"
+
+#include <cmath>
+
+RBFInputSpikeDriver::RBFInputSpikeDriver(int NewFirstNeuron, int NewNumberOfNeurons, double NewFirstCenter, double LastCenter, double Overlap, double NewMaxFrequency, bool NewStochastic, double NewStep, double NewStartTime, unsigned int Seed): GeneratorInputSpikeDriver(NewFirstNeuron, NewNumberOfNeurons, NewStep, NewStartTime, Seed), FirstCenter(NewFirstCenter), CenterDistance(0.0), Width(1.0), MaxFrequency(NewMaxFrequency), Stochastic(NewStochastic){
+	if (this->NumberOfNeurons>1){
+		this->CenterDistance = (LastCenter-NewFirstCenter)/(this->NumberOfNeurons-1);
+
+		// Two consecutive gaussians cross at their middle point with the overlap value
+		double HalfDistance = this->CenterDistance/2;
+		this->Width = sqrt(HalfDistance*HalfDistance/(-2*log(Overlap)));
+	}
+}
+		
+RBFInputSpikeDriver::~RBFInputSpikeDriver(){
+}
+
+double RBFInputSpikeDriver::NextSpikeMass(){
+	if (this->Stochastic){
+		return -log(1.0-this->RandomUniform());
+	} else {
+		return 1.0;
+	}
+}
+
+void RBFInputSpikeDriver::SetInput(double Value){
+	double Center = this->FirstCenter;
+	for (int i=0; i<this->NumberOfNeurons; ++i, Center+=this->CenterDistance){
+		double Distance = (Value-Center)/this->Width;
+		this->Rates[i] = this->MaxFrequency*exp(-Distance*Distance/2);
+	}
+}
+
+ostream & RBFInputSpikeDriver::PrintInfo(ostream & out){
+
+	out << "- RBF Input Spike Driver: " << this->NumberOfNeurons << " neurons from " << this->FirstNeuron << endl;
+
+	out << "\tCenters: " << this->FirstCenter << " to " << (this->FirstCenter+this->CenterDistance*(this->NumberOfNeurons-1)) << ". Width: " << this->Width << endl;
+
+	out << "\tMaximum frequency: " << this->MaxFrequency << "Hz. " << (this->Stochastic?"Poisson":"Regular") << " spike trains" << endl;
+
+	out << "\tTime window: " << this->Step << "s" << endl;
+
+	return out;
+}
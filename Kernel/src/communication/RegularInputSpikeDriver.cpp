@@ -0,0 +1,36 @@
+/***************************************************************************
+ *                           RegularInputSpikeDriver.cpp                   *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/communication/RegularInputSpikeDriver.h"
+
+RegularInputSpikeDriver::RegularInputSpikeDriver(int NewFirstNeuron, int NewNumberOfNeurons, double NewStep, double NewStartTime): GeneratorInputSpikeDriver(NewFirstNeuron, NewNumberOfNeurons, NewStep, NewStartTime){
+}
+		
+RegularInputSpikeDriver::~RegularInputSpikeDriver(){
+}
+
+double RegularInputSpikeDriver::NextSpikeMass(){
+	return 1.0;
+}
+
+ostream & RegularInputSpikeDriver::PrintInfo(ostream & out){
+
+	out << "- Regular Input Spike Driver: " << this->NumberOfNeurons << " neurons from " << this->FirstNeuron << endl;
+
+	out << "\tTime window: " << this->Step << "s" << endl;
+
+	return out;
+}
@@ -0,0 +1,87 @@
+/***************************************************************************
+ *                           SharedMemoryInputOutputSpikeDriver.cpp        *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/communication/SharedMemoryInputOutputSpikeDriver.h"
+
+#include "../../include/simulation/EventQueue.h"
+
+#include "../../include/spike/Spike.h"
+#include "../../include/spike/Network.h"
+#include "../../include/spike/Neuron.h"
+
+SharedMemoryInputOutputSpikeDriver::SharedMemoryInputOutputSpikeDriver(enum TCPIPConnectionType Type, string Name) throw (EDLUTException){
+	this->Channel = new SharedMemorySpikeChannel(Name, Type);
+	this->Finished = false;
+	this->FlushTime = 0.0;
+}
+		
+SharedMemoryInputOutputSpikeDriver::~SharedMemoryInputOutputSpikeDriver(){
+	delete this->Channel;
+}
+
+void SharedMemoryInputOutputSpikeDriver::LoadInputs(EventQueue * Queue, Network * Net) throw (EDLUTException){
+	double Time;
+	unsigned int csize = this->Channel->ReceiveSpikes(Time);
+	const SharedMemorySpike * InputSpikes = this->Channel->GetSpikes();
+
+	if (this->Channel->IsClosed()){
+		this->Finished = true;
+	}
+
+	for (unsigned int c=0; c<csize; ++c){
+		Queue->InsertInputSpike(InputSpikes[c].Time, Net->GetNeuronAt(InputSpikes[c].Neuron));
+	}
+}
+
+void SharedMemoryInputOutputSpikeDriver::WriteSpike(const Spike * NewSpike) throw (EDLUTException){
+	SharedMemorySpike spike(NewSpike->GetSource()->GetIndex(),NewSpike->GetTime());
+		
+	this->OutputBuffer.push_back(spike);	
+}
+		
+void SharedMemoryInputOutputSpikeDriver::WriteState(float Time, Neuron * Source) throw (EDLUTException){
+	return;	
+}
+		
+bool SharedMemoryInputOutputSpikeDriver::IsBuffered() const{
+	return true;
+}
+
+bool SharedMemoryInputOutputSpikeDriver::IsWritePotentialCapable() const{
+	return false;
+}
+		 
+void SharedMemoryInputOutputSpikeDriver::FlushBuffers() throw (EDLUTException){
+	unsigned int size = (unsigned int)this->OutputBuffer.size();
+
+	// The spikes are copied directly from the buffer to the shared memory.
+	this->Channel->SendSpikes(this->FlushTime, (size>0)?&this->OutputBuffer[0]:0, size);
+
+	this->OutputBuffer.clear();
+}
+
+void SharedMemoryInputOutputSpikeDriver::SetFlushTime(double Time){
+	this->FlushTime = Time;
+}
+
+ostream & SharedMemoryInputOutputSpikeDriver::PrintInfo(ostream & out){
+
+	out << "- Shared Memory Input/Output Spike Driver" << endl;
+
+	out << "\tSegment: " << this->Channel->GetName() << endl;
+
+	return out;
+}
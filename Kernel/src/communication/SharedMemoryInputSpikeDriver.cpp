@@ -0,0 +1,53 @@
+/***************************************************************************
+ *                           SharedMemoryInputSpikeDriver.cpp              *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/communication/SharedMemoryInputSpikeDriver.h"
+
+#include "../../include/simulation/EventQueue.h"
+
+#include "../../include/spike/Network.h"
+
+SharedMemoryInputSpikeDriver::SharedMemoryInputSpikeDriver(enum TCPIPConnectionType Type, string Name) throw (EDLUTException){
+	this->Channel = new SharedMemorySpikeChannel(Name, Type);
+	this->Finished = false;
+}
+		
+SharedMemoryInputSpikeDriver::~SharedMemoryInputSpikeDriver(){
+	delete this->Channel;
+}
+
+void SharedMemoryInputSpikeDriver::LoadInputs(EventQueue * Queue, Network * Net) throw (EDLUTException){
+	double Time;
+	unsigned int csize = this->Channel->ReceiveSpikes(Time);
+	const SharedMemorySpike * InputSpikes = this->Channel->GetSpikes();
+
+	if (this->Channel->IsClosed()){
+		this->Finished = true;
+	}
+
+	for (unsigned int c=0; c<csize; ++c){
+		Queue->InsertInputSpike(InputSpikes[c].Time, Net->GetNeuronAt(InputSpikes[c].Neuron));
+	}
+}
+
+ostream & SharedMemoryInputSpikeDriver::PrintInfo(ostream & out){
+
+	out << "- Shared Memory Input Spike Driver" << endl;
+
+	out << "\tSegment: " << this->Channel->GetName() << endl;
+
+	return out;
+}
@@ -0,0 +1,69 @@
+/***************************************************************************
+ *                           SharedMemoryOutputSpikeDriver.cpp             *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/communication/SharedMemoryOutputSpikeDriver.h"
+
+#include "../../include/spike/Spike.h"
+#include "../../include/spike/Neuron.h"
+
+SharedMemoryOutputSpikeDriver::SharedMemoryOutputSpikeDriver(enum TCPIPConnectionType Type, string Name) throw (EDLUTException){
+	this->Channel = new SharedMemorySpikeChannel(Name, Type);
+	this->FlushTime = 0.0;
+}
+		
+SharedMemoryOutputSpikeDriver::~SharedMemoryOutputSpikeDriver(){
+	delete this->Channel;
+}
+
+void SharedMemoryOutputSpikeDriver::WriteSpike(const Spike * NewSpike) throw (EDLUTException){
+	SharedMemorySpike spike(NewSpike->GetSource()->GetIndex(),NewSpike->GetTime());
+		
+	this->OutputBuffer.push_back(spike);	
+}
+		
+void SharedMemoryOutputSpikeDriver::WriteState(float Time, Neuron * Source) throw (EDLUTException){
+	return;	
+}
+		
+bool SharedMemoryOutputSpikeDriver::IsBuffered() const{
+	return true;
+}
+
+bool SharedMemoryOutputSpikeDriver::IsWritePotentialCapable() const{
+	return false;
+}
+		 
+void SharedMemoryOutputSpikeDriver::FlushBuffers() throw (EDLUTException){
+	unsigned int size = (unsigned int)this->OutputBuffer.size();
+
+	// The spikes are copied directly from the buffer to the shared memory.
+	this->Channel->SendSpikes(this->FlushTime, (size>0)?&this->OutputBuffer[0]:0, size);
+
+	this->OutputBuffer.clear();
+}
+
+void SharedMemoryOutputSpikeDriver::SetFlushTime(double Time){
+	this->FlushTime = Time;
+}
+
+ostream & SharedMemoryOutputSpikeDriver::PrintInfo(ostream & out){
+
+	out << "- Shared Memory Output Spike Driver" << endl;
+
+	out << "\tSegment: " << this->Channel->GetName() << endl;
+
+	return out;
+}
@@ -0,0 +1,398 @@
+/***************************************************************************
+ *                           SharedMemorySpikeChannel.cpp                  *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/communication/SharedMemorySpikeChannel.h"
+
+#include <cstring>
+#include <climits>
+
+#ifndef _WIN32
+	#include <fcntl.h>
+	#include <sched.h>
+	#include <unistd.h>
+	#include <time.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#ifdef __linux__
+		#include <linux/futex.h>
+		#include <sys/syscall.h>
+	#endif
+#endif
+
+/*!
+ * It orders the memory accesses of both processes.
+ */
+static inline void MemoryFence(){
+#ifdef _WIN32
+	MemoryBarrier();
+#else
+	__sync_synchronize();
+#endif
+}
+
+/*!
+ * It sleeps while the index keeps this value. The other process wakes it up with WakeIndex
+ * (the sleep is also limited to 100 ms, so a closed channel is always noticed).
+ */
+static void WaitIndex(volatile unsigned int * Index, unsigned int Value){
+#if defined(_WIN32)
+	SwitchToThread();
+#elif defined(__linux__)
+	struct timespec Timeout = {0, 100000000};
+	syscall(SYS_futex, (unsigned int *) Index, FUTEX_WAIT, Value, &Timeout, 0, 0);
+#else
+	sched_yield();
+#endif
+}
+
+/*!
+ * It wakes up the process which sleeps on the index.
+ */
+static void WakeIndex(volatile unsigned int * Index){
+#if defined(__linux__)
+	syscall(SYS_futex, (unsigned int *) Index, FUTEX_WAKE, INT_MAX, 0, 0, 0);
+#endif
+}
+
+/*!
+ * It sleeps during a millisecond (while the client waits for the segment).
+ */
+static void SleepMillisecond(){
+#ifdef _WIN32
+	Sleep(1);
+#else
+	usleep(1000);
+#endif
+}
+
+/*!
+ * It returns the system name of the segment.
+ */
+static string SegmentName(const string & Name){
+#ifdef _WIN32
+	return string("Local\\")+Name;
+#else
+	return (Name.size()>0 && Name[0]=='/')?Name:string("/")+Name;
+#endif
+}
+
+SharedMemorySpikeChannel::SharedMemorySpikeChannel(string NewName, enum TCPIPConnectionType NewType, unsigned int NewRingSize) throw (EDLUTException): Name(NewName), Type(NewType), Segment(0), SegmentSize(0),
+#ifdef _WIN32
+	Mapping(NULL),
+#endif
+	OutputRing(0), OutputData(0), InputRing(0), InputData(0), RingSize(0), Spikes(0), AllocatedSpikes(0), Closed(false){
+	if (this->Type==SERVER){
+		this->CreateSegment(NewRingSize);
+	} else {
+		this->OpenSegment();
+	}
+
+	char * Data = ((char *) this->Segment)+sizeof(SharedMemorySegment);
+	int Output = (this->Type==SERVER)?0:1;
+	this->OutputRing = &this->Segment->Rings[Output];
+	this->OutputData = Data+Output*this->RingSize;
+	this->InputRing = &this->Segment->Rings[1-Output];
+	this->InputData = Data+(1-Output)*this->RingSize;
+}
+
+SharedMemorySpikeChannel::~SharedMemorySpikeChannel(){
+	// Both directions are closed (the other process stops waiting for this one)
+	this->OutputRing->Closed = 1;
+	this->InputRing->Closed = 1;
+	MemoryFence();
+	WakeIndex(&this->OutputRing->Head);
+	WakeIndex(&this->InputRing->Tail);
+
+#ifdef _WIN32
+	UnmapViewOfFile(this->Segment);
+	CloseHandle(this->Mapping);
+#else
+	munmap(this->Segment, this->SegmentSize);
+	if (this->Type==SERVER){
+		shm_unlink(SegmentName(this->Name).c_str());
+	}
+#endif
+
+	if (this->Spikes){
+		delete [] this->Spikes;
+	}
+}
+
+void SharedMemorySpikeChannel::CreateSegment(unsigned int NewRingSize) throw (EDLUTException){
+	this->RingSize = SHAREDMEMORYCACHELINE;
+	while (this->RingSize<NewRingSize){
+		this->RingSize *= 2;
+	}
+	this->SegmentSize = sizeof(SharedMemorySegment)+2*(unsigned long)this->RingSize;
+
+	string SystemName = SegmentName(this->Name);
+
+#ifdef _WIN32
+	this->Mapping = CreateFileMapping(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD) this->SegmentSize, SystemName.c_str());
+	if (this->Mapping==NULL){
+		throw EDLUTException(16,77,37,0);
+	}
+
+	this->Segment = (SharedMemorySegment *) MapViewOfFile(this->Mapping, FILE_MAP_ALL_ACCESS, 0, 0, this->SegmentSize);
+	if (this->Segment==NULL){
+		CloseHandle(this->Mapping);
+		throw EDLUTException(16,77,37,0);
+	}
+
+	memset(this->Segment, 0, sizeof(SharedMemorySegment));
+#else
+	// A former segment (of a broken simulation) is replaced
+	shm_unlink(SystemName.c_str());
+
+	int Descriptor = shm_open(SystemName.c_str(), O_CREAT|O_EXCL|O_RDWR, 0600);
+	if (Descriptor<0){
+		throw EDLUTException(16,77,37,0);
+	}
+
+	if (ftruncate(Descriptor, this->SegmentSize)!=0){
+		close(Descriptor);
+		shm_unlink(SystemName.c_str());
+		throw EDLUTException(16,77,37,0);
+	}
+
+	void * Address = mmap(0, this->SegmentSize, PROT_READ|PROT_WRITE, MAP_SHARED, Descriptor, 0);
+	close(Descriptor);
+	if (Address==MAP_FAILED){
+		shm_unlink(SystemName.c_str());
+		throw EDLUTException(16,77,37,0);
+	}
+
+	// The new segment is filled with zeros
+	this->Segment = (SharedMemorySegment *) Address;
+#endif
+
+	this->Segment->RingSize = this->RingSize;
+	MemoryFence();
+	this->Segment->Magic = SHAREDMEMORYMAGIC;
+}
+
+void SharedMemorySpikeChannel::OpenSegment() throw (EDLUTException){
+	string SystemName = SegmentName(this->Name);
+
+	for (int Elapsed=0; ; ++Elapsed){
+		if (Elapsed>=SHAREDMEMORYCONNECTIONTIMEOUT){
+			throw EDLUTException(16,78,38,0);
+		}
+
+		if (this->Segment==0){
+#ifdef _WIN32
+			this->Mapping = OpenFileMapping(FILE_MAP_ALL_ACCESS, FALSE, SystemName.c_str());
+			if (this->Mapping!=NULL){
+				this->Segment = (SharedMemorySegment *) MapViewOfFile(this->Mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+				if (this->Segment==NULL){
+					CloseHandle(this->Mapping);
+					throw EDLUTException(16,78,38,0);
+				}
+			}
+#else
+			int Descriptor = shm_open(SystemName.c_str(), O_RDWR, 0);
+			if (Descriptor>=0){
+				struct stat Status;
+				// The server may not have set the size yet
+				if (fstat(Descriptor, &Status)==0 && Status.st_size>=(off_t) sizeof(SharedMemorySegment)){
+					void * Address = mmap(0, Status.st_size, PROT_READ|PROT_WRITE, MAP_SHARED, Descriptor, 0);
+					if (Address==MAP_FAILED){
+						close(Descriptor);
+						throw EDLUTException(16,78,38,0);
+					}
+					this->Segment = (SharedMemorySegment *) Address;
+					this->SegmentSize = Status.st_size;
+				}
+				close(Descriptor);
+			}
+#endif
+		}
+
+		if (this->Segment!=0 && this->Segment->Magic==SHAREDMEMORYMAGIC){
+			break;
+		}
+
+		SleepMillisecond();
+	}
+
+	MemoryFence();
+	this->RingSize = this->Segment->RingSize;
+
+#ifndef _WIN32
+	if (this->SegmentSize!=sizeof(SharedMemorySegment)+2*(unsigned long)this->RingSize){
+		munmap(this->Segment, this->SegmentSize);
+		throw EDLUTException(16,78,38,0);
+	}
+#else
+	this->SegmentSize = sizeof(SharedMemorySegment)+2*(unsigned long)this->RingSize;
+#endif
+}
+
+void SharedMemorySpikeChannel::Write(const void * Buffer, unsigned int Size){
+	const char * Data = (const char *) Buffer;
+	SharedMemoryRing * Ring = this->OutputRing;
+	unsigned int Head = Ring->Head;
+	int Spins = 0;
+
+	while (Size>0){
+		unsigned int Tail = Ring->Tail;
+		unsigned int Free = this->RingSize-(Head-Tail);
+
+		if (Free==0){
+			if (Ring->Closed){
+				// Nobody reads the ring
+				return;
+			}
+
+			if (Spins<SHAREDMEMORYSPINS){
+				++Spins;
+			} else {
+				Ring->ProducerWaiting = 1;
+				MemoryFence();
+				if (Ring->Tail==Tail){
+					WaitIndex(&Ring->Tail, Tail);
+				}
+				Ring->ProducerWaiting = 0;
+			}
+			continue;
+		}
+
+		unsigned int Chunk = (Size<Free)?Size:Free;
+		unsigned int Offset = Head&(this->RingSize-1);
+		unsigned int First = (Chunk<this->RingSize-Offset)?Chunk:this->RingSize-Offset;
+		memcpy(this->OutputData+Offset, Data, First);
+		memcpy(this->OutputData, Data+First, Chunk-First);
+
+		Head += Chunk;
+		Data += Chunk;
+		Size -= Chunk;
+		Spins = 0;
+
+		MemoryFence();
+		Ring->Head = Head;
+		MemoryFence();
+		if (Ring->ConsumerWaiting){
+			WakeIndex(&Ring->Head);
+		}
+	}
+}
+
+bool SharedMemorySpikeChannel::Read(void * Buffer, unsigned int Size){
+	char * Data = (char *) Buffer;
+	SharedMemoryRing * Ring = this->InputRing;
+	unsigned int Tail = Ring->Tail;
+	int Spins = 0;
+
+	while (Size>0){
+		unsigned int Head = Ring->Head;
+		unsigned int Available = Head-Tail;
+
+		if (Available==0){
+			if (Ring->Closed){
+				MemoryFence();
+				// The last data could have been written before closing the ring
+				if (Ring->Head==Tail){
+					return false;
+				}
+				continue;
+			}
+
+			if (Spins<SHAREDMEMORYSPINS){
+				++Spins;
+			} else {
+				Ring->ConsumerWaiting = 1;
+				MemoryFence();
+				if (Ring->Head==Head){
+					WaitIndex(&Ring->Head, Head);
+				}
+				Ring->ConsumerWaiting = 0;
+			}
+			continue;
+		}
+
+		MemoryFence();
+
+		unsigned int Chunk = (Size<Available)?Size:Available;
+		unsigned int Offset = Tail&(this->RingSize-1);
+		unsigned int First = (Chunk<this->RingSize-Offset)?Chunk:this->RingSize-Offset;
+		memcpy(Data, this->InputData+Offset, First);
+		memcpy(Data+First, this->InputData, Chunk-First);
+
+		Tail += Chunk;
+		Data += Chunk;
+		Size -= Chunk;
+		Spins = 0;
+
+		MemoryFence();
+		Ring->Tail = Tail;
+		MemoryFence();
+		if (Ring->ProducerWaiting){
+			WakeIndex(&Ring->Tail);
+		}
+	}
+
+	return true;
+}
+
+void SharedMemorySpikeChannel::SendSpikes(double Time, const SharedMemorySpike * NewSpikes, unsigned int Number){
+	SharedMemoryBatchHeader Header;
+	Header.Spikes = Number;
+	Header.Reserved = 0;
+	Header.Time = Time;
+
+	this->Write(&Header, sizeof(SharedMemoryBatchHeader));
+	if (Number>0){
+		this->Write(NewSpikes, Number*sizeof(SharedMemorySpike));
+	}
+}
+
+unsigned int SharedMemorySpikeChannel::ReceiveSpikes(double & Time){
+	SharedMemoryBatchHeader Header;
+	if (this->Closed || !this->Read(&Header, sizeof(SharedMemoryBatchHeader))){
+		this->Closed = true;
+		return 0;
+	}
+
+	Time = Header.Time;
+
+	if (Header.Spikes>this->AllocatedSpikes){
+		if (this->Spikes){
+			delete [] this->Spikes;
+		}
+		this->AllocatedSpikes = (Header.Spikes>2*this->AllocatedSpikes)?Header.Spikes:2*this->AllocatedSpikes;
+		this->Spikes = new SharedMemorySpike [this->AllocatedSpikes];
+	}
+
+	// Copied directly from the ring to the spike array
+	if (Header.Spikes>0 && !this->Read(this->Spikes, Header.Spikes*sizeof(SharedMemorySpike))){
+		this->Closed = true;
+		return 0;
+	}
+
+	return Header.Spikes;
+}
+
+const SharedMemorySpike * SharedMemorySpikeChannel::GetSpikes() const{
+	return this->Spikes;
+}
+
+bool SharedMemorySpikeChannel::IsClosed() const{
+	return this->Closed;
+}
+
+string SharedMemorySpikeChannel::GetName() const{
+	return this->Name;
+}
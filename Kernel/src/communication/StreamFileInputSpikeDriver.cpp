@@ -0,0 +1,112 @@
+/***************************************************************************
+ *                           StreamFileInputSpikeDriver.cpp                *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/communication/StreamFileInputSpikeDriver.h"
+
+#include "../../include/simulation/Utils.h"
+#include "../../include/simulation/EventQueue.h"
+#include "../../include/simulation/StreamInputEvent.h"
+
+#include "../../include/spike/EDLUTFileException.h"
+#include "../../include/spike/Network.h"
+
+StreamFileInputSpikeDriver::StreamFileInputSpikeDriver(const char * NewFileName, double NewWindow) throw (EDLUTException): FileName(NewFileName), Currentline(1L), Window(NewWindow), NumberOfInputs(-1), ReadInputs(0), PendingLine(false){
+	this->Finished = false;
+	this->Handler = fopen(NewFileName,"rt");
+	if (!this->Handler){
+		throw EDLUTException(6,20,13,0);
+	}
+}
+		
+StreamFileInputSpikeDriver::~StreamFileInputSpikeDriver(){
+	if (this->Handler){
+		fclose(this->Handler);
+		this->Handler=NULL;
+	}
+}
+
+bool StreamFileInputSpikeDriver::ReadLine(Network * Net) throw (EDLUTFileException){
+	if (this->ReadInputs>=this->NumberOfInputs){
+		return false;
+	}
+
+	skip_comments(this->Handler,Currentline);
+	if(fscanf(this->Handler,"%f",&this->LineTime)==1 && fscanf(this->Handler,"%i",&this->LineSpikes)==1 && fscanf(this->Handler,"%f",&this->LineInterval)==1 && fscanf(this->Handler,"%i",&this->LineNeuron)==1 && fscanf(this->Handler,"%i",&this->LineRepetitions)==1){
+		if(this->LineNeuron+this->LineRepetitions<=Net->GetNeuronNumber() && this->LineNeuron >= 0){
+			this->ReadInputs+=this->LineSpikes*this->LineRepetitions;
+			
+			if(this->ReadInputs>this->NumberOfInputs){
+				throw EDLUTFileException(6,16,15,1,Currentline);
+			}
+		}else{
+			throw EDLUTFileException(6,17,16,1,Currentline);
+		}
+	}else{
+		throw EDLUTFileException(6,18,17,1,Currentline);
+	}
+
+	return true;
+}
+	
+void StreamFileInputSpikeDriver::LoadInputs(EventQueue * Queue, Network * Net) throw (EDLUTFileException){
+	if (this->Handler && this->NumberOfInputs==-1){
+		skip_comments(this->Handler,Currentline);
+		if(fscanf(this->Handler,"%i",&this->NumberOfInputs)!=1){
+			throw EDLUTFileException(6,19,18,1,Currentline);
+		}
+
+		this->LoadWindow(Queue, Net, 0.0);
+	}
+}
+
+void StreamFileInputSpikeDriver::LoadWindow(EventQueue * Queue, Network * Net, double CurrentTime) throw (EDLUTFileException){
+	if (!this->PendingLine){
+		this->PendingLine = this->ReadLine(Net);
+	}
+
+	if (this->PendingLine){
+		double EndTime = ((this->LineTime>CurrentTime)?this->LineTime:CurrentTime)+this->Window;
+
+		while (this->PendingLine && this->LineTime<EndTime){
+			if (this->LineTime<CurrentTime){
+				throw EDLUTFileException(6,74,33,1,Currentline);
+			}
+
+			for(int itime=0;itime<this->LineSpikes;itime++){
+				for(int ineuron=0;ineuron<this->LineRepetitions;ineuron++){
+					Queue->InsertInputSpike(this->LineTime+itime*this->LineInterval, Net->GetNeuronAt(this->LineNeuron+ineuron));
+				}
+			}
+
+			this->PendingLine = this->ReadLine(Net);
+		}
+
+		if (this->PendingLine){
+			Queue->InsertEvent(new StreamInputEvent(EndTime, this));
+		}
+	}
+
+	this->Finished = !this->PendingLine;
+}
+
+ostream & StreamFileInputSpikeDriver::PrintInfo(ostream & out){
+
+	out << "- Stream File Input Spike Driver: " << this->FileName << endl;
+
+	out << "\tTime window: " << this->Window << "s" << endl;
+
+	return out;
+}
@@ -18,49 +18,47 @@
 
 #include "../../include/communication/ServerSocket.h"
 #include "../../include/communication/ClientSocket.h"
+#include "../../include/communication/TCPIPSpikeProtocol.h"
 
 #include "../../include/simulation/EventQueue.h"
 
-#include "../../include/spike/InputSpike.h"
+#include "../../include/spike/Spike.h"
 #include "../../include/spike/Network.h"
 #include "../../include/spike/Neuron.h"
 
-TCPIPInputOutputSpikeDriver::TCPIPInputOutputSpikeDriver(enum TCPIPConnectionType Type, string server_address,unsigned short tcp_port){
+TCPIPInputOutputSpikeDriver::TCPIPInputOutputSpikeDriver(enum TCPIPConnectionType Type, string server_address,unsigned short tcp_port, unsigned int Version, bool Delta) throw (EDLUTException){
 	if (Type == SERVER){
 		this->Socket = new ServerSocket(tcp_port);
 	} else {
 		this->Socket = new ClientSocket(server_address,tcp_port);
 	}
-	this->Finished = false;	
+	this->Protocol = new TCPIPSpikeProtocol(this->Socket, Type, Version, Delta);
+	this->Finished = false;
+	this->FlushTime = 0.0;
 }
 		
 TCPIPInputOutputSpikeDriver::~TCPIPInputOutputSpikeDriver(){
+	delete this->Protocol;
 	delete this->Socket;
 }
 
-void TCPIPInputOutputSpikeDriver::LoadInputs(EventQueue * Queue, Network * Net) throw (EDLUTFileException){
-	unsigned short csize;
-	
-	this->Socket->receiveBuffer(&csize, sizeof(unsigned short));
-	
-	if (csize>0){
-		OutputSpike * InputSpikes = new OutputSpike [csize];
-	
-		this->Socket->receiveBuffer(InputSpikes,sizeof(OutputSpike)*(int) csize);
-		
-		for (int c=0; c<csize; ++c){
-			InputSpike * NewSpike = new InputSpike(InputSpikes[c].Time, Net->GetNeuronAt(InputSpikes[c].Neuron));
-						
-			Queue->InsertEvent(NewSpike);				
-		}
+void TCPIPInputOutputSpikeDriver::LoadInputs(EventQueue * Queue, Network * Net) throw (EDLUTException){
+	double Time;
+	unsigned int csize = this->Protocol->ReceiveSpikes(Time);
+	const TCPIPSpike * InputSpikes = this->Protocol->GetSpikes();
 
-		delete [] InputSpikes;
+	if (this->Protocol->IsClosed()){
+		this->Finished = true;
+	}
+
+	for (unsigned int c=0; c<csize; ++c){
+		Queue->InsertInputSpike(InputSpikes[c].Time, Net->GetNeuronAt(InputSpikes[c].Neuron));
 	}
 }
 
 	
 void TCPIPInputOutputSpikeDriver::WriteSpike(const Spike * NewSpike) throw (EDLUTException){
-	OutputSpike spike(NewSpike->GetSource()->GetIndex(),NewSpike->GetTime());
+	TCPIPSpike spike(NewSpike->GetSource()->GetIndex(),NewSpike->GetTime());
 		
 	this->OutputBuffer.push_back(spike);	
 }
@@ -78,27 +76,25 @@ bool TCPIPInputOutputSpikeDriver::IsWritePotentialCapable() const{
 }
 		 
 void TCPIPInputOutputSpikeDriver::FlushBuffers() throw (EDLUTException){
-	
-	unsigned short size = (unsigned short)this->OutputBuffer.size();
-	this->Socket->sendBuffer(&size,sizeof(unsigned short));
-	if (size>0){
-		OutputSpike * Array = new OutputSpike [size];
-		
-		for (unsigned short int i=0; i<size; ++i){
-			Array[i] = this->OutputBuffer[i];	
-		}
-		
-		this->Socket->sendBuffer((char *) Array, sizeof(OutputSpike)*size);
-					
-		delete [] Array;
-		
-		this->OutputBuffer.clear();
-	}
+	unsigned int size = (unsigned int)this->OutputBuffer.size();
+
+	// The spikes are sent directly from the buffer (no intermediate copy).
+	this->Protocol->SendSpikes(this->FlushTime, (size>0)?&this->OutputBuffer[0]:0, size);
+
+	this->OutputBuffer.clear();
+}
+
+void TCPIPInputOutputSpikeDriver::SetFlushTime(double Time){
+	this->FlushTime = Time;
 }
 
 ostream & TCPIPInputOutputSpikeDriver::PrintInfo(ostream & out){
 
 	out << "- TCP/IP Input/Output Spike Driver" << endl;
 
+	out << "\tProtocol version: " << this->Protocol->GetVersion() << endl;
+
+	out << "\tDelta-encoded payload: " << (this->Protocol->IsDeltaEncoding()?"yes":"no") << endl;
+
 	return out;
 }
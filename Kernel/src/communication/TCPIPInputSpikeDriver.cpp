@@ -20,45 +20,40 @@
 #include "../../include/communication/ClientSocket.h"
 
 #include "../../include/communication/CdSocket.h"
+#include "../../include/communication/TCPIPSpikeProtocol.h"
 
 #include "../../include/simulation/EventQueue.h"
 
-#include "../../include/spike/InputSpike.h"
 #include "../../include/spike/Network.h"
 
 
 
-TCPIPInputSpikeDriver::TCPIPInputSpikeDriver(enum TCPIPConnectionType Type, string server_address,unsigned short tcp_port){
+TCPIPInputSpikeDriver::TCPIPInputSpikeDriver(enum TCPIPConnectionType Type, string server_address,unsigned short tcp_port, unsigned int Version, bool Delta) throw (EDLUTException){
 	if (Type == SERVER){
 		this->Socket = new ServerSocket(tcp_port);
 	} else {
 		this->Socket = new ClientSocket(server_address,tcp_port);
 	}
+	this->Protocol = new TCPIPSpikeProtocol(this->Socket, Type, Version, Delta);
 	this->Finished = false;
 }
 		
 TCPIPInputSpikeDriver::~TCPIPInputSpikeDriver(){
+	delete this->Protocol;
 	delete this->Socket;
 }
 	
-void TCPIPInputSpikeDriver::LoadInputs(EventQueue * Queue, Network * Net) throw (EDLUTFileException){
-	unsigned short csize;
-	
-	this->Socket->receiveBuffer(&csize, sizeof(unsigned short));
-
+void TCPIPInputSpikeDriver::LoadInputs(EventQueue * Queue, Network * Net) throw (EDLUTException){
+	double Time;
+	unsigned int csize = this->Protocol->ReceiveSpikes(Time);
+	const TCPIPSpike * InputSpikes = this->Protocol->GetSpikes();
 
-	if (csize>0){
-		OutputSpike * InputSpikes = new OutputSpike [csize];
-	
-		this->Socket->receiveBuffer(InputSpikes,sizeof(OutputSpike)*(int) csize);
-		
-		for (int c=0; c<csize; ++c){
-			InputSpike * NewSpike = new InputSpike(InputSpikes[c].Time, Net->GetNeuronAt(InputSpikes[c].Neuron));
-			
-			Queue->InsertEvent(NewSpike);				
-		}
+	if (this->Protocol->IsClosed()){
+		this->Finished = true;
+	}
 
-		delete [] InputSpikes;
+	for (unsigned int c=0; c<csize; ++c){
+		Queue->InsertInputSpike(InputSpikes[c].Time, Net->GetNeuronAt(InputSpikes[c].Neuron));
 	}
 }
 
@@ -66,5 +61,9 @@ ostream & TCPIPInputSpikeDriver::PrintInfo(ostream & out){
 
 	out << "- TCP/IP Input Spike Driver" << endl;
 
+	out << "\tProtocol version: " << this->Protocol->GetVersion() << endl;
+
+	out << "\tDelta-encoded payload: " << (this->Protocol->IsDeltaEncoding()?"yes":"no") << endl;
+
 	return out;
 }
@@ -18,25 +18,29 @@
 
 #include "../../include/communication/ServerSocket.h"
 #include "../../include/communication/ClientSocket.h"
+#include "../../include/communication/TCPIPSpikeProtocol.h"
 
 #include "../../include/spike/Spike.h"
 #include "../../include/spike/Neuron.h"
 
 
-TCPIPOutputSpikeDriver::TCPIPOutputSpikeDriver(enum TCPIPConnectionType Type, string server_address,unsigned short tcp_port){
+TCPIPOutputSpikeDriver::TCPIPOutputSpikeDriver(enum TCPIPConnectionType Type, string server_address,unsigned short tcp_port, unsigned int Version, bool Delta) throw (EDLUTException){
 	if (Type == SERVER){
 		this->Socket = new ServerSocket(tcp_port);
 	} else {
 		this->Socket = new ClientSocket(server_address,tcp_port);
 	}
+	this->Protocol = new TCPIPSpikeProtocol(this->Socket, Type, Version, Delta);
+	this->FlushTime = 0.0;
 }
 		
 TCPIPOutputSpikeDriver::~TCPIPOutputSpikeDriver(){
+	delete this->Protocol;
 	delete this->Socket;
 }
 	
 void TCPIPOutputSpikeDriver::WriteSpike(const Spike * NewSpike) throw (EDLUTException){
-	OutputSpike spike(NewSpike->GetSource()->GetIndex(),NewSpike->GetTime());
+	TCPIPSpike spike(NewSpike->GetSource()->GetIndex(),NewSpike->GetTime());
 		
 	this->OutputBuffer.push_back(spike);	
 }
@@ -54,27 +58,25 @@ bool TCPIPOutputSpikeDriver::IsWritePotentialCapable() const{
 }
 		 
 void TCPIPOutputSpikeDriver::FlushBuffers() throw (EDLUTException){
-	
-	unsigned short size = (unsigned short)this->OutputBuffer.size();
-	this->Socket->sendBuffer(&size,sizeof(unsigned short));
-	if (size>0){
-		OutputSpike * Array = new OutputSpike [size];
-		
-		for (unsigned short int i=0; i<size; ++i){
-			Array[i] = this->OutputBuffer[i];	
-		}
-		
-		this->Socket->sendBuffer((char *) Array, sizeof(OutputSpike)*size);
-					
-		delete [] Array;
-		
-		this->OutputBuffer.clear();
-	}
+	unsigned int size = (unsigned int)this->OutputBuffer.size();
+
+	// The spikes are sent directly from the buffer (no intermediate copy).
+	this->Protocol->SendSpikes(this->FlushTime, (size>0)?&this->OutputBuffer[0]:0, size);
+
+	this->OutputBuffer.clear();
+}
+
+void TCPIPOutputSpikeDriver::SetFlushTime(double Time){
+	this->FlushTime = Time;
 }		
 
 ostream & TCPIPOutputSpikeDriver::PrintInfo(ostream & out){
 
 	out << "- TCP/IP Output Spike Driver" << endl;
 
+	out << "\tProtocol version: " << this->Protocol->GetVersion() << endl;
+
+	out << "\tDelta-encoded payload: " << (this->Protocol->IsDeltaEncoding()?"yes":"no") << endl;
+
 	return out;
 }
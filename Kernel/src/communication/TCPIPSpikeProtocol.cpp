@@ -0,0 +1,350 @@
+/***************************************************************************
+ *                           TCPIPSpikeProtocol.cpp                        *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/communication/TCPIPSpikeProtocol.h"
+
+#include "../../include/communication/CdSocket.h"
+
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <unistd.h>
+#endif
+
+/*!
+ * \brief It writes a varint (7 bits per byte, the lower bits first).
+ */
+static unsigned char * WriteVarint(unsigned char * Buffer, unsigned int Value){
+	while (Value>=0x80){
+		*Buffer++ = (unsigned char) (Value|0x80);
+		Value >>= 7;
+	}
+	*Buffer++ = (unsigned char) Value;
+	return Buffer;
+}
+
+/*!
+ * \brief It reads a varint. It returns 0 if the varint is wrong or exceeds the buffer.
+ */
+static const unsigned char * ReadVarint(const unsigned char * Buffer, const unsigned char * End, unsigned int & Value){
+	Value = 0;
+	for (int Shift=0; Shift<35 && Buffer<End; Shift+=7){
+		unsigned char Byte = *Buffer++;
+		Value |= ((unsigned int) (Byte&0x7F)) << Shift;
+		if (!(Byte&0x80)){
+			return Buffer;
+		}
+	}
+	return 0;
+}
+
+/*!
+ * \brief It maps a (wrapped) signed difference to an unsigned number (small differences to small numbers).
+ */
+static unsigned int ZigZag(unsigned int Difference){
+	return (Difference<<1)^(0u-(Difference>>31));
+}
+
+static unsigned int UnZigZag(unsigned int Value){
+	return (Value>>1)^(0u-(Value&1));
+}
+
+static unsigned int FloatBits(float Value){
+	unsigned int Bits;
+	memcpy(&Bits, &Value, sizeof(float));
+	return Bits;
+}
+
+static float BitsFloat(unsigned int Bits){
+	float Value;
+	memcpy(&Value, &Bits, sizeof(float));
+	return Value;
+}
+
+TCPIPSpikeProtocol::TCPIPSpikeProtocol(CdSocket * NewSocket, enum TCPIPConnectionType Type, unsigned int RequestedVersion, bool RequestedDelta) throw (EDLUTException): Socket(NewSocket), Version(1), DeltaEncoding(false), Spikes(0), AllocatedSpikes(0), Payload(0), AllocatedPayload(0), Closed(false){
+	if (RequestedVersion>=2){
+		unsigned int Flags = (RequestedDelta)?TCPIPDELTAENCODING:0;
+		if (Type==SERVER){
+			this->NegotiateServer(Flags);
+		} else {
+			this->NegotiateClient(Flags);
+		}
+	}
+}
+
+TCPIPSpikeProtocol::~TCPIPSpikeProtocol(){
+	if (this->Spikes){
+		delete [] this->Spikes;
+	}
+
+	if (this->Payload){
+		delete [] this->Payload;
+	}
+}
+
+void TCPIPSpikeProtocol::ReserveSpikes(unsigned int Number){
+	if (Number>this->AllocatedSpikes){
+		if (this->Spikes){
+			delete [] this->Spikes;
+		}
+		this->AllocatedSpikes = (Number>2*this->AllocatedSpikes)?Number:2*this->AllocatedSpikes;
+		this->Spikes = new TCPIPSpike [this->AllocatedSpikes];
+	}
+}
+
+void TCPIPSpikeProtocol::ReservePayload(unsigned int Bytes){
+	if (Bytes>this->AllocatedPayload){
+		if (this->Payload){
+			delete [] this->Payload;
+		}
+		this->AllocatedPayload = (Bytes>2*this->AllocatedPayload)?Bytes:2*this->AllocatedPayload;
+		this->Payload = new unsigned char [this->AllocatedPayload];
+	}
+}
+
+void TCPIPSpikeProtocol::NegotiateServer(unsigned int RequestedFlags){
+	TCPIPHello Hello;
+	unsigned int Magic = TCPIPPROTOCOLMAGIC;
+	int Received = 0;
+
+	// The data is only peeked, so the first batch of a version 1 client is not lost
+	for (int Waited=0; Waited<TCPIPNEGOTIATIONTIMEOUT; ){
+		if (this->Socket->waitForData(TCPIPNEGOTIATIONTIMEOUT-Waited)){
+			Received = this->Socket->peekBuffer(&Hello, sizeof(TCPIPHello));
+			if (Received<=0){
+				// Closed connection
+				break;
+			}
+
+			int Compared = (Received<(int) sizeof(unsigned int))?Received:(int) sizeof(unsigned int);
+			if (memcmp(&Hello, &Magic, Compared)!=0 || Received==(int) sizeof(TCPIPHello)){
+				break;
+			}
+
+			// Incomplete hello message
+#ifdef _WIN32
+			Sleep(1);
+#else
+			usleep(1000);
+#endif
+			Waited++;
+		} else {
+			break;
+		}
+	}
+
+	if (Received==(int) sizeof(TCPIPHello) && Hello.Magic==TCPIPPROTOCOLMAGIC){
+		this->Socket->receiveBuffer(&Hello, sizeof(TCPIPHello));
+
+		this->Version = (Hello.Version<TCPIPPROTOCOLVERSION)?Hello.Version:TCPIPPROTOCOLVERSION;
+		if (this->Version<1){
+			this->Version = 1;
+		}
+		this->DeltaEncoding = (this->Version>=2 && ((Hello.Flags|RequestedFlags)&TCPIPDELTAENCODING));
+
+		Hello.Magic = TCPIPPROTOCOLMAGIC;
+		Hello.Version = this->Version;
+		Hello.Flags = (this->DeltaEncoding)?TCPIPDELTAENCODING:0;
+		Hello.Reserved = 0;
+		this->Socket->sendBuffer(&Hello, sizeof(TCPIPHello));
+	} else {
+		cout << "The TCP/IP client doesn't support the version 2 protocol. The version 1 protocol is used." << endl;
+	}
+}
+
+void TCPIPSpikeProtocol::NegotiateClient(unsigned int RequestedFlags) throw (EDLUTException){
+	TCPIPHello Hello;
+	Hello.Magic = TCPIPPROTOCOLMAGIC;
+	Hello.Version = TCPIPPROTOCOLVERSION;
+	Hello.Flags = RequestedFlags;
+	Hello.Reserved = 0;
+
+	if (this->Socket->sendBuffer(&Hello, sizeof(TCPIPHello))<=0 || this->Socket->receiveBuffer(&Hello, sizeof(TCPIPHello))<=0 || Hello.Magic!=TCPIPPROTOCOLMAGIC || Hello.Version<1){
+		throw EDLUTException(15,76,36,0);
+	}
+
+	this->Version = (Hello.Version<TCPIPPROTOCOLVERSION)?Hello.Version:TCPIPPROTOCOLVERSION;
+	this->DeltaEncoding = (this->Version>=2 && (Hello.Flags&TCPIPDELTAENCODING));
+}
+
+void TCPIPSpikeProtocol::SendSpikes(double Time, const TCPIPSpike * NewSpikes, unsigned int Number) throw (EDLUTException){
+	void * Blocks[2];
+	int Sizes[2];
+	int Sent;
+
+	if (this->Version==1){
+		if (Number>TCPIPVERSION1MAXSPIKES){
+			throw EDLUTException(15,75,35,0);
+		}
+
+		unsigned short Size = (unsigned short) Number;
+		Blocks[0] = &Size;
+		Sizes[0] = sizeof(unsigned short);
+
+		if (Number>0){
+			this->ReservePayload(Number*sizeof(TCPIPLegacySpike));
+			TCPIPLegacySpike * Legacy = (TCPIPLegacySpike *) this->Payload;
+			for (unsigned int i=0; i<Number; ++i){
+				Legacy[i].Neuron = NewSpikes[i].Neuron;
+				Legacy[i].Time = NewSpikes[i].Time;
+			}
+
+			Blocks[1] = Legacy;
+			Sizes[1] = Number*sizeof(TCPIPLegacySpike);
+		}
+
+		Sent = this->Socket->sendBuffers(Blocks, Sizes, (Number>0)?2:1);
+	} else {
+		TCPIPFrameHeader Header;
+		Header.Spikes = Number;
+		Header.Time = Time;
+
+		Blocks[0] = &Header;
+		Sizes[0] = sizeof(TCPIPFrameHeader);
+
+		if (this->DeltaEncoding){
+			// At most 5 bytes per varint
+			this->ReservePayload(Number*10);
+
+			unsigned char * Position = this->Payload;
+			unsigned int LastNeuron = 0;
+			unsigned int LastTime = FloatBits((float) Time);
+			for (unsigned int i=0; i<Number; ++i){
+				unsigned int Neuron = (unsigned int) NewSpikes[i].Neuron;
+				unsigned int Bits = FloatBits(NewSpikes[i].Time);
+				Position = WriteVarint(Position, ZigZag(Neuron-LastNeuron));
+				Position = WriteVarint(Position, ZigZag(Bits-LastTime));
+				LastNeuron = Neuron;
+				LastTime = Bits;
+			}
+
+			Header.Bytes = (unsigned int) (Position-this->Payload);
+			Blocks[1] = this->Payload;
+		} else {
+			// Sent directly from the driver buffer
+			Header.Bytes = Number*sizeof(TCPIPSpike);
+			Blocks[1] = (void *) NewSpikes;
+		}
+		Sizes[1] = Header.Bytes;
+
+		Sent = this->Socket->sendBuffers(Blocks, Sizes, (Number>0)?2:1);
+	}
+
+	if (Sent<0){
+		throw EDLUTException(15,76,36,0);
+	}
+}
+
+unsigned int TCPIPSpikeProtocol::ReceiveSpikes(double & Time) throw (EDLUTException){
+	if (this->Version==1){
+		unsigned short Size;
+		int Status = this->Socket->receiveBuffer(&Size, sizeof(unsigned short));
+		if (Status==0){
+			// The connection has been closed between two batches
+			this->Closed = true;
+			return 0;
+		} else if (Status<0){
+			throw EDLUTException(15,76,36,0);
+		}
+
+		Time = -1;
+
+		if (Size>0){
+			this->ReservePayload(Size*sizeof(TCPIPLegacySpike));
+			TCPIPLegacySpike * Legacy = (TCPIPLegacySpike *) this->Payload;
+			if (this->Socket->receiveBuffer(Legacy, Size*sizeof(TCPIPLegacySpike))<=0){
+				throw EDLUTException(15,76,36,0);
+			}
+
+			this->ReserveSpikes(Size);
+			for (unsigned int i=0; i<Size; ++i){
+				this->Spikes[i].Neuron = (int) Legacy[i].Neuron;
+				this->Spikes[i].Time = Legacy[i].Time;
+			}
+		}
+
+		return Size;
+	} else {
+		TCPIPFrameHeader Header;
+		int Status = this->Socket->receiveBuffer(&Header, sizeof(TCPIPFrameHeader));
+		if (Status==0){
+			// The connection has been closed between two batches
+			this->Closed = true;
+			return 0;
+		} else if (Status<0){
+			throw EDLUTException(15,76,36,0);
+		}
+
+		Time = Header.Time;
+
+		if (Header.Spikes>0){
+			this->ReserveSpikes(Header.Spikes);
+
+			if (this->DeltaEncoding){
+				if (Header.Bytes>Header.Spikes*10ULL){
+					throw EDLUTException(15,76,36,0);
+				}
+
+				this->ReservePayload(Header.Bytes);
+				if (this->Socket->receiveBuffer(this->Payload, Header.Bytes)<=0){
+					throw EDLUTException(15,76,36,0);
+				}
+
+				const unsigned char * Position = this->Payload;
+				const unsigned char * End = this->Payload+Header.Bytes;
+				unsigned int LastNeuron = 0;
+				unsigned int LastTime = FloatBits((float) Header.Time);
+				for (unsigned int i=0; i<Header.Spikes; ++i){
+					unsigned int Neuron, Bits;
+					if (!(Position = ReadVarint(Position, End, Neuron)) || !(Position = ReadVarint(Position, End, Bits))){
+						throw EDLUTException(15,76,36,0);
+					}
+					LastNeuron += UnZigZag(Neuron);
+					LastTime += UnZigZag(Bits);
+					this->Spikes[i].Neuron = (int) LastNeuron;
+					this->Spikes[i].Time = BitsFloat(LastTime);
+				}
+			} else {
+				if (Header.Bytes!=Header.Spikes*sizeof(TCPIPSpike)){
+					throw EDLUTException(15,76,36,0);
+				}
+
+				// Received directly in the spike array
+				if (this->Socket->receiveBuffer(this->Spikes, Header.Bytes)<=0){
+					throw EDLUTException(15,76,36,0);
+				}
+			}
+		}
+
+		return Header.Spikes;
+	}
+}
+
+const TCPIPSpike * TCPIPSpikeProtocol::GetSpikes() const{
+	return this->Spikes;
+}
+
+unsigned int TCPIPSpikeProtocol::GetVersion() const{
+	return this->Version;
+}
+
+bool TCPIPSpikeProtocol::IsDeltaEncoding() const{
+	return this->DeltaEncoding;
+}
+
+bool TCPIPSpikeProtocol::IsClosed() const{
+	return this->Closed;
+}
@@ -24,7 +24,6 @@
 
 #include "../../include/spike/Network.h"
 #include "../../include/spike/Neuron.h"
-#include "../../include/spike/InputSpike.h"
 #include "../../include/spike/EDLUTException.h"
 #include "../../include/spike/EDLUTFileException.h"
 
@@ -89,7 +88,33 @@ extern "C" int LSAM_des_checkIfNeuronExists(Simulation * Simul, int neuron_index
 }
 
 extern "C" void LSAM_des_injectSpike(Simulation * Simul, double time, int neuron_index) {
-  Simul->GetQueue()->InsertEvent(new InputSpike(time, Simul->GetNetwork()->GetNeuronAt(neuron_index)));
+  Simul->GetQueue()->InsertInputSpike(time, Simul->GetNetwork()->GetNeuronAt(neuron_index));
+}
+
+extern "C" int LSAM_des_injectSpikes(Simulation * Simul, int number, const double * times, const int * neuron_indexes) {
+  Network * Net = Simul->GetNetwork();
+  EventQueue * Queue = Simul->GetQueue();
+  int nneurons = Net->GetNeuronNumber();
+  for (int i=0; i<number; i++){
+    if (neuron_indexes[i]<0 || neuron_indexes[i]>=nneurons) return 1;
+  }
+  for (int i=0; i<number; i++){
+    Queue->InsertInputSpike(times[i], Net->GetNeuronAt(neuron_indexes[i]));
+  }
+  return 0;
+}
+
+extern "C" int LSAM_des_injectSpikeMask(Simulation * Simul, double time, int first_neuron, int number, const unsigned char * mask) {
+  Network * Net = Simul->GetNetwork();
+  EventQueue * Queue = Simul->GetQueue();
+  if (first_neuron<0 || number<0 || first_neuron+number>Net->GetNeuronNumber()) return 1;
+  for (int i=0; i<number; i+=8){
+    unsigned char bits = mask[i/8];
+    for (int j=i; bits!=0 && j<number; j++, bits>>=1){
+      if (bits & 1) Queue->InsertInputSpike(time, Net->GetNeuronAt(first_neuron+j));
+    }
+  }
+  return 0;
 }
 
 extern "C" int LSAM_des_simulate(Simulation * Simul, double preempt_time) {
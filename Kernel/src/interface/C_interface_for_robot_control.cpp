@@ -34,12 +34,13 @@
 
 #include "../../include/spike/Network.h"
 
-#include "../../include/spike/InputSpike.h"
-
 #include "../../include/communication/ArrayOutputSpikeDriver.h"
 #include "../../include/communication/FileInputSpikeDriver.h"
 #include "../../include/communication/FileOutputSpikeDriver.h"
 #include "../../include/communication/FileOutputWeightDriver.h"
+#include "../../include/communication/PoissonInputSpikeDriver.h"
+#include "../../include/communication/RBFInputSpikeDriver.h"
+#include "../../include/communication/RegularInputSpikeDriver.h"
 
 #include "../../include/simulation/EventQueue.h"
 
@@ -89,16 +90,16 @@ EXTERN_C Simulation *create_neural_simulation(const char *net_file, const char *
 EXTERN_C void finish_neural_simulation(Simulation *neural_sim)
   {
    // EDLUT interface drivers
-   FileInputSpikeDriver *neural_activity_input_file;
+   InputSpikeDriver *neural_activity_input;
    FileOutputWeightDriver *neural_weight_output_file;
    ArrayOutputSpikeDriver *neural_activity_output_array;
    FileOutputSpikeDriver *neural_activity_output_file;
 
-   neural_activity_input_file=(FileInputSpikeDriver *)neural_sim->GetInputSpikeDriver(0);
-   if(neural_activity_input_file)
+   // The input drivers are the input file driver (if any) and the input generators
+   while((neural_activity_input=neural_sim->GetInputSpikeDriver(0))!=NULL)
      {
-      neural_sim->RemoveInputSpikeDriver(neural_activity_input_file);
-      delete neural_activity_input_file;
+      neural_sim->RemoveInputSpikeDriver(neural_activity_input);
+      delete neural_activity_input;
      }
 
    neural_weight_output_file=(FileOutputWeightDriver *)neural_sim->GetOutputWeightDriver(0);
@@ -154,6 +155,7 @@ EXTERN_C int run_neural_simulation_slot(Simulation *neural_sim, double slot_end_
 EXTERN_C void reset_neural_simulation(Simulation *neural_sim)
   {
    neural_sim->GetQueue()->RemoveSpikes();
+   neural_sim->ClearPredictedSpikes();
   }
 
 EXTERN_C void save_neural_weights(Simulation *neural_sim)
@@ -353,8 +355,7 @@ void generate_activityRBF(Simulation *sim, double cur_slot_time, struct rbf_set
          cur_spk_time=cur_slot_time;
       for(;cur_spk_time<cur_slot_time+SIM_SLOT_LENGTH;cur_spk_time+=spk_per)
         {
-         InputSpike *newspk=new InputSpike(cur_spk_time, cur_neuron);
-         sim->GetQueue()->InsertEvent(newspk);
+         sim->GetQueue()->InsertInputSpike(cur_spk_time, cur_neuron);
          last_spk_times[nneu]=cur_spk_time;
         }
      }
@@ -462,6 +463,83 @@ EXTERN_C void generate_robot_state_activity(Simulation *neural_sim, double cur_s
   }
 
 
+///////////////////////////// INPUT GENERATORS //////////////////////////
+
+static GeneratorInputSpikeDriver *add_input_generator(Simulation *neural_sim, GeneratorInputSpikeDriver *generator)
+  {
+   try
+     {
+      generator->LoadInputs(neural_sim->GetQueue(), neural_sim->GetNetwork()); // Schedule the first time window
+      neural_sim->AddInputSpikeDriver(generator);
+     }
+   catch(EDLUTException exc)
+     {
+      cerr << exc;
+      delete generator;
+      generator=NULL;
+     }
+   return(generator);
+  }
+
+EXTERN_C GeneratorInputSpikeDriver *create_poisson_input_generator(Simulation *neural_sim, double cur_slot_time, long first_neuron, long num_neurons, unsigned int seed)
+  {
+   return(add_input_generator(neural_sim, new PoissonInputSpikeDriver(first_neuron, num_neurons, SIM_SLOT_LENGTH, cur_slot_time+INPUT_GENERATOR_DELAY, seed)));
+  }
+
+EXTERN_C GeneratorInputSpikeDriver *create_regular_input_generator(Simulation *neural_sim, double cur_slot_time, long first_neuron, long num_neurons)
+  {
+   return(add_input_generator(neural_sim, new RegularInputSpikeDriver(first_neuron, num_neurons, SIM_SLOT_LENGTH, cur_slot_time+INPUT_GENERATOR_DELAY)));
+  }
+
+EXTERN_C RBFInputSpikeDriver *create_rbf_input_generator(Simulation *neural_sim, double cur_slot_time, struct rbf_set *rbfs, long first_input_neuron, double max_spk_freq, int stochastic, unsigned int seed)
+  {
+   RBFInputSpikeDriver *generator;
+   generator=new RBFInputSpikeDriver(first_input_neuron, rbfs->num_rbfs, rbfs->first_bell_pos, rbfs->last_bell_pos, rbfs->bell_overlap, max_spk_freq*rbfs->bell_amp, stochastic!=0, SIM_SLOT_LENGTH, cur_slot_time+INPUT_GENERATOR_DELAY, seed);
+   return((RBFInputSpikeDriver *)add_input_generator(neural_sim, generator));
+  }
+
+EXTERN_C void set_input_generator_rates(GeneratorInputSpikeDriver *generator, double *rates)
+  {
+   generator->SetRates(rates);
+  }
+
+EXTERN_C void set_rbf_input_generator_value(RBFInputSpikeDriver *generator, double input_var)
+  {
+   generator->SetInput(input_var);
+  }
+
+EXTERN_C int inject_input_spikes(Simulation *neural_sim, long num_spikes, const double *spike_times, const long *spike_neurons)
+  {
+   long nspk, num_neurons;
+   Network *net=neural_sim->GetNetwork();
+   EventQueue *queue=neural_sim->GetQueue();
+   num_neurons=net->GetNeuronNumber();
+   for(nspk=0;nspk<num_spikes;nspk++)
+      if(spike_neurons[nspk] < 0 || spike_neurons[nspk] >= num_neurons)
+         return(1); // Nothing is injected if any neuron is not defined
+   for(nspk=0;nspk<num_spikes;nspk++)
+      queue->InsertInputSpike(spike_times[nspk], net->GetNeuronAt(spike_neurons[nspk]));
+   return(0);
+  }
+
+EXTERN_C int inject_input_spike_mask(Simulation *neural_sim, double spike_time, long first_neuron, long num_neurons, const unsigned char *mask)
+  {
+   long nneu, nbit;
+   unsigned char bits;
+   Network *net=neural_sim->GetNetwork();
+   EventQueue *queue=neural_sim->GetQueue();
+   if(first_neuron < 0 || num_neurons < 0 || first_neuron+num_neurons > net->GetNeuronNumber())
+      return(1);
+   for(nneu=0;nneu<num_neurons;nneu+=8)
+     {
+      bits=mask[nneu/8];
+      for(nbit=nneu;bits!=0 && nbit<num_neurons;nbit++,bits>>=1) // Empty bytes are skipped
+         if(bits & 1)
+            queue->InsertInputSpike(spike_time, net->GetNeuronAt(first_neuron+nbit));
+     }
+   return(0);
+  }
+
 /////////////////////// GENERATE LEARNING ACTIVITY ///////////////////
 
 double compute_PD_error(double desired_position, double desired_velocity, double actual_position, double actual_velocity, double kp, double kd)
@@ -498,8 +576,7 @@ void generate_stochastic_activity(Simulation *sim, double cur_slot_init, double
          if((cur_spk_end_zone-cur_spk_init_zone)*input_current*current_freq_factor*max_spk_freq > rand()/(double)RAND_MAX)
            {
             double cur_spk_time=(cur_spk_end_zone+cur_spk_init_zone)/2;
-            InputSpike *newspk=new InputSpike(cur_spk_time, cur_neuron);
-            sim->GetQueue()->InsertEvent(newspk);
+            sim->GetQueue()->InsertInputSpike(cur_spk_time, cur_neuron);
             last_spk_times[nneu]=cur_spk_time;
            }
         }
@@ -579,8 +656,10 @@ EXTERN_C void generate_learning_activity(Simulation *neural_sim, double cur_slot
 
 EXTERN_C int compute_output_activity(Simulation *neural_sim, double *output_vars)
   {
-   long nspks, spkneu;
+   long nspks, spkneu, nspk;
    double spktime;
+   const double *spktimes;
+   const long *spkneus;
    static float current_time_check=0;
    int noutputvar;
    ArrayOutputSpikeDriver *neural_activity_output_array;
@@ -590,10 +669,12 @@ EXTERN_C int compute_output_activity(Simulation *neural_sim, double *output_vars
    for(noutputvar=0;noutputvar<NUM_OUTPUT_VARS;noutputvar++)
       output_vars[noutputvar]*=exp(-SIM_SLOT_LENGTH/tau_time_constant);
  
-   nspks=0;
    neural_activity_output_array=(ArrayOutputSpikeDriver *)neural_sim->GetOutputSpikeDriver(0); // The first output spike driver in the list is the ArrayOutputSpikeDriver
-   while(neural_activity_output_array->RemoveBufferedSpike(spktime,spkneu))
+   nspks=neural_activity_output_array->GetSlotSpikes(spktimes,spkneus); // The spikes are read from the driver buffer (no allocations nor copies)
+   for(nspk=0;nspk<nspks;nspk++)
      {
+      spktime=spktimes[nspk];
+      spkneu=spkneus[nspk];
       if(spktime < current_time_check)
          printf("Unexpected spike time:%f of neuron: %li (current simulation time: %f)\n",spktime,spkneu,current_time_check);
       current_time_check=(float)spktime;
@@ -602,12 +683,17 @@ EXTERN_C int compute_output_activity(Simulation *neural_sim, double *output_vars
          noutputvar=(spkneu-FIRST_OUTPUT_NEURON)/NUM_NEURONS_PER_OUTPUT_VAR;
          output_vars[noutputvar]+=kernel_amplitude;
         }
-      nspks++;
      }
-   neural_activity_output_array->OutputBuffer.clear();
    return(nspks);
   }
 
+EXTERN_C int get_output_spikes(Simulation *neural_sim, const double **spike_times, const long **spike_neurons)
+  {
+   ArrayOutputSpikeDriver *neural_activity_output_array;
+   neural_activity_output_array=(ArrayOutputSpikeDriver *)neural_sim->GetOutputSpikeDriver(0); // The first output spike driver in the list is the ArrayOutputSpikeDriver
+   return(neural_activity_output_array->GetSlotSpikes(*spike_times,*spike_neurons));
+  }
+
 ///////////////////////////// VARIABLES LOG //////////////////////////
 
 EXTERN_C int create_log(struct log *log, int total_traj_executions, int trajectory_time)
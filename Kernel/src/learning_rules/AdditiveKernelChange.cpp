@@ -16,7 +16,7 @@
 
 #include "../../include/learning_rules/AdditiveKernelChange.h"
 
-#include "../../include/learning_rules/ExpState.h"
+#include "../../include/learning_rules/AdditiveKernelState.h"
 
 #include "../../include/spike/Interconnection.h"
 #include "../../include/spike/Neuron.h"
@@ -25,6 +25,15 @@
 
 #include <cmath>
 
+AdditiveKernelChange::AdditiveKernelChange(): PresynapticActivity(0), PresynapticActivitySize(0){
+}
+
+AdditiveKernelChange::~AdditiveKernelChange(){
+	if (this->PresynapticActivity!=0){
+		delete [] this->PresynapticActivity;
+	}
+}
+
 int AdditiveKernelChange::GetNumberOfVar() const{
 	return 2;
 }
@@ -79,7 +88,7 @@ void AdditiveKernelChange::ApplyPreSynapticSpike(Interconnection * Connection,do
 	int LearningRuleIndex = Connection->GetLearningRuleIndex_withoutPost();
 
 	// Second case: the weight change is linked to this connection
-	Connection->IncrementWeight(this->a1pre);
+	this->ChangeWeight(Connection, this->a1pre);
 
 	// Update the presynaptic activity
 	State->SetNewUpdateTime(LearningRuleIndex, SpikeTime, false);
@@ -89,30 +98,56 @@ void AdditiveKernelChange::ApplyPreSynapticSpike(Interconnection * Connection,do
 
 	// Check if this is the teaching signal
 	if(this->trigger == 1){
-		Interconnection * interi;
-		AdditiveKernelChange * wchani;
-		ConnectionState * ConnectionStatePre;
-		int LearningRuleIndex; 
-		int i;
-#pragma omp parallel for num_threads(8) schedule(guided, 32) if(Connection->GetTarget()->GetInputNumberWithoutPostSynapticLearning()>128) default(none) shared(Connection, SpikeTime) private(i, interi, wchani, ConnectionStatePre, LearningRuleIndex)
-		for(i=0; i<Connection->GetTarget()->GetInputNumberWithoutPostSynapticLearning(); ++i){
-			interi=Connection->GetTarget()->GetInputConnectionWithoutPostSynapticLearningAt(i);
-		    wchani=(AdditiveKernelChange *)interi->GetWeightChange_withoutPost();
-
-		    // Apply sinaptic plasticity driven by teaching signal
-		    // Get connection state
-			ConnectionStatePre = wchani->GetConnectionState();
-			LearningRuleIndex = interi->GetLearningRuleIndex_withoutPost();
-
-			// Update the presynaptic activity
-			ConnectionStatePre->SetNewUpdateTime(LearningRuleIndex, SpikeTime, false);
-
-			// Update synaptic weight
-			interi->IncrementWeight(wchani->a2prepre*ConnectionStatePre->GetPresynapticActivity(LearningRuleIndex));
+		Interconnection ** Inputs = Connection->GetTarget()->GetInputConnectionsWithoutPostSynapticLearning();
+		unsigned int NumberOfInputs = Connection->GetTarget()->GetInputNumberWithoutPostSynapticLearning();
+
+		// The input connections with the same learning rule are consecutive
+		unsigned int First = 0;
+		while (First<NumberOfInputs){
+			AdditiveKernelChange * wchani = (AdditiveKernelChange *) Inputs[First]->GetWeightChange_withoutPost();
+			unsigned int Last = First+1;
+			while (Last<NumberOfInputs && Inputs[Last]->GetWeightChange_withoutPost()==wchani){
+				Last++;
+			}
+
+			// Apply sinaptic plasticity driven by teaching signal
+			wchani->ApplyTeachingSignal(Inputs+First, Last-First, SpikeTime);
+			First = Last;
 		}
 	}
 }
 
+void AdditiveKernelChange::ApplyTeachingSignal(Interconnection ** Connections, unsigned int NumberOfConnections, double SpikeTime){
+	AdditiveKernelState * KernelState = (AdditiveKernelState *) this->State;
+
+	if (this->PresynapticActivitySize<NumberOfConnections){
+		if (this->PresynapticActivity!=0){
+			delete [] this->PresynapticActivity;
+		}
+		this->PresynapticActivity = new float [NumberOfConnections];
+		this->PresynapticActivitySize = NumberOfConnections;
+	}
+
+	// The connections of a neuron with the same learning rule have consecutive states (see Network::FindInConnections)
+	unsigned int FirstIndex = Connections[0]->GetLearningRuleIndex_withoutPost();
+	if ((unsigned int)Connections[NumberOfConnections-1]->GetLearningRuleIndex_withoutPost()==FirstIndex+NumberOfConnections-1){
+		KernelState->GetPresynapticActivities(FirstIndex, NumberOfConnections, SpikeTime, this->PresynapticActivity);
+	} else {
+		for (unsigned int i=0; i<NumberOfConnections; ++i){
+			KernelState->GetPresynapticActivities(Connections[i]->GetLearningRuleIndex_withoutPost(), 1, SpikeTime, this->PresynapticActivity+i);
+		}
+	}
+
+	// Update synaptic weights
+	for (unsigned int i=0; i<NumberOfConnections; ++i){
+		this->ChangeWeight(Connections[i], this->a2prepre*this->PresynapticActivity[i]);
+	}
+}
+
+void AdditiveKernelChange::SetTargetSynapses(unsigned int FirstIndex, unsigned int NumberOfSynapses){
+	((AdditiveKernelState *) this->State)->SetGroup(FirstIndex, NumberOfSynapses);
+}
+
 
 
 ostream & AdditiveKernelChange::PrintInfo(ostream & out){
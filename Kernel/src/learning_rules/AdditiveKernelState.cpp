@@ -0,0 +1,88 @@
+/***************************************************************************
+ *                           AdditiveKernelState.cpp                       *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/learning_rules/AdditiveKernelState.h"
+
+AdditiveKernelState::AdditiveKernelState(unsigned int NumSynapses, int NumVariables, float NewTau): ConnectionState(NumSynapses, NumVariables), GroupFirstSynapse(1,0), GroupSize(1,NumSynapses), GroupEpoch(1,0.0), tau(NewTau){
+	if (this->tau==0){
+		this->tau = 1e-6;
+	}
+	inv_tau=1.0f/tau;
+
+	this->SynapseGroup = (unsigned int *) new unsigned int [NumSynapses]();
+}
+
+AdditiveKernelState::~AdditiveKernelState() {
+	delete [] this->SynapseGroup;
+}
+
+void AdditiveKernelState::SetGroup(unsigned int FirstIndex, unsigned int NumberOfIndexes){
+	// The first group is the default one (all the synapses)
+	if (this->GroupSize[0]==this->NumberOfSynapses && this->GroupSize.size()==1){
+		this->GroupSize[0] = 0;
+	}
+
+	unsigned int NewGroup = this->GroupEpoch.size();
+	this->GroupFirstSynapse.push_back(FirstIndex);
+	this->GroupSize.push_back(NumberOfIndexes);
+	this->GroupEpoch.push_back(0.0);
+
+	for (unsigned int i=FirstIndex; i<FirstIndex+NumberOfIndexes; ++i){
+		this->SynapseGroup[i] = NewGroup;
+	}
+}
+
+void AdditiveKernelState::CheckEpoch(unsigned int group, double NewTime){
+	float ElapsedRelative = (float)(NewTime-this->GroupEpoch[group])*this->inv_tau;
+	if (ElapsedRelative>EPOCHLENGTH){
+		this->MoveEpoch(this->GroupFirstSynapse[group], this->GroupSize[group], ElapsedRelative);
+		this->GroupEpoch[group] = NewTime;
+	}
+}
+
+float AdditiveKernelState::GetPresynapticActivity(unsigned int index){
+	float Activity;
+	double Epoch = this->GroupEpoch[this->SynapseGroup[index]];
+	this->EvaluateKernels(index, 1, (float)(this->GetLastUpdateTime(index)-Epoch)*this->inv_tau, &Activity);
+	return Activity;
+}
+
+float AdditiveKernelState::GetPostsynapticActivity(unsigned int index){
+	return 0.0f;
+}
+
+void AdditiveKernelState::GetPresynapticActivities(unsigned int FirstIndex, unsigned int NumberOfIndexes, double Time, float * Activity){
+	unsigned int group = this->SynapseGroup[FirstIndex];
+
+	this->CheckEpoch(group, Time);
+
+	this->EvaluateKernels(FirstIndex, NumberOfIndexes, (float)(Time-this->GroupEpoch[group])*this->inv_tau, Activity);
+}
+
+void AdditiveKernelState::SetNewUpdateTime(unsigned int index, double NewTime, bool pre_post){
+	this->CheckEpoch(this->SynapseGroup[index], NewTime);
+
+	this->SetLastUpdateTime(index, NewTime);
+}
+
+void AdditiveKernelState::ApplyPresynapticSpike(unsigned int index){
+	double Epoch = this->GroupEpoch[this->SynapseGroup[index]];
+	this->AddSpike(index, (float)(this->GetLastUpdateTime(index)-Epoch)*this->inv_tau);
+}
+
+void AdditiveKernelState::ApplyPostsynapticSpike(unsigned int index){
+	return;
+}
@@ -16,14 +16,22 @@
 
 #include "../../include/learning_rules/ConnectionState.h"
 
-#include "../../include/simulation/ExponentialTable.h"
+#include <cstddef>
 
 ConnectionState::ConnectionState(unsigned int NumSynapses, int NumVariables): NumberOfSynapses(NumSynapses), NumberOfVariables(NumVariables){
 	// TODO Auto-generated constructor stub
 	this->LastUpdate = (double *) new double [NumSynapses]();
-	this->StateVars = (float *) new float [NumSynapses*NumVariables]();
 
-	exponential = new ExponentialTable(-20, 0, 4*1024*1024);
+	// Every state variable starts at an aligned position
+	const unsigned int FloatsPerBlock = CONNECTIONSTATEALIGNMENT/sizeof(float);
+	this->VariableStride = ((NumSynapses+FloatsPerBlock-1)/FloatsPerBlock)*FloatsPerBlock;
+	this->AllocatedStateVars = (float *) new float [this->VariableStride*NumVariables+FloatsPerBlock]();
+
+	size_t Misalignment = ((size_t) this->AllocatedStateVars)%CONNECTIONSTATEALIGNMENT;
+	this->StateVars = this->AllocatedStateVars;
+	if (Misalignment!=0){
+		this->StateVars += (CONNECTIONSTATEALIGNMENT-Misalignment)/sizeof(float);
+	}
 }
 
 ConnectionState::~ConnectionState() {
@@ -32,17 +40,13 @@ ConnectionState::~ConnectionState() {
 		delete [] this->LastUpdate;
 	}
 
-	if (this->StateVars!=0){
-		delete [] this->StateVars;
-	}
-
-	if(exponential!=0){
-		delete exponential;
+	if (this->AllocatedStateVars!=0){
+		delete [] this->AllocatedStateVars;
 	}
 }
 
 //void ConnectionState::void SetStateVariableAt(unsigned int index, unsigned int position,float NewValue){
-//	*(this->StateVars + index*NumberOfVariables + position) = NewValue;
+//	*(this->StateVars + position*VariableStride + index) = NewValue;
 //}
 
 unsigned int ConnectionState::GetNumberOfVariables(){
@@ -50,7 +54,7 @@ unsigned int ConnectionState::GetNumberOfVariables(){
 }
 
 //float ConnectionState::GetStateVariableAt(unsigned int index, unsigned int position){
-//	return *(this->StateVars + index*NumberOfVariables + position);
+//	return *(this->StateVars + position*VariableStride + index);
 //}
 
 //double ConnectionState::GetLastUpdateTime(unsigned int index){
@@ -0,0 +1,43 @@
+/***************************************************************************
+ *                           DeferredWeightChanges.cpp                     *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/learning_rules/DeferredWeightChanges.h"
+
+DeferredWeightChanges::DeferredWeightChanges(long int NumConnections): NumberOfChangedConnections(0){
+	this->Weights = new float [NumConnections];
+	for (long int i=0; i<NumConnections; ++i){
+		this->Weights[i] = NO_DEFERRED_WEIGHT;
+	}
+	this->ChangedConnections = new long int [NumConnections];
+}
+
+DeferredWeightChanges::~DeferredWeightChanges(){
+	delete [] this->Weights;
+	delete [] this->ChangedConnections;
+}
+
+void DeferredWeightChanges::ApplyChanges(Interconnection ** Connections){
+	for (long int i=0; i<this->NumberOfChangedConnections; ++i){
+		long int Index = this->ChangedConnections[i];
+		Connections[Index]->SetWeight(this->Weights[Index]);
+		this->Weights[Index] = NO_DEFERRED_WEIGHT;
+	}
+	this->NumberOfChangedConnections = 0;
+}
+
+long int DeferredWeightChanges::GetNumberOfChangedConnections() const{
+	return this->NumberOfChangedConnections;
+}
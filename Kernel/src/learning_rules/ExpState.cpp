@@ -21,11 +21,7 @@
 #include <cmath>
 #include <stdio.h>
 
-ExpState::ExpState(unsigned int NumSynapses, float NewTau): ConnectionState(NumSynapses, 2), tau(NewTau){
-	if (this->tau==0){
-		this->tau = 1e-6;
-	}
-	inv_tau=1.0f/tau;
+ExpState::ExpState(unsigned int NumSynapses, float NewTau): AdditiveKernelState(NumSynapses, 2, NewTau){
 }
 
 ExpState::~ExpState() {
@@ -36,69 +32,46 @@ unsigned int ExpState::GetNumberOfPrintableValues(){
 }
 
 double ExpState::GetPrintableValuesAt(unsigned int position){
-	if (position<ConnectionState::GetNumberOfPrintableValues()){
-		return ConnectionState::GetStateVariableAt(0, position);
+	if (position==0){
+		return this->GetPresynapticActivity(0);
+	} else if (position==1){
+		// The coefficients are referred to the epoch: they are moved to the last update time
+		float ElapsedRelative = (float)(this->GetLastUpdateTime(0)-this->GroupEpoch[this->SynapseGroup[0]])*this->inv_tau;
+		return this->GetStateVariableAt(0, 1)*ExponentialTable::GetResult(-ElapsedRelative);
+	} else if (position==this->GetNumberOfVariables()) {
+		return this->GetLastUpdateTime(0);
 	} else if (position==ConnectionState::GetNumberOfPrintableValues()) {
 		return this->tau;
 	} else return -1;
 }
 
-float ExpState::GetPresynapticActivity(unsigned int index){
-	return this->GetStateVariableAt(index, 0);
-}
+void ExpState::MoveEpoch(unsigned int FirstIndex, unsigned int NumberOfIndexes, float ElapsedRelative){
+	float expon = exp(-ElapsedRelative);
+	float * CoeffA = this->GetStateVariableArray(0)+FirstIndex;
+	float * CoeffB = this->GetStateVariableArray(1)+FirstIndex;
 
-float ExpState::GetPostsynapticActivity(unsigned int index){
-	return 0.0f;
+	for (unsigned int i=0; i<NumberOfIndexes; ++i){
+		CoeffA[i] = (CoeffA[i]+ElapsedRelative*CoeffB[i])*expon;
+		CoeffB[i] = CoeffB[i]*expon;
+	}
 }
 
+void ExpState::AddSpike(unsigned int index, float ElapsedRelative){
+	float growth = 1.0f/ExponentialTable::GetResult(-ElapsedRelative);
 
-//void ExpState::SetNewUpdateTime(unsigned int index, double NewTime, bool pre_post){
-//	float ElapsedTime=float(NewTime -  this->GetLastUpdateTime(index));
-//	float factor = ElapsedTime*this->inv_tau;
-//	float expon = exp(-factor);
-//	
-//	// Update the activity value
-//	float OldExpon = this->GetStateVariableAt(index, 0);
-//	float OldExpon1 = this->GetStateVariableAt(index, 1);
-//
-//	float NewExpon = (OldExpon+factor*OldExpon1)*expon;
-//	float NewExpon1 = OldExpon1*expon;
-//
-//	this->SetStateVariableAt(index, 0, NewExpon);
-//	this->SetStateVariableAt(index, 1, NewExpon1);
-//
-//	this->SetLastUpdateTime(index, NewTime);
-//}
-
-void ExpState::SetNewUpdateTime(unsigned int index, double NewTime, bool pre_post){
-	float ElapsedTime=float(NewTime -  this->GetLastUpdateTime(index));
-	float factor = ElapsedTime*this->inv_tau;
-	float expon = exponential->GetResult(-factor);
-	
-	// Update the activity value
-	float OldExpon = this->GetStateVariableAt(index, 0);
-	float OldExpon1 = this->GetStateVariableAt(index, 1);
-
-	float NewExpon = (OldExpon+factor*OldExpon1)*expon;
-	float NewExpon1 = OldExpon1*expon;
-
-	this->SetStateVariableAt(index, 0, NewExpon);
-	this->SetStateVariableAt(index, 1, NewExpon1);
-
-	this->SetLastUpdateTime(index, NewTime);
+	this->incrementStateVaraibleAt(index, 0, -ElapsedRelative*growth);
+	this->incrementStateVaraibleAt(index, 1, growth);
 }
 
+void ExpState::EvaluateKernels(unsigned int FirstIndex, unsigned int NumberOfIndexes, float ElapsedRelative, float * Activity){
+	// All the synapses share the decay factors
+	float FactorA = ExponentialTable::GetResult(-ElapsedRelative);
+	float FactorB = ElapsedRelative*FactorA;
+	const float * CoeffA = this->GetStateVariableArray(0)+FirstIndex;
+	const float * CoeffB = this->GetStateVariableArray(1)+FirstIndex;
 
-
-void ExpState::ApplyPresynapticSpike(unsigned int index){
-	//float OldExpon = this->GetStateVariableAt(index, 1);
-	//this->SetStateVariableAt(index, 1,OldExpon+1);
-
-	this->incrementStateVaraibleAt(index, 1, 1.0f);
-}
-
-void ExpState::ApplyPostsynapticSpike(unsigned int index){
-	return;
+	#pragma omp parallel for if(NumberOfIndexes>PARALLELKERNELEVALUATION) schedule(static)
+	for (int i=0; i<(int)NumberOfIndexes; ++i){
+		Activity[i] = CoeffA[i]*FactorA + CoeffB[i]*FactorB;
+	}
 }
-
-
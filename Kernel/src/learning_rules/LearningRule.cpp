@@ -16,8 +16,10 @@
 
 #include "../../include/learning_rules/LearningRule.h"
 
+#include "../../include/learning_rules/ConnectionState.h"
 
-LearningRule::LearningRule(): State(0), counter(0){
+
+LearningRule::LearningRule(): State(0), counter(0), DeferredWeights(0){
 
 }
 
@@ -29,6 +31,23 @@ LearningRule::~LearningRule(){
 
 
 
+void LearningRule::InitializeConnectionState(unsigned int NumberOfSynapses, unsigned int NumberOfNeurons){
+	this->InitializeConnectionState(NumberOfSynapses);
+}
+
+void LearningRule::SetTargetSynapses(unsigned int FirstIndex, unsigned int NumberOfSynapses){
+}
+
+void LearningRule::ApplyPostSynapticSpikes(Interconnection ** Connections, unsigned int NumberOfConnections, double SpikeTime){
+	for (unsigned int i=0; i<NumberOfConnections; ++i){
+		this->ApplyPostSynapticSpike(Connections[i], SpikeTime);
+	}
+}
+
+void LearningRule::SetDeferredWeights(DeferredWeightChanges * NewDeferredWeights){
+	this->DeferredWeights = NewDeferredWeights;
+}
+
 ConnectionState * LearningRule::GetConnectionState(){
 	return this->State;
 }
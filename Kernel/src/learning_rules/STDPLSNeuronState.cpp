@@ -0,0 +1,35 @@
+/***************************************************************************
+ *                           STDPLSNeuronState.cpp                         *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/learning_rules/STDPLSNeuronState.h"
+
+STDPLSNeuronState::STDPLSNeuronState(unsigned int NumNeurons, float NewLTPValue, float NewLTDValue): STDPNeuronState(NumNeurons, NewLTPValue, NewLTDValue){
+
+}
+
+STDPLSNeuronState::~STDPLSNeuronState() {
+
+}
+
+void STDPLSNeuronState::ApplyPresynapticSpike(unsigned int index){
+	// Store the activity in the state variable
+	this->SetStateVariableAt(index, 0, 1.0f);
+}
+
+void STDPLSNeuronState::ApplyPostsynapticSpike(unsigned int index){
+	// Store the activity in the state variable
+	this->SetStateVariableAt(index, 1, 1.0f);
+}
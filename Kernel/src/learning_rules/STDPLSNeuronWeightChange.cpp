@@ -0,0 +1,30 @@
+/***************************************************************************
+ *                           STDPLSNeuronWeightChange.cpp                  *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/learning_rules/STDPLSNeuronWeightChange.h"
+
+#include "../../include/learning_rules/STDPLSNeuronState.h"
+
+void STDPLSNeuronWeightChange::InitializeConnectionState(unsigned int NumberOfSynapses, unsigned int NumberOfNeurons){
+	this->State=(ConnectionState *) new STDPLSNeuronState(NumberOfNeurons, this->tauLTP, this->tauLTD);
+}
+
+ostream & STDPLSNeuronWeightChange::PrintInfo(ostream & out){
+
+	out << "- STDP Last Spike Learning Rule (neuron traces): LTD " << this->MaxChangeLTD << "\t" << this->tauLTD << "\tLTP " << this->MaxChangeLTP << "\t" << this->tauLTP << endl;
+
+	return out;
+}
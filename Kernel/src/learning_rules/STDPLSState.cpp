@@ -20,6 +20,11 @@
 
 #include <cmath>
 
+/*!
+ * Minimum number of synapses to update the state in parallel.
+ */
+#define PARALLELSTATEUPDATE 1024
+
 STDPLSState::STDPLSState(unsigned int NumSynapses, double NewLTPValue, double NewLTDValue): STDPState(NumSynapses, NewLTPValue, NewLTDValue){
 
 }
@@ -59,10 +64,10 @@ void STDPLSState::SetNewUpdateTime(unsigned int index, double NewTime, bool pre_
 	float ElapsedTime=(float)(NewTime - this->GetLastUpdateTime(index));
 	if(pre_post){
 		//Accumulate activity since the last update time
-		this->multiplyStateVaraibleAt(index,0,exponential->GetResult(-ElapsedTime*this->inv_LTPTau));
+		this->multiplyStateVaraibleAt(index,0,ExponentialTable::GetResult(-ElapsedTime*this->inv_LTPTau));
 	}else{
 		//Accumulate activity since the last update time
-		this->multiplyStateVaraibleAt(index,1,exponential->GetResult(-ElapsedTime*this->inv_LTDTau));
+		this->multiplyStateVaraibleAt(index,1,ExponentialTable::GetResult(-ElapsedTime*this->inv_LTDTau));
 	}
 	this->SetLastUpdateTime(index, NewTime);
 }
@@ -78,3 +83,22 @@ void STDPLSState::ApplyPostsynapticSpike(unsigned int index){
 }
 
 
+void STDPLSState::ApplyPostsynapticSpikes(unsigned int FirstIndex, unsigned int NumberOfIndexes, double NewTime, float * PresynapticActivity){
+	double * LastUpdate = this->LastUpdate+FirstIndex;
+	float * PreActivity = this->GetStateVariableArray(0)+FirstIndex;
+	float * PostActivity = this->GetStateVariableArray(1)+FirstIndex;
+
+	#pragma omp parallel for if(NumberOfIndexes>PARALLELSTATEUPDATE) schedule(static)
+	for (int i=0; i<(int)NumberOfIndexes; ++i){
+		float ElapsedTime=(float)(NewTime - LastUpdate[i]);
+
+		//Accumulate activity since the last update time and store the postsynaptic spike
+		float NewPreActivity = PreActivity[i]*ExponentialTable::GetResult(-ElapsedTime*this->inv_LTPTau);
+		PreActivity[i] = NewPreActivity;
+		PostActivity[i] = 1.0f;
+
+		LastUpdate[i] = NewTime;
+		PresynapticActivity[i] = NewPreActivity;
+	}
+}
+
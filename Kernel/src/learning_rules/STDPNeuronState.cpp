@@ -0,0 +1,76 @@
+/***************************************************************************
+ *                           STDPNeuronState.cpp                           *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/learning_rules/STDPNeuronState.h"
+
+STDPNeuronState::STDPNeuronState(unsigned int NumNeurons, float NewLTPValue, float NewLTDValue): ConnectionState(NumNeurons, 2), LTPTau(NewLTPValue), LTDTau(NewLTDValue){
+	inv_LTPTau=1.0f/NewLTPValue;
+	inv_LTDTau=1.0f/NewLTDValue;
+
+	this->LastPostUpdate = (double *) new double [NumNeurons];
+
+	// No spike has been emitted yet (the simulation starts at time 0).
+	for (unsigned int i=0; i<NumNeurons; i++){
+		this->SetLastUpdateTime(i, -1.0);
+		this->LastPostUpdate[i] = -1.0;
+	}
+}
+
+STDPNeuronState::~STDPNeuronState() {
+	delete [] this->LastPostUpdate;
+}
+
+unsigned int STDPNeuronState::GetNumberOfPrintableValues(){
+	return ConnectionState::GetNumberOfPrintableValues()+2;
+}
+
+double STDPNeuronState::GetPrintableValuesAt(unsigned int position){
+	if (position<ConnectionState::GetNumberOfPrintableValues()){
+		return ConnectionState::GetStateVariableAt(0, position);
+	} else if (position==ConnectionState::GetNumberOfPrintableValues()) {
+		return this->LTPTau;
+	} else if (position==ConnectionState::GetNumberOfPrintableValues()+1) {
+		return this->LTDTau;
+	} else return -1;
+}
+
+void STDPNeuronState::SetNewUpdateTime(unsigned int index, double NewTime, bool pre_post){
+	if(pre_post){
+		float ElapsedTime=(float)(NewTime - this->LastPostUpdate[index]);
+
+		//Accumulate activity since the last update time
+		this->multiplyStateVaraibleAt(index,1,ExponentialTable::GetResult(-ElapsedTime*this->inv_LTDTau));
+
+		this->LastPostUpdate[index] = NewTime;
+	}else{
+		float ElapsedTime=(float)(NewTime - this->GetLastUpdateTime(index));
+
+		//Accumulate activity since the last update time
+		this->multiplyStateVaraibleAt(index,0,ExponentialTable::GetResult(-ElapsedTime*this->inv_LTPTau));
+
+		this->SetLastUpdateTime(index, NewTime);
+	}
+}
+
+void STDPNeuronState::ApplyPresynapticSpike(unsigned int index){
+	// Increment the activity in the state variable
+	this->incrementStateVaraibleAt(index, 0, 1.0f);
+}
+
+void STDPNeuronState::ApplyPostsynapticSpike(unsigned int index){
+	// Increment the activity in the state variable
+	this->incrementStateVaraibleAt(index, 1, 1.0f);
+}
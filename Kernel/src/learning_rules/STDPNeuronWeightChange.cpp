@@ -0,0 +1,112 @@
+/***************************************************************************
+ *                           STDPNeuronWeightChange.cpp                    *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/learning_rules/STDPNeuronWeightChange.h"
+
+#include "../../include/learning_rules/STDPNeuronState.h"
+
+#include "../../include/spike/Interconnection.h"
+#include "../../include/spike/Neuron.h"
+
+/*!
+ * Minimum interval between two spikes of the same neuron. The emission time of a spike is
+ * calculated from the arrival time of each connection, so it is only accurate up to rounding.
+ */
+#define SAMESPIKEINTERVAL 1e-9
+
+void STDPNeuronWeightChange::InitializeConnectionState(unsigned int NumberOfSynapses) throw (EDLUTException){
+	throw EDLUTException(4,79,39,0);
+}
+
+void STDPNeuronWeightChange::InitializeConnectionState(unsigned int NumberOfSynapses, unsigned int NumberOfNeurons){
+	this->State=(ConnectionState *) new STDPNeuronState(NumberOfNeurons, this->tauLTP, this->tauLTD);
+}
+
+void STDPNeuronWeightChange::ApplyPreSynapticSpike(Interconnection * Connection,double SpikeTime){
+	STDPNeuronState * NeuronState = (STDPNeuronState *) this->State;
+	unsigned int Source = Connection->GetSource()->GetIndex();
+	unsigned int Target = Connection->GetTarget()->GetIndex();
+
+	double EmissionTime = SpikeTime - Connection->GetDelay();
+
+	// The presynaptic trace is only updated with the first connection which receives the spike
+	if (EmissionTime > NeuronState->GetLastUpdateTime(Source)+SAMESPIKEINTERVAL){
+		// Apply synaptic activity decaying rule
+		NeuronState->SetNewUpdateTime(Source, EmissionTime, false);
+
+		// Apply presynaptic spike
+		NeuronState->ApplyPresynapticSpike(Source);
+	}
+
+	// Apply weight change
+	this->ChangeWeight(Connection, -this->MaxChangeLTD*NeuronState->GetPostsynapticActivityAt(Target, SpikeTime));
+
+	return;
+}
+
+void STDPNeuronWeightChange::ApplyPostSynapticSpike(Interconnection * Connection,double SpikeTime){
+	STDPNeuronState * NeuronState = (STDPNeuronState *) this->State;
+	unsigned int Source = Connection->GetSource()->GetIndex();
+	unsigned int Target = Connection->GetTarget()->GetIndex();
+
+	// The postsynaptic trace is only updated once per spike (the input connections of the
+	// target neuron can be processed in parallel).
+	if (NeuronState->GetLastPostUpdateTime(Target)!=SpikeTime){
+		#pragma omp critical (STDPNeuronPostsynaptic)
+		{
+			if (NeuronState->GetLastPostUpdateTime(Target)!=SpikeTime){
+				// Apply synaptic activity decaying rule
+				NeuronState->SetNewUpdateTime(Target, SpikeTime, true);
+
+				// Apply postsynaptic spike
+				NeuronState->ApplyPostsynapticSpike(Target);
+			}
+		}
+	}
+
+	// Apply weight change (with the presynaptic activity seen by this connection)
+	this->ChangeWeight(Connection, this->MaxChangeLTP*NeuronState->GetPresynapticActivityAt(Source, SpikeTime-Connection->GetDelay()));
+
+	return;
+}
+
+void STDPNeuronWeightChange::ApplyPostSynapticSpikes(Interconnection ** Connections, unsigned int NumberOfConnections, double SpikeTime){
+	STDPNeuronState * NeuronState = (STDPNeuronState *) this->State;
+	unsigned int Target = Connections[0]->GetTarget()->GetIndex();
+
+	if (NeuronState->GetLastPostUpdateTime(Target)!=SpikeTime){
+		// Apply synaptic activity decaying rule
+		NeuronState->SetNewUpdateTime(Target, SpikeTime, true);
+
+		// Apply postsynaptic spike
+		NeuronState->ApplyPostsynapticSpike(Target);
+	}
+
+	// Apply weight change (with the presynaptic activity seen by each connection)
+	for (unsigned int i=0; i<NumberOfConnections; ++i){
+		Interconnection * Connection = Connections[i];
+		this->ChangeWeight(Connection, this->MaxChangeLTP*NeuronState->GetPresynapticActivityAt(Connection->GetSource()->GetIndex(), SpikeTime-Connection->GetDelay()));
+	}
+
+	return;
+}
+
+ostream & STDPNeuronWeightChange::PrintInfo(ostream & out){
+
+	out << "- STDP Learning Rule (neuron traces): LTD " << this->MaxChangeLTD << "\t" << this->tauLTD << "\tLTP " << this->MaxChangeLTP << "\t" << this->tauLTP << endl;
+
+	return out;
+}
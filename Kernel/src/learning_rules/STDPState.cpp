@@ -24,6 +24,11 @@
 #include <stdio.h>
 #include <float.h>
 
+/*!
+ * Minimum number of synapses to update the state in parallel.
+ */
+#define PARALLELSTATEUPDATE 1024
+
 STDPState::STDPState(int NumSynapses, float NewLTPValue, float NewLTDValue): ConnectionState(NumSynapses, 2), LTPTau(NewLTPValue), LTDTau(NewLTDValue){
 	inv_LTPTau=1.0f/NewLTPValue;
 	inv_LTDTau=1.0f/NewLTDValue;
@@ -77,9 +82,9 @@ void STDPState::SetNewUpdateTime(unsigned int index, double NewTime, bool pre_po
 	float ElapsedTime=(float)(NewTime - this->GetLastUpdateTime(index));
 
     //Accumulate activity since the last update time
-	this->multiplyStateVaraibleAt(index,0,exponential->GetResult(-ElapsedTime*this->inv_LTPTau));
+	this->multiplyStateVaraibleAt(index,0,ExponentialTable::GetResult(-ElapsedTime*this->inv_LTPTau));
     //Accumulate activity since the last update time
-	this->multiplyStateVaraibleAt(index,1,exponential->GetResult(-ElapsedTime*this->inv_LTDTau));
+	this->multiplyStateVaraibleAt(index,1,ExponentialTable::GetResult(-ElapsedTime*this->inv_LTDTau));
 
 	this->SetLastUpdateTime(index, NewTime);
 }
@@ -98,3 +103,22 @@ void STDPState::ApplyPostsynapticSpike(unsigned int index){
 	this->incrementStateVaraibleAt(index, 1, 1.0f); 
 }
 
+
+void STDPState::ApplyPostsynapticSpikes(unsigned int FirstIndex, unsigned int NumberOfIndexes, double NewTime, float * PresynapticActivity){
+	double * LastUpdate = this->LastUpdate+FirstIndex;
+	float * PreActivity = this->GetStateVariableArray(0)+FirstIndex;
+	float * PostActivity = this->GetStateVariableArray(1)+FirstIndex;
+
+	#pragma omp parallel for if(NumberOfIndexes>PARALLELSTATEUPDATE) schedule(static)
+	for (int i=0; i<(int)NumberOfIndexes; ++i){
+		float ElapsedTime=(float)(NewTime - LastUpdate[i]);
+
+		//Accumulate activity since the last update time and apply the postsynaptic spike
+		float NewPreActivity = PreActivity[i]*ExponentialTable::GetResult(-ElapsedTime*this->inv_LTPTau);
+		PreActivity[i] = NewPreActivity;
+		PostActivity[i] = PostActivity[i]*ExponentialTable::GetResult(-ElapsedTime*this->inv_LTDTau)+1.0f;
+
+		LastUpdate[i] = NewTime;
+		PresynapticActivity[i] = NewPreActivity;
+	}
+}
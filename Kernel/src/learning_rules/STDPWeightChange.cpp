@@ -25,6 +25,15 @@
 #include "../../include/neuron_model/NeuronState.h"
 
 
+STDPWeightChange::STDPWeightChange(): PresynapticActivity(0), PresynapticActivitySize(0){
+}
+
+STDPWeightChange::~STDPWeightChange(){
+	if (this->PresynapticActivity!=0){
+		delete [] this->PresynapticActivity;
+	}
+}
+
 void STDPWeightChange::InitializeConnectionState(unsigned int NumberOfSynapses){
 	this->State=(ConnectionState *) new STDPState(NumberOfSynapses, this->tauLTP, this->tauLTD);
 }
@@ -39,7 +48,7 @@ void STDPWeightChange::ApplyPreSynapticSpike(Interconnection * Connection,double
 	State->ApplyPresynapticSpike(LearningRuleIndex);
 
 	// Apply weight change
-	Connection->IncrementWeight(-this->MaxChangeLTD*State->GetPostsynapticActivity(LearningRuleIndex));
+	this->ChangeWeight(Connection, -this->MaxChangeLTD*State->GetPostsynapticActivity(LearningRuleIndex));
 
 	return;
 }
@@ -54,11 +63,38 @@ void STDPWeightChange::ApplyPostSynapticSpike(Interconnection * Connection,doubl
 	State->ApplyPostsynapticSpike(LearningRuleIndex);
 
 	// Apply weight change
-	Connection->IncrementWeight(this->MaxChangeLTP*State->GetPresynapticActivity(LearningRuleIndex));
+	this->ChangeWeight(Connection, this->MaxChangeLTP*State->GetPresynapticActivity(LearningRuleIndex));
 
 	return;
 }
 
+void STDPWeightChange::ApplyPostSynapticSpikes(Interconnection ** Connections, unsigned int NumberOfConnections, double SpikeTime){
+	unsigned int FirstIndex = Connections[0]->GetLearningRuleIndex_withPost();
+
+	// The connections of a neuron with the same learning rule have consecutive states (see Network::FindInConnections)
+	if ((unsigned int)Connections[NumberOfConnections-1]->GetLearningRuleIndex_withPost()!=FirstIndex+NumberOfConnections-1){
+		WithPostSynaptic::ApplyPostSynapticSpikes(Connections, NumberOfConnections, SpikeTime);
+		return;
+	}
+
+	if (this->PresynapticActivitySize<NumberOfConnections){
+		if (this->PresynapticActivity!=0){
+			delete [] this->PresynapticActivity;
+		}
+		this->PresynapticActivity = new float [NumberOfConnections];
+		this->PresynapticActivitySize = NumberOfConnections;
+	}
+
+	// Apply synaptic activity decaying rule and postsynaptic spike
+	((STDPState *) this->State)->ApplyPostsynapticSpikes(FirstIndex, NumberOfConnections, SpikeTime, this->PresynapticActivity);
+
+	// Apply weight change
+	for (unsigned int i=0; i<NumberOfConnections; ++i){
+		this->ChangeWeight(Connections[i], this->MaxChangeLTP*this->PresynapticActivity[i]);
+	}
+
+	return;
+}
 
 void STDPWeightChange::LoadLearningRule(FILE * fh, long & Currentline) throw (EDLUTFileException){
 	skip_comments(fh,Currentline);
@@ -44,16 +44,10 @@ float SinState::inv_LUTStep = 0;
 
 float SinState::SinLUT[2*TERMSLUT];
 
-SinState::SinState(unsigned int NumSynapses, unsigned int NewExponent, float NewMaxpos): ConnectionState(NumSynapses, NewExponent+2), exponent(NewExponent), maxpos(NewMaxpos){
+SinState::SinState(unsigned int NumSynapses, unsigned int NewExponent, float NewMaxpos): AdditiveKernelState(NumSynapses, NewExponent+1, NewMaxpos/atan((float)NewExponent)), exponent(NewExponent), maxpos(NewMaxpos){
 
-	this->tau = this->maxpos/atan((float)exponent);
 	this->factor = 1./(exp(-atan((float)this->exponent))*pow(sin(atan((float)this->exponent)),(int) this->exponent));
 
-	if (this->tau==0){
-		this->tau = 1e-6;
-	}
-	inv_tau=1.0f/tau;
-
 	// Initialize LUT
 	if (!this->InitializedLUT){
 		this->InitializedLUT = true;
@@ -73,138 +67,122 @@ SinState::SinState(unsigned int NumSynapses, unsigned int NewExponent, float New
 SinState::~SinState() {
 }
 
-float SinState::GetPresynapticActivity(unsigned int index){
-	return this->GetStateVariableAt(index, 0);
-}
-
-float SinState::GetPostsynapticActivity(unsigned int index){
-	return 0.0f;
-}
 
 unsigned int SinState::GetNumberOfPrintableValues(){
-	return ConnectionState::GetNumberOfPrintableValues()+2;
+	return ConnectionState::GetNumberOfPrintableValues()+3;
 }
 
 double SinState::GetPrintableValuesAt(unsigned int position){
-	if (position<ConnectionState::GetNumberOfPrintableValues()){
-		return ConnectionState::GetStateVariableAt(0,position);
-	} else if (position==ConnectionState::GetNumberOfPrintableValues()) {
+	if (position==0){
+		return this->GetPresynapticActivity(0);
+	} else if (position<=this->GetNumberOfVariables()){
+		// The coefficients are referred to the epoch: they are moved to the last update time
+		unsigned int variable = position-1;
+		float ElapsedRelative = (float)(this->GetLastUpdateTime(0)-this->GroupEpoch[this->SynapseGroup[0]])*this->inv_tau;
+		float expon = ExponentialTable::GetResult(-ElapsedRelative);
+		if (variable==0){
+			return this->GetStateVariableAt(0, 0)*expon;
+		}
+
+		unsigned int grade = variable+(variable&1);
+		unsigned int aux=(int)(ElapsedRelative*inv_LUTStep + 0.5f);
+		unsigned int LUTindex = (grade*aux)%(TERMSLUT*2);
+		float SinVar = SinLUT[LUTindex]*expon;
+		float CosVar = SinLUT[LUTindex+1]*expon;
+		float OldVarCos = this->GetStateVariableAt(0, grade-1);
+		float OldVarSin = this->GetStateVariableAt(0, grade);
+		if (variable&1){
+			return OldVarCos*CosVar-OldVarSin*SinVar;
+		} else {
+			return OldVarSin*CosVar+OldVarCos*SinVar;
+		}
+	} else if (position==this->GetNumberOfVariables()+1) {
+		return this->GetLastUpdateTime(0);
+	} else if (position==this->GetNumberOfVariables()+2) {
 		return this->exponent;
-	} else if (position==ConnectionState::GetNumberOfPrintableValues()+1) {
+	} else if (position==this->GetNumberOfVariables()+3) {
 		return this->maxpos;
 	} else return -1;
 }
 
 
-//void SinState::SetNewUpdateTime (unsigned int index, double NewTime, bool pre_post){
-//	// Update the activity value
-//	float OldExpon = this->GetStateVariableAt(index, 1);
-//
-//	float ElapsedTime=float(NewTime -  this->GetLastUpdateTime(index));
-//	float ElapsedRelative = ElapsedTime*this->inv_tau;
-//	float expon = exp(-ElapsedRelative);
-//
-//	unsigned int ExponenLine = this->exponent>>1;
-//
-//	const float* TermPointer = this->terms[ExponenLine]; 
-//
-//	float NewActivity =OldExpon*(*(TermPointer++))*expon;
-//
-//	float NewExpon = OldExpon * expon;
-//
-//	this->SetStateVariableAt(index, 1, NewExpon);
-//
-//	unsigned int aux=(int)(ElapsedRelative*inv_LUTStep + 0.5f);
-//
-//	for (unsigned int grade=2; grade<=this->exponent; grade+=2){
-//
-//		unsigned int LUTindex = (grade*aux)%(TERMSLUT*2);
-//		float SinVar = SinLUT[LUTindex];
-//		float CosVar = SinLUT[LUTindex+1];
-//
-//		float OldVarCos = this->GetStateVariableAt(index, grade);
-//		float OldVarSin = this->GetStateVariableAt(index, grade + 1);
-//
-//		float NewVarCos = (OldVarCos*CosVar-OldVarSin*SinVar)*expon;
-//		float NewVarSin = (OldVarSin*CosVar+OldVarCos*SinVar)*expon;
-//
-//		
-//		NewActivity += (NewVarCos*(*(TermPointer++)));
-//
-//		/*if(spike){  // if spike, we need to increase the e1 variable
-//			NewVarCos += 1;
-//		}*/
-//
-//		//this->SetStateVariableAt(index, grade, NewVarCos);
-//		//this->SetStateVariableAt(index, grade + 1, NewVarSin);
-//		this->SetStateVariableAt(index, grade , NewVarCos, NewVarSin);
-//
-//	}
-//	NewActivity*=this->factor;
-//	this->SetStateVariableAt(index, 0, NewActivity);
-//
-//	this->SetLastUpdateTime(index, NewTime);
-//}
-
-
-void SinState::SetNewUpdateTime (unsigned int index, double NewTime, bool pre_post){
-	// Update the activity value
-	float OldExpon = this->GetStateVariableAt(index, 1);
-
-	float ElapsedTime=float(NewTime -  this->GetLastUpdateTime(index));
-	float ElapsedRelative = ElapsedTime*this->inv_tau;
-	float expon = exponential->GetResult(-ElapsedRelative);
-
-	unsigned int ExponenLine = this->exponent>>1;
-
-	const float* TermPointer = this->terms[ExponenLine]; 
-
-	float NewActivity =OldExpon*(*(TermPointer++))*expon;
-
-	float NewExpon = OldExpon * expon;
+
+void SinState::MoveEpoch(unsigned int FirstIndex, unsigned int NumberOfIndexes, float ElapsedRelative){
+	float expon = exp(-ElapsedRelative);
 
 	unsigned int aux=(int)(ElapsedRelative*inv_LUTStep + 0.5f);
 
-	for (unsigned int grade=2; grade<=this->exponent; grade+=2){
+	float * CoeffExp = this->GetStateVariableArray(0)+FirstIndex;
+	for (unsigned int i=0; i<NumberOfIndexes; ++i){
+		CoeffExp[i] *= expon;
+	}
 
+	// Every harmonic is rotated with the same angle in all the synapses
+	for (unsigned int grade=2; grade<=this->exponent; grade+=2){
 		unsigned int LUTindex = (grade*aux)%(TERMSLUT*2);
-		float SinVar = SinLUT[LUTindex];
-		float CosVar = SinLUT[LUTindex+1];
-
-		float OldVarCos = this->GetStateVariableAt(index, grade);
-		float OldVarSin = this->GetStateVariableAt(index, grade + 1);
+		float SinVar = SinLUT[LUTindex]*expon;
+		float CosVar = SinLUT[LUTindex+1]*expon;
 
-		float NewVarCos = (OldVarCos*CosVar-OldVarSin*SinVar)*expon;
-		float NewVarSin = (OldVarSin*CosVar+OldVarCos*SinVar)*expon;
+		float * CoeffCos = this->GetStateVariableArray(grade-1)+FirstIndex;
+		float * CoeffSin = this->GetStateVariableArray(grade)+FirstIndex;
+		for (unsigned int i=0; i<NumberOfIndexes; ++i){
+			float OldVarCos = CoeffCos[i];
+			float OldVarSin = CoeffSin[i];
 
-		
-		NewActivity += (NewVarCos*(*(TermPointer++)));
+			CoeffCos[i] = OldVarCos*CosVar-OldVarSin*SinVar;
+			CoeffSin[i] = OldVarSin*CosVar+OldVarCos*SinVar;
+		}
+	}
+}
 
-		/*if(spike){  // if spike, we need to increase the e1 variable
-			NewVarCos += 1;
-		}*/
+void SinState::AddSpike(unsigned int index, float ElapsedRelative){
+	float growth = 1.0f/ExponentialTable::GetResult(-ElapsedRelative);
 
-		//this->SetStateVariableAt(index, grade, NewVarCos);
-		//this->SetStateVariableAt(index, grade + 1, NewVarSin);
-		this->SetStateVariableAt(index, grade , NewVarCos, NewVarSin);
+	unsigned int aux=(int)(ElapsedRelative*inv_LUTStep + 0.5f);
 
+	this->incrementStateVaraibleAt(index, 0, growth);
+	for (unsigned int grade=2; grade<=this->exponent; grade+=2){
+		// The spike is rotated back to the epoch
+		unsigned int LUTindex = (grade*aux)%(TERMSLUT*2);
+		this->incrementStateVaraibleAt(index, grade-1, growth*SinLUT[LUTindex+1]);
+		this->incrementStateVaraibleAt(index, grade, -growth*SinLUT[LUTindex]);
 	}
-	NewActivity*=this->factor;
-	this->SetStateVariableAt(index, 0, NewActivity, NewExpon);
-
-	this->SetLastUpdateTime(index, NewTime);
 }
 
+void SinState::EvaluateKernels(unsigned int FirstIndex, unsigned int NumberOfIndexes, float ElapsedRelative, float * Activity){
+	// All the synapses share the factors of the coefficients
+	float Factors[2*10+1];
+	float expon = ExponentialTable::GetResult(-ElapsedRelative)*this->factor;
+	const float* TermPointer = this->terms[this->exponent>>1];
+
+	unsigned int aux=(int)(ElapsedRelative*inv_LUTStep + 0.5f);
 
-void SinState::ApplyPresynapticSpike(unsigned int index){
-	this->incrementStateVaraibleAt(index, 1, 1.0f);
+	Factors[0] = expon*TermPointer[0];
 	for (unsigned int grade=2; grade<=this->exponent; grade+=2){
-		this->incrementStateVaraibleAt(index, grade, 1.0f);
+		unsigned int LUTindex = (grade*aux)%(TERMSLUT*2);
+		Factors[grade-1] = expon*TermPointer[grade>>1]*SinLUT[LUTindex+1];
+		Factors[grade] = -expon*TermPointer[grade>>1]*SinLUT[LUTindex];
 	}
-}
 
-void SinState::ApplyPostsynapticSpike(unsigned int index){
-	return;
-}
+	// The activity is accumulated harmonic by harmonic (every thread always processes the same synapses)
+	#pragma omp parallel if(NumberOfIndexes>PARALLELKERNELEVALUATION)
+	{
+		const float * CoeffExp = this->GetStateVariableArray(0)+FirstIndex;
+		#pragma omp for schedule(static) nowait
+		for (int i=0; i<(int)NumberOfIndexes; ++i){
+			Activity[i] = CoeffExp[i]*Factors[0];
+		}
 
+		for (unsigned int grade=2; grade<=this->exponent; grade+=2){
+			const float * CoeffCos = this->GetStateVariableArray(grade-1)+FirstIndex;
+			const float * CoeffSin = this->GetStateVariableArray(grade)+FirstIndex;
+			float FactorCos = Factors[grade-1];
+			float FactorSin = Factors[grade];
 
+			#pragma omp for schedule(static) nowait
+			for (int i=0; i<(int)NumberOfIndexes; ++i){
+				Activity[i] += CoeffCos[i]*FactorCos + CoeffSin[i]*FactorSin;
+			}
+		}
+	}
+}
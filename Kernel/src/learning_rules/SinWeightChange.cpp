@@ -29,7 +29,7 @@ void SinWeightChange::InitializeConnectionState(unsigned int NumberOfSynapses){
 }
 
 int SinWeightChange::GetNumberOfVar() const{
-	return this->exponent+2;
+	return this->exponent+1;
 }
 
 int SinWeightChange::GetExponent() const{
@@ -42,6 +42,11 @@ void SinWeightChange::LoadLearningRule(FILE * fh, long & Currentline) throw (EDL
 	if(!(fscanf(fh,"%i",&this->exponent)==1)){
 		throw EDLUTFileException(4,28,23,1,Currentline);
 	}
+
+	//the terms of SinState are tabulated up to exponent 20.
+	if(exponent<0 || exponent>20){
+		throw EDLUTFileException(4,27,22,1,Currentline);
+	}
 	
 	//exponent must be multiple of 2.
 	if(exponent%2 == 1){
@@ -0,0 +1,69 @@
+/***************************************************************************
+ *                           ActivityBuffer.cpp                            *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/neuron_model/ActivityBuffer.h"
+
+ActivityBuffer::ActivityBuffer(): Elements(0), Capacity(MINACTIVITYBUFFERSIZE), First(0), NumberOfElements(0){
+	this->Elements = new InputActivity [this->Capacity];
+}
+
+ActivityBuffer::ActivityBuffer(const ActivityBuffer & OldBuffer): Elements(0), Capacity(OldBuffer.Capacity), First(0), NumberOfElements(OldBuffer.NumberOfElements){
+	this->Elements = new InputActivity [this->Capacity];
+	for (unsigned int i=0; i<this->NumberOfElements; ++i){
+		this->Elements[i] = OldBuffer.GetActivityAt(i);
+	}
+}
+
+ActivityBuffer & ActivityBuffer::operator=(const ActivityBuffer & OldBuffer){
+	if (this!=&OldBuffer){
+		delete [] this->Elements;
+		this->Capacity = OldBuffer.Capacity;
+		this->First = 0;
+		this->NumberOfElements = OldBuffer.NumberOfElements;
+		this->Elements = new InputActivity [this->Capacity];
+		for (unsigned int i=0; i<this->NumberOfElements; ++i){
+			this->Elements[i] = OldBuffer.GetActivityAt(i);
+		}
+	}
+	return *this;
+}
+
+ActivityBuffer::~ActivityBuffer(){
+	delete [] this->Elements;
+}
+
+void ActivityBuffer::Resize(unsigned int NewCapacity){
+	InputActivity * NewElements = new InputActivity [NewCapacity];
+	for (unsigned int i=0; i<this->NumberOfElements; ++i){
+		NewElements[i] = this->GetActivityAt(i);
+	}
+
+	delete [] this->Elements;
+	this->Elements = NewElements;
+	this->Capacity = NewCapacity;
+	this->First = 0;
+}
+
+void ActivityBuffer::Reserve(unsigned int NumberOfSpikes){
+	unsigned int NewCapacity = this->Capacity;
+	while (NewCapacity<NumberOfSpikes){
+		NewCapacity *= 2;
+	}
+
+	if (NewCapacity!=this->Capacity){
+		this->Resize(NewCapacity);
+	}
+}
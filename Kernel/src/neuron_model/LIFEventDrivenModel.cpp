@@ -0,0 +1,492 @@
+/***************************************************************************
+ *                           LIFEventDrivenModel.cpp                       *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/neuron_model/LIFEventDrivenModel.h"
+#include "../../include/neuron_model/VectorNeuronState.h"
+
+#include "../../include/spike/InternalSpike.h"
+#include "../../include/spike/Neuron.h"
+#include "../../include/spike/Interconnection.h"
+#include "../../include/spike/PropagatedSpike.h"
+
+#include "../../include/simulation/Utils.h"
+
+#include <cmath>
+#include <string>
+
+/*!
+ * Maximum number of Newton-Raphson iterations refining a threshold crossing.
+ */
+#define MAXNEWTONITERATIONS 50
+
+/*!
+ * Time precision of the threshold crossing (in seconds).
+ */
+#define CROSSINGPRECISION 1e-10
+
+/*!
+ * Initial length of the unbounded intervals of the threshold crossing search (in time constants).
+ */
+#define HORIZONTIMECONSTANTS 5
+
+void LIFEventDrivenModel::LoadNeuronModel(string ConfigFile) throw (EDLUTFileException){
+	FILE *fh;
+	long Currentline = 0L;
+	fh=fopen(ConfigFile.c_str(),"rt");
+	if(fh){
+		Currentline=1L;
+		skip_comments(fh,Currentline);
+		if(fscanf(fh,"%f",&this->erest)==1){
+			skip_comments(fh,Currentline);
+
+			if (fscanf(fh,"%f",&this->vthr)==1){
+				skip_comments(fh,Currentline);
+
+				if(fscanf(fh,"%f",&this->vreset)==1){
+					skip_comments(fh,Currentline);
+
+					if(fscanf(fh,"%f",&this->cm)==1){
+						skip_comments(fh,Currentline);
+
+						if(fscanf(fh,"%f",&this->grest)==1){
+							skip_comments(fh,Currentline);
+
+							if(fscanf(fh,"%f",&this->texc)==1){
+								skip_comments(fh,Currentline);
+
+								if(fscanf(fh,"%f",&this->tinh)==1){
+									skip_comments(fh,Currentline);
+
+									if(fscanf(fh,"%f",&this->tref)==1){
+										skip_comments(fh,Currentline);
+
+										if(fscanf(fh,"%f",&this->ibias)==1){
+											this->InitialState = (VectorNeuronState *) new VectorNeuronState(3, false);
+										} else {
+											throw EDLUTFileException(13,72,3,1,Currentline);
+										}
+									} else {
+										throw EDLUTFileException(13,61,3,1,Currentline);
+									}
+								} else {
+									throw EDLUTFileException(13,63,3,1,Currentline);
+								}
+							} else {
+								throw EDLUTFileException(13,65,3,1,Currentline);
+							}
+						} else {
+							throw EDLUTFileException(13,60,3,1,Currentline);
+						}
+					} else {
+						throw EDLUTFileException(13,66,3,1,Currentline);
+					}
+				} else {
+					throw EDLUTFileException(13,71,3,1,Currentline);
+				}
+			} else {
+				throw EDLUTFileException(13,67,3,1,Currentline);
+			}
+		} else {
+			throw EDLUTFileException(13,68,3,1,Currentline);
+		}
+
+		fclose(fh);
+	}else{
+		throw EDLUTFileException(13,25,13,0,Currentline);
+	}
+
+	this->tmem = this->cm/this->grest;
+	this->vinf = this->erest+this->ibias/this->grest;
+
+	// The closed form has a removable singularity when a synaptic time constant
+	// matches the membrane time constant. Move it away (relative change 1e-6).
+	if (fabs(this->texc-this->tmem)<1e-6*this->tmem){
+		this->texc = this->tmem*(1.0+1e-6);
+	}
+	if (fabs(this->tinh-this->tmem)<1e-6*this->tmem){
+		this->tinh = this->tmem*(1.0+1e-6);
+	}
+
+	double maxtau = this->tmem;
+	if (this->texc>maxtau) maxtau = this->texc;
+	if (this->tinh>maxtau) maxtau = this->tinh;
+	this->horizon = HORIZONTIMECONSTANTS*maxtau;
+}
+
+int LIFEventDrivenModel::PotentialTerms(double vm, double iexc, double iinh, double * Coeffs, double * Rates){
+	// Particular solutions of cm*dV/dt = grest*(erest-V)+ibias+iexc*exp(-t/texc)-iinh*exp(-t/tinh)
+	double TermCoeffs[3], TermRates[3];
+	TermCoeffs[1] = iexc/this->cm*this->texc*this->tmem/(this->texc-this->tmem);
+	TermCoeffs[2] = -iinh/this->cm*this->tinh*this->tmem/(this->tinh-this->tmem);
+	TermCoeffs[0] = vm-this->vinf-TermCoeffs[1]-TermCoeffs[2];
+	TermRates[0] = 1.0/this->tmem;
+	TermRates[1] = 1.0/this->texc;
+	TermRates[2] = 1.0/this->tinh;
+
+	// Sort the terms by decay rate, merging equal rates and removing null terms
+	int N = 0;
+	for (int i=0; i<3; i++){
+		if (TermCoeffs[i]==0.0){
+			continue;
+		}
+
+		int j;
+		for (j=0; j<N && Rates[j]<TermRates[i]; j++);
+
+		if (j<N && Rates[j]==TermRates[i]){
+			Coeffs[j] += TermCoeffs[i];
+		} else {
+			for (int k=N; k>j; k--){
+				Coeffs[k] = Coeffs[k-1];
+				Rates[k] = Rates[k-1];
+			}
+			Coeffs[j] = TermCoeffs[i];
+			Rates[j] = TermRates[i];
+			N++;
+		}
+	}
+
+	return N;
+}
+
+double LIFEventDrivenModel::EvaluateTerms(double Constant, const double * Coeffs, const double * Rates, int N, double Time, double * Derivative){
+	double Value = Constant;
+	double Slope = 0.0;
+
+	for (int i=0; i<N; i++){
+		double Term = Coeffs[i]*exp(-Rates[i]*Time);
+		Value += Term;
+		Slope -= Rates[i]*Term;
+	}
+
+	if (Derivative!=0){
+		*Derivative = Slope;
+	}
+
+	return Value;
+}
+
+double LIFEventDrivenModel::FindRoot(double Constant, const double * Coeffs, const double * Rates, int N, double a, double b){
+	double fa = EvaluateTerms(Constant,Coeffs,Rates,N,a,0);
+
+	// Bracketed Newton-Raphson: the bracket [a,b] is shrunk after every evaluation and
+	// the iteration falls back to bisection when the Newton step leaves it.
+	double t = 0.5*(a+b);
+	for (int it=0; it<MAXNEWTONITERATIONS && b-a>CROSSINGPRECISION; it++){
+		double df;
+		double f = EvaluateTerms(Constant,Coeffs,Rates,N,t,&df);
+		if (f==0.0){
+			return t;
+		}
+
+		if ((f<0)==(fa<0)){
+			a = t;
+		} else {
+			b = t;
+		}
+
+		double next = (df!=0.0)?t-f/df:a;
+		if (next<=a || next>=b){
+			next = 0.5*(a+b);
+		} else if (fabs(next-t)<CROSSINGPRECISION){
+			return next;
+		}
+		t = next;
+	}
+
+	return b;
+}
+
+double LIFEventDrivenModel::ThresholdCrossing(double vm, double iexc, double iinh){
+	if (vm>=this->vthr){
+		return 0.0;
+	}
+
+	double Coeffs[3], Rates[3];
+	int N = this->PotentialTerms(vm,iexc,iinh,Coeffs,Rates);
+	double Level = this->vinf-this->vthr;
+
+	// Each term is monotonic, so the potential is bounded by the positive terms.
+	double bound = Level;
+	for (int i=0; i<N; i++){
+		if (Coeffs[i]>0){
+			bound += Coeffs[i];
+		}
+	}
+	if (bound<0){
+		return NO_SPIKE_PREDICTED;
+	}
+
+	// Critical points of the potential. They are the roots of
+	// g(t)=exp(Rates[0]*t)*dV/dt=GCoeffs[0]+GCoeffs[1]*exp(-GRates[1]*t)+GCoeffs[2]*exp(-GRates[2]*t),
+	// which has at most one extremum, so there are at most two critical points.
+	double Limits[4];
+	int NLimits = 0;
+	Limits[NLimits++] = 0.0;
+
+	if (N>1){
+		double GCoeffs[2], GRates[2];
+		for (int i=1; i<N; i++){
+			GCoeffs[i-1] = -Rates[i]*Coeffs[i];
+			GRates[i-1] = Rates[i]-Rates[0];
+		}
+		double GConstant = -Rates[0]*Coeffs[0];
+
+		// Monotonic pieces of g
+		double Pieces[3];
+		int NPieces = 0;
+		Pieces[NPieces++] = 0.0;
+		if (N==3){
+			double ratio = -(GRates[1]*GCoeffs[1])/(GRates[0]*GCoeffs[0]);
+			if (ratio>1.0){
+				Pieces[NPieces++] = log(ratio)/(GRates[1]-GRates[0]);
+			}
+		}
+
+		for (int ip=0; ip<NPieces; ip++){
+			double a = Pieces[ip];
+			double ga = EvaluateTerms(GConstant,GCoeffs,GRates,N-1,a,0);
+			double b, gb;
+			if (ip+1<NPieces){
+				b = Pieces[ip+1];
+				gb = EvaluateTerms(GConstant,GCoeffs,GRates,N-1,b,0);
+			} else {
+				// g tends to GConstant. Look for a finite end with that sign.
+				if (GConstant==0.0 || (GConstant<0)==(ga<0)){
+					continue;
+				}
+				b = a+this->horizon;
+				gb = EvaluateTerms(GConstant,GCoeffs,GRates,N-1,b,0);
+				while ((gb<0)!=(GConstant<0)){
+					b = a+2.0*(b-a);
+					gb = EvaluateTerms(GConstant,GCoeffs,GRates,N-1,b,0);
+				}
+			}
+
+			if (ga!=0.0 && (ga<0)!=(gb<0)){
+				Limits[NLimits++] = FindRoot(GConstant,GCoeffs,GRates,N-1,a,b);
+			}
+		}
+	}
+
+	// The potential is monotonic between consecutive limits. The first increasing piece
+	// which reaches the threshold contains the crossing.
+	for (int il=0; il<NLimits; il++){
+		double a = Limits[il];
+		double fa = EvaluateTerms(Level,Coeffs,Rates,N,a,0);
+		if (fa>=0){
+			return a;
+		}
+
+		double b, fb;
+		if (il+1<NLimits){
+			b = Limits[il+1];
+			fb = EvaluateTerms(Level,Coeffs,Rates,N,b,0);
+			if (fb<0){
+				continue;
+			}
+		} else {
+			// The potential tends to vinf
+			if (Level<=0){
+				return NO_SPIKE_PREDICTED;
+			}
+			b = a+this->horizon;
+			fb = EvaluateTerms(Level,Coeffs,Rates,N,b,0);
+			while (fb<0){
+				b = a+2.0*(b-a);
+				fb = EvaluateTerms(Level,Coeffs,Rates,N,b,0);
+			}
+		}
+
+		return FindRoot(Level,Coeffs,Rates,N,a,b);
+	}
+
+	return NO_SPIKE_PREDICTED;
+}
+
+void LIFEventDrivenModel::UpdateState(int index, VectorNeuronState * State, double CurrentTime){
+	float * NeuronState = State->GetStateVariableAt(index);
+	//NeuronState[0] --> vm
+	//NeuronState[1] --> iexc
+	//NeuronState[2] --> iinh
+
+	double LastUpdate = State->GetLastUpdateTime(index);
+	double ElapsedTime = CurrentTime-LastUpdate;
+
+	double vm = NeuronState[0];
+	double iexc = NeuronState[1];
+	double iinh = NeuronState[2];
+
+	// The potential is held during the refractory period
+	double EndRefractory = State->GetEndRefractoryPeriod(index);
+	if (EndRefractory>LastUpdate){
+		double RefractoryTime = ((EndRefractory<CurrentTime)?EndRefractory:CurrentTime)-LastUpdate;
+		vm = this->vreset;
+		iexc *= exp(-RefractoryTime/this->texc);
+		iinh *= exp(-RefractoryTime/this->tinh);
+		ElapsedTime -= RefractoryTime;
+	}
+
+	if (ElapsedTime>0){
+		double Coeffs[3], Rates[3];
+		int N = this->PotentialTerms(vm,iexc,iinh,Coeffs,Rates);
+		vm = EvaluateTerms(this->vinf,Coeffs,Rates,N,ElapsedTime,0);
+		iexc *= exp(-ElapsedTime/this->texc);
+		iinh *= exp(-ElapsedTime/this->tinh);
+	}
+
+	NeuronState[0] = vm;
+	NeuronState[1] = iexc;
+	NeuronState[2] = iinh;
+
+	State->SetLastUpdateTime(index,CurrentTime);
+}
+
+void LIFEventDrivenModel::SynapsisEffect(int index, VectorNeuronState * State, Interconnection * InputConnection){
+	switch (InputConnection->GetType()){
+		case 0: {
+			State->IncrementStateVariableAtCPU(index,1,1e-9f*InputConnection->GetWeight());
+			break;
+		}case 1:{
+			State->IncrementStateVariableAtCPU(index,2,1e-9f*InputConnection->GetWeight());
+			break;
+		}default :{
+			printf("ERROR: LIFEventDrivenModel only support two kind of input synapses \n");
+		}
+	}
+}
+
+double LIFEventDrivenModel::NextFiringPrediction(int index, VectorNeuronState * State){
+	float * NeuronState = State->GetStateVariableAt(index);
+
+	double LastUpdate = State->GetLastUpdateTime(index);
+
+	double vm = NeuronState[0];
+	double iexc = NeuronState[1];
+	double iinh = NeuronState[2];
+
+	// Predict from the end of the refractory period
+	double Offset = State->GetEndRefractoryPeriod(index)-LastUpdate;
+	if (Offset>0){
+		vm = this->vreset;
+		iexc *= exp(-Offset/this->texc);
+		iinh *= exp(-Offset/this->tinh);
+	} else {
+		Offset = 0;
+	}
+
+	double Predicted = this->ThresholdCrossing(vm,iexc,iinh);
+	if (Predicted!=NO_SPIKE_PREDICTED){
+		Predicted += Offset;
+	}
+
+	return Predicted;
+}
+
+InternalSpike * LIFEventDrivenModel::PredictSpike(Neuron * Cell){
+	int index = Cell->GetIndex_VectorNeuronState();
+	VectorNeuronState * State = Cell->GetVectorNeuronState();
+
+	InternalSpike * GeneratedSpike = 0;
+
+	double NextSpike = this->NextFiringPrediction(index,State);
+	if (NextSpike!=NO_SPIKE_PREDICTED){
+		NextSpike += State->GetLastUpdateTime(index);
+
+		GeneratedSpike = new InternalSpike(NextSpike,Cell);
+	}
+
+	State->SetNextPredictedSpikeTime(index,NextSpike);
+
+	return GeneratedSpike;
+}
+
+LIFEventDrivenModel::LIFEventDrivenModel(string NeuronTypeID, string NeuronModelID): EventDrivenNeuronModel(NeuronTypeID, NeuronModelID),
+		erest(0), vthr(0), vreset(0), cm(0), grest(0), texc(0), tinh(0), tref(0), ibias(0), tmem(0), vinf(0), horizon(0){
+}
+
+LIFEventDrivenModel::~LIFEventDrivenModel(){
+}
+
+void LIFEventDrivenModel::LoadNeuronModel() throw (EDLUTFileException){
+	this->LoadNeuronModel(this->GetModelID()+".cfg");
+}
+
+VectorNeuronState * LIFEventDrivenModel::InitializeState(){
+	return this->InitialState;
+}
+
+InternalSpike * LIFEventDrivenModel::GenerateInitialActivity(Neuron *  Cell){
+	return this->PredictSpike(Cell);
+}
+
+InternalSpike * LIFEventDrivenModel::ProcessInputSpike(PropagatedSpike *  InputSpike){
+	Interconnection * inter = InputSpike->GetSource()->GetOutputConnectionAt(InputSpike->GetTarget());
+
+	return this->ProcessInputSpike(inter,inter->GetTarget(),InputSpike->GetTime());
+}
+
+InternalSpike * LIFEventDrivenModel::ProcessInputSpike(Interconnection * inter, Neuron * target, double time){
+	int TargetIndex = target->GetIndex_VectorNeuronState();
+
+	VectorNeuronState * CurrentState = target->GetVectorNeuronState();
+
+	// Update the neuron state until the current time
+	this->UpdateState(TargetIndex,CurrentState,time);
+
+	// Add the effect of the input spike
+	this->SynapsisEffect(TargetIndex,CurrentState,inter);
+
+	// Check if an spike will be fired
+	return this->PredictSpike(target);
+}
+
+InternalSpike * LIFEventDrivenModel::GenerateNextSpike(InternalSpike *  OutputSpike){
+	Neuron * SourceCell = OutputSpike->GetSource();
+
+	int SourceIndex = SourceCell->GetIndex_VectorNeuronState();
+
+	VectorNeuronState * CurrentState = SourceCell->GetVectorNeuronState();
+
+	this->UpdateState(SourceIndex,CurrentState,OutputSpike->GetTime());
+
+	CurrentState->SetStateVariableAt(SourceIndex,0,this->vreset);
+	CurrentState->SetEndRefractoryPeriod(SourceIndex,OutputSpike->GetTime()+this->tref);
+
+	// Check if some auto-activity is generated after the refractory period
+	return this->PredictSpike(SourceCell);
+}
+
+bool LIFEventDrivenModel::DiscardSpike(InternalSpike *  OutputSpike){
+	return (OutputSpike->GetSource()->GetVectorNeuronState()->GetNextPredictedSpikeTime(OutputSpike->GetSource()->GetIndex_VectorNeuronState())!=OutputSpike->GetTime());
+}
+
+ostream & LIFEventDrivenModel::PrintInfo(ostream & out){
+	out << "- Leaky Event-Driven Model: " << this->GetModelID() << endl;
+
+	out << "\tResting potential: " << this->erest << "V\tFiring threshold: " << this->vthr << "V\tReset potential: " << this->vreset << "V" << endl;
+
+	out << "\tMembrane capacitance: " << this->cm << "F\tResting Conductance: " << this->grest << "S\tBias current: " << this->ibias << "A" << endl;
+
+	out << "\tExcitatory time constant: " << this->texc << "s\tInhibitory time constant: " << this->tinh << "s\tRefractory Period: " << this->tref << "s" << endl;
+
+	return out;
+}
+
+void LIFEventDrivenModel::InitializeStates(int N_neurons){
+	float initialization[] = {erest,0.0f,0.0f};
+	InitialState->InitializeStates(N_neurons, initialization);
+}
@@ -328,6 +328,7 @@ float NeuronModelTable::TableAccessDirect(int index, VectorNeuronState * stateva
 // Bilineal interpolation
 float NeuronModelTable::TableAccessInterpBi(int index, VectorNeuronState * statevars){
 	unsigned int idim;
+	int iidim;
 	float elem,coord,*coords;
 	NeuronModelTable *tab;
 	NeuronModelTable::TableDimension *dim;
@@ -362,24 +363,25 @@ float NeuronModelTable::TableAccessInterpBi(int index, VectorNeuronState * state
 		}
 	}
 	
-	idim=0;
+	// iidim is the interpolated dimension toggled in each iteration (-1 when all the corners are added)
+	iidim=0;
 	do{
-		for(;idim<tab->ndims-1;idim++){
+		for(idim=iidim;idim<tab->ndims-1;idim++){
 			dpointers[idim+1]=(void **)dpointers[idim][tableinds[idim]+intstate[idim]];
 		}
 		
 		elem=((float *)dpointers[idim])[tableinds[idim]+intstate[idim]];
 
-		for(idim=tab->firstintdim;idim>=0;idim-=tab->dims[idim].nextintdim){
-			intstate[idim]=!intstate[idim];
-			if(intstate[idim]){
-				subints[idim]=elem;
+		for(iidim=tab->firstintdim;iidim>=0;iidim-=tab->dims[iidim].nextintdim){
+			intstate[iidim]=!intstate[iidim];
+			if(intstate[iidim]){
+				subints[iidim]=elem;
 				break;
 			}else{
-				elem=subints[idim]=subints[idim]+(elem-subints[idim])*coeints[idim];
+				elem=subints[iidim]=subints[iidim]+(elem-subints[iidim])*coeints[iidim];
 			}
 		}
-	} while(idim>=0);
+	} while(iidim>=0);
    
 	return(elem);
 }
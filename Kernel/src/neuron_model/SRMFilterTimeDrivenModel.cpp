@@ -0,0 +1,394 @@
+/***************************************************************************
+ *                           SRMFilterTimeDrivenModel.cpp                  *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido and Francisco Naveros  *
+ * email                : jgarrido@atc.ugr.es, fnaveros@atc.ugr.es         *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <iostream>
+#include <cmath>
+#include <string>
+
+#include "../../include/neuron_model/SRMFilterTimeDrivenModel.h"
+#include "../../include/neuron_model/VectorSRMState.h"
+#include "../../include/neuron_model/VectorNeuronState.h"
+
+#include "../../include/spike/EDLUTFileException.h"
+#include "../../include/spike/Neuron.h"
+#include "../../include/spike/InternalSpike.h"
+#include "../../include/spike/PropagatedSpike.h"
+
+#include "../../include/simulation/Utils.h"
+
+#ifdef _OPENMP
+	#include <omp.h>
+#else
+	#define omp_get_thread_num() 0
+	#define omp_get_num_thread() 1
+#endif
+
+
+using namespace std;
+
+/*!
+ * Number of state variables before the EPSP filters (as in SRMTimeDrivenModel).
+ */
+#define SRMFILTERFIRSTVARIABLE 5
+
+/*
+ * Least-squares fit (in s=t/tau, 0<=s<=8, sampled densely near 0) of the normalized EPSP
+ * sqrt(2*e*s)*exp(-s) (with a peak of 1) by exp(-s)*sum(c_k*(1-exp(-lambda_k*s))).
+ */
+static const float EPSPFilterLambda[EPSPFILTERTERMS] = {0.4266419f, 7.5838895f, 97.699733f, 3477.4501f};
+static const float EPSPFilterCoeff[EPSPFILTERTERMS] = {4.3561797f, 0.57243966f, 0.19045043f, 0.055610201f};
+
+void SRMFilterTimeDrivenModel::LoadNeuronModel(string ConfigFile) throw (EDLUTFileException){
+	FILE *fh;
+	long Currentline = 0L;
+
+	fh=fopen(ConfigFile.c_str(),"rt");
+	if(!fh){
+		// Error: Neuron model file doesn't exist
+		throw EDLUTFileException(13,59,31,1,Currentline);
+	}
+
+	Currentline=1L;
+	skip_comments(fh,Currentline);
+	if (fscanf(fh, "%u", &this->NumberOfChannels)!=1){
+		throw EDLUTFileException(13,57,3,1,Currentline);
+	}
+
+	this->tau = (float *) new float [this->NumberOfChannels];
+	this->W = (float *) new float [this->NumberOfChannels];
+
+	for (unsigned int i=0; i<this->NumberOfChannels; ++i){
+		skip_comments(fh,Currentline);
+		if(fscanf(fh,"%f",&this->tau[i])!=1){
+			throw EDLUTFileException(13,58,3,1,Currentline);
+		}
+	}
+
+	skip_comments(fh,Currentline);
+
+	if(fscanf(fh,"%f",&this->vr)!=1){
+		throw EDLUTFileException(13,56,3,1,Currentline);
+	}
+
+	for (unsigned int i=0; i<this->NumberOfChannels; ++i){
+		skip_comments(fh,Currentline);
+		if(fscanf(fh,"%f",&this->W[i])!=1){
+			throw EDLUTFileException(13,55,3,1,Currentline);
+		}
+	}
+
+	skip_comments(fh,Currentline);
+
+	if(fscanf(fh,"%f",&this->r0)!=1){
+		throw EDLUTFileException(13,54,3,1,Currentline);
+	}
+
+	skip_comments(fh,Currentline);
+
+	if(fscanf(fh,"%f",&this->v0)!=1){
+		throw EDLUTFileException(13,53,3,1,Currentline);
+	}
+
+	skip_comments(fh,Currentline);
+
+	if(fscanf(fh,"%f",&this->vf)!=1){
+		throw EDLUTFileException(13,52,3,1,Currentline);
+	}
+
+	skip_comments(fh,Currentline);
+
+	if(fscanf(fh,"%f",&this->tauabs)!=1){
+		throw EDLUTFileException(13,51,3,1,Currentline);
+	}
+
+	skip_comments(fh,Currentline);
+
+	if(fscanf(fh,"%f",&this->taurel)!=1){
+		throw EDLUTFileException(13,50,3,1,Currentline);
+	}
+
+	this->FilterRate = (float *) new float [this->NumberOfChannels*(EPSPFILTERTERMS+1)];
+	for (unsigned int i=0; i<this->NumberOfChannels; ++i){
+		this->FilterRate[i*(EPSPFILTERTERMS+1)] = 1.0f/this->tau[i];
+		for (unsigned int k=0; k<EPSPFILTERTERMS; ++k){
+			this->FilterRate[i*(EPSPFILTERTERMS+1)+k+1] = (1.0f+EPSPFilterLambda[k])/this->tau[i];
+		}
+	}
+
+	this->CoeffSum = 0;
+	for (unsigned int k=0; k<EPSPFILTERTERMS; ++k){
+		this->CoeffSum += EPSPFilterCoeff[k];
+	}
+
+	this->MaxEPSPError = EPSPError();
+
+	// Initialize the neuron state
+	this->InitialState = (VectorSRMState *) new VectorSRMState(SRMFILTERFIRSTVARIABLE+this->NumberOfChannels*(EPSPFILTERTERMS+1), 0, true);
+
+	//TIME DRIVEN STEP
+	this->integrationMethod = LoadIntegrationMethod::loadIntegrationMethod(fh, &Currentline, 0, 0, 0, 0);
+
+	// Decay factors of the filters for the integration step
+	this->Step = this->integrationMethod->PredictedElapsedTime[0];
+	this->StepDecay = (float *) new float [this->NumberOfChannels*(EPSPFILTERTERMS+1)];
+	for (unsigned int i=0; i<this->NumberOfChannels*(EPSPFILTERTERMS+1); ++i){
+		this->StepDecay[i] = exp(-this->FilterRate[i]*this->Step);
+	}
+}
+
+float SRMFilterTimeDrivenModel::EPSPError(){
+	// The buffered window of SRMTimeDrivenModel is 8*tau
+	const int NumberOfPoints = 8000;
+	double MaxError = 0;
+	for (int i=0; i<=NumberOfPoints; ++i){
+		double s = 8.0*i/NumberOfPoints;
+		double Exact = sqrt(2*exp(1.0)*s)*exp(-s);
+
+		double Filtered = this->CoeffSum*exp(-s);
+		for (unsigned int k=0; k<EPSPFILTERTERMS; ++k){
+			Filtered -= EPSPFilterCoeff[k]*exp(-(1+EPSPFilterLambda[k])*s);
+		}
+
+		if (fabs(Filtered-Exact)>MaxError){
+			MaxError = fabs(Filtered-Exact);
+		}
+	}
+
+	return (float) MaxError;
+}
+
+void SRMFilterTimeDrivenModel::SynapsisEffect(int index, VectorSRMState * State, Interconnection * InputConnection){
+	float * Filter = State->GetStateVariableAt(index)+SRMFILTERFIRSTVARIABLE+InputConnection->GetType()*(EPSPFILTERTERMS+1);
+	float Weight = InputConnection->GetWeight();
+
+	// Every term starts with the same amplitude (the EPSP is null when the spike arrives)
+	for (unsigned int k=0; k<=EPSPFILTERTERMS; ++k){
+		Filter[k] += Weight;
+	}
+}
+
+float SRMFilterTimeDrivenModel::PotentialIncrement(int index, VectorSRMState * State, double ElapsedTime){
+	float Increment = 0;
+
+	// The decay factors are precalculated for the integration step
+	bool IsStep = fabs(ElapsedTime-this->Step)<=1e-6*this->Step;
+
+	float * Filter = State->GetStateVariableAt(index)+SRMFILTERFIRSTVARIABLE;
+
+	for (unsigned int i=0; i<this->NumberOfChannels; ++i){
+		float * ChannelFilter = Filter+i*(EPSPFILTERTERMS+1);
+
+		for (unsigned int k=0; k<=EPSPFILTERTERMS; ++k){
+			if (IsStep){
+				ChannelFilter[k] *= this->StepDecay[i*(EPSPFILTERTERMS+1)+k];
+			} else {
+				ChannelFilter[k] *= exp(-this->FilterRate[i*(EPSPFILTERTERMS+1)+k]*ElapsedTime);
+			}
+		}
+
+		float EPSP = this->CoeffSum*ChannelFilter[0];
+		for (unsigned int k=0; k<EPSPFILTERTERMS; ++k){
+			EPSP -= EPSPFilterCoeff[k]*ChannelFilter[k+1];
+		}
+
+		// Inhibitory channels must define negative W values
+		Increment += this->W[i]*EPSP;
+	}
+
+	return Increment;
+}
+
+bool SRMFilterTimeDrivenModel::CheckSpikeAt(int index, VectorSRMState * State, double CurrentTime){
+	double Probability = State->GetStateVariableAt(index,4);
+	return (((double) rand())/RAND_MAX<Probability);
+}
+
+SRMFilterTimeDrivenModel::SRMFilterTimeDrivenModel(string NeuronTypeID, string NeuronModelID): TimeDrivenNeuronModel(NeuronTypeID, NeuronModelID), tau(0), vr(0), W(0), r0(0), v0(0), vf(0),
+		tauabs(0), taurel(0), FilterRate(0), StepDecay(0), Step(0), CoeffSum(0), MaxEPSPError(0) {
+
+}
+
+SRMFilterTimeDrivenModel::~SRMFilterTimeDrivenModel(){
+	delete [] this->tau;
+	this->tau = 0;
+	delete [] this->W;
+	this->W = 0;
+	delete [] this->FilterRate;
+	this->FilterRate = 0;
+	delete [] this->StepDecay;
+	this->StepDecay = 0;
+}
+
+void SRMFilterTimeDrivenModel::LoadNeuronModel() throw (EDLUTFileException) {
+
+	this->LoadNeuronModel(this->GetModelID() + ".cfg");
+}
+
+VectorNeuronState * SRMFilterTimeDrivenModel::InitializeState(){
+	return ((VectorSRMState *) InitialState);
+}
+
+InternalSpike * SRMFilterTimeDrivenModel::ProcessInputSpike(PropagatedSpike *  InputSpike){
+	Interconnection * inter = InputSpike->GetSource()->GetOutputConnectionAt(InputSpike->GetTarget());
+
+	Neuron * TargetCell = inter->GetTarget();
+
+	VectorNeuronState * CurrentState = TargetCell->GetVectorNeuronState();
+
+	InternalSpike * ProducedSpike = 0;
+
+	// Update Cell State
+	if (this->UpdateState(inter->GetTarget()->GetIndex_VectorNeuronState(),TargetCell->GetVectorNeuronState(),InputSpike->GetTime())){
+		ProducedSpike = new InternalSpike(InputSpike->GetTime(),TargetCell);
+	}
+
+	// Add the effect of the input spike
+	this->SynapsisEffect(inter->GetTarget()->GetIndex_VectorNeuronState(),(VectorSRMState *)CurrentState,inter);
+
+	return ProducedSpike;
+}
+
+InternalSpike * SRMFilterTimeDrivenModel::ProcessInputSpike(Interconnection * inter, Neuron * target, double time){
+
+	VectorNeuronState * CurrentState = target->GetVectorNeuronState();
+
+	InternalSpike * ProducedSpike = 0;
+
+	// Update Cell State
+	if (this->UpdateState(target->GetIndex_VectorNeuronState(),target->GetVectorNeuronState(),time)){
+		ProducedSpike = new InternalSpike(time,target);
+	}
+
+	// Add the effect of the input spike
+	this->SynapsisEffect(target->GetIndex_VectorNeuronState(),(VectorSRMState *)CurrentState,inter);
+
+	return ProducedSpike;
+}
+
+
+bool SRMFilterTimeDrivenModel::UpdateState(int index, VectorNeuronState * State, double CurrentTime){
+
+	VectorSRMState * SRMstate=(VectorSRMState *)State;
+
+	bool * internalSpike=State->getInternalSpike();
+
+	int First, Last;
+	if (index!=-1){
+		First = index;
+		Last = index+1;
+	} else {
+		First = 0;
+		Last = State->GetSizeState();
+	}
+
+	int i;
+	double ElapsedTime;
+
+#pragma omp parallel for default(none) shared(First, Last, State, SRMstate, internalSpike, CurrentTime) private(i,ElapsedTime) if (index==-1)
+	for (i=First; i<Last; i++){
+		ElapsedTime = CurrentTime-State->GetLastUpdateTime(i);
+
+		State->AddElapsedTime(i, ElapsedTime);
+
+		float Potential = this->vr + this->PotentialIncrement(i,SRMstate,ElapsedTime);
+		State->SetStateVariableAt(i,1,Potential);
+
+		float FiringRate;
+
+		if((Potential-this->v0) > (10*this->vf)){
+			FiringRate = this->r0*(Potential-this->v0)/this->vf;
+		} else {
+			float texp=exp((Potential-this->v0)/this->vf);
+			FiringRate =this->r0*log(1+texp);
+		}
+
+		State->SetStateVariableAt(i,2,FiringRate);
+
+		double TimeSinceSpike = State->GetLastSpikeTime(i);
+		float Aux = TimeSinceSpike-this->tauabs;
+		float Refractoriness = 0;
+
+		if (TimeSinceSpike>this->tauabs){
+			Refractoriness = 1./(1.+(this->taurel*this->taurel)/(Aux*Aux));
+		}
+		State->SetStateVariableAt(i,3,Refractoriness);
+
+		float Probability = (1 - exp(-FiringRate*Refractoriness*((float)ElapsedTime)));
+		State->SetStateVariableAt(i,4,Probability);
+
+		State->SetLastUpdateTime(i,CurrentTime);
+
+		if (this->CheckSpikeAt(i,SRMstate, CurrentTime)){
+			State->NewFiredSpike(i);
+			internalSpike[i]=true;
+		}else{
+			internalSpike[i]=false;
+		}
+
+		float * NeuronState=State->GetStateVariableAt(i);
+		this->integrationMethod->NextDifferentialEcuationValue(i,this,NeuronState,0,0);
+	}
+
+	return false;
+}
+
+
+ostream & SRMFilterTimeDrivenModel::PrintInfo(ostream & out) {
+	out << "- SRM Filter Time-Driven Model: " << this->GetModelID() << endl;
+
+	out << "\tNumber of channels: " << this->NumberOfChannels << endl;
+
+	out << "\tTau: ";
+	for (unsigned int i=0; i<this->NumberOfChannels; ++i){
+		out << "\t" << this->tau[i];
+	}
+
+	out << endl << "\tVresting: " << this->vr << endl;
+
+	out << "\tWeight Scale: ";
+
+	for (unsigned int i=0; i<this->NumberOfChannels; ++i){
+		out << "\t" << this->W[i];
+	}
+
+	out << endl << "\tFiring Rate: " << this->r0 << "Hz\tVthreshold: " << this->v0 << "V" << endl;
+
+	out << "\tGain Factor: " << this->vf << "\tAbsolute Refractory Period: " << this->tauabs << "s\tRelative Refractory Period: " << this->taurel << "s" << endl;
+
+	out << "\tEPSP filter terms: " << EPSPFILTERTERMS+1 << "\tMaximum EPSP error: " << this->MaxEPSPError*100 << "% of the EPSP peak" << endl;
+
+	return out;
+}
+
+
+void SRMFilterTimeDrivenModel::InitializeStates(int N_neurons){
+
+	VectorSRMState * state = (VectorSRMState *) this->InitialState;
+
+	// All the state variables (and the EPSP filters) start at zero
+	unsigned int NumberOfVariables = SRMFILTERFIRSTVARIABLE+this->NumberOfChannels*(EPSPFILTERTERMS+1);
+	float * initialization = new float [NumberOfVariables];
+	for (unsigned int i=0; i<NumberOfVariables; ++i){
+		initialization[i] = 0.0f;
+	}
+
+	//Initialize the state variables
+	state->InitializeSRMStates(N_neurons, initialization);
+
+	this->integrationMethod->InitializeStates(N_neurons, initialization);
+
+	delete [] initialization;
+}
@@ -209,5 +209,5 @@ InternalSpike * SRMTableBasedModel::GenerateNextSpike(InternalSpike *  OutputSpi
 }
 
 void SRMTableBasedModel::InitializeStates(int N_neurons){
-	InitialState->InitializeStates(N_neurons, InitValues);
+	TableBasedModel::InitializeStates(N_neurons);
 }
\ No newline at end of file
@@ -126,13 +126,13 @@ float SRMTimeDrivenModel::PotentialIncrement(int index, VectorSRMState * State){
 
 	for (unsigned int i=0; i<this->NumberOfChannels; ++i){
 		VectorBufferedState::Iterator itEnd = State->End();
+
+		float EPSPMax = sqrt(this->tau[i]/2)*exp(-0.5);
 		
 		for (VectorBufferedState::Iterator it=State->Begin(index,i); it!=itEnd; ++it){
 			float TimeDifference = it.GetSpikeTime();
 			float Weight = it.GetConnection()->GetWeight();
 
-			float EPSPMax = sqrt(this->tau[i]/2)*exp(-0.5);
-
 			float EPSP = sqrt(TimeDifference)*exp(-(TimeDifference/this->tau[i]))/EPSPMax;
 
 			// Inhibitory channels must define negative W values
@@ -174,7 +174,7 @@ void TableBasedModel::LoadTables(string TableFile) throw (EDLUTException){
 TableBasedModel::TableBasedModel(string NeuronTypeID, string NeuronModelID): EventDrivenNeuronModel(NeuronTypeID, NeuronModelID),
 		NumStateVar(0), NumTimeDependentStateVar(0), NumSynapticVar(0), SynapticVar(0),
 		StateVarOrder(0), StateVarTable(0), FiringTable(0), EndFiringTable(0),
-		NumTables(0), Tables(0), TempStateVars(0) {
+		NumTables(0), Tables(0), TempStateVars(0), PostFiringState(0), InitValues(0) {
 
 }
 
@@ -203,6 +203,10 @@ TableBasedModel::~TableBasedModel() {
 	if(this->InitValues!=0){
 		delete [] InitValues;
 	}
+
+	if(this->PostFiringState!=0){
+		delete this->PostFiringState;
+	}
 }
 
 void TableBasedModel::LoadNeuronModel() throw (EDLUTFileException){
@@ -264,6 +268,14 @@ double TableBasedModel::NextFiringPrediction(int index, VectorNeuronState * Stat
 	return this->FiringTable->TableAccess(index, State);
 }
 
+double TableBasedModel::PostFiringPrediction(int index, VectorNeuronState * State, double EndRefractory){
+	this->PostFiringState->CopyStateFrom(*State, index);
+
+	this->UpdateState(0,this->PostFiringState,EndRefractory);
+
+	return this->NextFiringPrediction(0,this->PostFiringState);
+}
+
 double TableBasedModel::EndRefractoryPeriod(int index, VectorNeuronState * State){
 	return this->EndFiringTable->TableAccess(index, State);
 }
@@ -297,11 +309,7 @@ InternalSpike * TableBasedModel::ProcessInputSpike(PropagatedSpike *  InputSpike
 		} else { // Only for neurons which never stop firing
 			// The generated spike was at refractory period -> Check after refractoriness
 
-			VectorNeuronState newState(*CurrentState, TargetIndex);
-
-			this->UpdateState(0,&newState,newState.GetEndRefractoryPeriod(0));
-
-			NextSpike = this->NextFiringPrediction(0,&newState);
+			NextSpike = this->PostFiringPrediction(TargetIndex,CurrentState,CurrentState->GetEndRefractoryPeriod(TargetIndex));
 
 			if(NextSpike != NO_SPIKE_PREDICTED){
 				NextSpike += CurrentState->GetEndRefractoryPeriod(TargetIndex);
@@ -342,11 +350,7 @@ InternalSpike * TableBasedModel::ProcessInputSpike(Interconnection * inter, Neur
 		} else { // Only for neurons which never stop firing
 			// The generated spike was at refractory period -> Check after refractoriness
 
-			VectorNeuronState newState(*CurrentState, TargetIndex);
-
-			this->UpdateState(0,&newState,newState.GetEndRefractoryPeriod(0));
-
-			NextSpike = this->NextFiringPrediction(0,&newState);
+			NextSpike = this->PostFiringPrediction(TargetIndex,CurrentState,CurrentState->GetEndRefractoryPeriod(TargetIndex));
 
 			if(NextSpike != NO_SPIKE_PREDICTED){
 				NextSpike += CurrentState->GetEndRefractoryPeriod(TargetIndex);
@@ -388,11 +392,7 @@ InternalSpike * TableBasedModel::GenerateNextSpike(InternalSpike *  OutputSpike)
 	CurrentState->SetEndRefractoryPeriod(SourceIndex,EndRefractory);
 
 	// Check if some auto-activity is generated after the refractory period
-	VectorNeuronState PostFiringState (*CurrentState, SourceIndex);
-
-	this->UpdateState(0,&PostFiringState,CurrentState->GetEndRefractoryPeriod(SourceIndex));
-
-	double PredictedSpike = this->NextFiringPrediction(0,&PostFiringState);
+	double PredictedSpike = this->PostFiringPrediction(SourceIndex,CurrentState,EndRefractory);
 
 	if(PredictedSpike != NO_SPIKE_PREDICTED){
 		PredictedSpike += CurrentState->GetEndRefractoryPeriod(SourceIndex);
@@ -429,4 +429,8 @@ ostream & TableBasedModel::PrintInfo(ostream & out) {
 
 void TableBasedModel::InitializeStates(int N_neurons){
 	InitialState->InitializeStates(N_neurons, InitValues);
+
+	if(this->PostFiringState==0 && N_neurons>0){
+		this->PostFiringState = new VectorNeuronState(*InitialState, 0);
+	}
 }
\ No newline at end of file
@@ -66,6 +66,18 @@ VectorNeuronState::VectorNeuronState(const VectorNeuronState & OldState, int ind
 	}
 }
 
+void VectorNeuronState::CopyStateFrom(const VectorNeuronState & OldState, int index){
+	memcpy(VectorNeuronStates, OldState.VectorNeuronStates+index*NumberOfVariables, NumberOfVariables*sizeof(float));
+
+	LastUpdate[0]=OldState.LastUpdate[index];
+	LastSpikeTime[0]=OldState.LastSpikeTime[index];
+
+	if(!GetTimeDriven()){
+		PredictedSpike[0]=OldState.PredictedSpike[index];
+		PredictionEnd[0]=OldState.PredictionEnd[index];
+	}
+}
+
 VectorNeuronState::~VectorNeuronState() {
 	delete [] this->VectorNeuronStates;
 	delete [] this->LastUpdate;
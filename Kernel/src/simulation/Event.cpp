@@ -18,10 +18,10 @@
 
 #include "../../include/simulation/Simulation.h"
 
-Event::Event():time(0){
+Event::Event():time(0), QueuePosition(0){
 }
    	
-Event::Event(double NewTime): time(NewTime){
+Event::Event(double NewTime): time(NewTime), QueuePosition(0){
 }
    		
 Event::~Event(){
@@ -18,7 +18,18 @@
 
 #include "../../include/simulation/Event.h"
 
-EventQueue::EventQueue() : Events(0), NumberOfElements(0), AllocatedSize(0) {
+#include "../../include/spike/InputSpike.h"
+
+#include <algorithm>
+
+/*!
+ * It compares the time of two external input spikes.
+ */
+static inline bool EarlierInput(const InputSpikeForQueue & a, const InputSpikeForQueue & b){
+	return a.Time < b.Time;
+}
+
+EventQueue::EventQueue() : Events(0), NumberOfElements(0), AllocatedSize(0), TrackPositions(false), Inputs(0), FirstInput(0), LastInput(0), AllocatedInputs(MIN_SIZE), InputsSorted(true) {
 	// Allocate memory for a MIN_SIZE sized array
 	this->Events = (EventForQueue *) new EventForQueue [MIN_SIZE];
 
@@ -27,6 +38,9 @@ EventQueue::EventQueue() : Events(0), NumberOfElements(0), AllocatedSize(0) {
 	// The first element in the array is discard
 	NumberOfElements = 1;
 
+	this->Inputs = new InputSpikeForQueue [this->AllocatedInputs];
+
+	this->CurrentInput = new InputSpike();
 }
    		
 EventQueue::~EventQueue(){
@@ -35,6 +49,10 @@ EventQueue::~EventQueue(){
 	}
 
 	delete [] this->Events;
+
+	delete [] this->Inputs;
+
+	delete this->CurrentInput;
 }
 
 void EventQueue::SwapEvents(unsigned int c1, unsigned int c2){
@@ -42,6 +60,33 @@ void EventQueue::SwapEvents(unsigned int c1, unsigned int c2){
 	exchange=*(this->Events+c2);
 	*(this->Events+c2)=*(this->Events+c1);
 	*(this->Events+c1)=exchange;
+
+	if (this->TrackPositions){
+		(this->Events+c1)->EventPtr->SetQueuePosition(c1);
+		(this->Events+c2)->EventPtr->SetQueuePosition(c2);
+	}
+}
+
+void EventQueue::SiftUp(unsigned int c){
+	for(;c>1 && (this->Events+c/2)->Time > (this->Events+c)->Time; c/=2){
+		SwapEvents(c, c/2);
+	}
+}
+
+void EventQueue::SiftDown(unsigned int p){
+	unsigned int c;
+	for(c=p*2;c<this->Size();p=c,c=p*2){
+		if((this->Events+c)->Time > (this->Events+c+1)->Time)
+			c++;
+
+		if((this->Events+c)->Time < (this->Events+p)->Time)
+			SwapEvents(p, c);
+		else
+			break;
+	}
+
+	if(c==this->Size() && (this->Events+p)->Time > (this->Events+c)->Time)
+		SwapEvents(p, c);
 }
 
 
@@ -70,6 +115,9 @@ void EventQueue::InsertEvent(Event * event){
 	
 	(this->Events+this->NumberOfElements)->EventPtr = event;
 	(this->Events+this->NumberOfElements)->Time = event->GetTime();
+	if (this->TrackPositions){
+		event->SetQueuePosition(this->NumberOfElements);
+	}
 	
 	this->NumberOfElements++;
 
@@ -84,17 +132,77 @@ void EventQueue::InsertEvent(Event * event){
 unsigned int EventQueue::Size() const{
 	return this->NumberOfElements-1;
 }
+
+unsigned int EventQueue::InputSize() const{
+	return this->LastInput-this->FirstInput;
+}
+
+void EventQueue::InsertInputSpike(double Time, Neuron * Source){
+	if (this->LastInput==this->AllocatedInputs){
+		unsigned int Pending = this->LastInput-this->FirstInput;
+		if (Pending*2>this->AllocatedInputs){
+			// Grow the array
+			InputSpikeForQueue * Temp = this->Inputs;
+			this->AllocatedInputs *= 2;
+			this->Inputs = new InputSpikeForQueue [this->AllocatedInputs];
+			copy(Temp+this->FirstInput, Temp+this->LastInput, this->Inputs);
+			delete [] Temp;
+		} else {
+			// Move the pending spikes to the beginning
+			copy(this->Inputs+this->FirstInput, this->Inputs+this->LastInput, this->Inputs);
+		}
+		this->FirstInput = 0;
+		this->LastInput = Pending;
+	}
+
+	if (this->LastInput>this->FirstInput && Time<(this->Inputs+this->LastInput-1)->Time){
+		this->InputsSorted = false;
+	}
+
+	(this->Inputs+this->LastInput)->Time = Time;
+	(this->Inputs+this->LastInput)->Source = Source;
+	this->LastInput++;
+}
+
+void EventQueue::SortInputs(){
+	stable_sort(this->Inputs+this->FirstInput, this->Inputs+this->LastInput, EarlierInput);
+	this->InputsSorted = true;
+}
    		
 Event * EventQueue::RemoveEvent(void){
 	unsigned int c,p;
 double time_c0, time_c1, time_p;
    	
+	if (this->FirstInput<this->LastInput){
+		if (!this->InputsSorted){
+			this->SortInputs();
+		}
+
+		// Merge the external input spikes with the heap
+		InputSpikeForQueue * Input = this->Inputs+this->FirstInput;
+		if (this->NumberOfElements==1 || Input->Time<(this->Events+1)->Time){
+			this->CurrentInput->SetTime(Input->Time);
+			this->CurrentInput->SetSource(Input->Source);
+
+			this->FirstInput++;
+			if (this->FirstInput==this->LastInput){
+				this->FirstInput = this->LastInput = 0;
+			}
+
+			return this->CurrentInput;
+		}
+	}
+
    	Event * first = 0;
 	if(this->NumberOfElements>2){
 		first=(this->Events+1)->EventPtr;
       
       	//Events[1]=Events.back();
 		*(this->Events+1)=*(this->Events+this->Size());
+		if (this->TrackPositions){
+			first->SetQueuePosition(0);
+			(this->Events+1)->EventPtr->SetQueuePosition(1);
+		}
 		this->NumberOfElements--;
 
 		if (this->NumberOfElements>MIN_SIZE && this->NumberOfElements<this->AllocatedSize/(RESIZE_FACTOR*2)){
@@ -116,12 +224,21 @@ double time_c0, time_c1, time_p;
         	SwapEvents(p, c);
 	} else if (this->NumberOfElements==2){
 		first = (this->Events+1)->EventPtr;
+		if (this->TrackPositions){
+			first->SetQueuePosition(0);
+		}
 
 		this->NumberOfElements--;
 	}
     
     return(first);
 }
+
+void EventQueue::ReleaseEvent(Event * event){
+	if (event!=this->CurrentInput){
+		delete event;
+	}
+}
    		
 double EventQueue::FirstEventTime() const{
 	double ti;
@@ -130,6 +247,18 @@ double EventQueue::FirstEventTime() const{
 		ti=(this->Events+1)->Time;
    	else
     	ti=-1.0;
+
+	if (this->InputsSorted){
+		if (this->FirstInput<this->LastInput && (ti==-1.0 || (this->Inputs+this->FirstInput)->Time<ti)){
+			ti=(this->Inputs+this->FirstInput)->Time;
+		}
+	} else {
+		for (unsigned int i=this->FirstInput; i<this->LastInput; ++i){
+			if (ti==-1.0 || (this->Inputs+i)->Time<ti){
+				ti=(this->Inputs+i)->Time;
+			}
+		}
+	}
    
    	return(ti);		
 }
@@ -138,6 +267,9 @@ void EventQueue::RemoveSpikes(){
 	unsigned int OldNumberOfElements=this->NumberOfElements;
 	Event * TmpEvent;
 
+	this->FirstInput = this->LastInput = 0;
+	this->InputsSorted = true;
+
 	this->NumberOfElements=1; // Initially resize occupied size of the heap so that all the events are out
 	// Reinsert in the heap only the events which are spikes 
 	for (unsigned int i = 1; i<OldNumberOfElements; ++i){
@@ -149,3 +281,50 @@ void EventQueue::RemoveSpikes(){
 		}		
 	}
 }
+
+void EventQueue::SetPositionTracking(bool Track){
+	if (Track && !this->TrackPositions){
+		// Store the positions of the events already inserted
+		for (unsigned int i=1; i<this->NumberOfElements; ++i){
+			(this->Events+i)->EventPtr->SetQueuePosition(i);
+		}
+	}
+
+	this->TrackPositions = Track;
+}
+
+void EventQueue::CancelEvent(Event * event){
+	unsigned int pos = event->GetQueuePosition();
+	unsigned int last = this->Size();
+
+	if (pos!=last){
+		// Move the last event to the hole and restore the heap order from there
+		*(this->Events+pos)=*(this->Events+last);
+		(this->Events+pos)->EventPtr->SetQueuePosition(pos);
+		this->NumberOfElements--;
+
+		if (pos>1 && (this->Events+pos/2)->Time > (this->Events+pos)->Time){
+			SiftUp(pos);
+		} else {
+			SiftDown(pos);
+		}
+	} else {
+		this->NumberOfElements--;
+	}
+
+	event->SetQueuePosition(0);
+}
+
+void EventQueue::UpdateEventTime(Event * event, double NewTime){
+	unsigned int pos = event->GetQueuePosition();
+	double OldTime = (this->Events+pos)->Time;
+
+	event->SetTime(NewTime);
+	(this->Events+pos)->Time = NewTime;
+
+	if (NewTime<OldTime){
+		SiftUp(pos);
+	} else if (NewTime>OldTime){
+		SiftDown(pos);
+	}
+}
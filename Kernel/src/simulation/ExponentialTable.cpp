@@ -19,37 +19,20 @@
 
 #include "../../include/simulation/ExponentialTable.h"
 
+float ExponentialTable::LookUpTable[EXPTABLESIZE];
 
+float ExponentialTable::ScaleTable[32];
 
+bool ExponentialTable::Initialized = ExponentialTable::InitializeTables();
 
-ExponentialTable::ExponentialTable(float minimum, float maximum, int size): Min(minimum), Max(maximum), TableSize(size){
-	LookUpTable=new float[TableSize];
-	for(int i=0; i<TableSize; i++){
-		float exponent = Min + ((Max-Min)*i)/(TableSize-1);
-		LookUpTable[i]=exp(exponent);		
+bool ExponentialTable::InitializeTables(){
+	for(int i=0; i<EXPTABLESIZE; i++){
+		LookUpTable[i]=pow(2.0,((double)i)/EXPTABLESIZE);
 	}
-aux=1.0f/(Max-Min);
-}
-   		
-ExponentialTable::~ExponentialTable(){
-	delete LookUpTable;
-}
-   	
-float ExponentialTable::GetResult(float value){
-	if(value>=Min && value<=Max){
-		//int position=((value-Min)/(Max-Min))*(TableSize-1);
-		int position=((value-Min)*aux)*(TableSize-1);
-		return LookUpTable[position];
-	}else{
-		if(value<(-20)){
-			return 0.0f;
-		}else{
-			return exp(value);
-		}
-	}
-}
-
-
-   		
 
+	for(int i=0; i<32; i++){
+		ScaleTable[i]=ldexp(1.0,-i);
+	}
 
+	return true;
+}
@@ -0,0 +1,34 @@
+/***************************************************************************
+ *                           GeneratorInputEvent.cpp                       *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/simulation/GeneratorInputEvent.h"
+
+#include "../../include/simulation/Simulation.h"
+
+#include "../../include/communication/GeneratorInputSpikeDriver.h"
+
+GeneratorInputEvent::GeneratorInputEvent():Event(0), Driver(0){
+}
+
+GeneratorInputEvent::GeneratorInputEvent(double NewTime, GeneratorInputSpikeDriver * NewDriver): Event(NewTime), Driver(NewDriver){
+}
+
+GeneratorInputEvent::~GeneratorInputEvent(){
+}
+
+void GeneratorInputEvent::ProcessEvent(Simulation * CurrentSimulation, bool RealTimeRestriction){
+	this->Driver->LoadWindow(CurrentSimulation->GetQueue(), CurrentSimulation->GetNetwork(), this->GetTime());
+}
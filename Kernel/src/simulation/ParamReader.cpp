@@ -22,19 +22,43 @@
 #include "../../include/communication/TCPIPConnectionType.h"
 
 #include "../../include/communication/FileInputSpikeDriver.h"
+#include "../../include/communication/StreamFileInputSpikeDriver.h"
 #include "../../include/communication/TCPIPInputSpikeDriver.h"
 
 #include "../../include/communication/FileOutputSpikeDriver.h"
+#include "../../include/communication/BinaryFileOutputSpikeDriver.h"
+#include "../../include/communication/AsynchronousOutputSpikeDriver.h"
 #include "../../include/communication/TCPIPOutputSpikeDriver.h"
 #include "../../include/communication/TCPIPInputOutputSpikeDriver.h"
+#include "../../include/communication/SharedMemoryInputSpikeDriver.h"
+#include "../../include/communication/SharedMemoryOutputSpikeDriver.h"
+#include "../../include/communication/SharedMemoryInputOutputSpikeDriver.h"
 
 #include "../../include/communication/FileOutputWeightDriver.h"
 
 #include "../../include/communication/ConnectionException.h"
 
 #include "../../include/simulation/ParameterException.h"
+
+#include <algorithm>
  
 void ParamReader::ParseArguments(int Number, char ** Arguments) throw (ParameterException, ConnectionException) {
+	bool AsynchronousOutput = false;
+	vector<OutputSpikeDriver *> SynchronousDrivers;
+
+	// The TCP/IP protocol options affect all the connections (whatever their position in the command line)
+	unsigned int TCPIPVersion = 1;
+	bool TCPIPDelta = false;
+	for (int i=1; i<Number; ++i){
+		string CurrentArgument = Arguments[i];
+		if (CurrentArgument=="-tcpv2"){
+			TCPIPVersion = 2;
+		} else if (CurrentArgument=="-tcpdelta"){
+			TCPIPVersion = 2;
+			TCPIPDelta = true;
+		}
+	}
+
 	for (int i=1; i<Number; ++i){
 		string CurrentArgument = Arguments[i];
 		if(CurrentArgument=="-time"){ // Simulation Total Time
@@ -69,6 +93,8 @@ void ParamReader::ParseArguments(int Number, char ** Arguments) throw (Parameter
 			}
 		} else if (CurrentArgument=="-info"){
 			this->NetworkInfo = true;
+		} else if (CurrentArgument=="-cancel"){
+			this->CancelPredictions = true;
 		} else if (CurrentArgument=="-sf"){
 			if (i+1<Number){
 				// Check if it is a valid file and exists
@@ -84,6 +110,16 @@ void ParamReader::ParseArguments(int Number, char ** Arguments) throw (Parameter
 			} else {
 				throw ParameterException(Arguments[i],"Invalid saving weight step time");				
 			}
+		} else if (CurrentArgument=="-wu"){
+			if (i+1<Number){
+				// Check if it is a number
+				istringstream Argument(Arguments[++i]);
+
+				if (!(Argument >> this->WeightUpdateTime))
+					throw ParameterException(Arguments[i], "Invalid weight update step time");
+			} else {
+				throw ParameterException(Arguments[i],"Invalid weight update step time");
+			}
 		} else if (CurrentArgument=="-st"){
 			if (i+1<Number){
 				// Check if it is a number
@@ -125,6 +161,17 @@ void ParamReader::ParseArguments(int Number, char ** Arguments) throw (Parameter
 			} else {
 				throw ParameterException(Arguments[i],"Invalid input file");				
 			}
+		} else if (CurrentArgument=="-ifs"){
+			if (i+1<Number){
+				// Check if it is a valid file and exists
+				string File=Arguments[++i];
+				if (!this->FileExists(File)){
+					throw ParameterException(File,"Invalid input file. The file doesn't exist.");
+				}
+				this->InputDrivers.push_back(new StreamFileInputSpikeDriver (File.c_str()));
+			} else {
+				throw ParameterException(Arguments[i],"Invalid input file");				
+			}
 		} else if (CurrentArgument=="-ic"){
 			if (i+2<Number){
 				string host = Arguments[i+1];
@@ -161,7 +208,11 @@ void ParamReader::ParseArguments(int Number, char ** Arguments) throw (Parameter
 					throw ParameterException(Arguments[i+2],"Invalid output connection type. Only Server and Client are allowed");
 				}
 				
-				Driver = new TCPIPInputSpikeDriver (Type,address,port);
+				try {
+					Driver = new TCPIPInputSpikeDriver (Type,address,port,TCPIPVersion,TCPIPDelta);
+				} catch (EDLUTException & Exc){
+					throw ConnectionException(address,port,Exc.GetErrorMsg());
+				}
 
 				i += 2;
 				this->InputDrivers.push_back(Driver);
@@ -170,6 +221,10 @@ void ParamReader::ParseArguments(int Number, char ** Arguments) throw (Parameter
 				throw ParameterException(Arguments[i],"Invalid input connection.");
 			}
 			
+		} else if (CurrentArgument=="-async"){
+			AsynchronousOutput = true;
+		} else if (CurrentArgument=="-tcpv2" || CurrentArgument=="-tcpdelta"){
+			// Already processed
 		} else if (CurrentArgument=="-log"){
 			if (i+1<Number){
 				// Check if it is a valid file and exists
@@ -180,11 +235,91 @@ void ParamReader::ParseArguments(int Number, char ** Arguments) throw (Parameter
 				// Check if it is a valid file and exists
 				this->MonitorDrivers.push_back(new FileOutputSpikeDriver (Arguments[++i],true));
 			}
+		} else if (CurrentArgument=="-logb"){
+			if (i+1<Number){
+				// Check if it is a valid file and exists
+				this->MonitorDrivers.push_back(new BinaryFileOutputSpikeDriver (Arguments[++i],false));
+			}
+		} else if (CurrentArgument=="-logpb"){
+			if (i+1<Number){
+				// Check if it is a valid file and exists
+				this->MonitorDrivers.push_back(new BinaryFileOutputSpikeDriver (Arguments[++i],true));
+			}
+		} else if (CurrentArgument=="-logperiod"){
+			if (this->MonitorDrivers.empty()){
+				throw ParameterException(Arguments[i],"The state monitoring options must follow a monitoring file.");
+			}
+
+			double Period;
+			if (i+1<Number){
+				istringstream Argument(Arguments[++i]);
+
+				if (!(Argument >> Period) || Period<0.0)
+					throw ParameterException(Arguments[i], "Invalid state sampling period");
+			} else {
+				throw ParameterException(Arguments[i],"Invalid state sampling period");
+			}
+
+			this->MonitorDrivers.back()->SetStateSamplingPeriod(Period);
+		} else if (CurrentArgument=="-logwindow"){
+			if (this->MonitorDrivers.empty()){
+				throw ParameterException(Arguments[i],"The state monitoring options must follow a monitoring file.");
+			}
+
+			double Start, End;
+			if (i+2<Number){
+				istringstream StartArgument(Arguments[++i]);
+				istringstream EndArgument(Arguments[++i]);
+
+				if (!(StartArgument >> Start) || !(EndArgument >> End) || End<=Start)
+					throw ParameterException(Arguments[i], "Invalid state monitoring window");
+			} else {
+				throw ParameterException(Arguments[i],"Invalid state monitoring window");
+			}
+
+			this->MonitorDrivers.back()->AddStateWindow(Start, End);
+		} else if (CurrentArgument=="-logvars"){
+			if (this->MonitorDrivers.empty()){
+				throw ParameterException(Arguments[i],"The state monitoring options must follow a monitoring file.");
+			}
+
+			vector<unsigned int> Variables;
+			if (i+1<Number){
+				string List = Arguments[++i];
+				replace(List.begin(), List.end(), ',', ' ');
+				istringstream Argument(List);
+
+				int Variable;
+				while (Argument >> Variable){
+					if (Variable<0){
+						throw ParameterException(Arguments[i], "Invalid state variable list");
+					}
+					Variables.push_back(Variable);
+				}
+
+				if (!Argument.eof() || Variables.empty())
+					throw ParameterException(Arguments[i], "Invalid state variable list");
+			} else {
+				throw ParameterException(Arguments[i],"Invalid state variable list");
+			}
+
+			this->MonitorDrivers.back()->SetStateVariables(Variables.size(), &Variables[0]);
+		} else if (CurrentArgument=="-logfiring"){
+			if (this->MonitorDrivers.empty()){
+				throw ParameterException(Arguments[i],"The state monitoring options must follow a monitoring file.");
+			}
+
+			this->MonitorDrivers.back()->SetStateOnlyAtFiring(true);
 		} else if (CurrentArgument=="-of"){
 			if (i+1<Number){
 				// Check if it is a valid file and exists
 				this->OutputDrivers.push_back(new FileOutputSpikeDriver (Arguments[++i],false));
 			}
+		} else if (CurrentArgument=="-ofb"){
+			if (i+1<Number){
+				// Check if it is a valid file and exists
+				this->OutputDrivers.push_back(new BinaryFileOutputSpikeDriver (Arguments[++i],false));
+			}
 		} else if (CurrentArgument=="-oc"){
 			if (i+2<Number){
 				string host = Arguments[i+1];
@@ -220,7 +355,11 @@ void ParamReader::ParseArguments(int Number, char ** Arguments) throw (Parameter
 					throw ParameterException(Arguments[i],"Invalid output connection type. Only Server and Client are allowed");
 				}
 				
-				Driver = new TCPIPOutputSpikeDriver (Type,address,port);
+				try {
+					Driver = new TCPIPOutputSpikeDriver (Type,address,port,TCPIPVersion,TCPIPDelta);
+				} catch (EDLUTException & Exc){
+					throw ConnectionException(address,port,Exc.GetErrorMsg());
+				}
 
 				i += 2;
 				
@@ -262,19 +401,129 @@ void ParamReader::ParseArguments(int Number, char ** Arguments) throw (Parameter
 					throw ParameterException(Arguments[i],"Invalid input-output connection type. Only Server and Client are allowed");
 				}
 				
-				Driver = new TCPIPInputOutputSpikeDriver (Type,address,port);
+				try {
+					Driver = new TCPIPInputOutputSpikeDriver (Type,address,port,TCPIPVersion,TCPIPDelta);
+				} catch (EDLUTException & Exc){
+					throw ConnectionException(address,port,Exc.GetErrorMsg());
+				}
 
 				i += 2;
 				
 				this->InputDrivers.push_back(Driver);
 				this->OutputDrivers.push_back(Driver);
+
+				// The output of the input-output connections is synchronized with the input
+				SynchronousDrivers.push_back(Driver);
 			} else {
 				throw ParameterException(Arguments[i],"Invalid input-output connection.");
 			}
+		} else if (CurrentArgument=="-ism"){
+			if (i+2<Number){
+				string name = Arguments[i+1];
+				string type = Arguments[i+2];
+				enum TCPIPConnectionType Type;
+
+				SharedMemoryInputSpikeDriver * Driver;
+
+				if (type == string("Server")){
+					Type = SERVER;
+				} else if (type == string("Client")){
+					Type = CLIENT;
+				} else {
+					// Output error
+					throw ParameterException(Arguments[i+2],"Invalid input shared memory type. Only Server and Client are allowed");
+				}
+
+				try {
+					Driver = new SharedMemoryInputSpikeDriver (Type,name);
+				} catch (EDLUTException & Exc){
+					throw ParameterException(Arguments[i+1],Exc.GetErrorMsg());
+				}
+
+				i += 2;
+
+				this->InputDrivers.push_back(Driver);
+			} else {
+				throw ParameterException(Arguments[i],"Invalid input shared memory.");
+			}
+		} else if (CurrentArgument=="-osm"){
+			if (i+2<Number){
+				string name = Arguments[i+1];
+				string type = Arguments[i+2];
+				enum TCPIPConnectionType Type;
+
+				SharedMemoryOutputSpikeDriver * Driver;
+
+				if (type == string("Server")){
+					Type = SERVER;
+				} else if (type == string("Client")){
+					Type = CLIENT;
+				} else {
+					// Output error
+					throw ParameterException(Arguments[i+2],"Invalid output shared memory type. Only Server and Client are allowed");
+				}
+
+				try {
+					Driver = new SharedMemoryOutputSpikeDriver (Type,name);
+				} catch (EDLUTException & Exc){
+					throw ParameterException(Arguments[i+1],Exc.GetErrorMsg());
+				}
+
+				i += 2;
+
+				this->OutputDrivers.push_back(Driver);
+			} else {
+				throw ParameterException(Arguments[i],"Invalid output shared memory.");
+			}
+		} else if (CurrentArgument=="-iosm"){
+			if (i+2<Number){
+				string name = Arguments[i+1];
+				string type = Arguments[i+2];
+				enum TCPIPConnectionType Type;
+
+				SharedMemoryInputOutputSpikeDriver * Driver;
+
+				if (type == string("Server")){
+					Type = SERVER;
+				} else if (type == string("Client")){
+					Type = CLIENT;
+				} else {
+					// Output error
+					throw ParameterException(Arguments[i+2],"Invalid input-output shared memory type. Only Server and Client are allowed");
+				}
+
+				try {
+					Driver = new SharedMemoryInputOutputSpikeDriver (Type,name);
+				} catch (EDLUTException & Exc){
+					throw ParameterException(Arguments[i+1],Exc.GetErrorMsg());
+				}
+
+				i += 2;
+
+				this->InputDrivers.push_back(Driver);
+				this->OutputDrivers.push_back(Driver);
+
+				// The output of the input-output connections is synchronized with the input
+				SynchronousDrivers.push_back(Driver);
+			} else {
+				throw ParameterException(Arguments[i],"Invalid input-output shared memory.");
+			}
 		} else {
 				throw ParameterException(Arguments[i],"Invalid parameter.");
 		}	
 	}	
+
+	if (AsynchronousOutput){
+		for (unsigned int i=0; i<this->OutputDrivers.size(); ++i){
+			if (find(SynchronousDrivers.begin(), SynchronousDrivers.end(), this->OutputDrivers[i])==SynchronousDrivers.end()){
+				this->OutputDrivers[i] = new AsynchronousOutputSpikeDriver(this->OutputDrivers[i]);
+			}
+		}
+
+		for (unsigned int i=0; i<this->MonitorDrivers.size(); ++i){
+			this->MonitorDrivers[i] = new AsynchronousOutputSpikeDriver(this->MonitorDrivers[i]);
+		}
+	}
 	
 	if (this->SimulationTime==-1.0){
 		throw ParameterException(Arguments[0],"The simulation time isn't specified."); 	
@@ -298,7 +547,7 @@ bool ParamReader::FileExists(string Name){
 	return flag;	
 }
  		 
-ParamReader::ParamReader(int ArgNumber, char ** Arg) throw (ParameterException, ConnectionException) :SimulationTime(-1.0), NetworkFile(NULL), WeightsFile(NULL), WeightTime(0.0), NetworkInfo(false),
+ParamReader::ParamReader(int ArgNumber, char ** Arg) throw (ParameterException, ConnectionException) :SimulationTime(-1.0), NetworkFile(NULL), WeightsFile(NULL), WeightTime(0.0), WeightUpdateTime(0.0), NetworkInfo(false), CancelPredictions(false),
 	SimulationStepTime(0.0), TimeDrivenStepTime(-1.0), TimeDrivenStepTimeGPU(-1.0), InputDrivers(), OutputDrivers(), OutputWeightDrivers() {
 	ParseArguments(ArgNumber,Arg);	
 }
@@ -310,6 +559,10 @@ double ParamReader::GetSimulationTime(){
 double ParamReader::GetSaveWeightStepTime(){
 	return this->WeightTime;
 }
+
+double ParamReader::GetWeightUpdateStepTime(){
+	return this->WeightUpdateTime;
+}
  		
 char * ParamReader::GetNetworkFile(){
 	return this->NetworkFile;
@@ -322,6 +575,10 @@ char * ParamReader::GetWeightsFile(){
 bool ParamReader::CheckInfo(){
 	return this->NetworkInfo;
 }
+
+bool ParamReader::CheckCancelPredictions(){
+	return this->CancelPredictions;
+}
  				
 double ParamReader::GetSimulationStepTime(){
 	return this->SimulationStepTime;	
@@ -361,6 +618,10 @@ Simulation * ParamReader::CreateAndInitializeSimulation() throw (EDLUTException,
 
 	Simul->SetSaveStep(this->GetSaveWeightStepTime());
 
+	Simul->SetWeightUpdateStep(this->GetWeightUpdateStepTime());
+
+	Simul->SetCancelPredictions(this->CheckCancelPredictions());
+
 	for (unsigned int i=0; i<this->GetInputSpikeDrivers().size(); ++i){
 		Simul->AddInputSpikeDriver(this->GetInputSpikeDrivers()[i]);
 	}
@@ -26,10 +26,12 @@
 #include "../../include/spike/Network.h"
 #include "../../include/spike/Spike.h"
 #include "../../include/spike/Neuron.h"
+#include "../../include/spike/InternalSpike.h"
 
 #include "../../include/simulation/EventQueue.h"
 #include "../../include/simulation/EndSimulationEvent.h"
 #include "../../include/simulation/SaveWeightsEvent.h"
+#include "../../include/simulation/UpdateWeightsEvent.h"
 #include "../../include/simulation/CommunicationEvent.h"
 
 #include "../../include/communication/OutputSpikeDriver.h"
@@ -39,12 +41,12 @@
 #include "../../include/neuron_model/NeuronModel.h"
 #include "../../include/neuron_model/TimeDrivenNeuronModel.h"
 
-Simulation::Simulation(const char * NetworkFile, const char * WeightsFile, double SimulationTime, double NewSimulationStep) throw (EDLUTException): Net(0), Queue(0), InputSpike(), OutputSpike(), OutputWeight(), Totsimtime(SimulationTime), SimulationStep(NewSimulationStep), TimeDrivenStep(0), MaxSlotConsumedTime(0), TimeDrivenStepGPU(0), SaveWeightStep(0), EndOfSimulation(false), Updates(0), Heapoc(0){
+Simulation::Simulation(const char * NetworkFile, const char * WeightsFile, double SimulationTime, double NewSimulationStep) throw (EDLUTException): Net(0), Queue(0), InputSpike(), OutputSpike(), OutputWeight(), Totsimtime(SimulationTime), SimulationStep(NewSimulationStep), TimeDrivenStep(0), MaxSlotConsumedTime(0), TimeDrivenStepGPU(0), SaveWeightStep(0), WeightUpdateStep(0), EndOfSimulation(false), Updates(0), Heapoc(0), CancelPredictions(false), DiscardedSpikeCounter(0), CancelledSpikeCounter(0){
 	Queue = new EventQueue();
 	Net = new Network(NetworkFile, WeightsFile, this->Queue);
 }
 
-Simulation::Simulation(const Simulation & ant):Net(ant.Net), Queue(ant.Queue), InputSpike(ant.InputSpike), OutputSpike(ant.OutputSpike), OutputWeight(ant.OutputWeight), Totsimtime(ant.Totsimtime), TimeDrivenStep(ant.TimeDrivenStep), MaxSlotConsumedTime(ant.MaxSlotConsumedTime), TimeDrivenStepGPU(ant.TimeDrivenStepGPU), SaveWeightStep(ant.SaveWeightStep), EndOfSimulation(ant.EndOfSimulation), Updates(ant.Updates), Heapoc(ant.Heapoc){
+Simulation::Simulation(const Simulation & ant):Net(ant.Net), Queue(ant.Queue), InputSpike(ant.InputSpike), OutputSpike(ant.OutputSpike), OutputWeight(ant.OutputWeight), Totsimtime(ant.Totsimtime), TimeDrivenStep(ant.TimeDrivenStep), MaxSlotConsumedTime(ant.MaxSlotConsumedTime), TimeDrivenStepGPU(ant.TimeDrivenStepGPU), SaveWeightStep(ant.SaveWeightStep), WeightUpdateStep(ant.WeightUpdateStep), EndOfSimulation(ant.EndOfSimulation), Updates(ant.Updates), Heapoc(ant.Heapoc), CancelPredictions(ant.CancelPredictions), DiscardedSpikeCounter(ant.DiscardedSpikeCounter), CancelledSpikeCounter(ant.CancelledSpikeCounter){
 }
 
 Simulation::~Simulation(){
@@ -75,6 +77,15 @@ double Simulation::GetSaveStep(){
 	return this->SaveWeightStep;	
 }
 
+void Simulation::SetWeightUpdateStep(double NewWeightUpdateStep){
+	this->WeightUpdateStep = NewWeightUpdateStep;
+	this->Net->SetDeferredWeightChanges(NewWeightUpdateStep>0.0);
+}
+
+double Simulation::GetWeightUpdateStep(){
+	return this->WeightUpdateStep;
+}
+
 void Simulation::SetSimulationStep(double NewSimulationStep){
 	this->SimulationStep = NewSimulationStep;		
 }
@@ -136,6 +147,11 @@ void Simulation::InitSimulation() throw (EDLUTException){
 	if (this->SaveWeightStep>0.0F){
 		this->Queue->InsertEvent(new SaveWeightsEvent(this->SaveWeightStep));	
 	}
+
+	// Add the first deferred weight changes event
+	if (this->WeightUpdateStep>0.0F){
+		this->Queue->InsertEvent(new UpdateWeightsEvent(this->WeightUpdateStep));
+	}
 	
 	// Add the first communication event
 	if (this->SimulationStep>0.0F){
@@ -191,8 +207,11 @@ void Simulation::RunSimulation()  throw (EDLUTException){
 
 		NewEvent->ProcessEvent(this, false);
 		
-		delete NewEvent;
+		this->Queue->ReleaseEvent(NewEvent);
 	}
+
+	// Apply the pending weight changes
+	this->Net->ApplyDeferredWeights();
 }
 
 void Simulation::RunSimulationSlot(double preempt_time)  throw (EDLUTException){
@@ -236,7 +255,7 @@ void Simulation::RunSimulationSlot(double preempt_time)  throw (EDLUTException){
 
                 NewEvent->ProcessEvent(this, real_time_restriction);
 
-		delete NewEvent;
+		this->Queue->ReleaseEvent(NewEvent);
 		
 #if defined(_WIN32) || defined(_WIN64)
         if(this->MaxSlotConsumedTime != 0UL){
@@ -254,6 +273,9 @@ void Simulation::RunSimulationSlot(double preempt_time)  throw (EDLUTException){
         }
 #endif
     }
+
+	// Apply the pending weight changes
+	this->Net->ApplyDeferredWeights();
 }
 
 void Simulation::WriteSpike(const Spike * spike){
@@ -274,16 +296,20 @@ void Simulation::WriteSpike(const Spike * spike){
 	}		
 }
 
-void Simulation::WriteState(float time, Neuron * neuron){
+void Simulation::WriteState(float time, Neuron * neuron, bool firing){
 	for (list<OutputSpikeDriver *>::iterator it=this->MonitorSpike.begin(); it!=this->MonitorSpike.end(); ++it){
 		if ((*it)->IsWritePotentialCapable()){
-			(*it)->WriteState(time, neuron);
+			(*it)->MonitorState(time, neuron, firing);
 		}
 	}
 }
 
 void Simulation::SaveWeights(){
 	cout << "Saving weights in time " << this->CurrentSimulationTime << endl;
+
+	// The saved weights include the pending weight changes
+	this->Net->ApplyDeferredWeights();
+
 	for (list<OutputWeightDriver *>::iterator it=this->OutputWeight.begin(); it!=this->OutputWeight.end(); ++it){
 		(*it)->WriteWeights(this->Net,this->CurrentSimulationTime);
 	}
@@ -294,6 +320,7 @@ void Simulation::SendOutput(){
 //	cout << "Sending outputs in time " << this->CurrentSimulationTime << endl;
 	for (list<OutputSpikeDriver *>::iterator it=this->OutputSpike.begin(); it!=this->OutputSpike.end(); ++it){
 		if ((*it)->IsBuffered()){
+			(*it)->SetFlushTime(this->CurrentSimulationTime);
 			(*it)->FlushBuffers();	
 		}
 	}
@@ -320,6 +347,65 @@ void Simulation::IncrementTotalSpikeCounter() {
 	this->TotalSpikeCounter++;
 }
 
+void Simulation::SetCancelPredictions(bool Cancel){
+	if (!Cancel){
+		this->ClearPredictedSpikes();
+	}
+
+	this->CancelPredictions = Cancel;
+	this->Queue->SetPositionTracking(Cancel);
+}
+
+bool Simulation::GetCancelPredictions() const{
+	return this->CancelPredictions;
+}
+
+void Simulation::IncrementDiscardedSpikeCounter(){
+	this->DiscardedSpikeCounter++;
+}
+
+long Simulation::GetDiscardedSpikeCounter() const{
+	return this->DiscardedSpikeCounter;
+}
+
+long Simulation::GetCancelledSpikeCounter() const{
+	return this->CancelledSpikeCounter;
+}
+
+void Simulation::UpdatePredictedSpike(Neuron * neuron, InternalSpike * NewSpike){
+	if (!this->CancelPredictions){
+		if (NewSpike!=0){
+			this->Queue->InsertEvent(NewSpike);
+		}
+		return;
+	}
+
+	InternalSpike * OldSpike = neuron->GetPredictedSpike();
+
+	if (OldSpike!=0){
+		this->CancelledSpikeCounter++;
+
+		if (NewSpike!=0){
+			// Reuse the pending spike (decrease/increase key)
+			this->Queue->UpdateEventTime(OldSpike, NewSpike->GetTime());
+			delete NewSpike;
+		} else {
+			this->Queue->CancelEvent(OldSpike);
+			neuron->SetPredictedSpike(0);
+			delete OldSpike;
+		}
+	} else if (NewSpike!=0){
+		this->Queue->InsertEvent(NewSpike);
+		neuron->SetPredictedSpike(NewSpike);
+	}
+}
+
+void Simulation::ClearPredictedSpikes(){
+	for (int i=0; i<this->Net->GetNeuronNumber(); ++i){
+		this->Net->GetNeuronAt(i)->SetPredictedSpike(0);
+	}
+}
+
 Network * Simulation::GetNetwork() const{
 	return this->Net;	
 }
@@ -423,6 +509,8 @@ ostream & Simulation::PrintInfo(ostream & out) {
 
 	out << "  * Saving weight step time: " << this->GetSaveStep() << " s." << endl;
 
+	out << "  * Weight update step time: " << this->GetWeightUpdateStep() << " s." << endl;
+
 	out << "  * Communication step time: " << this->GetSimulationStep() << " s." << endl;
 
 	out << "  * Total simulation time: " << this->GetTotalSimulationTime() << " s." << endl;
@@ -37,6 +37,7 @@
 #include "../../include/simulation/EventQueue.h"
 #include "../../include/simulation/EndSimulationEvent.h"
 #include "../../include/simulation/SaveWeightsEvent.h"
+#include "../../include/simulation/UpdateWeightsEvent.h"
 #include "../../include/simulation/CommunicationEvent.h"
 
 #include "../../include/communication/OutputSpikeDriver.h"
@@ -47,12 +48,12 @@
 #include "../../include/neuron_model/TimeDrivenNeuronModel.h"
 #include "../../include/neuron_model/TimeDrivenNeuronModel_GPU.h"
 
-Simulation::Simulation(const char * NetworkFile, const char * WeightsFile, double SimulationTime, double NewSimulationStep) throw (EDLUTException): Net(0), Queue(0), InputSpike(), OutputSpike(), OutputWeight(), Totsimtime(SimulationTime), SimulationStep(NewSimulationStep), TimeDrivenStep(0), MaxSlotConsumedTime(0), TimeDrivenStepGPU(0), SaveWeightStep(0), EndOfSimulation(false), Updates(0), Heapoc(0){
+Simulation::Simulation(const char * NetworkFile, const char * WeightsFile, double SimulationTime, double NewSimulationStep) throw (EDLUTException): Net(0), Queue(0), InputSpike(), OutputSpike(), OutputWeight(), Totsimtime(SimulationTime), SimulationStep(NewSimulationStep), TimeDrivenStep(0), MaxSlotConsumedTime(0), TimeDrivenStepGPU(0), SaveWeightStep(0), WeightUpdateStep(0), EndOfSimulation(false), Updates(0), Heapoc(0){
 	Queue = new EventQueue();
 	Net = new Network(NetworkFile, WeightsFile, this->Queue);
 }
 
-Simulation::Simulation(const Simulation & ant):Net(ant.Net), Queue(ant.Queue), InputSpike(ant.InputSpike), OutputSpike(ant.OutputSpike), OutputWeight(ant.OutputWeight), Totsimtime(ant.Totsimtime), TimeDrivenStep(ant.TimeDrivenStep), MaxSlotConsumedTime(ant.MaxSlotConsumedTime), TimeDrivenStepGPU(ant.TimeDrivenStepGPU), SaveWeightStep(ant.SaveWeightStep), EndOfSimulation(ant.EndOfSimulation), Updates(ant.Updates), Heapoc(ant.Heapoc){
+Simulation::Simulation(const Simulation & ant):Net(ant.Net), Queue(ant.Queue), InputSpike(ant.InputSpike), OutputSpike(ant.OutputSpike), OutputWeight(ant.OutputWeight), Totsimtime(ant.Totsimtime), TimeDrivenStep(ant.TimeDrivenStep), MaxSlotConsumedTime(ant.MaxSlotConsumedTime), TimeDrivenStepGPU(ant.TimeDrivenStepGPU), SaveWeightStep(ant.SaveWeightStep), WeightUpdateStep(ant.WeightUpdateStep), EndOfSimulation(ant.EndOfSimulation), Updates(ant.Updates), Heapoc(ant.Heapoc){
 }
 
 Simulation::~Simulation(){
@@ -83,6 +84,15 @@ double Simulation::GetSaveStep(){
 	return this->SaveWeightStep;	
 }
 
+void Simulation::SetWeightUpdateStep(double NewWeightUpdateStep){
+	this->WeightUpdateStep = NewWeightUpdateStep;
+	this->Net->SetDeferredWeightChanges(NewWeightUpdateStep>0.0);
+}
+
+double Simulation::GetWeightUpdateStep(){
+	return this->WeightUpdateStep;
+}
+
 void Simulation::SetSimulationStep(double NewSimulationStep){
 	this->SimulationStep = NewSimulationStep;		
 }
@@ -144,6 +154,11 @@ void Simulation::InitSimulation() throw (EDLUTException){
 	if (this->SaveWeightStep>0.0F){
 		this->Queue->InsertEvent(new SaveWeightsEvent(this->SaveWeightStep));	
 	}
+
+	// Add the first deferred weight changes event
+	if (this->WeightUpdateStep>0.0F){
+		this->Queue->InsertEvent(new UpdateWeightsEvent(this->WeightUpdateStep));
+	}
 	
 	// Add the first communication event
 	if (this->SimulationStep>0.0F){
@@ -209,8 +224,11 @@ void Simulation::RunSimulation()  throw (EDLUTException){
  
 		NewEvent->ProcessEvent(this, false);
 		
-		delete NewEvent;
+		this->Queue->ReleaseEvent(NewEvent);
 	}
+
+	// Apply the pending weight changes
+	this->Net->ApplyDeferredWeights();
 }
 
 void Simulation::RunSimulationSlot(double preempt_time)  throw (EDLUTException){
@@ -254,7 +272,7 @@ void Simulation::RunSimulationSlot(double preempt_time)  throw (EDLUTException){
 
                 NewEvent->ProcessEvent(this, real_time_restriction);
 
-		delete NewEvent;
+		this->Queue->ReleaseEvent(NewEvent);
 		
 #if defined(_WIN32) || defined(_WIN64)
         if(this->MaxSlotConsumedTime != 0UL){
@@ -272,6 +290,9 @@ void Simulation::RunSimulationSlot(double preempt_time)  throw (EDLUTException){
         }
 #endif
     }
+
+	// Apply the pending weight changes
+	this->Net->ApplyDeferredWeights();
 }
 
 void Simulation::WriteSpike(const Spike * spike){
@@ -292,16 +313,20 @@ void Simulation::WriteSpike(const Spike * spike){
 	}		
 }
 
-void Simulation::WriteState(float time, Neuron * neuron){
+void Simulation::WriteState(float time, Neuron * neuron, bool firing){
 	for (list<OutputSpikeDriver *>::iterator it=this->MonitorSpike.begin(); it!=this->MonitorSpike.end(); ++it){
 		if ((*it)->IsWritePotentialCapable()){
-			(*it)->WriteState(time, neuron);
+			(*it)->MonitorState(time, neuron, firing);
 		}
 	}
 }
 
 void Simulation::SaveWeights(){
 	cout << "Saving weights in time " << this->CurrentSimulationTime << endl;
+
+	// The saved weights include the pending weight changes
+	this->Net->ApplyDeferredWeights();
+
 	for (list<OutputWeightDriver *>::iterator it=this->OutputWeight.begin(); it!=this->OutputWeight.end(); ++it){
 		(*it)->WriteWeights(this->Net,this->CurrentSimulationTime);
 	}
@@ -312,6 +337,7 @@ void Simulation::SendOutput(){
 //	cout << "Sending outputs in time " << this->CurrentSimulationTime << endl;
 	for (list<OutputSpikeDriver *>::iterator it=this->OutputSpike.begin(); it!=this->OutputSpike.end(); ++it){
 		if ((*it)->IsBuffered()){
+			(*it)->SetFlushTime(this->CurrentSimulationTime);
 			(*it)->FlushBuffers();	
 		}
 	}
@@ -441,6 +467,8 @@ ostream & Simulation::PrintInfo(ostream & out) {
 
 	out << "  * Saving weight step time: " << this->GetSaveStep() << " s." << endl;
 
+	out << "  * Weight update step time: " << this->GetWeightUpdateStep() << " s." << endl;
+
 	out << "  * Communication step time: " << this->GetSimulationStep() << " s." << endl;
 
 	out << "  * Total simulation time: " << this->GetTotalSimulationTime() << " s." << endl;
@@ -0,0 +1,34 @@
+/***************************************************************************
+ *                           StreamInputEvent.cpp                          *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/simulation/StreamInputEvent.h"
+
+#include "../../include/simulation/Simulation.h"
+
+#include "../../include/communication/StreamFileInputSpikeDriver.h"
+
+StreamInputEvent::StreamInputEvent():Event(0), Driver(0){
+}
+
+StreamInputEvent::StreamInputEvent(double NewTime, StreamFileInputSpikeDriver * NewDriver): Event(NewTime), Driver(NewDriver){
+}
+
+StreamInputEvent::~StreamInputEvent(){
+}
+
+void StreamInputEvent::ProcessEvent(Simulation * CurrentSimulation, bool RealTimeRestriction){
+	this->Driver->LoadWindow(CurrentSimulation->GetQueue(), CurrentSimulation->GetNetwork(), this->GetTime());
+}
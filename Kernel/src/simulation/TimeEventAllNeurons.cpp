@@ -71,7 +71,7 @@ void TimeEventAllNeurons::ProcessEvent(Simulation * CurrentSimulation, bool Real
 						delete internalSpike;
 					}
 					if (Cell->IsMonitored()){
-						CurrentSimulation->WriteState(CurrentTime, Cell);
+						CurrentSimulation->WriteState(CurrentTime, Cell, false);
 					}
 				}
 			}else{
@@ -70,7 +70,7 @@ void TimeEventAllNeurons_GPU::ProcessEvent(Simulation * CurrentSimulation, bool
 					delete internalSpike;
 				}
 				if (Cell->IsMonitored()){
-					CurrentSimulation->WriteState(CurrentTime, Cell);
+					CurrentSimulation->WriteState(CurrentTime, Cell, false);
 				}
 			}
 		}else{
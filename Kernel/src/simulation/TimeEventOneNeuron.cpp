@@ -64,7 +64,7 @@ void TimeEventOneNeuron::ProcessEvent(Simulation * CurrentSimulation, bool RealT
 			delete internalSpike;
 		}
 		if (Cell->IsMonitored()){
-			CurrentSimulation->WriteState(CurrentTime, Cell);
+			CurrentSimulation->WriteState(CurrentTime, Cell, false);
 		}
 
 		//Next TimeEvent for this cell
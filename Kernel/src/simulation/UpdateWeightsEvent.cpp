@@ -0,0 +1,39 @@
+/***************************************************************************
+ *                           UpdateWeightsEvent.cpp                        *
+ *                           -------------------                           *
+ * copyright            : (C) 2013 by Jesus Garrido                        *
+ * email                : jgarrido@atc.ugr.es                              *
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 3 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "../../include/simulation/UpdateWeightsEvent.h"
+
+#include "../../include/simulation/Simulation.h"
+#include "../../include/simulation/EventQueue.h"
+
+#include "../../include/spike/Network.h"
+
+UpdateWeightsEvent::UpdateWeightsEvent():Event(0){
+}
+
+UpdateWeightsEvent::UpdateWeightsEvent(double NewTime): Event(NewTime){
+}
+
+UpdateWeightsEvent::~UpdateWeightsEvent(){
+}
+
+void UpdateWeightsEvent::ProcessEvent(Simulation * CurrentSimulation, bool RealTimeRestriction){
+	CurrentSimulation->GetNetwork()->ApplyDeferredWeights();
+	if (CurrentSimulation->GetWeightUpdateStep()>0.0){
+		UpdateWeightsEvent * NewEvent = new UpdateWeightsEvent(this->GetTime()+CurrentSimulation->GetWeightUpdateStep());
+		CurrentSimulation->GetQueue()->InsertEvent(NewEvent);
+	}
+}
@@ -18,7 +18,7 @@
 
 int skip_spaces(FILE *fh, long & Currentline){
 	int ch;
-	while((ch=fgetc(fh)) == ' ' || ch=='\n') // take all spaces
+	while((ch=fgetc(fh)) == ' ' || ch=='\n' || ch=='\r') // take all spaces (and carriage returns of CRLF files)
 		if(ch=='\n')
 			Currentline++;
 			
@@ -31,7 +31,10 @@ const char * EDLUTException::Taskmsgs[] ={
 	"Loading neuron tables",
 	"Loading weights from file",
 	"Saving weights to file",
-	"Loading the neuron type configuration"
+	"Loading the neuron type configuration",
+	"Generating the input spikes",
+	"Exchanging spikes through a TCP/IP connection",
+	"Connecting through shared memory"
 };
 
 const char * EDLUTException::Errormsgs[] ={
@@ -111,7 +114,16 @@ const char * EDLUTException::Errormsgs[] ={
 	"Can't read the firing threshold",
 	"Can't read the resting potential",
 	"Can't read the inhibitory reversal potential",
-	"Can't read the excitatory reversal potential"
+	"Can't read the excitatory reversal potential",
+	"Can't read the reset potential",
+	"Can't read the bias current",
+	"Can't create the output writer thread",
+	"The input spikes are not sorted by time",
+	"Too many spikes in a communication step for the version 1 TCP/IP protocol",
+	"The TCP/IP connection has been closed or has sent a wrong message",
+	"Can't create the shared memory segment",
+	"The shared memory segment doesn't exist or hasn't been initialized",
+	"The state of the learning rule needs the number of neurons of the network"
 
 
 };
@@ -150,8 +162,16 @@ const char * EDLUTException::Repairmsgs[] ={
 	"Free more memory or use a smaller network",
 	"Reduce the number of state variables or change the maximum number of state variables in the simulator source code",
 
-	"Check the type of the neuron model: Only SRMTimeDriven, TableBasedModel and SRMTableBasedModel are implemented at the moment",
-	"Check if the neuron model is described and can be accessed by this software"
+	"Check the type of the neuron model: Only SRMTimeDriven, TableBasedModel, SRMTableBasedModel and LIFEventDrivenModel are implemented at the moment",
+	"Check if the neuron model is described and can be accessed by this software",
+	"Check the system thread limits or disable the asynchronous output",
+	"Sort the lines of the file of input spikes by time or load it with the -if option",
+	"Specify a range of neurons of the input generator which is defined in the network",
+	"Use the version 2 TCP/IP protocol (-tcpv2 option) or a shorter communication step",
+	"Check that the other end of the connection is running and uses the same protocol version",
+	"Check the name of the segment and the shared memory limits of the system",
+	"Start the server side of the connection first and use the same segment name in both sides",
+	"Initialize the state of the learning rule with the number of synapses and neurons"
 };
 
 long EDLUTException::GetErrorValue(int a, int b, int c, int d){
@@ -24,12 +24,21 @@
 #include "../../include/learning_rules/LearningRule.h"
 #include "../../include/learning_rules/ConnectionState.h"
 
-Interconnection::Interconnection(): source(0), target(0), index(0), delay(0), type(0), weight(0), maxweight(0), wchange_withPost(0), LearningRuleIndex_withPost(0), wchange_withoutPost(0), LearningRuleIndex_withoutPost(0){
+const InterconnectionGroup Interconnection::NoGroup;
+
+InterconnectionGroup::InterconnectionGroup(float NewMaxWeight): scale(0), maxweight(NewMaxWeight){
+	if (NewMaxWeight>0.0f){
+		this->scale = NewMaxWeight/MAX_QUANTIZED_WEIGHT;
+	}
+}
+
+Interconnection::Interconnection(): source(0), target(0), learning(0), group(&NoGroup), delay(0), type(0), qweight(0){
 	
 }
 
-Interconnection::Interconnection(int NewIndex, Neuron * NewSource, Neuron * NewTarget, float NewDelay, int NewType, float NewWeight, float NewMaxWeight, LearningRule* NewWeightChange_withPost, unsigned int NewLearningRuleIndex_withPost, LearningRule* NewWeightChange_withoutPost, unsigned int NewLearningRuleIndex_withoutPost):
-	source(NewSource), target(NewTarget), index(NewIndex), delay(NewDelay), type(NewType), weight(NewWeight), maxweight(NewMaxWeight), wchange_withPost(NewWeightChange_withPost),LearningRuleIndex_withPost(NewLearningRuleIndex_withPost), wchange_withoutPost(NewWeightChange_withoutPost),LearningRuleIndex_withoutPost(NewLearningRuleIndex_withoutPost) {
+Interconnection::Interconnection(Neuron * NewSource, Neuron * NewTarget, float NewDelay, int NewType, float NewWeight, const InterconnectionGroup * NewGroup, InterconnectionLearning * NewLearning):
+	source(NewSource), target(NewTarget), learning(NewLearning), group((NewGroup!=0)?NewGroup:&NoGroup), delay(NewDelay), type((short int) NewType), qweight(0) {
+	this->SetWeight(NewWeight);
 }
 
 Interconnection::~Interconnection(){
@@ -37,11 +46,13 @@ Interconnection::~Interconnection(){
 }
 
 long int Interconnection::GetIndex() const{
-	return this->index;
+	return (this->learning!=0)?this->learning->index:-1;
 }
 		
 void Interconnection::SetIndex(long int NewIndex){
-	this->index = NewIndex;
+	if (this->learning!=0){
+		this->learning->index = NewIndex;
+	}
 }
 		
 //Neuron * Interconnection::GetSource() const{
@@ -73,7 +84,7 @@ void Interconnection::SetDelay(float NewDelay){
 //}
 		
 void Interconnection::SetType(int NewType){
-	this->type = NewType;
+	this->type = (short int) NewType;
 }
 		
 //float Interconnection::GetWeight() const{
@@ -89,15 +100,27 @@ void Interconnection::SetType(int NewType){
 //}
 		
 void Interconnection::SetMaxWeight(float NewMaxWeight){
-	this->maxweight = NewMaxWeight;
+	if (this->learning!=0){
+		this->learning->maxweight = NewMaxWeight;
+	}
+}
+
+void Interconnection::SetGroup(const InterconnectionGroup * NewGroup){
+	this->group = (NewGroup!=0)?NewGroup:&NoGroup;
 }
 		
+void Interconnection::SetLearning(InterconnectionLearning * NewLearning){
+	this->learning = NewLearning;
+}
+
 //LearningRule * Interconnection::GetWeightChange_withPost() const{
 //	return this->wchange_withPost;
 //}
 		
 void Interconnection::SetWeightChange_withPost(LearningRule * NewWeightChange_withPost){
-	this->wchange_withPost=NewWeightChange_withPost;
+	if (this->learning!=0){
+		this->learning->wchange_withPost=NewWeightChange_withPost;
+	}
 }
 
 //LearningRule * Interconnection::GetWeightChange_withoutPost() const{
@@ -105,12 +128,16 @@ void Interconnection::SetWeightChange_withPost(LearningRule * NewWeightChange_wi
 //}
 		
 void Interconnection::SetWeightChange_withoutPost(LearningRule * NewWeightChange_withoutPost){
-	this->wchange_withoutPost=NewWeightChange_withoutPost;
+	if (this->learning!=0){
+		this->learning->wchange_withoutPost=NewWeightChange_withoutPost;
+	}
 }
 
 
 void Interconnection::SetLearningRuleIndex_withPost(int NewIndex){
-	this->LearningRuleIndex_withPost=NewIndex;
+	if (this->learning!=0){
+		this->learning->LearningRuleIndex_withPost=NewIndex;
+	}
 }
 
 //int Interconnection::GetLearningRuleIndex_withPost() const{
@@ -118,7 +145,9 @@ void Interconnection::SetLearningRuleIndex_withPost(int NewIndex){
 //}
 
 void Interconnection::SetLearningRuleIndex_withoutPost(int NewIndex){
-	this->LearningRuleIndex_withoutPost=NewIndex;
+	if (this->learning!=0){
+		this->learning->LearningRuleIndex_withoutPost=NewIndex;
+	}
 }
 
 //int Interconnection::GetLearningRuleIndex_withoutPost() const{
@@ -136,7 +165,9 @@ void Interconnection::SetLearningRuleIndex_withoutPost(int NewIndex){
 
 
 ostream & Interconnection::PrintInfo(ostream & out) {
-	out << "- Interconnection: " << this->index << endl;
+	out << "- Interconnection: ";
+	if (this->learning!=0) out << this->GetIndex() << endl;
+	else out << "static (16-bit weight)" << endl;
 
 	out << "\tSource: " << this->source->GetIndex() << endl;
 
@@ -40,6 +40,23 @@ InternalSpike::InternalSpike(double NewTime, Neuron * NewSource): Spike(NewTime,
 InternalSpike::~InternalSpike(){
 }
 
+void InternalSpike::ApplyPostSynapticLearning(Neuron * neuron){
+	Interconnection ** Connections = neuron->GetInputConnectionsWithPostSynapticLearning();
+	unsigned int NumberOfConnections = neuron->GetInputNumberWithPostSynapticLearning();
+
+	// The connections with the same learning rule are consecutive: each rule updates its connections at once.
+	unsigned int First = 0;
+	while (First<NumberOfConnections){
+		LearningRule * Rule = Connections[First]->GetWeightChange_withPost();
+		unsigned int Last = First+1;
+		while (Last<NumberOfConnections && Connections[Last]->GetWeightChange_withPost()==Rule){
+			Last++;
+		}
+		Rule->ApplyPostSynapticSpikes(Connections+First, Last-First, this->time);
+		First = Last;
+	}
+}
+
 void InternalSpike::ProcessEvent(Simulation * CurrentSimulation, bool RealTimeRestriction){
 
 	if(!RealTimeRestriction){
@@ -48,7 +65,15 @@ void InternalSpike::ProcessEvent(Simulation * CurrentSimulation, bool RealTimeRe
 		
 		if (neuron->GetNeuronModel()->GetModelType() == EVENT_DRIVEN_MODEL){
 			EventDrivenNeuronModel * Model = (EventDrivenNeuronModel *) neuron->GetNeuronModel();
-			if(!Model->DiscardSpike(this)){
+
+			// This spike is leaving the queue, so it can't be rescheduled anymore
+			if (neuron->GetPredictedSpike()==this){
+				neuron->SetPredictedSpike(0);
+			}
+
+			if(Model->DiscardSpike(this)){
+				CurrentSimulation->IncrementDiscardedSpikeCounter();
+			} else {
 				// Add the spike to simulation spike counter
 				CurrentSimulation->IncrementTotalSpikeCounter();
 
@@ -56,14 +81,12 @@ void InternalSpike::ProcessEvent(Simulation * CurrentSimulation, bool RealTimeRe
 				// If it is a valid spike (not discard), generate the next spike in this cell.
 				InternalSpike * NextSpike = Model->GenerateNextSpike(this);
 
-				if (NextSpike!=0){
-					CurrentSimulation->GetQueue()->InsertEvent(NextSpike);
-				}
+				CurrentSimulation->UpdatePredictedSpike(neuron, NextSpike);
 				
 				
 				CurrentSimulation->WriteSpike(this);
 				if (neuron->IsMonitored()){
-					CurrentSimulation->WriteState(neuron->GetVectorNeuronState()->GetLastUpdateTime(neuron->GetIndex_VectorNeuronState()), neuron);
+					CurrentSimulation->WriteState(neuron->GetVectorNeuronState()->GetLastUpdateTime(neuron->GetIndex_VectorNeuronState()), neuron, true);
 				}
 
 				// Generate the output activity
@@ -73,13 +96,7 @@ void InternalSpike::ProcessEvent(Simulation * CurrentSimulation, bool RealTimeRe
 				}
 
 				if(neuron->GetInputNumberWithPostSynapticLearning()>0){
-					int i;
-					Interconnection * inter;
-					#pragma omp parallel for if(neuron->GetInputNumberWithPostSynapticLearning()>64) schedule(guided, 16) num_threads(8) shared (neuron) private (i, inter)
-					for (int i=0; i<neuron->GetInputNumberWithPostSynapticLearning(); ++i){
-						inter = neuron->GetInputConnectionWithPostSynapticLearningAt(i);
-						inter->GetWeightChange_withPost()->ApplyPostSynapticSpike(inter,this->time);
-					}
+					this->ApplyPostSynapticLearning(neuron);
 				}
 			}
 		} else { // Time-driven model (no check nor update needed
@@ -88,7 +105,7 @@ void InternalSpike::ProcessEvent(Simulation * CurrentSimulation, bool RealTimeRe
 
 			CurrentSimulation->WriteSpike(this);
 			if (neuron->IsMonitored()){
-				CurrentSimulation->WriteState(neuron->GetVectorNeuronState()->GetLastUpdateTime(neuron->GetIndex_VectorNeuronState()), neuron);
+				CurrentSimulation->WriteState(neuron->GetVectorNeuronState()->GetLastUpdateTime(neuron->GetIndex_VectorNeuronState()), neuron, true);
 			}
 			
 			// Generate the output activity
@@ -98,13 +115,7 @@ void InternalSpike::ProcessEvent(Simulation * CurrentSimulation, bool RealTimeRe
 			}
 
 			if(neuron->GetInputNumberWithPostSynapticLearning()>0){
-				int i;
-				Interconnection * inter;
-				#pragma omp parallel for if(neuron->GetInputNumberWithPostSynapticLearning()>64) schedule(guided, 16) num_threads(8) shared (neuron) private (i, inter)
-				for (int i=0; i<neuron->GetInputNumberWithPostSynapticLearning(); ++i){
-					inter = neuron->GetInputConnectionWithPostSynapticLearningAt(i);
-					inter->GetWeightChange_withPost()->ApplyPostSynapticSpike(inter,this->time);
-				}
+				this->ApplyPostSynapticLearning(neuron);
 			}
 			
 		}
@@ -16,6 +16,9 @@
  ***************************************************************************/
 
 #include "../../include/spike/Network.h"
+
+#include <vector>
+
 #include "../../include/spike/Interconnection.h"
 #include "../../include/spike/Neuron.h"
 #include "../../include/spike/InternalSpike.h"
@@ -24,15 +27,20 @@
 #include "../../include/learning_rules/SinWeightChange.h"
 #include "../../include/learning_rules/STDPWeightChange.h"
 #include "../../include/learning_rules/STDPLSWeightChange.h"
+#include "../../include/learning_rules/STDPNeuronWeightChange.h"
+#include "../../include/learning_rules/STDPLSNeuronWeightChange.h"
+#include "../../include/learning_rules/DeferredWeightChanges.h"
 
 #include "../../include/neuron_model/NeuronModel.h"
 #include "../../include/neuron_model/SRMTimeDrivenModel.h"
+#include "../../include/neuron_model/SRMFilterTimeDrivenModel.h"
 #include "../../include/neuron_model/LIFTimeDrivenModel_1_4.h"
 #include "../../include/neuron_model/LIFTimeDrivenModel_1_2.h"
 #include "../../include/neuron_model/TimeDrivenNeuronModel.h"
 #include "../../include/neuron_model/EventDrivenNeuronModel.h"
 #include "../../include/neuron_model/TableBasedModel.h"
 #include "../../include/neuron_model/SRMTableBasedModel.h"
+#include "../../include/neuron_model/LIFEventDrivenModel.h"
 #include "../../include/neuron_model/VectorNeuronState.h"
 #include "../../include/neuron_model/EgidioGranuleCell_TimeDriven.h"
 #include "../../include/neuron_model/Vanderpol.h"
@@ -44,24 +52,51 @@
 int qsort_inters(const void *e1, const void *e2){
 	int ord;
 	float ordf;
+	Interconnection * c1 = *((Interconnection **)e1);
+	Interconnection * c2 = *((Interconnection **)e2);
 	
-	ord=((Interconnection *)e1)->GetSource()->GetIndex() - ((Interconnection *)e2)->GetSource()->GetIndex();
+	ord=c1->GetSource()->GetIndex() - c2->GetSource()->GetIndex();
 	if(!ord){
-		ordf=((Interconnection *)e1)->GetDelay() - ((Interconnection *)e2)->GetDelay();
+		ordf=c1->GetDelay() - c2->GetDelay();
 		if(ordf<0.0)
 			ord=-1;
 		else
 			if(ordf>0.0)
 				ord=1;
 	}
+
+	// Same source and delay: keep the initial order
+	if(!ord){
+		if(c1<c2)
+			ord=-1;
+		else
+			if(c1>c2)
+				ord=1;
+	}
    
 	return(ord);
 }
 
 void Network::FindOutConnections(){
-	// Change the ordenation
-   	qsort(inters,ninters,sizeof(Interconnection),qsort_inters);
 	if(ninters>0){
+		// Change the ordenation. The pointers are sorted so the initial position of each connection is known.
+		Interconnection ** SortedConnections = (Interconnection **) new Interconnection * [this->ninters];
+		for (long int con= 0; con<this->ninters; ++con){
+			SortedConnections[con] = this->inters+con;
+		}
+
+		qsort(SortedConnections,ninters,sizeof(Interconnection *),qsort_inters);
+
+		Interconnection * SortedInters = (Interconnection *) new Interconnection [this->ninters];
+		for (long int con= 0; con<this->ninters; ++con){
+			SortedInters[con] = *SortedConnections[con];
+			this->wordination[SortedConnections[con]-this->inters] = SortedInters+con;
+		}
+
+		delete [] SortedConnections;
+		delete [] this->inters;
+		this->inters = SortedInters;
+
 		// Calculate the number of input connections with learning for each cell
 		unsigned long * NumberOfOutputs = (unsigned long *) new unsigned long [this->nneurons];
 		unsigned long * OutputsLeft = (unsigned long *) new unsigned long [this->nneurons];
@@ -95,13 +130,6 @@ void Network::FindOutConnections(){
 
 		for (unsigned long neu = 0; neu<this->nneurons; ++neu){
 			this->neurons[neu].SetOutputConnections(OutputConnections[neu],NumberOfOutputs[neu]);
-
-			for (unsigned long aux = 0; aux < NumberOfOutputs[neu]; aux++){
-				if(OutputConnections[neu][aux]->GetWeightChange_withoutPost()!=0){
-					OutputConnections[neu][aux]->SetLearningRuleIndex_withoutPost(OutputConnections[neu][aux]->GetWeightChange_withoutPost()->counter);
-					OutputConnections[neu][aux]->GetWeightChange_withoutPost()->counter++;
-				}
-			}
 		}
 
 		delete [] OutputConnections;
@@ -110,15 +138,6 @@ void Network::FindOutConnections(){
 	}
 }
 
-void Network::SetWeightOrdination(){
-	if (ninters>0){
-		for (int ninter=0; ninter<ninters;ninter++){
-			int index = inters[ninter].GetIndex();
-			this->wordination[index] = &(this->inters[ninter]);
-		}
-	}	
-}
-
 void Network::FindInConnections(){
 	if(this->ninters>0){
 
@@ -169,13 +188,70 @@ void Network::FindInConnections(){
 			}
 		}
 
+		// Group the input connections of each cell by learning rule, so that the states of the
+		// connections of a cell with the same learning rule are consecutive.
+		if (this->nwchanges>1){
+			for (unsigned long neu = 0; neu<this->nneurons; ++neu){
+				if (NumberOfInputsWithPostSynapticLearning[neu]>1){
+					Interconnection ** Sorted = (Interconnection **) new Interconnection * [NumberOfInputsWithPostSynapticLearning[neu]];
+					unsigned long Position = 0;
+					for (int wcind=0; wcind<this->nwchanges; ++wcind){
+						for (unsigned long aux = 0; aux < NumberOfInputsWithPostSynapticLearning[neu]; aux++){
+							if (InputConnectionsWithPostSynapticLearning[neu][aux]->GetWeightChange_withPost()==this->wchanges[wcind]){
+								Sorted[Position++] = InputConnectionsWithPostSynapticLearning[neu][aux];
+							}
+						}
+					}
+					delete [] InputConnectionsWithPostSynapticLearning[neu];
+					InputConnectionsWithPostSynapticLearning[neu] = Sorted;
+				}
+				if (NumberOfInputsWithoutPostSynapticLearning[neu]>1){
+					Interconnection ** Sorted = (Interconnection **) new Interconnection * [NumberOfInputsWithoutPostSynapticLearning[neu]];
+					unsigned long Position = 0;
+					for (int wcind=0; wcind<this->nwchanges; ++wcind){
+						for (unsigned long aux = 0; aux < NumberOfInputsWithoutPostSynapticLearning[neu]; aux++){
+							if (InputConnectionsWithoutPostSynapticLearning[neu][aux]->GetWeightChange_withoutPost()==this->wchanges[wcind]){
+								Sorted[Position++] = InputConnectionsWithoutPostSynapticLearning[neu][aux];
+							}
+						}
+					}
+					delete [] InputConnectionsWithoutPostSynapticLearning[neu];
+					InputConnectionsWithoutPostSynapticLearning[neu] = Sorted;
+				}
+			}
+		}
+
+		unsigned int FirstSynapse = 0;
 		for (unsigned long neu = 0; neu<this->nneurons; ++neu){
 			this->neurons[neu].SetInputConnectionsWithPostSynapticLearning(InputConnectionsWithPostSynapticLearning[neu],NumberOfInputsWithPostSynapticLearning[neu]);
 			this->neurons[neu].SetInputConnectionsWithoutPostSynapticLearning(InputConnectionsWithoutPostSynapticLearning[neu],NumberOfInputsWithoutPostSynapticLearning[neu]);
 		
 			for (unsigned long aux = 0; aux < NumberOfInputsWithPostSynapticLearning[neu]; aux++){
-				InputConnectionsWithPostSynapticLearning[neu][aux]->SetLearningRuleIndex_withPost(InputConnectionsWithPostSynapticLearning[neu][aux]->GetWeightChange_withPost()->counter);
-				InputConnectionsWithPostSynapticLearning[neu][aux]->GetWeightChange_withPost()->counter++;
+				LearningRule * Rule = InputConnectionsWithPostSynapticLearning[neu][aux]->GetWeightChange_withPost();
+				if (aux==0 || InputConnectionsWithPostSynapticLearning[neu][aux-1]->GetWeightChange_withPost()!=Rule){
+					FirstSynapse = Rule->counter;
+				}
+				InputConnectionsWithPostSynapticLearning[neu][aux]->SetLearningRuleIndex_withPost(Rule->counter);
+				Rule->counter++;
+
+				// Last input of the cell with this learning rule
+				if (aux+1==NumberOfInputsWithPostSynapticLearning[neu] || InputConnectionsWithPostSynapticLearning[neu][aux+1]->GetWeightChange_withPost()!=Rule){
+					Rule->SetTargetSynapses(FirstSynapse, Rule->counter-FirstSynapse);
+				}
+			}
+
+			for (unsigned long aux = 0; aux < NumberOfInputsWithoutPostSynapticLearning[neu]; aux++){
+				LearningRule * Rule = InputConnectionsWithoutPostSynapticLearning[neu][aux]->GetWeightChange_withoutPost();
+				if (aux==0 || InputConnectionsWithoutPostSynapticLearning[neu][aux-1]->GetWeightChange_withoutPost()!=Rule){
+					FirstSynapse = Rule->counter;
+				}
+				InputConnectionsWithoutPostSynapticLearning[neu][aux]->SetLearningRuleIndex_withoutPost(Rule->counter);
+				Rule->counter++;
+
+				// Last input of the cell with this learning rule
+				if (aux+1==NumberOfInputsWithoutPostSynapticLearning[neu] || InputConnectionsWithoutPostSynapticLearning[neu][aux+1]->GetWeightChange_withoutPost()!=Rule){
+					Rule->SetTargetSynapses(FirstSynapse, Rule->counter-FirstSynapse);
+				}
 			}
 
 		}
@@ -204,10 +280,14 @@ NeuronModel * Network::LoadNetTypes(string ident_type, string neutype, int & ni)
 			neutypes[ni] = (LIFTimeDrivenModel_1_2 *) new LIFTimeDrivenModel_1_2(ident_type, neutype);
 		}else if (ident_type=="SRMTimeDrivenModel"){
 			neutypes[ni] = (SRMTimeDrivenModel *) new SRMTimeDrivenModel(ident_type, neutype);
+		}else if (ident_type=="SRMFilterTimeDrivenModel"){
+			neutypes[ni] = (SRMFilterTimeDrivenModel *) new SRMFilterTimeDrivenModel(ident_type, neutype);
 		} else if (ident_type=="TableBasedModel"){
    			neutypes[ni] = (TableBasedModel *) new TableBasedModel(ident_type, neutype);
 		} else if (ident_type=="SRMTableBasedModel"){
 			neutypes[ni] = (SRMTableBasedModel *) new SRMTableBasedModel(ident_type, neutype);
+		} else if (ident_type=="LIFEventDrivenModel"){
+			neutypes[ni] = (LIFEventDrivenModel *) new LIFEventDrivenModel(ident_type, neutype);
 		} else if (ident_type=="EgidioGranuleCell_TimeDriven"){
 			neutypes[ni] = (EgidioGranuleCell_TimeDriven *) new EgidioGranuleCell_TimeDriven(ident_type, neutype);
 		}else if (ident_type=="Vanderpol"){
@@ -248,7 +328,7 @@ void Network::InitNetPredictions(EventQueue * Queue){
 
 }
 
-Network::Network(const char * netfile, const char * wfile, EventQueue * Queue) throw (EDLUTException): inters(0), ninters(0), neutypes(0), nneutypes(0), neurons(0), nneurons(0), timedrivenneurons(0), ntimedrivenneurons(0), wchanges(0), nwchanges(0), wordination(0){
+Network::Network(const char * netfile, const char * wfile, EventQueue * Queue) throw (EDLUTException): inters(0), ninters(0), learnings(0), nlearnings(0), groups(0), ngroups(0), neutypes(0), nneutypes(0), neurons(0), nneurons(0), timedrivenneurons(0), ntimedrivenneurons(0), wchanges(0), nwchanges(0), wordination(0), DeferredWeights(0){
 	this->LoadNet(netfile);	
 	this->LoadWeights(wfile);
 	this->InitNetPredictions(Queue);	
@@ -259,6 +339,14 @@ Network::~Network(){
 		delete [] inters;
 	}
 
+	if (learnings!=0) {
+		delete [] learnings;
+	}
+
+	if (groups!=0) {
+		delete [] groups;
+	}
+
 	if (neutypes!=0) {
 		for (int i=0; i<this->nneutypes; ++i){
 			if (this->neutypes[i]!=0){
@@ -289,6 +377,8 @@ Network::~Network(){
 		delete [] wchanges;
 	}
 	if (wordination!=0) delete [] wordination;
+
+	if (DeferredWeights!=0) delete DeferredWeights;
 }
    		
 Neuron * Network::GetNeuronAt(int index) const{
@@ -332,6 +422,30 @@ int Network::GetLearningRuleNumber() const{
 	return this->nwchanges;
 }
 
+void Network::SetDeferredWeightChanges(bool Deferred){
+	if (Deferred && this->DeferredWeights==0){
+		this->DeferredWeights = new DeferredWeightChanges(this->ninters);
+	} else if (!Deferred && this->DeferredWeights!=0){
+		this->ApplyDeferredWeights();
+		delete this->DeferredWeights;
+		this->DeferredWeights = 0;
+	}
+
+	for (int i=0; i<this->nwchanges; ++i){
+		this->wchanges[i]->SetDeferredWeights(this->DeferredWeights);
+	}
+}
+
+bool Network::IsDeferredWeightChanges() const{
+	return this->DeferredWeights!=0;
+}
+
+void Network::ApplyDeferredWeights(){
+	if (this->DeferredWeights!=0){
+		this->DeferredWeights->ApplyChanges(this->wordination);
+	}
+}
+
 void Network::LoadNet(const char *netfile) throw (EDLUTException){
 	FILE *fh;
 	long savedcurrentline;
@@ -449,6 +563,10 @@ void Network::LoadNet(const char *netfile) throw (EDLUTException){
         							this->wchanges[wcind] = new STDPWeightChange();
 								} else if (string(ident_type)==string("STDPLS")){
         							this->wchanges[wcind] = new STDPLSWeightChange();
+        						} else if (string(ident_type)==string("STDPNeuron")){
+        							this->wchanges[wcind] = new STDPNeuronWeightChange();
+        						} else if (string(ident_type)==string("STDPLSNeuron")){
+        							this->wchanges[wcind] = new STDPLSNeuronWeightChange();
         						} else {
                            			throw EDLUTFileException(4,28,23,1,Currentline);
         						}
@@ -477,6 +595,11 @@ N_ConectionWithLearning=new int [this->nwchanges]();
         			int iind,sind,tind,rind,posc;
         			this->inters=(Interconnection *) new Interconnection [this->ninters];
         			this->wordination=(Interconnection **) new Interconnection * [this->ninters];
+        			// Learning rules of each connection (the learning fields are allocated after loading all of them)
+        			int * ConnectionRules = new int [2*this->ninters];
+        			// Group (line of the network file) of each connection and maximum weight of each group
+        			vector<long int> ConnectionGroups(this->ninters);
+        			vector<float> GroupMaxWeights;
         			if(this->inters && this->wordination){
         				for(iind=0;iind<this->ninters;iind+=nsources*ntargets*nreps){
         					skip_comments(fh,Currentline);
@@ -486,80 +609,121 @@ N_ConectionWithLearning=new int [this->nwchanges]();
 									if(is_end_line(fh,Currentline)==false){
 										if(fscanf(fh,"%i",&wchange2)==1){
 											if(wchange2>= this->nwchanges){
+  												delete [] ConnectionRules;
   												throw EDLUTFileException(4,29,24,1,Currentline);
 											}
 										}else{
+											delete [] ConnectionRules;
 											throw EDLUTFileException(4,12,11,1,Currentline);
 										}
 									}
 								}
 								if(iind+nsources*ntargets*nreps>this->ninters){
+        							delete [] ConnectionRules;
         							throw EDLUTFileException(4,10,9,1,Currentline);
         						}else{
         							if(source+nreps*nsources>this->nneurons || target+nreps*ntargets>this->nneurons){
+  										delete [] ConnectionRules;
   										throw EDLUTFileException(4,11,10,1,Currentline);
   									}else{
   										if(wchange >= this->nwchanges){
+  											delete [] ConnectionRules;
   											throw EDLUTFileException(4,29,24,1,Currentline);
   										}
         							}
         						}
+
+        						GroupMaxWeights.push_back(maxweight);
         						
         						for(rind=0;rind<nreps;rind++){
         							for(sind=0;sind<nsources;sind++){
         								for(tind=0;tind<ntargets;tind++){
         									posc=iind+rind*nsources*ntargets+sind*ntargets+tind;
-        									this->inters[posc].SetIndex(posc);
         									this->inters[posc].SetSource(&(this->neurons[source+rind*nsources+sind]));
         									this->inters[posc].SetTarget(&(this->neurons[target+rind*ntargets+tind]));
         									//Net.inters[posc].target=target+rind*nsources+tind;  // other kind of neuron arrangement
         									this->inters[posc].SetDelay(delay+delayinc*tind);
         									this->inters[posc].SetType(type);
         									//this->inters[posc].nextincon=&(this->inters[posc]);       // temporaly used as weight index
-        									this->inters[posc].SetWeight(maxweight);   //TODO: Use max interconnection conductance
-        									this->inters[posc].SetMaxWeight(maxweight);
+        									ConnectionGroups[posc] = GroupMaxWeights.size()-1;
 
-											this->inters[posc].SetWeightChange_withPost(0);
-											this->inters[posc].SetWeightChange_withoutPost(0);
+											ConnectionRules[2*posc] = wchange;
+											ConnectionRules[2*posc+1] = wchange2;
 											if(wchange >= 0){
-												//Set the new learning rule
-												if(wchanges[wchange]->ImplementPostSynaptic()==true){
-													this->inters[posc].SetWeightChange_withPost(this->wchanges[wchange]);
-												}else{
-													this->inters[posc].SetWeightChange_withoutPost(this->wchanges[wchange]);
-												}
 												N_ConectionWithLearning[wchange]++;
 											}
 
 											if(wchange2>= 0){
-												//Set the new learning rule
-												if(wchanges[wchange2]->ImplementPostSynaptic()==true){
-													this->inters[posc].SetWeightChange_withPost(this->wchanges[wchange2]);
-												}else{
-													this->inters[posc].SetWeightChange_withoutPost(this->wchanges[wchange2]);
-												}
 												N_ConectionWithLearning[wchange2]++;
 											}
                                 		}
         							}
         						}
         					}else{
+        						delete [] ConnectionRules;
         						throw EDLUTFileException(4,12,11,1,Currentline);
         					}
         				}
+
+					// Only the connections with learning rules get learning fields
+					this->nlearnings = 0;
+					for(posc=0;posc<this->ninters;posc++){
+						if(ConnectionRules[2*posc]>=0){
+							this->nlearnings++;
+						}
+					}
+
+					this->learnings = new InterconnectionLearning [this->nlearnings];
+
+					// The static connections store their weights quantized with the scale of their group
+					this->ngroups = GroupMaxWeights.size();
+					this->groups = new InterconnectionGroup [this->ngroups];
+					for(long int gind=0;gind<this->ngroups;gind++){
+						this->groups[gind] = InterconnectionGroup(GroupMaxWeights[gind]);
+					}
+
+					long int lind = 0;
+					for(posc=0;posc<this->ninters;posc++){
+						InterconnectionGroup * group = this->groups+ConnectionGroups[posc];
+						this->inters[posc].SetGroup(group);
+						if(ConnectionRules[2*posc]>=0){
+							this->inters[posc].SetLearning(this->learnings+lind);
+							lind++;
+
+							for(int r=0;r<2;r++){
+								int wcrule = ConnectionRules[2*posc+r];
+								if(wcrule>=0){
+									//Set the new learning rule
+									if(wchanges[wcrule]->ImplementPostSynaptic()==true){
+										this->inters[posc].SetWeightChange_withPost(this->wchanges[wcrule]);
+									}else{
+										this->inters[posc].SetWeightChange_withoutPost(this->wchanges[wcrule]);
+									}
+								}
+							}
+						}
+
+						// The index and the weights are set after the learning fields
+						this->inters[posc].SetIndex(posc);
+						this->inters[posc].SetMaxWeight(group->maxweight);
+						this->inters[posc].SetWeight(group->maxweight);   //TODO: Use max interconnection conductance
+					}
+
+					delete [] ConnectionRules;
+
 for(int t=0; t<this->nwchanges; t++){
 	if(N_ConectionWithLearning[t]>0){
-		this->wchanges[t]->InitializeConnectionState(N_ConectionWithLearning[t]);
+		this->wchanges[t]->InitializeConnectionState(N_ConectionWithLearning[t], this->nneurons);
 	}
 }
 if(this->nwchanges>0){
 delete [] N_ConectionWithLearning;
 }
         				
-						FindOutConnections();
-                    	SetWeightOrdination(); // must be before find_in_c() and after find_out_c()
+						FindOutConnections(); // it also sets the weight ordination (must be before find_in_c())
                     	FindInConnections();
                     }else{
+        				delete [] ConnectionRules;
         				throw EDLUTFileException(4,5,28,0,Currentline);
         			}
         		}else{
@@ -688,7 +852,7 @@ ostream & Network::PrintInfo(ostream & out) {
 
 	for(ind=0; ind<this->ninters; ind++){
 		out << "\tConnection: " << ind << endl;
-		this->inters[ind].PrintInfo(out);
+		this->wordination[ind]->PrintInfo(out);
 	}
 	
 	return out;
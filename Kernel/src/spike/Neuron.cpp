@@ -79,6 +79,8 @@ void Neuron::InitNeuron(int NewIndex, int index_VectorNeuronState, NeuronModel *
 	this->spikeCounter = 0; // For LSAM
 
 	this->isOutput = IsOutput;
+
+	this->PredictedSpike = 0;
 }
 
 long int Neuron::GetIndex() const{
@@ -70,12 +70,14 @@ void PropagatedSpike::ProcessEvent(Simulation * CurrentSimulation, bool RealTime
 			Generated = target->GetNeuronModel()->ProcessInputSpike(inter, target, CurrentTime);
 
 
-			if (Generated!=0){
+			if (target->GetNeuronModel()->GetModelType() == EVENT_DRIVEN_MODEL){
+				CurrentSimulation->UpdatePredictedSpike(target, Generated);
+			} else if (Generated!=0){
 				CurrentSimulation->GetQueue()->InsertEvent(Generated);
 			}
 
 			if (target->IsMonitored()){
-				CurrentSimulation->WriteState(CurrentTime, target);
+				CurrentSimulation->WriteState(CurrentTime, target, false);
 			}
 
 			ConnectionRule = inter->GetWeightChange_withoutPost();
@@ -1,4 +1,14 @@
-// Version 2.2
+// Version 2.3
+// Usage: TableGenerator [-e adaptive_error [-i 0|1] [-g max_growth]] [model_description_file]
+// The model description (equations and $PAR$ table definition) is compiled in through MODEL_FILE
+// (-DMODEL_FILE=\"model.c\"), and by default its table definition is read from the same file.
+// When compiled with OpenMP (-fopenmp) the table slices are calculated in parallel (OMP_NUM_THREADS)
+// and the generated tables do not depend on the number of threads.
+// With -e the coordinates of the configuration file are only the starting point: each dimension is
+// coarsened and refined until the interpolation error (relative to the output range of the table) is
+// below adaptive_error. -i selects the interpolation assumed by the error estimation (0=nearest
+// coordinate, 1=linear, default) and -g the maximum growth of each table size (4 by default).
+// The accuracy report is written to the file <table_file>.report
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -6,6 +16,9 @@
 #include <float.h>
 #include <time.h>
 #include <stdint.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #define MAXIDSIZE 32
 #define MAXIDSIZEC "32"
@@ -35,7 +48,11 @@ struct ttable Tables[MAXTABLES];
 
    int Deb;
 
-#include "tab2cfg.c"
+#ifndef MODEL_FILE
+#define MODEL_FILE "tab2cfg.c"
+#endif
+
+#include MODEL_FILE
 #define MAXDIMENSIONS (NUM_EQS+1)
 #define NEQSYS sizeof(Eq_sys)/((sizeof(void*)+sizeof(int))*NUM_EQS)
 
@@ -85,12 +102,22 @@ int Varupdate[NUM_EQS];
 // Global statistical variables
 unsigned long Function_evaluations;
 unsigned long Numeric_errs;
+#ifdef _OPENMP
+#pragma omp threadprivate(Function_evaluations,Numeric_errs)
+#endif
 
 // Global parameters
 float Error_tolerance=0.002;
 float Time_step_folding=1.2;
 float Max_retries=-1; //-1 = infinite (modify if approx never ends)
 
+// Adaptive coordinate selection parameters
+float Adaptive_error=0.0; // maximum interpolation error relative to the table output range (0 = use the coordinates of the configuration file)
+int Adaptive_interpolation=1; // interpolation assumed to estimate the error (0 = nearest coordinate, 1 = linear)
+#define MAXADAPTITERATIONS 8 // maximum number of refinements of each dimension
+float Adaptive_growth=4.0; // maximum growth of the table size (the growth is shared by the adapted dimensions)
+#define MAXVIRTUALCOORDS 4096 // the simulator creates (last-first)/minimum_increment virtual coordinates per dimension
+
 long Currentline;
 #define COMMENT_CHAR '/'
 int skip_spaces(FILE *fh)
@@ -148,6 +175,9 @@ void lineerror(int errwar, char *msg)
 inline float table_access(int ntable, union vars *v)
   {
    static unsigned int coo[MAXTABLES][MAXDIMENSIONS]={{0}};
+#ifdef _OPENMP
+#pragma omp threadprivate(coo)
+#endif
    unsigned long ndim,tabpos;
    struct ttablecfg *ctableconf;
    struct ttable *ctableel;
@@ -957,44 +987,60 @@ inline float table_element_calculation(float h, struct ttablecfg *tab, struct co
    return(ret_h);
   }
 
-inline int inc_coordinates(unsigned long *coo, int *dper, int *vper, struct ttablecfg *tab, struct tcoordinates *coord, union vars *vars, float *prev_t)
+// calculate all the elements of a table slice: the elements which only differ in the first-dimension (normally time) coordinate
+// each slice starts from the initial values (and from the same integration step), so slices can be calculated in any order
+void calculate_table_slice(float *table, struct ttablecfg *tab, struct consts *cons, struct tcoordinates *coord, int *dper, int *vper, unsigned long slice)
   {
-   unsigned long ndims, idim, ieq;
-   int ret;
+   unsigned long coo[MAXDIMENSIONS];
+   float prev_t,next_t,time_step;
+   unsigned long tabpos,ndims,i;
+   union vars vars;
+   int neqsel,neqsys;
+
    ndims=tab->ndimensions;
-   
-   for(idim=0;idim<ndims && ++coo[idim] >= coord->size[dper[idim]];idim++)
+   // obtain the coordinates of the other dimensions from the slice number
+   coo[0]=0;
+   for(i=1;i<ndims;i++)
      {
-      coo[idim]=0;
+      coo[i]=slice%coord->size[dper[i]];
+      slice/=coord->size[dper[i]];
      }
-   if(idim<ndims) // if calculation has not finished yet
+   vars.named.t=0;
+   time_step=1; // Not important
+   do
      {
-      if(idim>0 || vper[0] != 0) // if a dimension coordinate which is not time has changed or the table does not have time dimension
+      if(coo[0]==0 || vper[0] != 0) // if the slice starts or the table does not have time dimension
         {
          // initialize all variables except time (which does not have initialization value)
-         for(ieq=0;ieq<NUM_EQS;ieq++)
-            vars->list[ieq+1]=tab->varinit[ieq];
+         for(i=0;i<NUM_EQS;i++)
+            vars.list[i+1]=tab->varinit[i];
          // update all variables except the first one (normally time)
-         for(idim=1;idim<ndims;idim++)
-            vars->list[vper[idim]]=coord->ranges[dper[idim]][coo[idim]];
-         *prev_t=(vper[0] == 0)?coord->ranges[dper[0]][0]:0; // first time coordinate or 0
+         for(i=1;i<ndims;i++)
+            vars.list[vper[i]]=coord->ranges[dper[i]][coo[i]];
+         prev_t=(vper[0] == 0)?coord->ranges[dper[0]][0]:0; // first time coordinate or 0
+        }
+      vars.list[vper[0]]=coord->ranges[dper[0]][coo[0]]; // update first-dimension variable (normally time)
+      tabpos=0;
+      neqsel=0;
+      for(i=0;i<ndims;i++)
+        {
+         tabpos+=coo[dper[i]]*coord->posdim[i]; // calculate table position
+         neqsel|=coord->neqsel[i][coo[i]]; // calculate number of equation selector to be used for this element
         }
-      vars->list[vper[0]]=coord->ranges[dper[0]][coo[0]]; // update first-dimension variable (normally time)
-      ret=1;
+      neqsys=Eq_sel[neqsel](&vars, cons);
+      next_t=(vper[0] == 0)?coord->ranges[dper[0]][coo[0]]:0.0; // if table has time dimension, calculate current time coordinate
+      table_element_calculation(next_t-prev_t, tab, cons, &vars, &time_step, neqsys, &table[tabpos]);
+      prev_t=next_t;
      }
-   else
-      ret=0;
-   return(ret);
+   while(++coo[0] < coord->size[dper[0]]);
   }
 
 void calculate_table(float *table, struct ttablecfg *tab, struct consts *cons, struct tcoordinates coord)
   {
-   unsigned long coo[MAXDIMENSIONS]={0}; // all elements are initialized to 0
-   float prev_t,next_t,time_step;
-   unsigned long tabpos,ndims,i;
-   union vars vars;
+   unsigned long ndims,i,nslices,slices_done,evaluations,errors;
+   long slice;
    int dimper[MAXDIMENSIONS], dimvarper[MAXDIMENSIONS];
-   int neqsel,neqsys;
+   int last_progress;
 
    ndims=tab->ndimensions;
    // time must be the first dimension
@@ -1012,43 +1058,512 @@ void calculate_table(float *table, struct ttablecfg *tab, struct consts *cons, s
    for(i=0;i<ndims;i++)
       dimvarper[i]=tab->dimension[dimper[i]].var;
 
-   // initialize all variables except t
-   for(i=0;i<NUM_EQS;i++)
-       vars.list[i+1]=tab->varinit[i];
-   // initialize coordinate-dependent variables
+   nslices=coord.posdim[ndims]/coord.size[dimper[0]];
+   slices_done=0;
+   last_progress=-1;
+   evaluations=Function_evaluations; // the counters are accumulated
+   errors=Numeric_errs;
+   Deb=0;
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:evaluations,errors)
+#endif
+     {
+      unsigned long thread_evaluations,thread_errors;
+      thread_evaluations=Function_evaluations;
+      thread_errors=Numeric_errs;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,1)
+#endif
+      for(slice=0;slice<(long)nslices;slice++)
+        {
+         int progress;
+         calculate_table_slice(table, tab, cons, &coord, dimper, dimvarper, (unsigned long)slice);
+#ifdef _OPENMP
+#pragma omp critical(table_progress)
+#endif
+           {
+            slices_done++;
+            progress=(int)((100*slices_done)/nslices);
+            if(progress != last_progress)
+              {
+               last_progress=progress;
+               printf("\rCalculating...%3i%%",progress);
+               fflush(stdout);
+              }
+           }
+        }
+      evaluations+=Function_evaluations-thread_evaluations;
+      errors+=Numeric_errs-thread_errors;
+     }
+   Function_evaluations=evaluations;
+   Numeric_errs=errors;
+   printf(" ");
+  }
+
+struct tcoordinates alloc_coordinates(unsigned long ndims, unsigned long *sizes)
+  {
+   struct tcoordinates coord;
+   unsigned long i,maxran,pos,ncoor;
+   coord.ranges=NULL;
+   coord.neqsel=NULL;
+   coord.size=(unsigned long *)malloc(ndims*sizeof(unsigned long));
+   coord.posdim=(unsigned long *)malloc((ndims+1)*sizeof(unsigned long));
+   if(coord.size && coord.posdim)
+     {
+      maxran=0;
+      pos=1;
+      for(i=0;i<ndims;i++)
+        {
+         coord.size[i]=sizes[i];
+         maxran+=sizes[i];
+         coord.posdim[i]=pos;
+         pos*=sizes[i];
+        }
+      coord.posdim[i]=pos;
+      coord.ranges=(float **)malloc(sizeof(float *)*ndims+sizeof(float)*maxran);
+      coord.neqsel=(int **)malloc(sizeof(int *)*ndims+sizeof(int)*maxran);
+      if(coord.ranges && coord.neqsel)
+        {
+         ncoor=0;
+         for(i=0;i<ndims;i++) // create two bidimensional matrices
+           {
+            coord.ranges[i]=(float *)(coord.ranges+ndims)+ncoor;
+            coord.neqsel[i]=(int *)(coord.neqsel+ndims)+ncoor;
+            ncoor+=sizes[i];
+           }
+        }
+      else
+        {
+         free(coord.neqsel);
+         free(coord.ranges);
+         coord.ranges=NULL;
+        }
+     }
+   if(!coord.ranges) // if the allocation fails, set all pointers to NULL
+     {
+      perror("*>Allocating memory for table coordinates");
+      free(coord.posdim);
+      free(coord.size);
+      coord.neqsel=NULL;
+      coord.size=NULL;
+      coord.posdim=NULL;
+     }
+   return(coord);
+  }
+
+void free_coordinates(struct tcoordinates *coord)
+  {
+   free(coord->neqsel);
+   free(coord->ranges);
+   free(coord->posdim);
+   free(coord->size);
+   coord->neqsel=NULL;
+   coord->ranges=NULL;
+   coord->posdim=NULL;
+   coord->size=NULL;
+  }
+
+// interpolation error of the element vm placed at relative position w (0 to 1) between the elements va and vb
+float interpolation_error(float va, float vb, float vm, float w)
+  {
+   float vi;
+   if(Adaptive_interpolation)
+      vi=va+w*(vb-va);
+   else
+      vi=(w <= 0.5)?va:vb;
+   return(fabs(vm-vi));
+  }
+
+// create a table with the coordinates sel[] of dimension dim taken from table
+// the coordinates of dim are selected from the table coordinates
+int select_coordinates(struct ttable *table, unsigned long ndims, unsigned long dim, unsigned long *sel, unsigned long nsel)
+  {
+   struct tcoordinates coord;
+   unsigned long sizes[MAXDIMENSIONS];
+   unsigned long i,k,o,stride,others,nold,lower,upper;
+   float *elems;
+   for(i=0;i<ndims;i++)
+      sizes[i]=table->coord.size[i];
+   nold=sizes[dim];
+   sizes[dim]=nsel;
+   coord=alloc_coordinates(ndims, sizes);
+   if(!coord.ranges)
+      return(0);
+   elems=(float *)malloc(sizeof(float)*coord.posdim[ndims]);
+   if(!elems)
+     {
+      perror("*>Table file size too large (Not enough memory)");
+      free_coordinates(&coord);
+      return(0);
+     }
+   for(i=0;i<ndims;i++)
+      for(k=0;k<sizes[i];k++)
+        {
+         coord.ranges[i][k]=table->coord.ranges[i][(i==dim)?sel[k]:k];
+         coord.neqsel[i][k]=table->coord.neqsel[i][(i==dim)?sel[k]:k];
+        }
+   stride=coord.posdim[dim];
+   others=coord.posdim[ndims]/nsel;
+   for(o=0;o<others;o++)
+     {
+      lower=o%stride;
+      upper=o/stride;
+      for(k=0;k<nsel;k++)
+         elems[lower+k*stride+upper*stride*nsel]=table->elems[lower+sel[k]*stride+upper*stride*nold];
+     }
+   free(table->elems);
+   free_coordinates(&table->coord);
+   table->elems=elems;
+   table->coord=coord;
+   return(1);
+  }
+
+// remove the coordinates of dimension dim which can be interpolated from their neighbors with an error lower than maxerr/2
+// the coordinates where the equation selector changes are always kept
+int coarsen_dimension(struct ttable *table, unsigned long ndims, unsigned long dim, float maxerr)
+  {
+   unsigned long *sel;
+   unsigned long n,nsel,last,j,m,o,stride,others,base;
+   float *r,*e,w;
+   int removable,ret,*s;
+   n=table->coord.size[dim];
+   if(n < 3)
+      return(1);
+   sel=(unsigned long *)malloc(n*sizeof(unsigned long));
+   if(!sel)
+      return(0);
+   r=table->coord.ranges[dim];
+   s=table->coord.neqsel[dim];
+   e=table->elems;
+   stride=table->coord.posdim[dim];
+   others=table->coord.posdim[ndims]/n;
+   nsel=0;
+   sel[nsel++]=last=0;
+   for(j=1;j+1<n;j++)
+     {
+      // check if all the coordinates between the last kept one and j+1 can be interpolated
+      removable=(r[j+1] > r[last] && s[j] == s[j-1] && s[j] == s[j+1]);
+      for(m=last+1;m<=j && removable;m++)
+        {
+         w=(r[m]-r[last])/(r[j+1]-r[last]);
+         for(o=0;o<others && removable;o++)
+           {
+            base=o%stride+(o/stride)*stride*n;
+            if(!(interpolation_error(e[base+last*stride], e[base+(j+1)*stride], e[base+m*stride], w) <= maxerr/2))
+               removable=0;
+           }
+        }
+      if(!removable)
+         sel[nsel++]=last=j;
+     }
+   sel[nsel++]=n-1;
+   ret=(nsel<n)?select_coordinates(table, ndims, dim, sel, nsel):1;
+   free(sel);
+   return(ret);
+  }
+
+int compare_errors(const void *e1, const void *e2)
+  {
+   return((*(float *)e1 < *(float *)e2) - (*(float *)e1 > *(float *)e2)); // descending order
+  }
+
+// insert the middle point of the intervals of dimension dim whose interpolation error is greater than maxerr
+// only the intervals marked in check[] are evaluated (the error of the others is kept in errs[])
+// intervals between coordinates with different equation selectors are not refined
+// if the dimension would have more than maxcoords coordinates, only the intervals with the largest errors are refined
+// check[] and errs[] are reallocated for the new coordinates and the new intervals are marked to be checked
+// it returns the number of inserted coordinates (-1 on error)
+long refine_dimension(struct ttable *table, struct ttablecfg *tab, struct consts *cons, unsigned long dim, float maxerr, float range, unsigned long maxcoords, char **check, float **errs)
+  {
+   struct ttable cand,mid;
+   unsigned long sizes[MAXDIMENSIONS];
+   unsigned long *sel,*pos;
+   unsigned long ndims,n,nm,nc,nsel,i,j,k,m,o,stride,others,lower,upper,nrefinable;
+   float *r,*cr,*sorted,*newerrs,min_increment,err,w,interr,cutoff;
+   char *newcheck;
+   int full;
+   long ninserted;
+   ndims=tab->ndimensions;
+   n=table->coord.size[dim];
+   r=table->coord.ranges[dim];
+   min_increment=(r[n-1]-r[0])/MAXVIRTUALCOORDS;
+   nm=0;
+   for(k=0;k<n-1;k++)
+      nm+=(*check)[k];
+   if(nm == 0)
+      return(0);
+   // candidate table: current coordinates and the middle point of each interval to check
+   nc=n+nm;
+   for(i=0;i<ndims;i++)
+      sizes[i]=table->coord.size[i];
+   sizes[dim]=nc;
+   cand.coord=alloc_coordinates(ndims, sizes);
+   if(!cand.coord.ranges)
+      return(-1);
+   cand.elems=(float *)malloc(sizeof(float)*cand.coord.posdim[ndims]);
+   sel=(unsigned long *)malloc(nc*sizeof(unsigned long));
+   pos=(unsigned long *)malloc(n*sizeof(unsigned long));
+   sorted=(float *)malloc(nm*sizeof(float));
+   newcheck=(char *)malloc(nc);
+   newerrs=(float *)malloc(nc*sizeof(float));
+   if(!cand.elems || !sel || !pos || !sorted || !newcheck || !newerrs)
+     {
+      perror("*>Table file size too large (Not enough memory)");
+      free(newerrs);
+      free(newcheck);
+      free(sorted);
+      free(pos);
+      free(sel);
+      free(cand.elems);
+      free_coordinates(&cand.coord);
+      return(-1);
+     }
+   for(i=0;i<ndims;i++)
+      if(i!=dim)
+         for(k=0;k<sizes[i];k++)
+           {
+            cand.coord.ranges[i][k]=table->coord.ranges[i][k];
+            cand.coord.neqsel[i][k]=table->coord.neqsel[i][k];
+           }
+   cr=cand.coord.ranges[dim];
+   for(j=k=0;k<n;k++)
+     {
+      pos[k]=j;
+      cr[j]=r[k];
+      cand.coord.neqsel[dim][j++]=table->coord.neqsel[dim][k];
+      if(k<n-1 && (*check)[k])
+        {
+         cr[j]=(r[k]+r[k+1])/2;
+         cand.coord.neqsel[dim][j++]=table->coord.neqsel[dim][k];
+        }
+     }
+   stride=cand.coord.posdim[dim];
+   others=cand.coord.posdim[ndims]/nc;
+   // the slices are calculated independently, so only the middle points have to be calculated
+   // unless the dimension is time (or time is not the first dimension)
+   full=0;
    for(i=0;i<ndims;i++)
-      vars.list[tab->dimension[i].var]=coord.ranges[i][coo[i]]; // coo[] is initialized to 0
-   if(dimvarper[0] != 0) // if the first coordinate-dependent variable is not time
-      prev_t=0; // the tables does not have time dimension: set time to 0
+      full=full || (tab->dimension[i].var==0 && (i==dim || i>0));
+   if(full)
+      calculate_table(cand.elems, tab, cons, cand.coord);
    else
-      prev_t=coord.ranges[dimper[0]][coo[0]]; // first initial-dimension (normally time) coordinate
-   time_step=1; // Not important
-   Deb=0;
-   do
      {
-      tabpos=0;
-      neqsel=0;
+      sizes[dim]=nm;
+      mid.coord=alloc_coordinates(ndims, sizes);
+      mid.elems=(mid.coord.ranges)?(float *)malloc(sizeof(float)*mid.coord.posdim[ndims]):NULL;
+      if(!mid.elems)
+        {
+         perror("*>Table file size too large (Not enough memory)");
+         free_coordinates(&mid.coord);
+         free(newerrs);
+         free(newcheck);
+         free(sorted);
+         free(pos);
+         free(sel);
+         free(cand.elems);
+         free_coordinates(&cand.coord);
+         return(-1);
+        }
       for(i=0;i<ndims;i++)
+         if(i!=dim)
+            for(k=0;k<sizes[i];k++)
+              {
+               mid.coord.ranges[i][k]=cand.coord.ranges[i][k];
+               mid.coord.neqsel[i][k]=cand.coord.neqsel[i][k];
+              }
+      for(m=k=0;k<n-1;k++)
+         if((*check)[k])
+           {
+            mid.coord.ranges[dim][m]=cr[pos[k]+1];
+            mid.coord.neqsel[dim][m++]=cand.coord.neqsel[dim][pos[k]+1];
+           }
+      calculate_table(mid.elems, tab, cons, mid.coord);
+      for(o=0;o<others;o++)
         {
-         tabpos+=coo[dimper[i]]*coord.posdim[i]; // calculate table position
-         neqsel|=coord.neqsel[i][coo[i]]; // calculate number of equation selector to be used for this element
+         lower=o%stride;
+         upper=o/stride;
+         for(m=k=0;k<n;k++)
+           {
+            cand.elems[lower+pos[k]*stride+upper*stride*nc]=table->elems[lower+k*stride+upper*stride*n];
+            if(k<n-1 && (*check)[k])
+               cand.elems[lower+(pos[k]+1)*stride+upper*stride*nc]=mid.elems[lower+(m++)*stride+upper*stride*nm];
+           }
         }
-      neqsys=Eq_sel[neqsel](&vars, cons);
-      next_t=(dimvarper[0] == 0)?coord.ranges[dimper[0]][coo[0]]:0.0; // if table has time dimension, calculate current time coordinate
-      table_element_calculation(next_t-prev_t, tab, cons, &vars, &time_step, neqsys, &table[tabpos]);
-      prev_t=next_t;
-/*      if(Function_evaluations > 100000L)
+      free(mid.elems);
+      free_coordinates(&mid.coord);
+     }
+   // estimate the interpolation error of each checked interval in its middle point
+   nrefinable=0;
+   for(k=0;k<n-1;k++)
+     {
+      if(!(*check)[k])
+         continue;
+      j=pos[k];
+      err=0;
+      w=(cr[j+1]-cr[j])/(cr[j+2]-cr[j]);
+      for(o=0;o<others;o++)
+        {
+         lower=o%stride+(o/stride)*stride*nc;
+         interr=interpolation_error(cand.elems[lower+j*stride], cand.elems[lower+(j+2)*stride], cand.elems[lower+(j+1)*stride], w);
+         if(!(interr <= err)) // NaN errors are also taken
+            err=interr;
+        }
+      if(range > 0)
+         err/=range;
+      (*errs)[k]=err;
+      (*check)[k]=0;
+      if(err > maxerr && cand.coord.neqsel[dim][j] == cand.coord.neqsel[dim][j+2] && cr[j+1]-cr[j] >= min_increment && cr[j+2]-cr[j+1] >= min_increment)
+        {
+         sorted[nrefinable++]=err;
+         (*check)[k]=1; // this interval can be refined
+        }
+     }
+   // error from which the intervals are refined
+   cutoff=maxerr;
+   if(n+nrefinable > maxcoords)
+     {
+      qsort(sorted, nrefinable, sizeof(float), compare_errors);
+      cutoff=(maxcoords > n)?sorted[maxcoords-n-1]:FLT_MAX;
+     }
+   nsel=0;
+   ninserted=0;
+   for(k=0;k<n;k++)
+     {
+      sel[nsel]=pos[k];
+      if(k<n-1)
+        {
+         if((*check)[k] && (*errs)[k] >= cutoff && n+ninserted < maxcoords)
+           {
+            // the two new intervals must be checked
+            newcheck[nsel]=1;
+            newerrs[nsel++]=(*errs)[k];
+            sel[nsel]=pos[k]+1;
+            newcheck[nsel]=1;
+            newerrs[nsel++]=(*errs)[k];
+            ninserted++;
+           }
+         else
+           {
+            newcheck[nsel]=0;
+            newerrs[nsel++]=(*errs)[k];
+           }
+        }
+      else
+         nsel++;
+     }
+   free(*check);
+   free(*errs);
+   *check=newcheck;
+   *errs=newerrs;
+   free(table->elems);
+   free_coordinates(&table->coord);
+   *table=cand;
+   if(!select_coordinates(table, ndims, dim, sel, nsel))
+      ninserted=-1;
+   free(sorted);
+   free(pos);
+   free(sel);
+   return(ninserted);
+  }
+
+// adapt the coordinates of every dimension of the table to the target interpolation error (Adaptive_error)
+// dimensions with less than 3 coordinates are considered discrete (e.g. the spiking state) and they are not modified
+// the table size can grow up to Adaptive_growth times, and the growth left is shared by the dimensions not adapted yet
+int adapt_table(FILE *rfd, struct ttable *table, struct ttablecfg *tab, struct consts *cons)
+  {
+   unsigned long ndims,dim,tabsize,i,initsize,maxcoords,unchecked,nadapt;
+   float minv,maxv,range,maxrelerr,meanrelerr,maxsize;
+   float *errs;
+   char *check;
+   long ninserted;
+   int iter,ret;
+   ndims=tab->ndimensions;
+   tabsize=table->coord.posdim[ndims];
+   minv=FLT_MAX;
+   maxv=-FLT_MAX;
+   for(i=0;i<tabsize;i++)
+     {
+      if(table->elems[i] < minv)
+         minv=table->elems[i];
+      if(table->elems[i] > maxv)
+         maxv=table->elems[i];
+     }
+   range=(maxv > minv)?maxv-minv:0;
+   maxsize=Adaptive_growth*tabsize;
+   nadapt=0;
+   for(dim=0;dim<ndims;dim++)
+      nadapt+=(table->coord.size[dim] > 2);
+   ret=1;
+   if(rfd)
+      fprintf(rfd,"Table output variable %i, output range %g, target relative error %g, %s interpolation\n",tab->outputvar+1,range,Adaptive_error,(Adaptive_interpolation)?"linear":"nearest-coordinate");
+   for(dim=0;dim<ndims && ret;dim++)
+     {
+      initsize=table->coord.size[dim];
+      maxrelerr=meanrelerr=0;
+      unchecked=0;
+      if(initsize > 2)
+        {
+         ret=coarsen_dimension(table, ndims, dim, Adaptive_error*range);
+         // share the growth left among this and the following adaptable dimensions
+         maxcoords=(unsigned long)(table->coord.size[dim]*pow(maxsize/table->coord.posdim[ndims], 1.0/nadapt--));
+         if(maxcoords < table->coord.size[dim])
+            maxcoords=table->coord.size[dim];
+         check=(char *)malloc(table->coord.size[dim]);
+         errs=(float *)malloc(table->coord.size[dim]*sizeof(float));
+         if(ret && check && errs)
+           {
+            for(i=0;i<table->coord.size[dim]-1;i++)
+               check[i]=1;
+            for(iter=0;iter<MAXADAPTITERATIONS && ret;iter++)
+              {
+               ninserted=refine_dimension(table, tab, cons, dim, Adaptive_error, range, maxcoords, &check, &errs);
+               if(ninserted < 0)
+                  ret=0;
+               if(ninserted <= 0 || table->coord.size[dim] >= maxcoords)
+                  break;
+              }
+            if(ret)
+              {
+               for(i=0;i<table->coord.size[dim]-1;i++)
+                 {
+                  unchecked+=check[i];
+                  if(errs[i] > maxrelerr)
+                     maxrelerr=errs[i];
+                  meanrelerr+=errs[i];
+                 }
+               meanrelerr/=table->coord.size[dim]-1;
+              }
+           }
+         else
+            ret=0;
+         free(errs);
+         free(check);
+        }
+      printf("\n  Dimension %lu (variable %i): %lu -> %lu coordinates, max error %g, mean error %g%s\n",dim,tab->dimension[dim].var,initsize,table->coord.size[dim],maxrelerr,meanrelerr,(initsize <= 2)?" (not adapted)":(unchecked > 0 || maxrelerr > Adaptive_error)?" (not converged)":"");
+      if(rfd)
         {
-         Function_evaluations=0;
-         for(i=0;i<ndims;i++)
-            printf("%f ",coord.ranges[i][coo[dimper[i]]]);
-         puts("");
-        } */
+         fprintf(rfd,"Dimension %lu (variable %i): %lu -> %lu coordinates, max error %g, mean error %g%s\n",dim,tab->dimension[dim].var,initsize,table->coord.size[dim],maxrelerr,meanrelerr,(initsize <= 2)?" (not adapted)":(unchecked > 0 || maxrelerr > Adaptive_error)?" (not converged)":"");
+         for(i=0;i<table->coord.size[dim];i++)
+            fprintf(rfd,"%g ",table->coord.ranges[dim][i]);
+         fprintf(rfd,"\n");
+        }
      }
-   while(inc_coordinates(coo, dimper, dimvarper, tab, &coord, &vars, &prev_t));
+   if(rfd)
+      fprintf(rfd,"\n");
+   return(ret);
+  }
+
+// wall-clock time in seconds (processor time is added up for all the threads)
+double elapsed_time(void)
+  {
+#ifdef _OPENMP
+   return(omp_get_wtime());
+#else
+   return(clock()/(double)CLOCKS_PER_SEC);
+#endif
   }
 
-struct ttable generate_table(FILE *ofd, struct ttablecfg *tabcfg, struct consts *cons)
+struct ttable generate_table(FILE *ofd, FILE *rfd, struct ttablecfg *tabcfg, struct consts *cons)
   {
    unsigned long tabsize;
    struct ttable table;
@@ -1064,14 +1579,22 @@ struct ttable generate_table(FILE *ofd, struct ttablecfg *tabcfg, struct consts
       table.elems=(float *)malloc(sizeof(float)*tabsize);
       if(table.elems)
         {
-         clock_t startt,endt;
+         double startt,endt;
          Function_evaluations=0L;
          Numeric_errs=0L;
-         startt=clock();
+         startt=elapsed_time();
          calculate_table(table.elems, tabcfg, cons, table.coord);
-         endt=clock();
-         printf("%lu evaluations (%gs) Numeric errors: %lu\n",Function_evaluations,(endt-startt)/(float)CLOCKS_PER_SEC,Numeric_errs);
-         save_table(ofd, tabcfg, table.coord, table.elems);
+         if(Adaptive_error > 0.0 && !adapt_table(rfd, &table, tabcfg, cons))
+           {
+            free(table.elems);
+            table.elems=NULL;
+           }
+         endt=elapsed_time();
+         if(table.elems)
+           {
+            printf("%lu evaluations (%gs) Numeric errors: %lu\n",Function_evaluations,endt-startt,Numeric_errs);
+            save_table(ofd, tabcfg, table.coord, table.elems);
+           }
         }
       else
         {
@@ -1089,7 +1612,7 @@ struct ttable generate_table(FILE *ofd, struct ttablecfg *tabcfg, struct consts
 
 int generate_files(void)
   {
-   FILE *ofd;
+   FILE *ofd,*rfd;
    int ret;
    long ti;
    struct ttablecfg *tab;
@@ -1103,10 +1626,19 @@ int generate_files(void)
          struct consts *cons;
          cons=&Confdef.file[Currentfile].cons;
          printf("--File: %s\n",Confdef.file[Currentfile].ident);
+         rfd=NULL;
+         if(Adaptive_error > 0.0)
+           {
+            char rname[MAXIDSIZE+8];
+            sprintf(rname,"%s.report",Confdef.file[Currentfile].ident);
+            rfd=fopen(rname,"wt");
+            if(!rfd)
+               perror("*>Can't create accuracy report file");
+           }
          for(ti=0;ti<Confdef.file[Currentfile].ntables;ti++)
            {
             tab=&Confdef.file[Currentfile].table[ti];
-            Tables[ti]=generate_table(ofd, tab, cons);
+            Tables[ti]=generate_table(ofd, rfd, tab, cons);
             if(!Tables[ti].elems)
               {
                printf("*>Table could not be processed\n");
@@ -1121,6 +1653,8 @@ int generate_files(void)
             free(Tables[ti].coord.posdim);
             free(Tables[ti].coord.size);
            }
+         if(rfd)
+            fclose(rfd);
          fclose(ofd);
         }
       else
@@ -1132,10 +1666,29 @@ int generate_files(void)
    return(ret);
   }
 
-int main()
+int main(int argc, char *argv[])
   {
-   int ret;
-   ret=load_conffile("tab2cfg.c");
+   int ret,narg;
+   char *cfgfile;
+   cfgfile=MODEL_FILE;
+   ret=1;
+   for(narg=1;narg<argc && ret;narg++)
+     {
+      if(!strcmp(argv[narg],"-e") && narg+1<argc)
+         ret=(sscanf(argv[++narg],"%f",&Adaptive_error)==1 && Adaptive_error >= 0.0);
+      else if(!strcmp(argv[narg],"-i") && narg+1<argc)
+         ret=(sscanf(argv[++narg],"%i",&Adaptive_interpolation)==1);
+      else if(!strcmp(argv[narg],"-g") && narg+1<argc)
+         ret=(sscanf(argv[++narg],"%f",&Adaptive_growth)==1 && Adaptive_growth >= 1.0);
+      else
+         cfgfile=argv[narg];
+     }
+   if(!ret)
+     {
+      printf("Usage: %s [-e adaptive_error [-i 0|1] [-g max_growth]] [model_description_file]\n",argv[0]);
+      return(1);
+     }
+   ret=load_conffile(cfgfile);
    if(ret)
       generate_files();
    return(!ret);